@@ -5189,6 +5189,18 @@ declare global {
 
     interface Profiler {
         getData(): ProfiledFunction[];
+        /**
+         * Gets the time spent by each plugin in each hook, interval and custom action.
+         */
+        getPluginData(): ProfiledPluginCall[];
+        /**
+         * Sets the maximum time each plugin may spend per tick. Plugins exceeding the budget are logged,
+         * and with "throttle" their intervals and hooks that do not modify the game state are skipped for a while.
+         * The budget applies whether or not the profiler has been started.
+         * @param milliseconds The budget per tick, 0 removes the budget.
+         * @param action What to do when a plugin exceeds the budget.
+         */
+        setPluginBudget(milliseconds: number, action: "none" | "log" | "throttle"): void;
         start(): void;
         stop(): void;
         reset(): void;
@@ -5205,6 +5217,19 @@ declare global {
         readonly children: number[];
     }
 
+    interface ProfiledPluginCall {
+        readonly plugin: string;
+        /**
+         * The hook name, "interval", "action.custom.query" or "action.custom.execute".
+         */
+        readonly name: string;
+        readonly callCount: number;
+        readonly maxTime: number;
+        readonly totalTime: number;
+        readonly p50: number;
+        readonly p99: number;
+    }
+
     interface ObjectManager {
         /**
          * Gets all the objects that are installed and can be loaded into the park.
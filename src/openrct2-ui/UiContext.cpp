@@ -44,6 +44,7 @@
 #include <openrct2/platform/Platform.h>
 #include <openrct2/scenes/title/TitleSequencePlayer.h>
 #include <openrct2/scripting/ScriptEngine.h>
+#include <openrct2/ui/DeferredUi.h>
 #include <openrct2/ui/UiContext.h>
 #include <openrct2/ui/WindowManager.h>
 #include <openrct2/world/Location.hpp>
@@ -708,6 +709,11 @@ public:
 
     IWindowManager* GetWindowManager() override
     {
+        // Threads that do not own the windows, such as the simulation thread, queue their calls
+        if (auto* deferred = GetDeferredWindowCalls(); deferred != nullptr)
+        {
+            return deferred;
+        }
         return _windowManager.get();
     }
 
@@ -462,6 +462,10 @@ public:
                 WindowGuestListRefreshList();
                 break;
 
+            case INTENT_ACTION_UPDATE_GUEST_LIST_ENTRY:
+                WindowGuestListUpdateGuest(EntityId::FromUnderlying(intent.GetUIntExtra(INTENT_EXTRA_PEEP_ID)));
+                break;
+
             case INTENT_ACTION_REFRESH_STAFF_LIST:
             {
                 WindowStaffListRefresh();
@@ -498,7 +502,6 @@ public:
                 gToolbarDirtyFlags |= BTM_TB_DIRTY_FLAG_PEEP_COUNT;
                 WindowInvalidateByClass(WindowClass::GuestList);
                 WindowInvalidateByClass(WindowClass::ParkInformation);
-                WindowGuestListRefreshList();
                 break;
 
             case INTENT_ACTION_UPDATE_PARK_RATING:
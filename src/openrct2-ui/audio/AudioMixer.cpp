@@ -10,13 +10,22 @@
 #include "AudioMixer.h"
 
 #include <algorithm>
+#include <cmath>
 #include <iterator>
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/config/Config.h>
 #include <speex/speex_resampler.h>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#    include <emmintrin.h>
+#    define OPENRCT2_AUDIO_SSE2
+#endif
+
 using namespace OpenRCT2::Audio;
 
+// Sources are converted to this format when they are loaded, so that in-memory sounds can be mixed without conversion.
+static constexpr AudioFormat kNativeFormat = { 22050, AUDIO_F32SYS, 2 };
+
 AudioMixer::~AudioMixer()
 {
     Close();
@@ -27,9 +36,10 @@ void AudioMixer::Init(const char* device)
     Close();
 
     SDL_AudioSpec want = {};
-    want.freq = 22050;
-    want.format = AUDIO_S16SYS;
-    want.channels = 2;
+    want.freq = kNativeFormat.freq;
+    // SDL converts the mixed samples to the device format as no changes are allowed
+    want.format = kNativeFormat.format;
+    want.channels = kNativeFormat.channels;
     want.samples = 2048;
     want.callback = [](void* arg, uint8_t* dst, int32_t length) -> void {
         auto* mixer = static_cast<AudioMixer*>(arg);
@@ -63,6 +73,33 @@ void AudioMixer::Close()
     _convertBuffer.shrink_to_fit();
     _effectBuffer.clear();
     _effectBuffer.shrink_to_fit();
+    _mixBuffer.clear();
+    _mixBuffer.shrink_to_fit();
+    _cvtCache.clear();
+}
+
+void AudioMixer::InitOffline()
+{
+    Close();
+    _deviceId = 0;
+    _format = kNativeFormat;
+}
+
+std::vector<float> AudioMixer::RenderOffline(double seconds)
+{
+    constexpr size_t kFramesPerChunk = 2048;
+
+    const size_t byteRate = _format.GetByteRate();
+    const auto totalFrames = static_cast<size_t>(seconds * _format.freq);
+    std::vector<float> output(totalFrames * _format.channels);
+    auto* dst = reinterpret_cast<uint8_t*>(output.data());
+    for (size_t frame = 0; frame < totalFrames; frame += kFramesPerChunk)
+    {
+        auto frames = std::min(kFramesPerChunk, totalFrames - frame);
+        GetNextAudioChunk(dst + frame * byteRate, frames * byteRate);
+        RemoveReleasedSources();
+    }
+    return output;
 }
 
 void AudioMixer::Lock()
@@ -128,8 +165,8 @@ void AudioMixer::GetNextAudioChunk(uint8_t* dst, size_t length)
 {
     UpdateAdjustedSound();
 
-    // Zero the output buffer
-    std::fill_n(dst, length, 0);
+    // Channels are accumulated in float and only clamped once all of them have been mixed
+    _mixBuffer.assign(length / _format.BytesPerSample(), 0.0f);
 
     // Mix channels onto output buffer
     auto it = _channels.begin();
@@ -149,11 +186,33 @@ void AudioMixer::GetNextAudioChunk(uint8_t* dst, size_t length)
             if ((group != MixerGroup::Sound || Config::Get().sound.SoundEnabled) && Config::Get().sound.MasterSoundEnabled
                 && Config::Get().sound.MasterVolume != 0)
             {
-                MixChannel(channel.get(), dst, length);
+                MixChannel(channel.get(), length);
             }
             it++;
         }
     }
+
+    WriteMixBuffer(dst, length);
+}
+
+void AudioMixer::WriteMixBuffer(uint8_t* dst, size_t length) const
+{
+    auto* dstF32 = reinterpret_cast<float*>(dst);
+    const auto* src = _mixBuffer.data();
+    const auto numSamples = std::min(_mixBuffer.size(), length / sizeof(float));
+    size_t i = 0;
+#ifdef OPENRCT2_AUDIO_SSE2
+    const __m128 lower = _mm_set1_ps(-1.0f);
+    const __m128 upper = _mm_set1_ps(1.0f);
+    for (; i + 4 <= numSamples; i += 4)
+    {
+        _mm_storeu_ps(dstF32 + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), lower), upper));
+    }
+#endif
+    for (; i < numSamples; i++)
+    {
+        dstF32[i] = std::clamp(src[i], -1.0f, 1.0f);
+    }
 }
 
 void AudioMixer::UpdateAdjustedSound()
@@ -171,48 +230,40 @@ void AudioMixer::UpdateAdjustedSound()
     }
 }
 
-void AudioMixer::MixChannel(ISDLAudioChannel* channel, uint8_t* data, size_t length)
+void AudioMixer::MixChannel(ISDLAudioChannel* channel, size_t length)
 {
     int32_t byteRate = _format.GetByteRate();
     auto numSamples = static_cast<int32_t>(length / byteRate);
-    double rate = 1;
-    if (_format.format == AUDIO_S16SYS)
-    {
-        rate = channel->GetRate();
-    }
+    double rate = channel->GetRate();
 
-    bool mustConvert = false;
-    SDL_AudioCVT cvt;
-    cvt.len_ratio = 1;
+    SDL_AudioCVT* cvt = nullptr;
     AudioFormat streamformat = channel->GetFormat();
     if (streamformat != _format)
     {
-        if (SDL_BuildAudioCVT(
-                &cvt, streamformat.format, streamformat.channels, streamformat.freq, _format.format, _format.channels,
-                _format.freq)
-            == -1)
+        cvt = GetConverter(streamformat);
+        if (cvt == nullptr)
         {
             // Unable to convert channel data
             return;
         }
-        mustConvert = true;
     }
 
     // Read raw PCM from channel
     int32_t readSamples = numSamples * rate;
-    auto readLength = static_cast<size_t>(readSamples / cvt.len_ratio) * byteRate;
+    auto lenRatio = cvt != nullptr ? cvt->len_ratio : 1.0;
+    auto readLength = static_cast<size_t>(readSamples / lenRatio) * byteRate;
     _channelBuffer.resize(readLength);
     size_t bytesRead = channel->Read(_channelBuffer.data(), readLength);
 
-    // Convert data to required format if necessary
-    void* buffer = nullptr;
+    // Convert data to required format if necessary, only streamed sources are not converted when they are loaded
+    const float* buffer = nullptr;
     size_t bufferLen = 0;
-    if (mustConvert)
+    if (cvt != nullptr)
     {
-        if (Convert(&cvt, _channelBuffer.data(), bytesRead))
+        if (Convert(cvt, _channelBuffer.data(), bytesRead))
         {
-            buffer = cvt.buf;
-            bufferLen = cvt.len_cvt;
+            buffer = reinterpret_cast<const float*>(cvt->buf);
+            bufferLen = cvt->len_cvt;
         }
         else
         {
@@ -221,7 +272,7 @@ void AudioMixer::MixChannel(ISDLAudioChannel* channel, uint8_t* data, size_t len
     }
     else
     {
-        buffer = _channelBuffer.data();
+        buffer = reinterpret_cast<const float*>(_channelBuffer.data());
         bufferLen = bytesRead;
     }
 
@@ -235,28 +286,52 @@ void AudioMixer::MixChannel(ISDLAudioChannel* channel, uint8_t* data, size_t len
             inRate = _format.freq;
             outRate = _format.freq * (1 / rate);
         }
-        _effectBuffer.resize(length);
+        _effectBuffer.resize(length / sizeof(float));
         bufferLen = ApplyResample(channel, buffer, static_cast<int32_t>(bufferLen / byteRate), numSamples, inRate, outRate);
         buffer = _effectBuffer.data();
     }
 
-    // Apply panning and volume
-    ApplyPan(channel, buffer, bufferLen, byteRate);
-    int32_t mixVolume = ApplyVolume(channel, buffer, bufferLen);
-
-    // Finally mix on to destination buffer
-    size_t dstLength = std::min(length, bufferLen);
-    SDL_MixAudioFormat(data, static_cast<const uint8_t*>(buffer), _format.format, static_cast<uint32_t>(dstLength), mixVolume);
+    // Apply panning and volume while accumulating on to the mix buffer
+    auto frames = std::min(length, bufferLen) / byteRate;
+    auto gain = GetChannelGain(channel);
+    if (_format.channels == 2)
+    {
+        MixStereoF32(buffer, _mixBuffer.data(), frames, gain);
+    }
+    else
+    {
+        MixF32(buffer, _mixBuffer.data(), frames * _format.channels, gain);
+    }
 
     channel->UpdateOldVolume();
 }
 
+SDL_AudioCVT* AudioMixer::GetConverter(const AudioFormat& srcFormat)
+{
+    // Building a converter is comparatively expensive, streams with the same format share one
+    auto it = std::find_if(
+        _cvtCache.begin(), _cvtCache.end(), [&srcFormat](const auto& entry) { return entry.first == srcFormat; });
+    if (it != _cvtCache.end())
+    {
+        return &it->second;
+    }
+
+    SDL_AudioCVT cvt;
+    if (SDL_BuildAudioCVT(
+            &cvt, srcFormat.format, srcFormat.channels, srcFormat.freq, _format.format, _format.channels, _format.freq)
+        == -1)
+    {
+        return nullptr;
+    }
+    return &_cvtCache.emplace_back(srcFormat, cvt).second;
+}
+
 /**
  * Resample the given buffer into _effectBuffer.
  * Assumes that srcBuffer is the same format as _format.
  */
 size_t AudioMixer::ApplyResample(
-    ISDLAudioChannel* channel, const void* srcBuffer, int32_t srcSamples, int32_t dstSamples, int32_t inRate, int32_t outRate)
+    ISDLAudioChannel* channel, const float* srcBuffer, int32_t srcSamples, int32_t dstSamples, int32_t inRate, int32_t outRate)
 {
     int32_t byteRate = _format.GetByteRate();
 
@@ -271,30 +346,12 @@ size_t AudioMixer::ApplyResample(
 
     uint32_t inLen = srcSamples;
     uint32_t outLen = dstSamples;
-    speex_resampler_process_interleaved_int(
-        resampler, static_cast<const spx_int16_t*>(srcBuffer), &inLen, reinterpret_cast<spx_int16_t*>(_effectBuffer.data()),
-        &outLen);
+    speex_resampler_process_interleaved_float(resampler, srcBuffer, &inLen, _effectBuffer.data(), &outLen);
 
     return outLen * byteRate;
 }
 
-void AudioMixer::ApplyPan(const IAudioChannel* channel, void* buffer, size_t len, size_t sampleSize)
-{
-    if (channel->GetPan() != 0.5f && _format.channels == 2)
-    {
-        switch (_format.format)
-        {
-            case AUDIO_S16SYS:
-                EffectPanS16(channel, static_cast<int16_t*>(buffer), static_cast<int32_t>(len / sampleSize));
-                break;
-            case AUDIO_U8:
-                EffectPanU8(channel, static_cast<uint8_t*>(buffer), static_cast<int32_t>(len / sampleSize));
-                break;
-        }
-    }
-}
-
-int32_t AudioMixer::ApplyVolume(const IAudioChannel* channel, void* buffer, size_t len)
+AudioMixer::ChannelGain AudioMixer::GetChannelGain(const IAudioChannel* channel) const
 {
     float volumeAdjust = _volume;
     volumeAdjust *= Config::Get().sound.MasterSoundEnabled ? (static_cast<float>(Config::Get().sound.MasterVolume) / 100.0f)
@@ -324,82 +381,63 @@ int32_t AudioMixer::ApplyVolume(const IAudioChannel* channel, void* buffer, size
         endVolume = 0;
     }
 
-    int32_t mixVolume = channel->GetVolume() * volumeAdjust;
-    if (startVolume != endVolume)
-    {
-        // Set to max since we are adjusting the volume ourselves
-        mixVolume = kMixerVolumeMax;
-
-        // Fade between volume levels to smooth out sound and minimize clicks from sudden volume changes
-        int32_t fadeLength = static_cast<int32_t>(len) / _format.BytesPerSample();
-        switch (_format.format)
-        {
-            case AUDIO_S16SYS:
-                EffectFadeS16(static_cast<int16_t*>(buffer), fadeLength, startVolume, endVolume);
-                break;
-            case AUDIO_U8:
-                EffectFadeU8(static_cast<uint8_t*>(buffer), fadeLength, startVolume, endVolume);
-                break;
-        }
-    }
-    return mixVolume;
-}
-
-void AudioMixer::EffectPanS16(const IAudioChannel* channel, int16_t* data, int32_t length)
-{
-    const float dt = 1.0f / static_cast<float>(length * 2.0f);
-    float volumeL = channel->GetOldVolumeL();
-    float volumeR = channel->GetOldVolumeR();
-    const float d_left = dt * (channel->GetVolumeL() - channel->GetOldVolumeL());
-    const float d_right = dt * (channel->GetVolumeR() - channel->GetOldVolumeR());
-
-    for (int32_t i = 0; i < length * 2; i += 2)
+    // Fade between volume levels to smooth out sound and minimize clicks from sudden volume changes
+    ChannelGain gain;
+    gain.StartL = gain.StartR = static_cast<float>(startVolume) / kMixerVolumeMax;
+    gain.EndL = gain.EndR = static_cast<float>(endVolume) / kMixerVolumeMax;
+    if (channel->GetPan() != 0.5f && _format.channels == 2)
     {
-        data[i + 0] = static_cast<int16_t>(volumeL * static_cast<float>(data[i + 0]));
-        data[i + 1] = static_cast<int16_t>(volumeR * static_cast<float>(data[i + 1]));
-        volumeL += d_left;
-        volumeR += d_right;
+        gain.StartL *= channel->GetOldVolumeL();
+        gain.StartR *= channel->GetOldVolumeR();
+        gain.EndL *= channel->GetVolumeL();
+        gain.EndR *= channel->GetVolumeR();
     }
+    return gain;
 }
 
-void AudioMixer::EffectPanU8(const IAudioChannel* channel, uint8_t* data, int32_t length)
+/**
+ * Applies a gain ramp to interleaved stereo samples and accumulates them on to dst.
+ */
+void AudioMixer::MixStereoF32(const float* src, float* dst, size_t frames, const ChannelGain& gain)
 {
-    float volumeL = channel->GetVolumeL();
-    float volumeR = channel->GetVolumeR();
-    float oldVolumeL = channel->GetOldVolumeL();
-    float oldVolumeR = channel->GetOldVolumeR();
-
-    for (int32_t i = 0; i < length * 2; i += 2)
+    if (frames == 0)
+        return;
+
+    const float dL = (gain.EndL - gain.StartL) / static_cast<float>(frames);
+    const float dR = (gain.EndR - gain.StartR) / static_cast<float>(frames);
+    size_t i = 0;
+#ifdef OPENRCT2_AUDIO_SSE2
+    // Two frames (four samples) per iteration
+    __m128 volume = _mm_setr_ps(gain.StartL, gain.StartR, gain.StartL + dL, gain.StartR + dR);
+    const __m128 step = _mm_setr_ps(2 * dL, 2 * dR, 2 * dL, 2 * dR);
+    for (; i + 2 <= frames; i += 2)
     {
-        float t = static_cast<float>(i) / static_cast<float>(length * 2.0f);
-        data[i] = static_cast<uint8_t>(data[i] * ((1.0 - t) * oldVolumeL + t * volumeL));
-        data[i + 1] = static_cast<uint8_t>(data[i + 1] * ((1.0 - t) * oldVolumeR + t * volumeR));
+        const __m128 samples = _mm_loadu_ps(src + i * 2);
+        const __m128 mixed = _mm_add_ps(_mm_loadu_ps(dst + i * 2), _mm_mul_ps(samples, volume));
+        _mm_storeu_ps(dst + i * 2, mixed);
+        volume = _mm_add_ps(volume, step);
     }
-}
-
-void AudioMixer::EffectFadeS16(int16_t* data, int32_t length, int32_t startvolume, int32_t endvolume)
-{
-    static_assert(SDL_MIX_MAXVOLUME == kMixerVolumeMax, "Max volume differs between OpenRCT2 and SDL2");
-
-    float startvolume_f = static_cast<float>(startvolume) / SDL_MIX_MAXVOLUME;
-    float endvolume_f = static_cast<float>(endvolume) / SDL_MIX_MAXVOLUME;
-    for (int32_t i = 0; i < length; i++)
+#endif
+    for (; i < frames; i++)
     {
-        float t = static_cast<float>(i) / length;
-        data[i] = static_cast<int16_t>(data[i] * ((1.0f - t) * startvolume_f + t * endvolume_f));
+        const auto t = static_cast<float>(i);
+        dst[i * 2 + 0] += src[i * 2 + 0] * (gain.StartL + t * dL);
+        dst[i * 2 + 1] += src[i * 2 + 1] * (gain.StartR + t * dR);
     }
 }
 
-void AudioMixer::EffectFadeU8(uint8_t* data, int32_t length, int32_t startvolume, int32_t endvolume)
+/**
+ * Applies the left gain ramp to every sample and accumulates them on to dst.
+ */
+void AudioMixer::MixF32(const float* src, float* dst, size_t samples, const ChannelGain& gain)
 {
-    static_assert(SDL_MIX_MAXVOLUME == kMixerVolumeMax, "Max volume differs between OpenRCT2 and SDL2");
+    if (samples == 0)
+        return;
 
-    float startvolume_f = static_cast<float>(startvolume) / SDL_MIX_MAXVOLUME;
-    float endvolume_f = static_cast<float>(endvolume) / SDL_MIX_MAXVOLUME;
-    for (int32_t i = 0; i < length; i++)
+    const float d = (gain.EndL - gain.StartL) / static_cast<float>(samples);
+    for (size_t i = 0; i < samples; i++)
     {
-        float t = static_cast<float>(i) / length;
-        data[i] = static_cast<uint8_t>(data[i] * ((1.0f - t) * startvolume_f + t * endvolume_f));
+        dst[i] += src[i] * (gain.StartL + static_cast<float>(i) * d);
     }
 }
 
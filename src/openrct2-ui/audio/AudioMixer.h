@@ -23,6 +23,7 @@
 #include <openrct2/audio/AudioMixer.h>
 #include <openrct2/audio/AudioSource.h>
 #include <openrct2/audio/audio.h>
+#include <utility>
 #include <vector>
 
 namespace OpenRCT2::Audio
@@ -41,9 +42,19 @@ namespace OpenRCT2::Audio
         uint8_t _settingSoundVolume = 0xFF;
         uint8_t _settingMusicVolume = 0xFF;
 
+        struct ChannelGain
+        {
+            float StartL;
+            float StartR;
+            float EndL;
+            float EndR;
+        };
+
         std::vector<uint8_t> _channelBuffer;
         std::vector<uint8_t> _convertBuffer;
-        std::vector<uint8_t> _effectBuffer;
+        std::vector<float> _effectBuffer;
+        std::vector<float> _mixBuffer;
+        std::vector<std::pair<AudioFormat, SDL_AudioCVT>> _cvtCache;
 
         std::mutex _mutex;
 
@@ -59,25 +70,34 @@ namespace OpenRCT2::Audio
 
         const AudioFormat& GetFormat() const;
 
+        /**
+         * Sets up the mixer without an audio device so that RenderOffline can be used, e.g. for benchmarking.
+         */
+        void InitOffline();
+
+        /**
+         * Mixes the playing channels for the given duration and returns the resulting interleaved samples.
+         */
+        std::vector<float> RenderOffline(double seconds);
+
     private:
         void GetNextAudioChunk(uint8_t* dst, size_t length);
         void UpdateAdjustedSound();
-        void MixChannel(ISDLAudioChannel* channel, uint8_t* data, size_t length);
+        void MixChannel(ISDLAudioChannel* channel, size_t length);
+        void WriteMixBuffer(uint8_t* dst, size_t length) const;
         void RemoveReleasedSources();
+        SDL_AudioCVT* GetConverter(const AudioFormat& srcFormat);
 
         /**
          * Resample the given buffer into _effectBuffer.
          * Assumes that srcBuffer is the same format as _format.
          */
         size_t ApplyResample(
-            ISDLAudioChannel* channel, const void* srcBuffer, int32_t srcSamples, int32_t dstSamples, int32_t inRate,
+            ISDLAudioChannel* channel, const float* srcBuffer, int32_t srcSamples, int32_t dstSamples, int32_t inRate,
             int32_t outRate);
-        void ApplyPan(const IAudioChannel* channel, void* buffer, size_t len, size_t sampleSize);
-        int32_t ApplyVolume(const IAudioChannel* channel, void* buffer, size_t len);
-        static void EffectPanS16(const IAudioChannel* channel, int16_t* data, int32_t length);
-        static void EffectPanU8(const IAudioChannel* channel, uint8_t* data, int32_t length);
-        static void EffectFadeS16(int16_t* data, int32_t length, int32_t startvolume, int32_t endvolume);
-        static void EffectFadeU8(uint8_t* data, int32_t length, int32_t startvolume, int32_t endvolume);
+        ChannelGain GetChannelGain(const IAudioChannel* channel) const;
+        static void MixStereoF32(const float* src, float* dst, size_t frames, const ChannelGain& gain);
+        static void MixF32(const float* src, float* dst, size_t samples, const ChannelGain& gain);
         bool Convert(SDL_AudioCVT* cvt, const void* src, size_t len);
     };
 } // namespace OpenRCT2::Audio
@@ -28,6 +28,8 @@
 #include <openrct2/util/Math.hpp>
 #include <openrct2/util/Util.h>
 #include <openrct2/world/Park.h>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace OpenRCT2::Ui::Windows
@@ -115,6 +117,20 @@ namespace OpenRCT2::Ui::Windows
             }
         };
 
+        struct FilterArgumentsHash
+        {
+            size_t operator()(const FilterArguments& arguments) const
+            {
+                // FNV-1a
+                uint64_t hash = 14695981039346656037ull;
+                for (auto b : arguments.args)
+                {
+                    hash = (hash ^ b) * 1099511628211ull;
+                }
+                return static_cast<size_t>(hash);
+            }
+        };
+
         struct GuestGroup
         {
             size_t NumGuests{};
@@ -127,13 +143,37 @@ namespace OpenRCT2::Ui::Windows
             using CompareFunc = bool (*)(const GuestItem&, const GuestItem&);
 
             EntityId Id;
-            char Name[256];
+            uint32_t PeepId{};
+            bool HasCustomName{};
+
+            /**
+             * The formatted name is only needed when sorting by name or filtering, so it is produced on first use.
+             */
+            const std::string& GetName() const
+            {
+                if (!_nameFormatted)
+                {
+                    auto* peep = GetEntity<Guest>(Id);
+                    if (peep != nullptr)
+                    {
+                        _name = FormatGuestName(*peep);
+                    }
+                    _nameFormatted = true;
+                }
+                return _name;
+            }
+
+        private:
+            mutable std::string _name;
+            mutable bool _nameFormatted{};
         };
 
         static constexpr uint8_t SUMMARISED_GUEST_ROW_HEIGHT = kScrollableRowHeight + 11;
         static constexpr auto GUESTS_PER_PAGE = 2000;
         static constexpr const auto GUEST_PAGE_HEIGHT = GUESTS_PER_PAGE * kScrollableRowHeight;
         static constexpr size_t MaxGroups = 240;
+        // Guests enter and leave a filtered list without any event, e.g. when they join a queue or have a new thought
+        static constexpr uint32_t kFilteredListRefreshInterval = 40;
 
         TabId _selectedTab{};
         GuestViewType _selectedView{};
@@ -149,8 +189,11 @@ namespace OpenRCT2::Ui::Windows
         uint32_t _lastFindGroupsTick{};
         uint32_t _lastFindGroupsWait{};
         std::vector<GuestGroup> _groups;
+        std::unordered_map<FilterArguments, size_t, FilterArgumentsHash> _groupIndex;
 
         std::vector<GuestItem> _guestList;
+        std::unordered_map<EntityId::UnderlyingType, size_t> _guestListIndex;
+        uint32_t _filteredListRefreshWait{};
         std::optional<size_t> _highlightedIndex;
 
         uint32_t _tabAnimationIndex{};
@@ -270,6 +313,16 @@ namespace OpenRCT2::Ui::Windows
                 _lastFindGroupsWait--;
             }
 
+            if (_filteredListRefreshWait != 0)
+            {
+                _filteredListRefreshWait--;
+            }
+            else if (_selectedTab == TabId::Individual && _selectedFilter)
+            {
+                RefreshList();
+                Invalidate();
+            }
+
             // Current tab image animation
             _tabAnimationIndex++;
             if (_tabAnimationIndex >= (_selectedTab == TabId::Individual ? 24uL : 32uL))
@@ -557,18 +610,13 @@ namespace OpenRCT2::Ui::Windows
                 {
                     auto i = screenCoords.y / kScrollableRowHeight;
                     i += static_cast<int32_t>(_selectedPage * GUESTS_PER_PAGE);
-                    for (const auto& guestItem : _guestList)
+                    if (i >= 0 && static_cast<size_t>(i) < _guestList.size())
                     {
-                        if (i == 0)
+                        auto guest = GetEntity<Guest>(_guestList[i].Id);
+                        if (guest != nullptr)
                         {
-                            auto guest = GetEntity<Guest>(guestItem.Id);
-                            if (guest != nullptr)
-                            {
-                                GuestOpen(guest);
-                            }
-                            break;
+                            GuestOpen(guest);
                         }
-                        i--;
                     }
                     break;
                 }
@@ -621,31 +669,85 @@ namespace OpenRCT2::Ui::Windows
 
                 for (auto peep : EntityList<Guest>())
                 {
-                    EntitySetFlashing(peep, false);
-                    if (peep->OutsideOfPark)
-                        continue;
-                    if (_selectedFilter)
+                    GuestItem item;
+                    if (TryMakeGuestItem(*peep, item))
                     {
-                        if (!IsPeepInFilter(*peep))
-                            continue;
-                        EntitySetFlashing(peep, true);
+                        _guestList.push_back(std::move(item));
                     }
-                    if (!GuestShouldBeVisible(*peep))
-                        continue;
-
-                    auto& item = _guestList.emplace_back();
-                    item.Id = peep->Id;
-
-                    Formatter ft;
-                    peep->FormatNameTo(ft);
-                    OpenRCT2::FormatStringLegacy(item.Name, sizeof(item.Name), STR_STRINGID, ft.Data());
                 }
 
                 std::sort(_guestList.begin(), _guestList.end(), GetGuestCompareFunc());
+
+                _guestListIndex.clear();
+                UpdateGuestListIndex(0, _guestList.size());
+                _filteredListRefreshWait = kFilteredListRefreshInterval;
             }
         }
 
+        /**
+         * Updates the list for a single guest that was added, removed, renamed or otherwise changed, keeping the list
+         * sorted without rebuilding it.
+         */
+        void UpdateGuest(EntityId guestId)
+        {
+            // The summary groups are refreshed periodically instead
+            if (_selectedTab != TabId::Individual)
+                return;
+
+            GuestItem item;
+            auto* peep = TryGetEntity<Guest>(guestId);
+            const bool isListed = peep != nullptr && TryMakeGuestItem(*peep, item);
+
+            auto compare = GetGuestCompareFunc();
+            auto begin = _guestList.begin();
+            auto found = _guestListIndex.find(guestId.ToUnderlying());
+            if (found == _guestListIndex.end())
+            {
+                if (isListed)
+                {
+                    auto pos = static_cast<size_t>(std::upper_bound(begin, _guestList.end(), item, compare) - begin);
+                    _guestList.insert(begin + pos, std::move(item));
+                    UpdateGuestListIndex(pos, _guestList.size());
+                }
+            }
+            else if (!isListed)
+            {
+                auto pos = found->second;
+                _guestListIndex.erase(found);
+                _guestList.erase(begin + pos);
+                UpdateGuestListIndex(pos, _guestList.size());
+            }
+            else
+            {
+                // The other entries are still sorted, so only the ones between the old and the new place move
+                auto oldPos = found->second;
+                auto newPos = static_cast<size_t>(std::upper_bound(begin, begin + oldPos, item, compare) - begin);
+                _guestList[oldPos] = std::move(item);
+                if (newPos < oldPos)
+                {
+                    std::rotate(begin + newPos, begin + oldPos, begin + oldPos + 1);
+                    UpdateGuestListIndex(newPos, oldPos + 1);
+                }
+                else
+                {
+                    auto next = begin + oldPos + 1;
+                    newPos = static_cast<size_t>(std::upper_bound(next, _guestList.end(), _guestList[oldPos], compare) - begin);
+                    std::rotate(begin + oldPos, next, begin + newPos);
+                    UpdateGuestListIndex(oldPos, newPos);
+                }
+            }
+            Invalidate();
+        }
+
     private:
+        void UpdateGuestListIndex(size_t first, size_t last)
+        {
+            for (auto i = first; i < last; i++)
+            {
+                _guestListIndex[_guestList[i].Id.ToUnderlying()] = i;
+            }
+        }
+
         void DrawTabImages(DrawPixelInfo& dpi)
         {
             // Tab 1 image
@@ -664,13 +766,18 @@ namespace OpenRCT2::Ui::Windows
 
         void DrawScrollIndividual(DrawPixelInfo& dpi)
         {
-            size_t index = 0;
-            auto y = static_cast<int32_t>(_selectedPage) * -GUEST_PAGE_HEIGHT;
-            for (const auto& guestItem : _guestList)
+            // Only visit the rows that intersect the area being drawn
+            auto pageOffset = static_cast<int32_t>(_selectedPage) * GUEST_PAGE_HEIGHT;
+            auto firstRow = std::max(0, (dpi.y + pageOffset) / kScrollableRowHeight - 1);
+            for (size_t index = firstRow; index < _guestList.size(); index++)
             {
+                const auto& guestItem = _guestList[index];
+                auto y = static_cast<int32_t>(index) * kScrollableRowHeight - pageOffset;
+                if (y >= dpi.y + dpi.height || y >= 0x7FFF)
+                    break;
+
                 // Check if y is beyond the scroll control
-                if (y + kScrollableRowHeight + 1 >= -0x7FFF && y + kScrollableRowHeight + 1 > dpi.y && y < 0x7FFF
-                    && y < dpi.y + dpi.height)
+                if (y + kScrollableRowHeight + 1 >= -0x7FFF && y + kScrollableRowHeight + 1 > dpi.y)
                 {
                     // Highlight backcolour and text colour (format)
                     StringId format = STR_BLACK_STRING;
@@ -724,8 +831,6 @@ namespace OpenRCT2::Ui::Windows
                             break;
                     }
                 }
-                y += kScrollableRowHeight;
-                index++;
             }
         }
 
@@ -781,19 +886,32 @@ namespace OpenRCT2::Ui::Windows
             }
         }
 
-        bool GuestShouldBeVisible(const Guest& peep)
+        bool TryMakeGuestItem(Guest& peep, GuestItem& item)
+        {
+            EntitySetFlashing(&peep, false);
+            if (peep.OutsideOfPark)
+                return false;
+            if (_selectedFilter)
+            {
+                if (!IsPeepInFilter(peep))
+                    return false;
+                EntitySetFlashing(&peep, true);
+            }
+
+            item.Id = peep.Id;
+            item.PeepId = peep.PeepId;
+            item.HasCustomName = peep.Name != nullptr;
+            return GuestShouldBeVisible(peep, item);
+        }
+
+        bool GuestShouldBeVisible(const Guest& peep, const GuestItem& item)
         {
             if (_trackingOnly && !(peep.PeepFlags & PEEP_FLAGS_TRACKING))
                 return false;
 
             if (!_filterName.empty())
             {
-                char name[256]{};
-
-                Formatter ft;
-                peep.FormatNameTo(ft);
-                OpenRCT2::FormatStringLegacy(name, sizeof(name), STR_STRINGID, ft.Data());
-                if (!String::Contains(name, _filterName.c_str(), true))
+                if (!String::Contains(item.GetName().c_str(), _filterName.c_str(), true))
                 {
                     return false;
                 }
@@ -802,6 +920,16 @@ namespace OpenRCT2::Ui::Windows
             return true;
         }
 
+        static std::string FormatGuestName(const Guest& peep)
+        {
+            char name[256]{};
+
+            Formatter ft;
+            peep.FormatNameTo(ft);
+            OpenRCT2::FormatStringLegacy(name, sizeof(name), STR_STRINGID, ft.Data());
+            return name;
+        }
+
         bool IsPeepInFilter(const Guest& peep)
         {
             auto guestViewType = _selectedFilter == GuestFilterType::Guests ? GuestViewType::Actions : GuestViewType::Thoughts;
@@ -829,12 +957,10 @@ namespace OpenRCT2::Ui::Windows
 
         GuestGroup& FindOrAddGroup(FilterArguments&& arguments)
         {
-            auto foundGroup = std::find_if(std::begin(_groups), std::end(_groups), [&arguments](GuestGroup& group) {
-                return group.Arguments == arguments;
-            });
-            if (foundGroup != std::end(_groups))
+            auto [it, inserted] = _groupIndex.try_emplace(arguments, _groups.size());
+            if (!inserted)
             {
-                return *foundGroup;
+                return _groups[it->second];
             }
             auto& newGroup = _groups.emplace_back();
             newGroup.Arguments = arguments;
@@ -847,6 +973,7 @@ namespace OpenRCT2::Ui::Windows
             _lastFindGroupsSelectedView = _selectedView;
             _lastFindGroupsWait = 320;
             _groups.clear();
+            _groupIndex.clear();
 
             for (auto peep : EntityList<Guest>())
             {
@@ -870,6 +997,8 @@ namespace OpenRCT2::Ui::Windows
                 _groups.erase(foundGroup);
             }
 
+            _groupIndex.clear();
+
             // Sort groups by number of guests
             std::sort(_groups.begin(), _groups.end(), [](const GuestGroup& a, const GuestGroup& b) {
                 return a.NumGuests > b.NumGuests;
@@ -935,27 +1064,16 @@ namespace OpenRCT2::Ui::Windows
 
         template<bool TRealNames> static bool CompareGuestItem(const GuestItem& a, const GuestItem& b)
         {
-            const auto* peepA = GetEntity<Peep>(a.Id);
-            const auto* peepB = GetEntity<Peep>(b.Id);
-            if (peepA != nullptr && peepB != nullptr)
+            // Compare name
+            if constexpr (!TRealNames)
             {
-                // Compare types
-                if (peepA->Type != peepB->Type)
-                {
-                    return static_cast<int32_t>(peepA->Type) < static_cast<int32_t>(peepB->Type);
-                }
-
-                // Compare name
-                if constexpr (!TRealNames)
+                if (!a.HasCustomName && !b.HasCustomName)
                 {
-                    if (peepA->Name == nullptr && peepB->Name == nullptr)
-                    {
-                        // Simple ID comparison for when both peeps use a number or a generated name
-                        return peepA->PeepId < peepB->PeepId;
-                    }
+                    // Simple ID comparison for when both peeps use a number or a generated name
+                    return a.PeepId < b.PeepId;
                 }
             }
-            return StrLogicalCmp(a.Name, b.Name) < 0;
+            return StrLogicalCmp(a.GetName().c_str(), b.GetName().c_str()) < 0;
         }
 
         static GuestItem::CompareFunc GetGuestCompareFunc()
@@ -996,4 +1114,13 @@ namespace OpenRCT2::Ui::Windows
             static_cast<GuestListWindow*>(w)->RefreshList();
         }
     }
+
+    void WindowGuestListUpdateGuest(EntityId guestId)
+    {
+        auto* w = WindowFindByClass(WindowClass::GuestList);
+        if (w != nullptr)
+        {
+            static_cast<GuestListWindow*>(w)->UpdateGuest(guestId);
+        }
+    }
 } // namespace OpenRCT2::Ui::Windows
@@ -64,6 +64,7 @@
 #include <openrct2/sprites.h>
 #include <openrct2/windows/Intent.h>
 #include <openrct2/world/Park.h>
+#include <openrct2/world/TileElementsView.h>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -1407,34 +1408,30 @@ namespace OpenRCT2::Ui::Windows
         void UpdateOverallView(const Ride& ride) const
         {
             // Calculate x, y, z bounds of the entire ride using its track elements
-            TileElementIterator it;
-
-            TileElementIteratorBegin(&it);
-
             CoordsXYZ min = { std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::max(),
                               std::numeric_limits<int32_t>::max() };
             CoordsXYZ max = { std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::min(),
                               std::numeric_limits<int32_t>::min() };
 
-            while (TileElementIteratorNext(&it))
+            for (const auto& tilePos : MapGetRideTrackTiles(ride.id))
             {
-                if (it.element->GetType() != TileElementType::Track)
-                    continue;
-
-                if (it.element->AsTrack()->GetRideIndex() != ride.id)
-                    continue;
+                for (auto* trackElement : TileElementsView<TrackElement>(tilePos))
+                {
+                    if (trackElement->GetRideIndex() != ride.id)
+                        continue;
 
-                auto location = TileCoordsXY(it.x, it.y).ToCoordsXY();
-                int32_t baseZ = it.element->GetBaseZ();
-                int32_t clearZ = it.element->GetClearanceZ();
+                    auto location = tilePos.ToCoordsXY();
+                    int32_t baseZ = trackElement->GetBaseZ();
+                    int32_t clearZ = trackElement->GetClearanceZ();
 
-                min.x = std::min(min.x, location.x);
-                min.y = std::min(min.y, location.y);
-                min.z = std::min(min.z, baseZ);
+                    min.x = std::min(min.x, location.x);
+                    min.y = std::min(min.y, location.y);
+                    min.z = std::min(min.z, baseZ);
 
-                max.x = std::max(max.x, location.x);
-                max.y = std::max(max.y, location.y);
-                max.z = std::max(max.z, clearZ);
+                    max.x = std::max(max.x, location.x);
+                    max.y = std::max(max.y, location.y);
+                    max.z = std::max(max.z, clearZ);
+                }
             }
 
             const auto rideIndex = ride.id.ToUnderlying();
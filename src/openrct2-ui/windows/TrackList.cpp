@@ -13,17 +13,21 @@
 #include <openrct2/Context.h>
 #include <openrct2/Editor.h>
 #include <openrct2/OpenRCT2.h>
+#include <openrct2/PlatformEnvironment.h>
 #include <openrct2/audio/audio.h>
 #include <openrct2/config/Config.h>
+#include <openrct2/core/Path.hpp>
 #include <openrct2/core/String.hpp>
 #include <openrct2/drawing/IDrawingEngine.h>
 #include <openrct2/localisation/Formatting.h>
 #include <openrct2/ride/RideConstruction.h>
 #include <openrct2/ride/RideData.h>
 #include <openrct2/ride/TrackDesign.h>
+#include <openrct2/ride/TrackDesignPreviewCache.h>
 #include <openrct2/ride/TrackDesignRepository.h>
 #include <openrct2/sprites.h>
 #include <openrct2/windows/Intent.h>
+#include <algorithm>
 #include <vector>
 
 namespace OpenRCT2::Ui::Windows
@@ -78,6 +82,9 @@ namespace OpenRCT2::Ui::Windows
         uint16_t _loadedTrackDesignIndex;
         std::unique_ptr<TrackDesign> _loadedTrackDesign;
         std::vector<uint8_t> _trackDesignPreviewPixels;
+        std::unique_ptr<TrackDesignPreviewCache> _previewCache;
+        uint64_t _previewEnvironmentKey{};
+        bool _previewReady = false;
         bool _selectedItemIsBeingUpdated;
         bool _reloadTrackDesigns;
 
@@ -195,15 +202,41 @@ namespace OpenRCT2::Ui::Windows
             FilterList();
         }
 
-        bool LoadDesignPreview(const u8string& path)
+        bool LoadDesignPreview(const u8string& path, size_t listIndex)
         {
             _loadedTrackDesign = TrackDesignImport(path.c_str());
-            if (_loadedTrackDesign != nullptr)
+            if (_loadedTrackDesign == nullptr)
             {
-                TrackDesignDrawPreview(*_loadedTrackDesign, _trackDesignPreviewPixels.data());
-                return true;
+                return false;
+            }
+
+            ApplyCachedPreview(path);
+
+            // Load previews rendered before for the designs the user is likely to look at next
+            constexpr size_t kPrefetchDistance = 3;
+            const auto first = listIndex > kPrefetchDistance ? listIndex - kPrefetchDistance : 0;
+            const auto last = std::min(listIndex + kPrefetchDistance, _filteredTrackIds.size() - 1);
+            for (size_t i = first; i <= last; i++)
+            {
+                if (i != listIndex)
+                {
+                    _previewCache->Prefetch(_trackDesigns[_filteredTrackIds[i]].path, _previewEnvironmentKey);
+                }
+            }
+            return true;
+        }
+
+        void ApplyCachedPreview(const u8string& path)
+        {
+            // Previews are rendered by the cache, the window only shows them once they are ready
+            const auto* preview = _previewCache->Get(path, _previewEnvironmentKey);
+            _previewReady = preview != nullptr;
+            if (_previewReady)
+            {
+                std::copy(preview->Pixels.begin(), preview->Pixels.end(), _trackDesignPreviewPixels.begin());
+                _loadedTrackDesign->gameStateData.flags = preview->GameStateFlags;
+                _loadedTrackDesign->gameStateData.cost = preview->Cost;
             }
-            return false;
         }
 
     public:
@@ -243,6 +276,12 @@ namespace OpenRCT2::Ui::Windows
             _currentTrackPieceDirection = 2;
             _trackDesignPreviewPixels.resize(4 * kTrackPreviewImageSize);
 
+            auto env = GetContext()->GetPlatformEnvironment();
+            _previewCache = std::make_unique<TrackDesignPreviewCache>(
+                Path::Combine(env->GetDirectoryPath(DIRBASE::CACHE), u8"track_previews"));
+            _previewEnvironmentKey = TrackDesignPreviewCache::GetEnvironmentKey();
+            _previewReady = false;
+
             _loadedTrackDesign = nullptr;
             _loadedTrackDesignIndex = TRACK_DESIGN_INDEX_UNLOADED;
         }
@@ -253,6 +292,7 @@ namespace OpenRCT2::Ui::Windows
             _loadedTrackDesign = nullptr;
             _trackDesignPreviewPixels.clear();
             _trackDesignPreviewPixels.shrink_to_fit();
+            _previewCache = nullptr;
 
             // Dispose track list
             _trackDesigns.clear();
@@ -284,6 +324,7 @@ namespace OpenRCT2::Ui::Windows
                     break;
                 case WIDX_TOGGLE_SCENERY:
                     gTrackDesignSceneryToggle = !gTrackDesignSceneryToggle;
+                    _previewEnvironmentKey = TrackDesignPreviewCache::GetEnvironmentKey();
                     _loadedTrackDesignIndex = TRACK_DESIGN_INDEX_UNLOADED;
                     Invalidate();
                     break;
@@ -445,6 +486,16 @@ namespace OpenRCT2::Ui::Windows
                 Invalidate();
                 _reloadTrackDesigns = false;
             }
+
+            if (_previewCache->Update() && !_previewReady && _loadedTrackDesign != nullptr
+                && _loadedTrackDesignIndex != TRACK_DESIGN_INDEX_UNLOADED)
+            {
+                ApplyCachedPreview(_trackDesigns[_loadedTrackDesignIndex].path);
+                if (_previewReady)
+                {
+                    Invalidate();
+                }
+            }
         }
 
         void OnDraw(DrawPixelInfo& dpi) override
@@ -484,7 +535,7 @@ namespace OpenRCT2::Ui::Windows
 
             if (_loadedTrackDesignIndex != trackIndex)
             {
-                if (LoadDesignPreview(path))
+                if (LoadDesignPreview(path, listItemIndex))
                 {
                     _loadedTrackDesignIndex = trackIndex;
                 }
@@ -502,14 +553,17 @@ namespace OpenRCT2::Ui::Windows
             auto trackPreview = screenPos;
             screenPos = windowPos + ScreenCoordsXY{ tdWidget.midX(), tdWidget.midY() };
 
-            G1Element g1temp = {};
-            g1temp.offset = _trackDesignPreviewPixels.data() + (_currentTrackPieceDirection * kTrackPreviewImageSize);
-            g1temp.width = 370;
-            g1temp.height = 217;
-            g1temp.flags = G1_FLAG_HAS_TRANSPARENCY;
-            GfxSetG1Element(SPR_TEMP, &g1temp);
-            DrawingEngineInvalidateImage(SPR_TEMP);
-            GfxDrawSprite(dpi, ImageId(SPR_TEMP), trackPreview);
+            if (_previewReady)
+            {
+                G1Element g1temp = {};
+                g1temp.offset = _trackDesignPreviewPixels.data() + (_currentTrackPieceDirection * kTrackPreviewImageSize);
+                g1temp.width = 370;
+                g1temp.height = 217;
+                g1temp.flags = G1_FLAG_HAS_TRANSPARENCY;
+                GfxSetG1Element(SPR_TEMP, &g1temp);
+                DrawingEngineInvalidateImage(SPR_TEMP);
+                GfxDrawSprite(dpi, ImageId(SPR_TEMP), trackPreview);
+            }
 
             screenPos.y = windowPos.y + tdWidget.bottom - 12;
 
@@ -37,6 +37,7 @@
 #include "core/MemoryStream.h"
 #include "core/Path.hpp"
 #include "core/String.hpp"
+#include "core/TaskGraph.h"
 #include "core/Timer.hpp"
 #include "drawing/IDrawingEngine.h"
 #include "drawing/Image.h"
@@ -72,18 +73,23 @@
 #include "scenes/title/TitleSequenceManager.h"
 #include "scripting/HookEngine.h"
 #include "scripting/ScriptEngine.h"
+#include "ui/DeferredUi.h"
 #include "ui/UiContext.h"
 #include "ui/WindowManager.h"
 #include "util/Util.h"
 #include "world/Park.h"
 
+#include <atomic>
 #include <chrono>
 #include <cmath>
+#include <condition_variable>
 #include <exception>
 #include <future>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
@@ -101,6 +107,36 @@ namespace OpenRCT2
         using namespace std::chrono_literals;
 
         static constexpr auto kForcedUpdateInterval = 25ms;
+
+        /**
+         * A mutex that is handed over in the order it was asked for. A thread that unlocks and locks again straight
+         * away can not starve a thread that is already waiting.
+         */
+        class FairMutex
+        {
+        public:
+            void lock()
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                const auto ticket = _nextTicket++;
+                _condition.wait(lock, [this, ticket]() { return _servingTicket == ticket; });
+            }
+
+            void unlock()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _servingTicket++;
+                }
+                _condition.notify_all();
+            }
+
+        private:
+            std::mutex _mutex;
+            std::condition_variable _condition;
+            uint64_t _nextTicket{};
+            uint64_t _servingTicket{};
+        };
     } // namespace
 
     class Context final : public IContext
@@ -152,7 +188,24 @@ namespace OpenRCT2
 
         // If set, will end the OpenRCT2 game loop. Intentionally private to this module so that the flag can not be set back to
         // false.
-        bool _finished = false;
+        std::atomic<bool> _finished = false;
+
+        // Runs the game logic when threaded simulation is enabled. Each tick and each access of the main thread to the
+        // game state hold _gameStateMutex. The park is then copied to _drawnGameState, which frames draw without
+        // holding _gameStateMutex. Invalidations and window calls of the simulation thread wait for the main thread.
+        std::thread _simulationThread;
+        FairMutex _gameStateMutex;
+        // Guarded by _gameStateMutex
+        bool _stopSimulationThread = false;
+        bool _drawnGameStateStale = false;
+        Ui::DeferredInvalidations _pendingInvalidations;
+        Ui::DeferredWindowCalls _deferredWindowCalls;
+        // Guarded by _drawnGameStateMutex
+        std::mutex _drawnGameStateMutex;
+        std::unique_ptr<GameState_t> _drawnGameState;
+        Ui::DeferredInvalidations _drawnInvalidations;
+        // Only used by the main thread
+        Ui::DeferredInvalidations _frameInvalidations;
 
         std::future<void> _versionCheckFuture;
         NewVersionInfo _newVersionInfo;
@@ -161,6 +214,8 @@ namespace OpenRCT2
         // We keep track of this to perform certain operations differently.
         std::thread::id _mainThreadId{};
         Timer _forcedUpdateTimer;
+        // Startup tasks report progress from several threads at once
+        std::recursive_mutex _progressMutex;
 
     public:
         // Singleton of Context.
@@ -202,6 +257,8 @@ namespace OpenRCT2
             // NOTE: We must shutdown all systems here before Instance is set back to null.
             //       If objects use GetContext() in their destructor things won't go well.
 
+            StopSimulationThread();
+
 #ifdef ENABLE_SCRIPTING
             _scriptEngine.StopUnloadRegisterAllPlugins();
 #endif
@@ -372,6 +429,11 @@ namespace OpenRCT2
 
         void SetActiveScene(IScene* screen) override
         {
+            // The simulation thread only ticks the game scene. Scenes are changed while the game state is locked, so
+            // the thread sees this before it can tick again.
+            if (_simulationThread.joinable())
+                _stopSimulationThread = true;
+
             if (_activeScene != nullptr)
                 _activeScene->Stop();
             _activeScene = screen;
@@ -556,30 +618,70 @@ namespace OpenRCT2
 
             auto currentLanguage = _localisationService->GetCurrentLanguage();
 
-            OpenProgress(STR_CHECKING_OBJECT_FILES);
-            _objectRepository->LoadOrConstruct(currentLanguage);
+            // Track designs and scenarios look up objects while being indexed, and asset packs are applied on top of
+            // the loaded audio objects. Everything else is independent and runs concurrently.
+            TaskGraph startup;
+            auto objects = startup.AddTask("Object repository", [&]() {
+                OpenProgress(STR_CHECKING_OBJECT_FILES);
+                _objectRepository->LoadOrConstruct(currentLanguage);
+            });
 
-            OpenProgress(STR_LOADING_GENERIC);
-            Audio::LoadAudioObjects();
+            auto audioObjects = startup.AddTask("Audio objects", []() { Audio::LoadAudioObjects(); }, { objects });
 
             if (!gOpenRCT2Headless)
             {
-                OpenProgress(STR_CHECKING_ASSET_PACKS);
-                _assetPackManager->Scan();
-                _assetPackManager->LoadEnabledAssetPacks();
-                _assetPackManager->Reload();
+                startup.AddTask(
+                    "Asset packs",
+                    [&]() {
+                        OpenProgress(STR_CHECKING_ASSET_PACKS);
+                        _assetPackManager->Scan();
+                        _assetPackManager->LoadEnabledAssetPacks();
+                        _assetPackManager->Reload();
+                    },
+                    { audioObjects });
             }
 
-            OpenProgress(STR_CHECKING_TRACK_DESIGN_FILES);
-            _trackDesignRepository->Scan(currentLanguage);
+            startup.AddTask(
+                "Track designs",
+                [&]() {
+                    OpenProgress(STR_CHECKING_TRACK_DESIGN_FILES);
+                    _trackDesignRepository->Scan(currentLanguage);
+                },
+                { objects });
+
+            startup.AddTask(
+                "Scenarios",
+                [&]() {
+                    OpenProgress(STR_CHECKING_SCENARIO_FILES);
+                    _scenarioRepository->Scan(currentLanguage);
+                },
+                { objects });
 
-            OpenProgress(STR_CHECKING_SCENARIO_FILES);
-            _scenarioRepository->Scan(currentLanguage);
+            startup.AddTask("Title sequences", [&]() {
+                OpenProgress(STR_CHECKING_TITLE_SEQUENCES);
+                TitleSequenceManager::Scan();
+            });
 
-            OpenProgress(STR_CHECKING_TITLE_SEQUENCES);
-            TitleSequenceManager::Scan();
+            startup.Run();
 
             OpenProgress(STR_LOADING_GENERIC);
+
+            if (gOpenRCT2StartupReport)
+            {
+                PrintStartupReport(startup);
+            }
+        }
+
+        static void PrintStartupReport(const TaskGraph& startup)
+        {
+            Console::WriteLine("Startup report:");
+            for (const auto& timing : startup.GetTimings())
+            {
+                Console::WriteLine(
+                    "  %-20s %8.3f s  (started at %.3f s)%s", timing.Name.c_str(), timing.Duration, timing.Start,
+                    timing.Ran ? "" : ", skipped");
+            }
+            Console::WriteLine("  %-20s %8.3f s", "Total", startup.GetTotalTime());
         }
 
         void InitialiseScriptEngine()
@@ -661,6 +763,7 @@ namespace OpenRCT2
 
         void OpenProgress(StringId captionStringId) override
         {
+            std::lock_guard<std::recursive_mutex> lock(_progressMutex);
             auto captionString = _localisationService->GetString(captionStringId);
             auto intent = Intent(INTENT_ACTION_PROGRESS_OPEN);
             intent.PutExtra(INTENT_EXTRA_MESSAGE, captionString);
@@ -669,6 +772,7 @@ namespace OpenRCT2
 
         void SetProgress(uint32_t currentProgress, uint32_t totalCount, StringId format = STR_NONE) override
         {
+            std::lock_guard<std::recursive_mutex> lock(_progressMutex);
             if (_forcedUpdateTimer.GetElapsedTime() < kForcedUpdateInterval)
                 return;
 
@@ -693,6 +797,7 @@ namespace OpenRCT2
 
         void CloseProgress() override
         {
+            std::lock_guard<std::recursive_mutex> lock(_progressMutex);
             auto intent = Intent(INTENT_ACTION_PROGRESS_CLOSE);
             ContextOpenIntent(&intent);
         }
@@ -1240,6 +1345,7 @@ namespace OpenRCT2
             {
                 RunFrame();
             } while (!_finished);
+            StopSimulationThread();
 #else
             emscripten_set_main_loop_arg(
                 [](void* vctx) -> {
@@ -1257,17 +1363,21 @@ namespace OpenRCT2
 
             const auto deltaTime = _timer.GetElapsedTimeAndRestart().count();
 
+            if (UpdateSimulationThread())
+            {
+                RunThreadedFrame(deltaTime);
+                return;
+            }
+
             // Make sure we catch the state change and reset it.
             bool useVariableFrame = ShouldRunVariableFrame();
             if (_variableFrame != useVariableFrame)
             {
                 _variableFrame = useVariableFrame;
 
-                // Switching from variable to fixed frame requires reseting
-                // of entity positions back to end of tick positions
-                auto& tweener = EntityTweener::Get();
-                tweener.Restore();
-                tweener.Reset();
+                // Switching from variable to fixed frame requires drawing
+                // entities at their end of tick positions again
+                EntityTweener::Get().Reset();
             }
 
             UpdateTimeAccumulators(deltaTime);
@@ -1288,13 +1398,23 @@ namespace OpenRCT2
             float scaledDeltaTime = deltaTime * _timeScale;
             _ticksAccumulator = std::min(_ticksAccumulator + scaledDeltaTime, kGameUpdateMaxThreshold);
 
-            // Real Time.
+            UpdateRealTimeAccumulator(deltaTime);
+        }
+
+        /**
+         * Returns the number of real time ticks that passed.
+         */
+        uint32_t UpdateRealTimeAccumulator(float deltaTime)
+        {
+            uint32_t numTicks = 0;
             _realtimeAccumulator = std::min(_realtimeAccumulator + deltaTime, kGameUpdateMaxThreshold);
             while (_realtimeAccumulator >= kGameUpdateTimeMS)
             {
                 gCurrentRealTimeTicks++;
                 _realtimeAccumulator -= kGameUpdateTimeMS;
+                numTicks++;
             }
+            return numTicks;
         }
 
         void RunFixedFrame(float deltaTime)
@@ -1362,6 +1482,218 @@ namespace OpenRCT2
             }
         }
 
+        bool ShouldRunSimulationThread()
+        {
+#ifdef __EMSCRIPTEN__
+            return false;
+#else
+            if (!Config::Get().general.ThreadedSimulation || !ShouldDraw())
+                return false;
+            // Title sequences, the intro and the preloader keep ticking on the main thread
+            return _activeScene != nullptr && _activeScene == _gameScene.get();
+#endif
+        }
+
+        /**
+         * Starts or stops the simulation thread depending on the current configuration and scene.
+         * Returns true if the simulation thread is running.
+         */
+        bool UpdateSimulationThread()
+        {
+            bool useSimulationThread;
+            bool stopRequested;
+            {
+                std::lock_guard<FairMutex> lock(_gameStateMutex);
+                useSimulationThread = ShouldRunSimulationThread();
+                stopRequested = _stopSimulationThread;
+            }
+
+            if (!useSimulationThread || stopRequested)
+            {
+                StopSimulationThread();
+            }
+            if (useSimulationThread && !_simulationThread.joinable())
+            {
+                _drawnGameState = CreateGameStateForDrawing();
+                _drawnGameStateStale = true;
+                _stopSimulationThread = false;
+                _simulationThread = std::thread([this]() { RunSimulationThread(); });
+            }
+            return useSimulationThread;
+        }
+
+        void StopSimulationThread()
+        {
+            if (_simulationThread.joinable())
+            {
+                {
+                    std::lock_guard<FairMutex> lock(_gameStateMutex);
+                    _stopSimulationThread = true;
+                }
+                _simulationThread.join();
+
+                // Frames draw the park itself again
+                _deferredWindowCalls.Run(*_uiContext->GetWindowManager());
+                _pendingInvalidations.Apply();
+                _drawnInvalidations.Apply();
+                _drawnGameState.reset();
+            }
+        }
+
+        /**
+         * Copies the park for drawing, unless a frame is drawing the previous copy. Must be called with _gameStateMutex
+         * held, which also means the main thread always succeeds.
+         */
+        void TryPublishDrawnGameState()
+        {
+            std::unique_lock<std::mutex> lock(_drawnGameStateMutex, std::try_to_lock);
+            if (!lock.owns_lock())
+                return;
+
+            GameStateCopyForDrawing(GetGameState(), *_drawnGameState);
+            _drawnInvalidations.Take(_pendingInvalidations);
+            _drawnGameStateStale = false;
+        }
+
+        /**
+         * Runs the game logic at its own rate, independent of how long the frames take. The game state is locked for one
+         * tick at a time, and the lock is handed over fairly, so the user interface update of a frame waits for at most
+         * the tick in progress. Drawing never waits, it uses the copy published after each tick.
+         */
+        void RunSimulationThread()
+        {
+            // The main thread owns the viewports, the windows and the drawing engine
+            Ui::DeferInvalidations(&_pendingInvalidations);
+            Ui::DeferWindowCalls(&_deferredWindowCalls);
+
+            Timer timer;
+            while (true)
+            {
+                float sleepTimeSec = 0.0f;
+                {
+                    std::lock_guard<FairMutex> lock(_gameStateMutex);
+                    if (_stopSimulationThread)
+                        break;
+
+                    const auto deltaTime = timer.GetElapsedTimeAndRestart().count();
+                    _ticksAccumulator = std::min(_ticksAccumulator + deltaTime * _timeScale, kGameUpdateMaxThreshold);
+                    if (_ticksAccumulator >= kGameUpdateTimeMS)
+                    {
+                        auto& tweener = EntityTweener::Get();
+                        if (_variableFrame)
+                            tweener.PreTick();
+
+                        gameStateTickLogic();
+
+                        _ticksAccumulator -= kGameUpdateTimeMS;
+
+                        if (_variableFrame)
+                            tweener.PostTick();
+
+                        _drawnGameStateStale = true;
+                    }
+                    else
+                    {
+                        sleepTimeSec = kGameUpdateTimeMS - _ticksAccumulator;
+                    }
+
+                    // If a frame is being drawn, the main thread publishes the park before drawing the next one
+                    if (_drawnGameStateStale)
+                        TryPublishDrawnGameState();
+                }
+
+                if (sleepTimeSec > 0.0f)
+                    Platform::Sleep(static_cast<uint32_t>(sleepTimeSec * 1000.f));
+            }
+
+            Ui::DeferInvalidations(nullptr);
+            Ui::DeferWindowCalls(nullptr);
+        }
+
+        /**
+         * Handles input and ticks the user interface while the simulation thread runs the game logic, then draws the
+         * copy of the park published after the last tick. The game state is only locked for the user interface.
+         */
+        void RunThreadedFrame(float deltaTime)
+        {
+            PROFILED_FUNCTION();
+
+            const bool shouldDraw = ShouldDraw();
+            float alpha = 1.0f;
+            {
+                std::lock_guard<FairMutex> lock(_gameStateMutex);
+
+                bool useVariableFrame = ShouldRunVariableFrame();
+                if (_variableFrame != useVariableFrame)
+                {
+                    _variableFrame = useVariableFrame;
+                    EntityTweener::Get().Reset();
+                    _drawnGameStateStale = true;
+                }
+
+                // Whatever the user interface changes in the park is only drawn from the next copy
+                Ui::DeferInvalidations(&_frameInvalidations);
+
+                _deferredWindowCalls.Run(*_uiContext->GetWindowManager());
+                _uiContext->ProcessMessages();
+
+                // The user interface keeps ticking at the real time rate, the game speed only affects the game logic
+                const auto numTicks = UpdateRealTimeAccumulator(deltaTime);
+                for (uint32_t i = 0; i < numTicks; i++)
+                {
+                    TickFrontEnd();
+                }
+
+                ContextHandleInput();
+                WindowUpdateAll();
+
+                Ui::DeferInvalidations(nullptr);
+                if (!_frameInvalidations.IsEmpty())
+                {
+                    _pendingInvalidations.Take(_frameInvalidations);
+                    _drawnGameStateStale = true;
+                }
+                if (_drawnGameStateStale)
+                {
+                    TryPublishDrawnGameState();
+                }
+
+                if (_variableFrame)
+                {
+                    alpha = std::min(_ticksAccumulator / kGameUpdateTimeMS, 1.0f);
+                }
+            }
+
+            if (shouldDraw)
+            {
+                std::lock_guard<std::mutex> lock(_drawnGameStateMutex);
+                GameStateScope scope(*_drawnGameState);
+
+                _drawnInvalidations.Apply();
+                if (_variableFrame)
+                {
+                    EntityTweener::Get().Tween(alpha);
+                }
+                _drawingEngine->BeginDraw();
+                _painter->Paint(*_drawingEngine);
+            }
+
+            if (shouldDraw)
+            {
+                _drawingEngine->EndDraw();
+            }
+
+            if (!_variableFrame)
+            {
+                // Without interpolation nothing changes on screen until the next tick
+                const auto frameTime = _timer.GetElapsedTime().count();
+                if (frameTime < kGameUpdateTimeMS)
+                {
+                    Platform::Sleep(static_cast<uint32_t>((kGameUpdateTimeMS - frameTime) * 1000.f));
+                }
+            }
+        }
+
         void Draw()
         {
             PROFILED_FUNCTION();
@@ -1375,6 +1707,28 @@ namespace OpenRCT2
         {
             PROFILED_FUNCTION();
 
+            UpdateRealTimeEffects();
+
+            if (_activeScene)
+                _activeScene->Tick();
+
+            TickServices();
+        }
+
+        /**
+         * Runs everything of a tick except the game logic, for when the simulation thread runs that.
+         */
+        void TickFrontEnd()
+        {
+            PROFILED_FUNCTION();
+
+            UpdateRealTimeEffects();
+            gameStateHandleInput();
+            TickServices();
+        }
+
+        void UpdateRealTimeEffects()
+        {
             // TODO: This variable has been never "variable" in time, some code expects
             // this to be 40Hz (25 ms). Refactor this once the UI is decoupled.
             gCurrentDeltaTime = static_cast<uint16_t>(kGameUpdateTimeMS * 1000.0f);
@@ -1385,10 +1739,10 @@ namespace OpenRCT2
             }
 
             DateUpdateRealTimeOfDay();
+        }
 
-            if (_activeScene)
-                _activeScene->Tick();
-
+        void TickServices()
+        {
 #ifdef __ENABLE_DISCORD__
             if (_discordService != nullptr)
             {
@@ -11,6 +11,7 @@
 
 #include "Game.h"
 #include "GameStateSnapshots.h"
+#include "GameStateTransient.h"
 #include "Input.h"
 #include "OpenRCT2.h"
 #include "ReplayManager.h"
@@ -18,6 +19,7 @@
 #include "config/Config.h"
 #include "entity/EntityTweener.h"
 #include "entity/PatrolArea.h"
+#include "entity/Staff.h"
 #include "interface/Screenshot.h"
 #include "platform/Platform.h"
 #include "profiling/Profiling.h"
@@ -29,20 +31,146 @@
 #include "windows/Intent.h"
 #include "world/Scenery.h"
 
+#include <mutex>
+
 using namespace OpenRCT2::Scripting;
 
 namespace OpenRCT2
 {
     static auto _gameState = std::make_unique<GameState_t>();
 
-    GameState_t& GetGameState()
+    // Objects, scripting, network and a few peep statics are shared by all parks, so only one park ticks at a time
+    static std::recursive_mutex _tickMutex;
+
+    namespace Detail
+    {
+        GameState_t* gMainGameState = _gameState.get();
+        constinit thread_local GameState_t* gThreadGameState = nullptr;
+    } // namespace Detail
+
+    void GameStateTransientDeleter::operator()(GameStateTransient* transient) const
+    {
+        delete transient;
+    }
+
+    std::unique_ptr<GameStateTransient, GameStateTransientDeleter> CreateGameStateTransient()
     {
-        return *_gameState;
+        return std::unique_ptr<GameStateTransient, GameStateTransientDeleter>(new GameStateTransient());
     }
 
     void SwapGameState(std::unique_ptr<GameState_t>& otherState)
     {
         _gameState.swap(otherState);
+        Detail::gMainGameState = _gameState.get();
+    }
+
+    GameStateScope::GameStateScope(GameState_t& gameState)
+        : _previousState(Detail::gThreadGameState)
+    {
+        Detail::gThreadGameState = &gameState;
+    }
+
+    GameStateScope::~GameStateScope()
+    {
+        Detail::gThreadGameState = _previousState;
+    }
+
+    std::unique_ptr<GameState_t> CreateGameStateForDrawing()
+    {
+        auto gameState = std::make_unique<GameState_t>();
+        for (EntityId::UnderlyingType i = 0; i < MAX_ENTITIES; i++)
+        {
+            auto& entity = gameState->Entities[i].base;
+            entity.Type = EntityType::Null;
+            entity.Id = EntityId::FromUnderlying(i);
+        }
+        return gameState;
+    }
+
+    static void CopyEntityForDrawing(const Entity_t& src, Entity_t& dst)
+    {
+        // Peeps own their names and staff their patrol areas, the copy gets its own
+        if (auto* peep = dst.base.As<Peep>(); peep != nullptr)
+        {
+            peep->SetName({});
+            if (auto* staff = peep->As<Staff>(); staff != nullptr)
+            {
+                staff->ClearPatrolArea();
+            }
+        }
+
+        dst = src;
+
+        if (auto* peep = dst.base.As<Peep>(); peep != nullptr)
+        {
+            const auto* name = peep->Name;
+            peep->Name = nullptr;
+            if (name != nullptr)
+            {
+                peep->SetName(name);
+            }
+            if (auto* staff = peep->As<Staff>(); staff != nullptr && staff->PatrolInfo != nullptr)
+            {
+                staff->PatrolInfo = new PatrolArea(*staff->PatrolInfo);
+            }
+        }
+    }
+
+    void GameStateCopyForDrawing(const GameState_t& src, GameState_t& dst)
+    {
+        PROFILED_FUNCTION();
+
+        static_cast<GameStateData&>(dst) = src;
+
+        const auto& srcTransient = *src.Transient;
+        auto& dstTransient = *dst.Transient;
+
+        // Entities the copy had in use and the park has freed since, then all entities in use
+        for (const auto& list : dstTransient.EntityLists)
+        {
+            for (auto id : list)
+            {
+                const auto index = id.ToUnderlying();
+                if (src.Entities[index].base.Type == EntityType::Null)
+                {
+                    CopyEntityForDrawing(src.Entities[index], dst.Entities[index]);
+                }
+            }
+        }
+        for (const auto& list : srcTransient.EntityLists)
+        {
+            for (auto id : list)
+            {
+                const auto index = id.ToUnderlying();
+                CopyEntityForDrawing(src.Entities[index], dst.Entities[index]);
+            }
+        }
+        dstTransient.EntityLists = srcTransient.EntityLists;
+        dstTransient.EntitySpatialIndex = srcTransient.EntitySpatialIndex;
+        dstTransient.EntityFlashing = srcTransient.EntityFlashing;
+        dstTransient.Tweener = srcTransient.Tweener;
+
+        for (size_t i = 0; i < src.Rides.size(); i++)
+        {
+            const auto& srcRide = src.Rides[i];
+            auto& dstRide = dst.Rides[i];
+            if (srcRide.id.IsNull() && dstRide.id.IsNull())
+                continue;
+
+            dstRide = srcRide;
+            if (dstRide.measurement != nullptr)
+            {
+                dstRide.measurement = std::make_shared<RideMeasurement>(*srcRide.measurement);
+            }
+        }
+
+        dst.TileElements = src.TileElements;
+        dstTransient.TileIndex.CopyFrom(srcTransient.TileIndex, src.TileElements.data(), dst.TileElements.data());
+        dstTransient.TileTypeIndex = srcTransient.TileTypeIndex;
+        dstTransient.TileElementsInUse = srcTransient.TileElementsInUse;
+        dstTransient.RideTrackTiles = srcTransient.RideTrackTiles;
+        dstTransient.NewTrackTiles = srcTransient.NewTrackTiles;
+        dstTransient.RideTrackTilesValid = srcTransient.RideTrackTilesValid;
     }
 
     /**
@@ -99,14 +227,29 @@ namespace OpenRCT2
      */
     void gameStateTick()
     {
-        PROFILED_FUNCTION();
-
-        // Normal game play will update only once every kGameUpdateTimeMS
-        uint32_t numUpdates = 1;
+        gameStateHandleInput();
+        gameStateTickLogic();
+    }
 
+    /**
+     * Handles the screenshot and keyboard input that is checked once per game tick.
+     */
+    void gameStateHandleInput()
+    {
         // 0x006E3AEC // screen_game_process_mouse_input();
         ScreenshotCheck();
         GameHandleKeyboardInput();
+    }
+
+    /**
+     * The part of gameStateTick that does not handle input, for the simulation thread.
+     */
+    void gameStateTickLogic()
+    {
+        PROFILED_FUNCTION();
+
+        // Normal game play will update only once every kGameUpdateTimeMS
+        uint32_t numUpdates = 1;
 
         if (GameIsNotPaused() && gPreviewingTitleSequenceInGame)
         {
@@ -242,6 +385,8 @@ namespace OpenRCT2
     {
         PROFILED_FUNCTION();
 
+        std::scoped_lock<std::recursive_mutex> lock(_tickMutex);
+
         gInUpdateCode = true;
 
         gScreenAge++;
@@ -18,6 +18,7 @@
 #include "management/Finance.h"
 #include "management/Marketing.h"
 #include "management/NewsItem.h"
+#include "peep/RideUseSystem.h"
 #include "ride/Ride.h"
 #include "ride/RideRatings.h"
 #include "scenario/Scenario.h"
@@ -34,7 +35,20 @@
 
 namespace OpenRCT2
 {
-    struct GameState_t
+    struct GameStateTransient;
+
+    struct GameStateTransientDeleter
+    {
+        void operator()(GameStateTransient* transient) const;
+    };
+
+    std::unique_ptr<GameStateTransient, GameStateTransientDeleter> CreateGameStateTransient();
+
+    /**
+     * Everything in GameState_t apart from the entity, ride and tile element storage and the lookup structures, which
+     * are too large to be copied as a whole. See GameStateCopyForDrawing.
+     */
+    struct GameStateData
     {
         ::OpenRCT2::Park::ParkData Park{};
         std::string PluginStorage;
@@ -90,11 +104,7 @@ namespace OpenRCT2
         std::string ScenarioFileName;
 
         std::vector<Banner> Banners;
-        Entity_t Entities[MAX_ENTITIES]{};
-        // Ride storage for all the rides in the park, rides with RideId::Null are considered free.
-        std::array<Ride, OpenRCT2::Limits::kMaxRidesInPark> Rides{};
         ::RideRatingUpdateStates RideRatingUpdateStates;
-        std::vector<TileElement> TileElements;
 
         std::vector<ScenerySelection> RestrictedScenery;
 
@@ -147,13 +157,69 @@ namespace OpenRCT2
         uint32_t SuggestedGuestMaximum;
 
         CheatsState Cheats;
+
+        RideUse::RideHistory RideUseHistory;
+        RideUse::RideTypeHistory RideUseTypeHistory;
     };
 
-    GameState_t& GetGameState();
+    struct GameState_t : GameStateData
+    {
+        Entity_t Entities[MAX_ENTITIES]{};
+        // Ride storage for all the rides in the park, rides with RideId::Null are considered free.
+        std::array<Ride, OpenRCT2::Limits::kMaxRidesInPark> Rides{};
+        std::vector<TileElement> TileElements;
+
+        // Lookup structures and queued actions that are not saved, see GameStateTransient.h
+        std::unique_ptr<GameStateTransient, GameStateTransientDeleter> Transient = CreateGameStateTransient();
+    };
+
+    namespace Detail
+    {
+        extern GameState_t* gMainGameState;
+        extern constinit thread_local GameState_t* gThreadGameState;
+    } // namespace Detail
+
+    inline GameState_t& GetGameState()
+    {
+        auto* threadGameState = Detail::gThreadGameState;
+        return threadGameState != nullptr ? *threadGameState : *Detail::gMainGameState;
+    }
+
     void SwapGameState(std::unique_ptr<GameState_t>& otherState);
 
+    /**
+     * Makes GetGameState return the given state on the calling thread for the lifetime of the scope, so that a thread can
+     * update a park of its own. Other threads keep using the state they had. Parks bound on different threads still tick
+     * one at a time, see gameStateUpdateLogic.
+     */
+    class GameStateScope
+    {
+    public:
+        explicit GameStateScope(GameState_t& gameState);
+        ~GameStateScope();
+
+        GameStateScope(const GameStateScope&) = delete;
+        GameStateScope& operator=(const GameStateScope&) = delete;
+
+    private:
+        GameState_t* _previousState;
+    };
+
+    /**
+     * Creates a park that is only drawn, with all of its entities free, for GameStateCopyForDrawing.
+     */
+    std::unique_ptr<GameState_t> CreateGameStateForDrawing();
+
+    /**
+     * Copies what drawing reads of a park into one created by CreateGameStateForDrawing, so that the copy can be drawn
+     * while the park is updated on another thread. Only the entities and rides in use by either park are copied.
+     */
+    void GameStateCopyForDrawing(const GameState_t& src, GameState_t& dst);
+
     void gameStateInitAll(GameState_t& gameState, const TileCoordsXY& mapSize);
     void gameStateTick();
+    void gameStateHandleInput();
+    void gameStateTickLogic();
     void gameStateUpdateLogic();
 
 } // namespace OpenRCT2
@@ -0,0 +1,54 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "actions/GameAction.h"
+#include "entity/EntityBase.h"
+#include "entity/EntityRegistry.h"
+#include "entity/EntityTweener.h"
+#include "peep/PathFlowField.h"
+#include "peep/PathSegmentCache.h"
+#include "world/Location.hpp"
+#include "world/MapAnimation.h"
+#include "world/TileElement.h"
+#include "world/TileElementTypeIndex.h"
+#include "world/TilePointerIndex.hpp"
+
+#include <array>
+#include <list>
+#include <set>
+#include <vector>
+
+namespace OpenRCT2
+{
+    /**
+     * Lookup structures built from the saved park data and queued actions, none of which are saved. They are kept with
+     * the park so that every GameState_t can be updated on its own.
+     */
+    struct GameStateTransient
+    {
+        std::array<std::list<EntityId>, EnumValue(EntityType::Count)> EntityLists;
+        std::vector<EntityId> EntityFreeIds;
+        std::vector<std::vector<EntityId>> EntitySpatialIndex;
+        std::array<bool, MAX_ENTITIES> EntityFlashing{};
+        EntityTweener Tweener;
+        TilePointerIndex<TileElement> TileIndex;
+        TileElementTypeIndex TileTypeIndex;
+        size_t TileElementsInUse{};
+        std::vector<std::vector<TileCoordsXY>> RideTrackTiles;
+        std::vector<TileCoordsXY> NewTrackTiles;
+        bool RideTrackTilesValid{};
+        PathFinding::PathSegmentCache PathSegments;
+        PathFinding::PathFlowFieldCache PathFlowFields;
+        std::vector<MapAnimation> MapAnimations;
+        std::multiset<GameActions::QueuedGameAction> ActionQueue;
+        uint32_t NextActionId{};
+    };
+} // namespace OpenRCT2
@@ -45,6 +45,7 @@ extern bool gOpenRCT2Headless;
 extern bool gOpenRCT2NoGraphics;
 extern bool gOpenRCT2ShowChangelog;
 extern bool gOpenRCT2SilentBreakpad;
+extern bool gOpenRCT2StartupReport;
 extern u8string gSilentRecordingName;
 extern bool gSilentReplays;
 
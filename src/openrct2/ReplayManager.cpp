@@ -81,6 +81,14 @@ namespace OpenRCT2
         OpenRCT2::MemoryStream data;
     };
 
+    struct ReplayKeyframe
+    {
+        uint32_t tick = 0;
+        EntitiesChecksum checksum{};
+        OpenRCT2::MemoryStream parkData;
+        OpenRCT2::MemoryStream parkParams;
+    };
+
     struct ReplayRecordData
     {
         uint32_t magic;
@@ -98,11 +106,13 @@ namespace OpenRCT2
         std::vector<std::pair<uint32_t, EntitiesChecksum>> checksums;
         uint32_t checksumIndex;
         OpenRCT2::MemoryStream gameStateSnapshots;
+        std::vector<ReplayKeyframe> keyframes;
     };
 
     class ReplayManager final : public IReplayManager
     {
-        static constexpr uint16_t kReplayVersion = 10;
+        static constexpr uint16_t kReplayVersion = 11;
+        static constexpr uint16_t kReplayVersionKeyframes = 11;
         static constexpr uint32_t kReplayMagic = 0x5243524F; // ORCR.
         static constexpr int kReplayCompressionLevel = 9;
         static constexpr int kNormalRecordingChecksumTicks = 1;
@@ -156,6 +166,20 @@ namespace OpenRCT2
             _currentRecording->checksums.emplace_back(std::make_pair(tick, std::move(checksum)));
         }
 
+        void AddKeyframe(uint32_t tick)
+        {
+            auto& keyframe = _currentRecording->keyframes.emplace_back();
+            keyframe.tick = tick;
+            keyframe.checksum = GetAllEntitiesChecksum();
+
+            auto exporter = std::make_unique<ParkFileExporter>();
+            exporter->ExportObjectsList = GetContext()->GetObjectManager().GetPackableObjects();
+            exporter->Export(GetGameState(), keyframe.parkData);
+
+            DataSerialiser parkParamsDs(true, keyframe.parkParams);
+            SerialiseParkParameters(parkParamsDs);
+        }
+
         // Function runs each Tick.
         virtual void Update() override
         {
@@ -172,6 +196,13 @@ namespace OpenRCT2
                 _nextChecksumTick = currentTicks + ChecksumTicksDelta();
             }
 
+            if ((_mode == ReplayMode::RECORDING || _mode == ReplayMode::NORMALISATION) && _recordType == RecordType::NORMAL
+                && currentTicks == _nextKeyframeTick)
+            {
+                AddKeyframe(currentTicks);
+                _nextKeyframeTick = currentTicks + k_ReplayKeyframeTicks;
+            }
+
             if (_mode == ReplayMode::RECORDING)
             {
                 if (currentTicks >= _currentRecording->tickEnd)
@@ -193,7 +224,7 @@ namespace OpenRCT2
                 ReplayCommands();
 
                 // Normal playback will always end at the specific tick.
-                if (currentTicks >= _currentReplay->tickEnd)
+                if (currentTicks >= _playbackTickEnd)
                 {
                     StopPlayback();
                     return;
@@ -278,6 +309,7 @@ namespace OpenRCT2
             _currentRecording = std::move(replayData);
             _recordType = rt;
             _nextChecksumTick = currentTicks + 1;
+            _nextKeyframeTick = currentTicks + k_ReplayKeyframeTicks;
 
             return true;
         }
@@ -384,11 +416,30 @@ namespace OpenRCT2
                 info.Ticks = data->tickEnd - data->tickStart;
             info.NumCommands = static_cast<uint32_t>(data->commands.size());
             info.NumChecksums = static_cast<uint32_t>(data->checksums.size());
+            info.NumKeyframes = static_cast<uint32_t>(data->keyframes.size());
 
             return true;
         }
 
-        void LoadAndCompareSnapshot(MemoryStream& snapshotStream)
+        virtual bool GetReplayInfo(const std::string& file, ReplayRecordInfo& info) override
+        {
+            ReplayRecordData data;
+            if (!ReadReplayData(file, data))
+                return false;
+
+            info.FilePath = data.filePath;
+            info.Name = data.name;
+            info.Version = data.version;
+            info.TimeRecorded = data.timeRecorded;
+            info.Ticks = data.tickEnd - data.tickStart;
+            info.NumCommands = static_cast<uint32_t>(data.commands.size());
+            info.NumChecksums = static_cast<uint32_t>(data.checksums.size());
+            info.NumKeyframes = static_cast<uint32_t>(data.keyframes.size());
+
+            return true;
+        }
+
+        void LoadAndCompareSnapshot(MemoryStream& snapshotStream, bool compare = true)
         {
             DataSerialiser ds(false, snapshotStream);
 
@@ -396,6 +447,8 @@ namespace OpenRCT2
 
             GameStateSnapshot_t& replaySnapshot = snapshots->CreateSnapshot();
             snapshots->SerialiseSnapshot(replaySnapshot, ds);
+            if (!compare)
+                return;
 
             const auto currentTicks = GetGameState().CurrentTicks;
 
@@ -442,7 +495,7 @@ namespace OpenRCT2
                 return false;
             }
 
-            if (!LoadReplayDataMap(*replayData))
+            if (!LoadReplayDataMap(replayData->parkData, replayData->parkParams))
             {
                 LOG_ERROR("Unable to load map.");
                 return false;
@@ -454,6 +507,7 @@ namespace OpenRCT2
 
             _currentReplay = std::move(replayData);
             _currentReplay->checksumIndex = 0;
+            _playbackTickEnd = _currentReplay->tickEnd;
             _faultyChecksumIndex = -1;
 
             // Make sure game is not paused.
@@ -465,6 +519,88 @@ namespace OpenRCT2
             return true;
         }
 
+        virtual bool StartSegmentPlayback(const std::string& file, uint32_t segment) override
+        {
+            if (_mode != ReplayMode::NONE)
+                return false;
+
+            auto replayData = std::make_unique<ReplayRecordData>();
+            if (!ReadReplayData(file, *replayData))
+            {
+                LOG_ERROR("Unable to read replay data.");
+                return false;
+            }
+
+            if (segment > replayData->keyframes.size())
+            {
+                LOG_ERROR("Replay only has %zu segments.", replayData->keyframes.size() + 1);
+                return false;
+            }
+
+            auto* keyframe = segment == 0 ? nullptr : &replayData->keyframes[segment - 1];
+            const auto tickEnd = segment < replayData->keyframes.size() ? replayData->keyframes[segment].tick
+                                                                         : replayData->tickEnd;
+
+            _faultyChecksumIndex = -1;
+            if (!LoadReplayState(*replayData, keyframe))
+                return false;
+
+            // The first snapshot only matches the start of the replay
+            LoadAndCompareSnapshot(replayData->gameStateSnapshots, keyframe == nullptr);
+
+            _currentReplay = std::move(replayData);
+            _playbackTickEnd = tickEnd;
+            gGamePaused = 0;
+            _mode = ReplayMode::PLAYING;
+
+            return true;
+        }
+
+        virtual bool SeekPlayback(uint32_t tick) override
+        {
+            if (_mode != ReplayMode::PLAYING)
+                return false;
+
+            const auto targetTick = std::min(_currentReplay->tickStart + tick, _playbackTickEnd);
+            const auto currentTicks = GetGameState().CurrentTicks;
+
+            size_t numKeyframes = 0;
+            for (const auto& keyframe : _currentReplay->keyframes)
+            {
+                if (keyframe.tick > targetTick)
+                    break;
+                numKeyframes++;
+            }
+
+            // Playing on is quicker unless the target is behind or there is a keyframe between here and there
+            const auto startTick = numKeyframes == 0 ? _currentReplay->tickStart
+                                                     : _currentReplay->keyframes[numKeyframes - 1].tick;
+            if (targetTick < currentTicks || startTick > currentTicks)
+            {
+                // Commands are consumed while playing, so start again from the file
+                auto replayData = std::make_unique<ReplayRecordData>();
+                if (!ReadReplayData(_currentReplay->filePath, *replayData) || replayData->keyframes.size() < numKeyframes)
+                {
+                    LOG_ERROR("Unable to read replay data.");
+                    return false;
+                }
+
+                auto* keyframe = numKeyframes == 0 ? nullptr : &replayData->keyframes[numKeyframes - 1];
+                if (!LoadReplayState(*replayData, keyframe))
+                    return false;
+
+                // Keep the end snapshot available for StopPlayback
+                LoadAndCompareSnapshot(replayData->gameStateSnapshots, false);
+                _currentReplay = std::move(replayData);
+            }
+
+            while (_mode == ReplayMode::PLAYING && GetGameState().CurrentTicks < targetTick)
+            {
+                gameStateUpdateLogic();
+            }
+            return true;
+        }
+
         virtual bool IsPlaybackStateMismatching() const override
         {
             return _faultyChecksumIndex != -1;
@@ -475,7 +611,9 @@ namespace OpenRCT2
             if (_mode != ReplayMode::PLAYING && _mode != ReplayMode::NORMALISATION)
                 return false;
 
-            LoadAndCompareSnapshot(_currentReplay->gameStateSnapshots);
+            // The end snapshot is only comparable if playback got there
+            LoadAndCompareSnapshot(
+                _currentReplay->gameStateSnapshots, GetGameState().CurrentTicks >= _currentReplay->tickEnd);
 
             // During normal playback we pause the game if stopped.
             if (_mode == ReplayMode::PLAYING)
@@ -528,17 +666,18 @@ namespace OpenRCT2
             }
         }
 
-        bool LoadReplayDataMap(ReplayRecordData& data)
+        bool LoadReplayDataMap(MemoryStream& parkData, MemoryStream& parkParams)
         {
             try
             {
-                data.parkData.SetPosition(0);
+                parkData.SetPosition(0);
+                parkParams.SetPosition(0);
 
                 auto context = GetContext();
                 auto& objManager = context->GetObjectManager();
                 auto importer = ParkImporter::CreateParkFile(context->GetObjectRepository());
 
-                auto loadResult = importer->LoadFromStream(&data.parkData, false);
+                auto loadResult = importer->LoadFromStream(&parkData, false);
                 objManager.LoadObjects(loadResult.RequiredObjects);
 
                 // TODO: Have a separate GameState and exchange once loaded.
@@ -548,7 +687,7 @@ namespace OpenRCT2
                 EntityTweener::Get().Reset();
 
                 // Load all map global variables.
-                DataSerialiser parkParamsDs(false, data.parkParams);
+                DataSerialiser parkParamsDs(false, parkParams);
                 SerialiseParkParameters(parkParamsDs);
 
                 GameLoadInit();
@@ -562,6 +701,46 @@ namespace OpenRCT2
             return true;
         }
 
+        /**
+         * Loads the park at the keyframe, or at the start of the replay if there is none, and skips the commands and
+         * checksums before it.
+         */
+        bool LoadReplayState(ReplayRecordData& data, ReplayKeyframe* keyframe)
+        {
+            auto& parkData = keyframe != nullptr ? keyframe->parkData : data.parkData;
+            auto& parkParams = keyframe != nullptr ? keyframe->parkParams : data.parkParams;
+            if (!LoadReplayDataMap(parkData, parkParams))
+            {
+                LOG_ERROR("Unable to load map.");
+                return false;
+            }
+
+            const auto startTick = keyframe != nullptr ? keyframe->tick : data.tickStart;
+            GetGameState().CurrentTicks = startTick;
+
+            auto& commands = data.commands;
+            while (!commands.empty() && commands.begin()->tick < startTick)
+            {
+                commands.erase(commands.begin());
+            }
+
+            data.checksumIndex = 0;
+            while (data.checksumIndex < data.checksums.size() && data.checksums[data.checksumIndex].first < startTick)
+            {
+                data.checksumIndex++;
+            }
+
+#ifndef DISABLE_NETWORK
+            // A keyframe is only useful if loading it gives back the state it was saved from
+            if (keyframe != nullptr && GetAllEntitiesChecksum().raw != keyframe->checksum.raw)
+            {
+                LOG_WARNING("Keyframe at tick %u does not load to the recorded state.", keyframe->tick);
+                _faultyChecksumIndex = static_cast<int32_t>(data.checksumIndex);
+            }
+#endif
+            return true;
+        }
+
         bool ReadReplayFromFile(const std::string& file, MemoryStream& stream)
         {
             FILE* fp = fopen(file.c_str(), "rb");
@@ -723,7 +902,8 @@ namespace OpenRCT2
 
         bool Compatible(ReplayRecordData& data)
         {
-            return data.version == kReplayVersion;
+            // Replays from before keyframes play back the same way, they just cannot seek quickly
+            return data.version == kReplayVersion || data.version == kReplayVersionKeyframes - 1;
         }
 
         bool Serialise(DataSerialiser& serialiser, ReplayRecordData& data)
@@ -796,6 +976,25 @@ namespace OpenRCT2
             }
 
             serialiser << data.gameStateSnapshots;
+
+            if (data.version >= kReplayVersionKeyframes)
+            {
+                uint32_t countKeyframes = static_cast<uint32_t>(data.keyframes.size());
+                serialiser << countKeyframes;
+
+                if (serialiser.IsLoading())
+                {
+                    data.keyframes.resize(countKeyframes);
+                }
+
+                for (auto& keyframe : data.keyframes)
+                {
+                    serialiser << keyframe.tick;
+                    serialiser << keyframe.checksum.raw;
+                    serialiser << keyframe.parkData;
+                    serialiser << keyframe.parkParams;
+                }
+            }
             return true;
         }
 
@@ -893,6 +1092,8 @@ namespace OpenRCT2
         uint32_t _commandId = 0;
         uint32_t _nextChecksumTick = 0;
         uint32_t _nextReplayTick = 0;
+        uint32_t _nextKeyframeTick = 0;
+        uint32_t _playbackTickEnd = 0;
         RecordType _recordType = RecordType::NORMAL;
     };
 
@@ -18,6 +18,8 @@ class GameAction;
 namespace OpenRCT2
 {
     static constexpr uint32_t k_MaxReplayTicks = 0xFFFFFFFF;
+    // Normal recordings save a keyframe this often, silent recordings run all the time so they do not pay for keyframes.
+    static constexpr uint32_t k_ReplayKeyframeTicks = 4000;
 
     struct ReplayRecordInfo
     {
@@ -26,6 +28,7 @@ namespace OpenRCT2
         uint64_t TimeRecorded;
         uint32_t NumCommands;
         uint32_t NumChecksums;
+        uint32_t NumKeyframes;
         std::string Name;
         std::string FilePath;
     };
@@ -55,8 +58,13 @@ namespace OpenRCT2
             = 0;
         virtual bool StopRecording(bool discard = false) = 0;
         virtual bool GetCurrentReplayInfo(ReplayRecordInfo& info) const = 0;
+        virtual bool GetReplayInfo(const std::string& file, ReplayRecordInfo& info) = 0;
 
         virtual bool StartPlayback(const std::string& file) = 0;
+        // Plays the ticks between two keyframes, segment 0 starts at the beginning of the replay.
+        virtual bool StartSegmentPlayback(const std::string& file, uint32_t segment) = 0;
+        // Moves playback to the given replay tick, starting from the closest keyframe before it.
+        virtual bool SeekPlayback(uint32_t tick) = 0;
         virtual bool IsPlaybackStateMismatching() const = 0;
         virtual bool StopPlayback() = 0;
 
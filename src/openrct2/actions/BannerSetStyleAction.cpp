@@ -11,6 +11,8 @@
 
 #include "../Context.h"
 #include "../Diagnostic.h"
+#include "../GameState.h"
+#include "../GameStateTransient.h"
 #include "../management/Finance.h"
 #include "../util/Util.h"
 #include "../windows/Intent.h"
@@ -154,6 +156,7 @@ GameActions::Result BannerSetStyleAction::Execute() const
                 allowedEdges &= ~(1 << bannerElement->GetPosition());
             }
             bannerElement->SetAllowedEdges(allowedEdges);
+            GetGameState().Transient->PathFlowFields.Clear();
             break;
         }
         default:
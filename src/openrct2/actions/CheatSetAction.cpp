@@ -36,6 +36,7 @@
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 #include "../world/Surface.h"
+#include "../world/TileElementsView.h"
 #include "ParkSetLoanAction.h"
 #include "ParkSetParameterAction.h"
 
@@ -453,35 +454,29 @@ void CheatSetAction::SetGrassLength(int32_t length) const
 
 void CheatSetAction::WaterPlants() const
 {
-    TileElementIterator it;
-
-    TileElementIteratorBegin(&it);
-    do
+    for (const auto& tilePos : MapGetTilesWithElementTypes({ TileElementType::SmallScenery }))
     {
-        if (it.element->GetType() == TileElementType::SmallScenery)
+        for (auto* smallScenery : TileElementsView<SmallSceneryElement>(tilePos))
         {
-            it.element->AsSmallScenery()->SetAge(0);
+            smallScenery->SetAge(0);
         }
-    } while (TileElementIteratorNext(&it));
+    }
 
     GfxInvalidateScreen();
 }
 
 void CheatSetAction::FixVandalism() const
 {
-    TileElementIterator it;
-
-    TileElementIteratorBegin(&it);
-    do
+    for (const auto& tilePos : MapGetTilesWithElementTypes({ TileElementType::Path }))
     {
-        if (it.element->GetType() != TileElementType::Path)
-            continue;
-
-        if (!(it.element)->AsPath()->HasAddition())
-            continue;
+        for (auto* path : TileElementsView<PathElement>(tilePos))
+        {
+            if (!path->HasAddition())
+                continue;
 
-        it.element->AsPath()->SetIsBroken(false);
-    } while (TileElementIteratorNext(&it));
+            path->SetIsBroken(false);
+        }
+    }
 
     GfxInvalidateScreen();
 }
@@ -493,22 +488,18 @@ void CheatSetAction::RemoveLitter() const
         EntityRemove(litter);
     }
 
-    TileElementIterator it{};
-    TileElementIteratorBegin(&it);
-    do
+    for (const auto& tilePos : MapGetTilesWithElementTypes({ TileElementType::Path }))
     {
-        if (it.element->GetType() != TileElementType::Path)
-            continue;
-
-        auto* path = it.element->AsPath();
-        if (!path->HasAddition())
-            continue;
-
-        auto* pathAdditionEntry = path->GetAdditionEntry();
-        if (pathAdditionEntry != nullptr && pathAdditionEntry->flags & PATH_ADDITION_FLAG_IS_BIN)
-            path->SetAdditionStatus(0xFF);
+        for (auto* path : TileElementsView<PathElement>(tilePos))
+        {
+            if (!path->HasAddition())
+                continue;
 
-    } while (TileElementIteratorNext(&it));
+            auto* pathAdditionEntry = path->GetAdditionEntry();
+            if (pathAdditionEntry != nullptr && pathAdditionEntry->flags & PATH_ADDITION_FLAG_IS_BIN)
+                path->SetAdditionStatus(0xFF);
+        }
+    }
 
     GfxInvalidateScreen();
 }
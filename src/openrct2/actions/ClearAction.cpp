@@ -17,6 +17,7 @@
 #include "../management/Finance.h"
 #include "../world/Location.hpp"
 #include "../world/Map.h"
+#include "../world/TileElementsView.h"
 #include "FootpathRemoveAction.h"
 #include "LargeSceneryRemoveAction.h"
 #include "SmallSceneryRemoveAction.h"
@@ -217,22 +218,11 @@ money64 ClearAction::ClearSceneryFromTile(const CoordsXY& tilePos, bool executin
 
 void ClearAction::ResetClearLargeSceneryFlag()
 {
-    auto& gameState = GetGameState();
-    // TODO: Improve efficiency of this
-    for (int32_t y = 0; y < gameState.MapSize.y; y++)
+    for (const auto& tilePos : MapGetTilesWithElementTypes({ TileElementType::LargeScenery }))
     {
-        for (int32_t x = 0; x < gameState.MapSize.x; x++)
+        for (auto* largeScenery : TileElementsView<LargeSceneryElement>(tilePos))
         {
-            auto tileElement = MapGetFirstElementAt(TileCoordsXY{ x, y });
-            do
-            {
-                if (tileElement == nullptr)
-                    break;
-                if (tileElement->GetType() == TileElementType::LargeScenery)
-                {
-                    tileElement->AsLargeScenery()->SetIsAccounted(false);
-                }
-            } while (!(tileElement++)->IsLastForTile());
+            largeScenery->SetIsAccounted(false);
         }
     }
 }
@@ -13,6 +13,7 @@
 #include "../Context.h"
 #include "../Diagnostic.h"
 #include "../GameState.h"
+#include "../GameStateTransient.h"
 #include "../OpenRCT2.h"
 #include "../core/MemoryStream.h"
 #include "../interface/Window.h"
@@ -229,6 +230,8 @@ GameActions::Result FootpathPlaceAction::ElementUpdateExecute(PathElement* pathE
     }
 
     FootpathQueueChainReset();
+    // The path may be changed to or from a queue
+    GetGameState().Transient->PathFlowFields.Clear();
 
     if (!(GetFlags() & GAME_COMMAND_FLAG_TRACK_DESIGN))
     {
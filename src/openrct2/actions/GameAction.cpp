@@ -12,6 +12,7 @@
 #include "../Context.h"
 #include "../Diagnostic.h"
 #include "../GameState.h"
+#include "../GameStateTransient.h"
 #include "../ReplayManager.h"
 #include "../core/Guard.hpp"
 #include "../core/Memory.hpp"
@@ -36,34 +37,6 @@ using namespace OpenRCT2;
 
 namespace OpenRCT2::GameActions
 {
-    struct QueuedGameAction
-    {
-        uint32_t tick;
-        uint32_t uniqueId;
-        GameAction::Ptr action;
-
-        explicit QueuedGameAction(uint32_t t, std::unique_ptr<GameAction>&& ga, uint32_t id)
-            : tick(t)
-            , uniqueId(id)
-            , action(std::move(ga))
-        {
-        }
-
-        bool operator<(const QueuedGameAction& comp) const
-        {
-            // First sort by tick
-            if (tick < comp.tick)
-                return true;
-            if (tick > comp.tick)
-                return false;
-
-            // If the ticks are equal sort by commandIndex
-            return uniqueId < comp.uniqueId;
-        }
-    };
-
-    static std::multiset<QueuedGameAction> _actionQueue;
-    static uint32_t _nextUniqueId = 0;
     static bool _suspended = false;
 
     void SuspendQueue()
@@ -90,7 +63,8 @@ namespace OpenRCT2::GameActions
             // as that normally happens when receiving them over network.
             ga->SetPlayer(NetworkGetCurrentPlayerId());
         }
-        _actionQueue.emplace(tick, std::move(ga), _nextUniqueId++);
+        auto& gameState = GetGameState();
+        gameState.Transient->ActionQueue.emplace(tick, std::move(ga), gameState.Transient->NextActionId++);
     }
 
     void ProcessQueue()
@@ -101,12 +75,14 @@ namespace OpenRCT2::GameActions
             return;
         }
 
-        const uint32_t currentTick = GetGameState().CurrentTicks;
+        auto& gameState = GetGameState();
+        const uint32_t currentTick = gameState.CurrentTicks;
+        auto& actionQueue = gameState.Transient->ActionQueue;
 
-        while (_actionQueue.begin() != _actionQueue.end())
+        while (actionQueue.begin() != actionQueue.end())
         {
             // run all the game commands at the current tick
-            const QueuedGameAction& queued = *_actionQueue.begin();
+            const QueuedGameAction& queued = *actionQueue.begin();
 
             if (NetworkGetMode() == NETWORK_MODE_CLIENT)
             {
@@ -151,13 +127,13 @@ namespace OpenRCT2::GameActions
                 NetworkSendGameAction(action);
             }
 
-            _actionQueue.erase(_actionQueue.begin());
+            actionQueue.erase(actionQueue.begin());
         }
     }
 
     void ClearQueue()
     {
-        _actionQueue.clear();
+        GetGameState().Transient->ActionQueue.clear();
     }
 
     GameAction::Ptr Clone(const GameAction* action)
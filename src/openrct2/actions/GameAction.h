@@ -266,6 +266,32 @@ namespace OpenRCT2::GameActions
 {
     using GameActionFactory = GameAction* (*)();
 
+    struct QueuedGameAction
+    {
+        uint32_t tick;
+        uint32_t uniqueId;
+        GameAction::Ptr action;
+
+        explicit QueuedGameAction(uint32_t t, std::unique_ptr<GameAction>&& ga, uint32_t id)
+            : tick(t)
+            , uniqueId(id)
+            , action(std::move(ga))
+        {
+        }
+
+        bool operator<(const QueuedGameAction& comp) const
+        {
+            // First sort by tick
+            if (tick < comp.tick)
+                return true;
+            if (tick > comp.tick)
+                return false;
+
+            // If the ticks are equal sort by commandIndex
+            return uniqueId < comp.uniqueId;
+        }
+    };
+
     bool IsValidId(uint32_t id);
     const char* GetName(GameCommand id);
 
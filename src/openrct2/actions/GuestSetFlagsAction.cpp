@@ -13,6 +13,7 @@
 #include "../Diagnostic.h"
 #include "../OpenRCT2.h"
 #include "../entity/EntityRegistry.h"
+#include "../windows/Intent.h"
 
 using namespace OpenRCT2;
 
@@ -62,5 +63,9 @@ GameActions::Result GuestSetFlagsAction::Execute() const
 
     peep->PeepFlags = _newFlags;
 
+    auto intent = Intent(INTENT_ACTION_UPDATE_GUEST_LIST_ENTRY);
+    intent.PutExtra(INTENT_EXTRA_PEEP_ID, _peepId);
+    ContextBroadcastIntent(&intent);
+
     return GameActions::Result();
 }
@@ -98,7 +98,8 @@ GameActions::Result GuestSetNameAction::Execute() const
 
     GfxInvalidateScreen();
 
-    auto intent = Intent(INTENT_ACTION_REFRESH_GUEST_LIST);
+    auto intent = Intent(INTENT_ACTION_UPDATE_GUEST_LIST_ENTRY);
+    intent.PutExtra(INTENT_EXTRA_PEEP_ID, _spriteIndex);
     ContextBroadcastIntent(&intent);
 
     auto res = GameActions::Result();
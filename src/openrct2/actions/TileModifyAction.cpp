@@ -11,6 +11,8 @@
 
 #include "../Context.h"
 #include "../Diagnostic.h"
+#include "../GameState.h"
+#include "../GameStateTransient.h"
 #include "../windows/Intent.h"
 #include "../world/TileInspector.h"
 
@@ -249,6 +251,8 @@ GameActions::Result TileModifyAction::QueryExecute(bool isExecuting) const
 
     if (isExecuting)
     {
+        // Any of the modifications can change where guests may walk
+        GetGameState().Transient->PathFlowFields.Clear();
         MapInvalidateTileFull(_loc);
         auto intent = Intent(INTENT_ACTION_TILE_MODIFY);
         ContextBroadcastIntent(&intent);
@@ -118,6 +118,8 @@ namespace OpenRCT2::CommandLine
     extern const CommandLineCommand SpriteCommands[];
     extern const CommandLineCommand SimulateCommands[];
     extern const CommandLineCommand ParkInfoCommands[];
+    extern const CommandLineCommand MapGenCommands[];
+    extern const CommandLineCommand ReplayCommands[];
 
     extern const CommandLineExample RootExamples[];
 
@@ -13,20 +13,50 @@
 #include "../OpenRCT2.h"
 #include "../ParkImporter.h"
 #include "../core/Console.hpp"
+#include "../core/File.h"
+#include "../core/FileScanner.h"
+#include "../core/FileStream.h"
 #include "../core/Path.hpp"
+#include "../core/String.hpp"
+#include "../core/Timer.hpp"
 #include "../interface/Window.h"
 #include "../object/ObjectManager.h"
 #include "../park/ParkFile.h"
+#include "../rct12/SawyerChunkReader.h"
+#include "../rct2/RCT2.h"
 #include "../scenario/Scenario.h"
 #include "CommandLine.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <deque>
+#include <future>
 #include <memory>
+#include <thread>
+#include <vector>
 
 using namespace OpenRCT2;
 
+struct ConvertJob
+{
+    u8string SourcePath;
+    u8string DestinationPath;
+};
+
+struct LoadedPark
+{
+    std::unique_ptr<IParkImporter> Importer;
+    std::unique_ptr<ParkLoadResult> Result;
+    std::string Error;
+    float LoadTime{};
+};
+
 static void WriteConvertFromAndToMessage(FileExtension sourceFileType, FileExtension destinationFileType);
 static u8string GetFileTypeFriendlyName(FileExtension fileType);
+static bool IsBatchSource(const u8string& sourcePath);
+static exitcode_t HandleBatchConvert(const u8string& sourcePath, const u8string& destinationPath);
+static void ConvertLoadedPark(
+    IParkImporter& importer, const ParkLoadResult& loadResult, FileExtension sourceFileType, const u8string& destinationPath);
 
 exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerator)
 {
@@ -56,6 +86,11 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerato
     }
 
     const auto destinationPath = Path::GetAbsolute(rawDestinationPath);
+    if (IsBatchSource(sourcePath))
+    {
+        return HandleBatchConvert(sourcePath, destinationPath);
+    }
+
     auto destinationFileType = GetFileExtensionType(destinationPath.c_str());
 
     // Validate target type
@@ -92,18 +127,11 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerato
     auto context = OpenRCT2::CreateContext();
     context->Initialise();
 
-    auto& objManager = context->GetObjectManager();
-    auto& gameState = GetGameState();
-
     try
     {
         auto importer = ParkImporter::Create(sourcePath);
         auto loadResult = importer->Load(sourcePath.c_str());
-
-        objManager.LoadObjects(loadResult.RequiredObjects);
-
-        // TODO: Have a separate GameState and exchange once loaded.
-        importer->Import(gameState);
+        ConvertLoadedPark(*importer, loadResult, sourceFileType, destinationPath);
     }
     catch (const std::exception& ex)
     {
@@ -111,21 +139,157 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerato
         return EXITCODE_FAIL;
     }
 
+    Console::WriteLine("Conversion successful!");
+    return EXITCODE_OK;
+}
+
+static void ConvertLoadedPark(
+    IParkImporter& importer, const ParkLoadResult& loadResult, FileExtension sourceFileType, const u8string& destinationPath)
+{
+    auto& objManager = GetContext()->GetObjectManager();
+    auto& gameState = GetGameState();
+
+    objManager.LoadObjects(loadResult.RequiredObjects);
+
+    // TODO: Have a separate GameState and exchange once loaded.
+    importer.Import(gameState);
+
     if (sourceFileType == FileExtension::SC4 || sourceFileType == FileExtension::SC6)
     {
         // We are converting a scenario, so reset the park
         ScenarioBegin(gameState);
     }
 
+    auto exporter = std::make_unique<ParkFileExporter>();
+
+    // HACK remove the main window so it saves the park with the
+    //      correct initial view
+    WindowCloseByClass(WindowClass::MainWindow);
+
+    exporter->Export(gameState, destinationPath);
+}
+
+static bool IsConvertibleSourceType(FileExtension fileType)
+{
+    switch (fileType)
+    {
+        case FileExtension::SC4:
+        case FileExtension::SV4:
+        case FileExtension::SC6:
+        case FileExtension::SV6:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * A batch is either a directory, which is scanned recursively, or a manifest file with one source path per line. A
+ * manifest line may name its destination after a tab, otherwise the park is written to the destination directory.
+ */
+static bool IsBatchSource(const u8string& sourcePath)
+{
+    return Path::DirectoryExists(sourcePath) || String::IEquals(Path::GetExtension(sourcePath), ".txt");
+}
+
+static std::vector<ConvertJob> GetBatchJobs(const u8string& sourcePath, const u8string& destinationDirectory)
+{
+    std::vector<ConvertJob> jobs;
+    if (Path::DirectoryExists(sourcePath))
+    {
+        auto scanner = Path::ScanDirectory(Path::Combine(sourcePath, "*.sc4;*.sv4;*.sc6;*.sv6"), true);
+        while (scanner->Next())
+        {
+            auto destination = Path::WithExtension(Path::Combine(destinationDirectory, scanner->GetPathRelative()), ".park");
+            jobs.push_back({ scanner->GetPath(), std::move(destination) });
+        }
+        std::sort(jobs.begin(), jobs.end(), [](const ConvertJob& a, const ConvertJob& b) {
+            return a.SourcePath < b.SourcePath;
+        });
+        return jobs;
+    }
+
+    const auto manifestDirectory = Path::GetDirectory(sourcePath);
+    for (const auto& rawLine : File::ReadAllLines(sourcePath))
+    {
+        auto line = String::Trim(rawLine);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        ConvertJob job;
+        auto tab = line.find('\t');
+        job.SourcePath = String::Trim(line.substr(0, tab));
+        if (!Path::IsAbsolute(job.SourcePath))
+            job.SourcePath = Path::Combine(manifestDirectory, job.SourcePath);
+
+        if (tab != std::string::npos)
+        {
+            job.DestinationPath = String::Trim(line.substr(tab + 1));
+            if (!Path::IsAbsolute(job.DestinationPath))
+                job.DestinationPath = Path::Combine(destinationDirectory, job.DestinationPath);
+        }
+        else
+        {
+            job.DestinationPath = Path::Combine(
+                destinationDirectory, Path::GetFileNameWithoutExtension(job.SourcePath) + ".park");
+        }
+        jobs.push_back(std::move(job));
+    }
+    return jobs;
+}
+
+/**
+ * SV6 and SC6 files can carry packed objects, which are added to the object repository while loading. That is the
+ * only part of loading that writes shared state, so those files are loaded once up front before any worker starts.
+ */
+static bool HasPackedObjects(const u8string& path)
+{
+    auto fileType = GetFileExtensionType(path);
+    if (fileType != FileExtension::SC6 && fileType != FileExtension::SV6)
+        return false;
+
     try
     {
-        auto exporter = std::make_unique<ParkFileExporter>();
+        auto fs = FileStream(path, FILE_MODE_OPEN);
+        auto chunkReader = SawyerChunkReader(&fs);
+        RCT2::S6Header header{};
+        chunkReader.ReadChunk(&header, sizeof(header));
+        return header.NumPackedObjects != 0;
+    }
+    catch (const std::exception&)
+    {
+        // Let the real load report the error
+        return false;
+    }
+}
 
-        // HACK remove the main window so it saves the park with the
-        //      correct initial view
-        WindowCloseByClass(WindowClass::MainWindow);
+static LoadedPark LoadPark(const u8string& path)
+{
+    LoadedPark result;
+    Timer timer;
+    try
+    {
+        result.Importer = ParkImporter::Create(path);
+        result.Result = std::make_unique<ParkLoadResult>(result.Importer->Load(path));
+    }
+    catch (const std::exception& ex)
+    {
+        result.Error = ex.what();
+    }
+    result.LoadTime = timer.GetElapsedTime().count();
+    return result;
+}
 
-        exporter->Export(gameState, destinationPath);
+/**
+ * Decoding a park is independent of the game state, so it runs on worker threads while the calling thread imports
+ * and exports the previously decoded parks one at a time through the single global game state.
+ */
+static exitcode_t HandleBatchConvert(const u8string& sourcePath, const u8string& destinationPath)
+{
+    std::vector<ConvertJob> jobs;
+    try
+    {
+        jobs = GetBatchJobs(sourcePath, destinationPath);
     }
     catch (const std::exception& ex)
     {
@@ -133,7 +297,90 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerato
         return EXITCODE_FAIL;
     }
 
-    Console::WriteLine("Conversion successful!");
+    if (jobs.empty())
+    {
+        Console::Error::WriteLine("No parks to convert.");
+        return EXITCODE_FAIL;
+    }
+
+    Timer totalTimer;
+    gOpenRCT2Headless = true;
+    auto context = OpenRCT2::CreateContext();
+    context->Initialise();
+
+    for (const auto& job : jobs)
+    {
+        if (HasPackedObjects(job.SourcePath))
+        {
+            LoadPark(job.SourcePath);
+        }
+    }
+
+    const size_t maxInFlight = std::max<size_t>(1, std::thread::hardware_concurrency());
+    std::deque<std::future<LoadedPark>> inFlight;
+    size_t nextJob = 0;
+    auto queueLoads = [&]() {
+        while (inFlight.size() < maxInFlight && nextJob < jobs.size())
+        {
+            inFlight.push_back(std::async(std::launch::async, LoadPark, jobs[nextJob].SourcePath));
+            nextJob++;
+        }
+    };
+
+    std::vector<size_t> failures;
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        queueLoads();
+        auto loaded = inFlight.front().get();
+        inFlight.pop_front();
+        queueLoads();
+
+        const auto& job = jobs[i];
+        Timer convertTimer;
+        if (loaded.Error.empty())
+        {
+            auto sourceFileType = GetFileExtensionType(job.SourcePath);
+            try
+            {
+                if (!IsConvertibleSourceType(sourceFileType))
+                    throw std::runtime_error("Only conversion from .SC4, .SV4, .SC6 or .SV6 is supported.");
+
+                Path::CreateDirectory(Path::GetDirectory(job.DestinationPath));
+                ConvertLoadedPark(*loaded.Importer, *loaded.Result, sourceFileType, job.DestinationPath);
+            }
+            catch (const std::exception& ex)
+            {
+                loaded.Error = ex.what();
+            }
+        }
+
+        const auto convertTime = convertTimer.GetElapsedTime().count();
+        if (loaded.Error.empty())
+        {
+            Console::WriteLine(
+                "[%zu/%zu] OK    load %.3f s, convert %.3f s: %s", i + 1, jobs.size(), loaded.LoadTime, convertTime,
+                job.SourcePath.c_str());
+        }
+        else
+        {
+            failures.push_back(i);
+            Console::Error::WriteLine(
+                "[%zu/%zu] FAIL  %s: %s", i + 1, jobs.size(), job.SourcePath.c_str(), loaded.Error.c_str());
+        }
+    }
+
+    Console::WriteLine(
+        "Converted %zu of %zu parks in %.3f s.", jobs.size() - failures.size(), jobs.size(),
+        totalTimer.GetElapsedTime().count());
+    if (!failures.empty())
+    {
+        Console::Error::WriteLine("Failed to convert:");
+        for (auto index : failures)
+        {
+            Console::Error::WriteLine("  %s", jobs[index].SourcePath.c_str());
+        }
+        return EXITCODE_FAIL;
+    }
     return EXITCODE_OK;
 }
 
@@ -0,0 +1,148 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../EditorObjectSelectionSession.h"
+#include "../GameState.h"
+#include "../OpenRCT2.h"
+#include "../core/Console.hpp"
+#include "../core/Path.hpp"
+#include "../core/Timer.hpp"
+#include "../object/ObjectManager.h"
+#include "../object/ObjectRepository.h"
+#include "../scenario/Scenario.h"
+#include "../util/Util.h"
+#include "../world/Map.h"
+#include "../world/MapGen.h"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+
+using namespace OpenRCT2;
+
+static int32_t _mapSize = 150;
+static int32_t _seed = -1;
+static int32_t _baseHeight = 12;
+static int32_t _waterLevel = 6;
+static int32_t _simplexLow = 6;
+static int32_t _simplexHigh = 10;
+static int32_t _simplexBaseFrequency = 60;
+static int32_t _simplexOctaves = 4;
+static bool _noTrees = false;
+
+// clang-format off
+static constexpr CommandLineOptionDefinition MapGenOptionsDef[]
+{
+    { CMDLINE_TYPE_INTEGER, &_mapSize,              NAC, "size",        "width and length of the map in tiles (default 150)" },
+    { CMDLINE_TYPE_INTEGER, &_seed,                 NAC, "seed",        "seed for the random generator (default random)" },
+    { CMDLINE_TYPE_INTEGER, &_baseHeight,           NAC, "base-height", "base land height (default 12)" },
+    { CMDLINE_TYPE_INTEGER, &_waterLevel,           NAC, "water-level", "water level (default 6)" },
+    { CMDLINE_TYPE_INTEGER, &_simplexLow,           NAC, "low",         "lowest noise height (default 6)" },
+    { CMDLINE_TYPE_INTEGER, &_simplexHigh,          NAC, "high",        "highest noise height (default 10)" },
+    { CMDLINE_TYPE_INTEGER, &_simplexBaseFrequency, NAC, "frequency",   "base noise frequency in hundredths (default 60)" },
+    { CMDLINE_TYPE_INTEGER, &_simplexOctaves,       NAC, "octaves",     "number of noise octaves (default 4)" },
+    { CMDLINE_TYPE_SWITCH,  &_noTrees,              NAC, "no-trees",    "do not place trees" },
+    OptionTableEnd
+};
+
+static exitcode_t HandleMapGen(CommandLineArgEnumerator* argEnumerator);
+
+const CommandLineCommand CommandLine::MapGenCommands[]
+{
+    // Main commands
+    DefineCommand("", "<output_park>", MapGenOptionsDef, HandleMapGen),
+    CommandTableEnd
+};
+// clang-format on
+
+static void LoadDefaultObjects()
+{
+    // Select the same objects a new scenario starts with, so all generator features are available
+    gScreenFlags = SCREEN_FLAGS_SCENARIO_EDITOR;
+    Sub6AB211();
+
+    auto& objectManager = GetContext()->GetObjectManager();
+    const auto numItems = ObjectRepositoryGetItemsCount();
+    const auto* items = ObjectRepositoryGetItems();
+    for (size_t i = 0; i < numItems; i++)
+    {
+        if (_objectSelectionFlags[i] & ObjectSelectionFlags::Selected)
+        {
+            auto descriptor = ObjectEntryDescriptor(items[i]);
+            if (objectManager.GetLoadedObject(descriptor) == nullptr && objectManager.LoadObject(descriptor) == nullptr)
+            {
+                Console::Error::WriteLine("Failed to load object %s", std::string(descriptor.GetName()).c_str());
+            }
+        }
+    }
+    FinishObjectSelection();
+    EditorObjectFlagsFree();
+}
+
+static exitcode_t HandleMapGen(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 1)
+    {
+        Console::Error::WriteLine("Missing argument <output_park>.");
+        return EXITCODE_FAIL;
+    }
+
+    const auto outputPath = Path::GetAbsolute(argv[0]);
+    const auto mapSize = std::clamp<int32_t>(_mapSize, kMinimumMapSizeTechnical, kMaximumMapSizeTechnical);
+    const auto seed = _seed >= 0 ? static_cast<uint32_t>(_seed) : std::random_device{}();
+
+    gOpenRCT2Headless = true;
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    auto& gameState = GetGameState();
+    gameStateInitAll(gameState, { mapSize, mapSize });
+    LoadDefaultObjects();
+
+    MapGenSettings mapgenSettings{};
+    mapgenSettings.mapSize = { mapSize, mapSize };
+    mapgenSettings.height = _baseHeight;
+    mapgenSettings.water_level = _waterLevel + kMinimumWaterHeight;
+    mapgenSettings.floor = -1;
+    mapgenSettings.wall = -1;
+    mapgenSettings.trees = _noTrees ? 0 : 1;
+    mapgenSettings.simplex_low = _simplexLow;
+    mapgenSettings.simplex_high = _simplexHigh;
+    mapgenSettings.simplex_base_freq = static_cast<float>(_simplexBaseFrequency) / 100.00f;
+    mapgenSettings.simplex_octaves = _simplexOctaves;
+
+    // The generator draws all its random numbers from this thread
+    UtilSrand(seed);
+
+    Timer timer;
+    MapGenGenerate(&mapgenSettings);
+    const auto generateTime = timer.GetElapsedTimeAndRestart().count();
+
+    gameState.ScenarioFileName = Path::GetFileName(outputPath);
+    // Save as a landscape, so the park opens in the scenario editor
+    if (!ScenarioSave(gameState, outputPath, 2))
+    {
+        Console::Error::WriteLine("Failed to save %s", outputPath.c_str());
+        return EXITCODE_FAIL;
+    }
+    const auto saveTime = timer.GetElapsedTime().count();
+
+    Console::WriteLine(
+        "Generated a %dx%d map with seed %u in %.3f s, saved in %.3f s.", mapSize, mapSize, seed, generateTime, saveTime);
+    return EXITCODE_OK;
+}
@@ -0,0 +1,175 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../GameState.h"
+#include "../OpenRCT2.h"
+#include "../ReplayManager.h"
+#include "../core/Console.hpp"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
+#include "../core/Timer.hpp"
+#include "../platform/Platform.h"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static int32_t _jobs = 0;
+static int32_t _segment = -1;
+
+// clang-format off
+static constexpr CommandLineOptionDefinition ReplayVerifyOptionsDef[]
+{
+    { CMDLINE_TYPE_INTEGER, &_jobs,    'j', "jobs",    "number of segments to verify at once (default: one per core)" },
+    { CMDLINE_TYPE_INTEGER, &_segment, NAC, "segment", "only verify the given segment" },
+    OptionTableEnd
+};
+
+static exitcode_t HandleReplayVerify(CommandLineArgEnumerator* argEnumerator);
+
+const CommandLineCommand CommandLine::ReplayCommands[]
+{
+    // Main commands
+    DefineCommand("verify", "<replay>", ReplayVerifyOptionsDef, HandleReplayVerify),
+    CommandTableEnd
+};
+// clang-format on
+
+struct SegmentResult
+{
+    bool Passed{};
+    double Time{};
+};
+
+static bool PlaySegment(IReplayManager& replayManager, const u8string& replayPath, uint32_t segment)
+{
+    if (!replayManager.StartSegmentPlayback(replayPath, segment))
+        return false;
+
+    while (replayManager.IsReplaying())
+    {
+        gameStateUpdateLogic();
+        if (replayManager.IsPlaybackStateMismatching())
+        {
+            replayManager.StopPlayback();
+            return false;
+        }
+    }
+    return !replayManager.IsPlaybackStateMismatching();
+}
+
+static SegmentResult RunSegmentProcess(const u8string& replayPath, uint32_t segment)
+{
+    Timer timer;
+    auto command = String::StdFormat(
+        "\"%s\" replay verify \"%s\" --segment %u", Platform::GetCurrentExecutablePath().c_str(), replayPath.c_str(),
+        segment);
+
+    // Capture the output so the workers do not write over each other
+    std::string output;
+    const auto exitCode = Platform::Execute(command, &output);
+    return { exitCode == 0, timer.GetElapsedTime().count() };
+}
+
+static exitcode_t HandleReplayVerify(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 1)
+    {
+        Console::Error::WriteLine("Missing argument <replay>.");
+        return EXITCODE_FAIL;
+    }
+
+    const auto replayPath = Path::GetAbsolute(argv[0]);
+
+    gOpenRCT2Headless = true;
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    auto* replayManager = context->GetReplayManager();
+    if (_segment >= 0)
+    {
+        return PlaySegment(*replayManager, replayPath, static_cast<uint32_t>(_segment)) ? EXITCODE_OK : EXITCODE_FAIL;
+    }
+
+    ReplayRecordInfo info{};
+    if (!replayManager->GetReplayInfo(replayPath, info))
+    {
+        Console::Error::WriteLine("Unable to read replay %s", replayPath.c_str());
+        return EXITCODE_FAIL;
+    }
+
+    const uint32_t numSegments = info.NumKeyframes + 1;
+    size_t maxInFlight = _jobs > 0 ? static_cast<size_t>(_jobs) : std::max<size_t>(1, std::thread::hardware_concurrency());
+#ifdef _WIN32
+    // Platform::Execute is not available, play the segments one after the other instead
+    maxInFlight = 1;
+#endif
+
+    Console::WriteLine(
+        "Verifying %s: %u ticks, %u checksums, %u segments.", replayPath.c_str(), info.Ticks, info.NumChecksums,
+        numSegments);
+
+    Timer totalTimer;
+    std::vector<SegmentResult> results(numSegments);
+    if (maxInFlight > 1 && numSegments > 1)
+    {
+        // Each segment needs its own game state, which only a separate process can provide
+        std::deque<std::future<SegmentResult>> inFlight;
+        uint32_t nextSegment = 0;
+        auto queueSegments = [&]() {
+            while (inFlight.size() < maxInFlight && nextSegment < numSegments)
+            {
+                inFlight.push_back(std::async(std::launch::async, RunSegmentProcess, replayPath, nextSegment));
+                nextSegment++;
+            }
+        };
+
+        for (uint32_t i = 0; i < numSegments; i++)
+        {
+            queueSegments();
+            results[i] = inFlight.front().get();
+            inFlight.pop_front();
+        }
+    }
+    else
+    {
+        for (uint32_t i = 0; i < numSegments; i++)
+        {
+            Timer timer;
+            results[i].Passed = PlaySegment(*replayManager, replayPath, i);
+            results[i].Time = timer.GetElapsedTime().count();
+        }
+    }
+
+    uint32_t numFailed = 0;
+    for (uint32_t i = 0; i < numSegments; i++)
+    {
+        Console::WriteLine("[%u/%u] %s  %.3f s", i + 1, numSegments, results[i].Passed ? "OK  " : "FAIL", results[i].Time);
+        if (!results[i].Passed)
+            numFailed++;
+    }
+
+    Console::WriteLine(
+        "%u of %u segments passed in %.3f s.", numSegments - numFailed, numSegments, totalTimer.GetElapsedTime().count());
+    return numFailed == 0 ? EXITCODE_OK : EXITCODE_FAIL;
+}
@@ -13,21 +13,36 @@
 #include "../OpenRCT2.h"
 #include "../config/ConfigTypes.h"
 #include "../core/Console.hpp"
+#include "../core/Timer.hpp"
+#include "../entity/EntityList.h"
 #include "../entity/EntityRegistry.h"
+#include "../entity/Guest.h"
 #include "../network/network.h"
+#include "../peep/GuestPathfinding.h"
 #include "../platform/Platform.h"
+#include "../world/Footpath.h"
+#include "../world/Map.h"
+#include "../world/TileElementsView.h"
 #include "CommandLine.hpp"
 
 #include <cstdlib>
 #include <memory>
+#include <vector>
 
 using namespace OpenRCT2;
 
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleSimulateExodus(CommandLineArgEnumerator* argEnumerator);
 
-const CommandLineCommand CommandLine::SimulateCommands[]{ // Main commands
-                                                          DefineCommand("", "<ticks>", nullptr, HandleSimulate), CommandTableEnd
+// clang-format off
+const CommandLineCommand CommandLine::SimulateCommands[]
+{
+    // Main commands
+    DefineCommand("exodus", "<park> <guests> <ticks>", nullptr, HandleSimulateExodus),
+    DefineCommand("",       "<ticks>",                 nullptr, HandleSimulate      ),
+    CommandTableEnd
 };
+// clang-format on
 
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 {
@@ -72,3 +87,98 @@ static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 
     return EXITCODE_OK;
 }
+
+/**
+ * Places guests on the paths inside the park, one per path in turn, until the park has the given number of guests.
+ */
+static void AddGuestsOnPaths(uint32_t numGuests)
+{
+    std::vector<CoordsXYZ> pathLocations;
+    for (const auto& tile : MapGetTilesWithElementTypes({ TileElementType::Path }))
+    {
+        const auto coords = tile.ToCoordsXY();
+        if (!MapIsLocationInPark(coords))
+            continue;
+        for (auto* pathElement : TileElementsView<PathElement>(coords))
+        {
+            if (!pathElement->IsGhost() && !pathElement->IsQueue() && !pathElement->IsSloped())
+            {
+                pathLocations.emplace_back(coords.ToTileCentre(), pathElement->GetBaseZ());
+            }
+        }
+    }
+    if (pathLocations.empty())
+        return;
+
+    auto& gameState = GetGameState();
+    for (size_t i = 0; gameState.NumGuestsInPark < numGuests; i++)
+    {
+        auto* guest = Guest::Generate(pathLocations[i % pathLocations.size()]);
+        if (guest == nullptr)
+            break;
+        guest->OutsideOfPark = false;
+        guest->ParkEntryTime = gameState.CurrentTicks;
+        IncrementGuestsInPark();
+    }
+}
+
+/**
+ * Times guests finding their way out of a park at closing time, first with the heuristic search and then with the
+ * flow fields. The park is filled up to the given number of guests, all of which are sent home.
+ */
+static exitcode_t HandleSimulateExodus(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 3)
+    {
+        Console::Error::WriteLine("Missing arguments <park> <guests> <ticks>.");
+        return EXITCODE_FAIL;
+    }
+
+    const char* inputPath = argv[0];
+    uint32_t numGuests = atol(argv[1]);
+    uint32_t ticks = atol(argv[2]);
+
+    // Not started as a server, as the flow fields are never used in network games
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    for (bool useFlowFields : { false, true })
+    {
+        if (!context->LoadParkFromFile(inputPath))
+        {
+            return EXITCODE_FAIL;
+        }
+
+        AddGuestsOnPaths(numGuests);
+        for (auto* guest : EntityList<Guest>())
+        {
+            if (!guest->OutsideOfPark)
+            {
+                PeepLeavePark(guest);
+            }
+        }
+
+        gPeepPathFindFlowFields = useFlowFields;
+        const auto guestsAtStart = GetGameState().NumGuestsInPark;
+        Timer timer;
+        for (uint32_t i = 0; i < ticks; i++)
+        {
+            gameStateUpdateLogic();
+        }
+        Console::WriteLine(
+            "%s: %u ticks in %.3f s, %u of %u guests still in the park.", useFlowFields ? "Flow fields" : "Heuristic search",
+            ticks, timer.GetElapsedTime().count(), GetGameState().NumGuestsInPark, guestsAtStart);
+    }
+    gPeepPathFindFlowFields.reset();
+
+    return EXITCODE_OK;
+}
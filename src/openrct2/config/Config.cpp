@@ -221,6 +221,9 @@ namespace OpenRCT2::Config
 #else
             model->MultiThreading = reader->GetBoolean("multithreading", true);
 #endif // _DEBUG
+            model->ThreadedSimulation = reader->GetBoolean("threaded_simulation", false);
+            model->ParallelGuestUpdate = reader->GetBoolean("parallel_guest_update", false);
+            model->FlowFieldPathfinding = reader->GetBoolean("flow_field_pathfinding", false);
             model->TrapCursor = reader->GetBoolean("trap_cursor", false);
             model->AutoOpenShops = reader->GetBoolean("auto_open_shops", false);
             model->ScenarioSelectMode = reader->GetInt32("scenario_select_mode", SCENARIO_SELECT_MODE_ORIGIN);
@@ -307,6 +310,9 @@ namespace OpenRCT2::Config
         writer->WriteBoolean("infer_display_dpi", model->InferDisplayDPI);
         writer->WriteBoolean("show_fps", model->ShowFPS);
         writer->WriteBoolean("multithreading", model->MultiThreading);
+        writer->WriteBoolean("threaded_simulation", model->ThreadedSimulation);
+        writer->WriteBoolean("parallel_guest_update", model->ParallelGuestUpdate);
+        writer->WriteBoolean("flow_field_pathfinding", model->FlowFieldPathfinding);
         writer->WriteBoolean("trap_cursor", model->TrapCursor);
         writer->WriteBoolean("auto_open_shops", model->AutoOpenShops);
         writer->WriteInt32("scenario_select_mode", model->ScenarioSelectMode);
@@ -42,6 +42,9 @@ namespace OpenRCT2::Config
         bool UseVSync;
         bool ShowFPS;
         std::atomic_uint8_t MultiThreading;
+        bool ThreadedSimulation;
+        bool ParallelGuestUpdate;
+        bool FlowFieldPathfinding;
         bool MinimizeFullscreenFocusLoss;
         bool DisableScreensaver;
 
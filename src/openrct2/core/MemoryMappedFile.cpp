@@ -0,0 +1,130 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "MemoryMappedFile.h"
+
+#include "../Diagnostic.h"
+#include "FileStream.h"
+#include "String.hpp"
+
+#ifdef _WIN32
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace OpenRCT2
+{
+    MemoryMappedFile::MemoryMappedFile(u8string_view path)
+    {
+        auto pathStr = u8string(path);
+        if (!TryMap(pathStr))
+        {
+            ReadIntoBuffer(pathStr);
+        }
+    }
+
+    MemoryMappedFile::~MemoryMappedFile()
+    {
+        if (!_mapped)
+        {
+            return;
+        }
+#ifdef _WIN32
+        UnmapViewOfFile(_data);
+        CloseHandle(static_cast<HANDLE>(_mapping));
+        CloseHandle(static_cast<HANDLE>(_file));
+#else
+        munmap(const_cast<uint8_t*>(_data), _size);
+#endif
+    }
+
+    bool MemoryMappedFile::TryMap(const u8string& path)
+    {
+#ifdef _WIN32
+        auto pathW = String::ToWideChar(path);
+        auto file = CreateFileW(
+            pathW.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0
+            || static_cast<uint64_t>(fileSize.QuadPart) > SIZE_MAX)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view == nullptr)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        _file = file;
+        _mapping = mapping;
+        _data = static_cast<const uint8_t*>(view);
+        _size = static_cast<size_t>(fileSize.QuadPart);
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+        {
+            return false;
+        }
+
+        // Only regular files can be mapped, and mapping an empty file is an error.
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode) || fileStat.st_size <= 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        auto size = static_cast<size_t>(fileStat.st_size);
+        void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        // The mapping keeps its own reference to the file.
+        close(fd);
+        if (view == MAP_FAILED)
+        {
+            return false;
+        }
+
+        _data = static_cast<const uint8_t*>(view);
+        _size = size;
+#endif
+        _mapped = true;
+        return true;
+    }
+
+    void MemoryMappedFile::ReadIntoBuffer(const u8string& path)
+    {
+        LOG_VERBOSE("Unable to map '%s', reading it into memory instead", path.c_str());
+
+        auto fs = FileStream(path, FILE_MODE_OPEN);
+        _size = static_cast<size_t>(fs.GetLength());
+        _buffer = fs.ReadArray<uint8_t>(_size);
+        _data = _buffer.get();
+    }
+} // namespace OpenRCT2
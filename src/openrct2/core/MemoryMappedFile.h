@@ -0,0 +1,66 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "StringTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace OpenRCT2
+{
+    /**
+     * A read-only view of an entire file. Where the platform supports it the file is mapped into memory so pages are
+     * only loaded on first access and are shared between every process mapping the same file. Otherwise the file is
+     * read into a private buffer.
+     */
+    class MemoryMappedFile final
+    {
+    private:
+        const uint8_t* _data = nullptr;
+        size_t _size = 0;
+        bool _mapped = false;
+        std::unique_ptr<uint8_t[]> _buffer;
+#ifdef _WIN32
+        void* _file = nullptr;
+        void* _mapping = nullptr;
+#endif
+
+    public:
+        explicit MemoryMappedFile(u8string_view path);
+        ~MemoryMappedFile();
+
+        MemoryMappedFile(const MemoryMappedFile&) = delete;
+        MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+        const uint8_t* GetData() const
+        {
+            return _data;
+        }
+
+        size_t GetSize() const
+        {
+            return _size;
+        }
+
+        /**
+         * Whether the file is backed by a mapping rather than a private copy.
+         */
+        bool IsMapped() const
+        {
+            return _mapped;
+        }
+
+    private:
+        bool TryMap(const u8string& path);
+        void ReadIntoBuffer(const u8string& path);
+    };
+} // namespace OpenRCT2
@@ -35,6 +35,9 @@ namespace OpenRCT2
 
         static constexpr uint32_t COMPRESSION_NONE = 0;
         static constexpr uint32_t COMPRESSION_GZIP = 1;
+        // Each chunk is compressed independently so a single chunk can be read without inflating the rest of the file.
+        // The chunk table then holds the offset and length of the compressed chunk data instead of the uncompressed data.
+        static constexpr uint32_t COMPRESSION_GZIP_CHUNKED = 2;
 
     private:
 #pragma pack(push, 1)
@@ -66,6 +69,7 @@ namespace OpenRCT2
         std::vector<ChunkEntry> _chunks;
         MemoryStream _buffer;
         ChunkEntry _currentChunk;
+        uint64_t _dataOffset{};
 
     public:
         OrcaStream(IStream& stream, const Mode mode)
@@ -83,6 +87,13 @@ namespace OpenRCT2
                     _chunks.push_back(entry);
                 }
 
+                if (_header.Compression == COMPRESSION_GZIP_CHUNKED)
+                {
+                    // Chunks are read and inflated on demand, see SeekChunk
+                    _dataOffset = _stream->GetPosition();
+                    return;
+                }
+
                 // Read compressed data into buffer (read in blocks)
                 _buffer = MemoryStream{};
                 uint8_t temp[2048];
@@ -130,6 +141,12 @@ namespace OpenRCT2
                 _header.CompressedSize = uncompressedSize;
                 _header.FNV1a = Crypt::FNV1a(uncompressedData, uncompressedSize);
 
+                if (_header.Compression == COMPRESSION_GZIP_CHUNKED)
+                {
+                    WriteChunked(uncompressedData);
+                    return;
+                }
+
                 // Compress data
                 std::optional<std::vector<uint8_t>> compressedBytes;
                 if (_header.Compression == COMPRESSION_GZIP)
@@ -210,6 +227,12 @@ namespace OpenRCT2
             const auto result = std::find_if(_chunks.begin(), _chunks.end(), [id](const ChunkEntry& e) { return e.Id == id; });
             if (result != _chunks.end())
             {
+                if (_header.Compression == COMPRESSION_GZIP_CHUNKED)
+                {
+                    LoadCompressedChunk(*result);
+                    return true;
+                }
+
                 const auto offset = result->Offset;
                 _buffer.SetPosition(offset);
                 return true;
@@ -217,6 +240,45 @@ namespace OpenRCT2
             return false;
         }
 
+        void LoadCompressedChunk(const ChunkEntry& entry)
+        {
+            std::vector<uint8_t> compressedData(static_cast<size_t>(entry.Length));
+            _stream->SetPosition(_dataOffset + entry.Offset);
+            _stream->Read(compressedData.data(), compressedData.size());
+
+            auto uncompressedData = Ungzip(compressedData.data(), compressedData.size());
+            _buffer.Clear();
+            _buffer.Write(uncompressedData.data(), uncompressedData.size());
+            _buffer.SetPosition(0);
+        }
+
+        void WriteChunked(const void* uncompressedData)
+        {
+            // Compress each chunk on its own and rewrite the chunk table to point at the compressed data
+            std::vector<std::vector<uint8_t>> compressedChunks;
+            compressedChunks.reserve(_chunks.size());
+            uint64_t compressedOffset = 0;
+            for (auto& chunk : _chunks)
+            {
+                const auto* chunkData = static_cast<const uint8_t*>(uncompressedData) + chunk.Offset;
+                auto& compressedChunk = compressedChunks.emplace_back(Gzip(chunkData, static_cast<size_t>(chunk.Length)));
+                chunk.Offset = compressedOffset;
+                chunk.Length = compressedChunk.size();
+                compressedOffset += chunk.Length;
+            }
+            _header.CompressedSize = compressedOffset;
+
+            _stream->WriteValue(_header);
+            for (const auto& chunk : _chunks)
+            {
+                _stream->WriteValue(chunk);
+            }
+            for (const auto& compressedChunk : compressedChunks)
+            {
+                _stream->Write(compressedChunk.data(), compressedChunk.size());
+            }
+        }
+
     public:
         class ChunkStream
         {
@@ -131,6 +131,8 @@ namespace OpenRCT2::Random
             s1 = r.s1;
         }
 
+        RotateEngine& operator=(const RotateEngine& r) = default;
+
         template<typename TSseq, typename = typename std::enable_if<!std::is_same<TSseq, RotateEngine>::value>::type>
         explicit RotateEngine(TSseq& seed_seq)
         {
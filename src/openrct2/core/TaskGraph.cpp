@@ -0,0 +1,152 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TaskGraph.h"
+
+#include "Timer.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace OpenRCT2
+{
+    TaskGraph::TaskId TaskGraph::AddTask(
+        std::string name, std::function<void()> fn, std::initializer_list<TaskId> dependencies)
+    {
+        auto id = _tasks.size();
+        for (auto dependency : dependencies)
+        {
+            if (dependency >= id)
+            {
+                throw std::out_of_range("Task dependency has not been added yet.");
+            }
+            _tasks[dependency].Dependents.push_back(id);
+        }
+
+        auto& task = _tasks.emplace_back();
+        task.Name = std::move(name);
+        task.Fn = std::move(fn);
+        task.NumDependencies = dependencies.size();
+        return id;
+    }
+
+    void TaskGraph::Run(size_t maxThreads)
+    {
+        Timer timer;
+
+        _timings.clear();
+        _timings.resize(_tasks.size());
+        for (size_t i = 0; i < _tasks.size(); i++)
+        {
+            _timings[i].Name = _tasks[i].Name;
+        }
+
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::deque<TaskId> ready;
+        std::vector<size_t> remainingDependencies(_tasks.size());
+        std::vector<bool> skipped(_tasks.size());
+        std::exception_ptr firstException;
+        size_t numFinished = 0;
+
+        for (size_t i = 0; i < _tasks.size(); i++)
+        {
+            remainingDependencies[i] = _tasks[i].NumDependencies;
+            if (remainingDependencies[i] == 0)
+            {
+                ready.push_back(i);
+            }
+        }
+
+        auto worker = [&]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true)
+            {
+                cond.wait(lock, [&]() { return !ready.empty() || numFinished == _tasks.size(); });
+                if (ready.empty())
+                {
+                    break;
+                }
+
+                auto id = ready.front();
+                ready.pop_front();
+
+                bool ran = false;
+                auto start = timer.GetElapsedTime().count();
+                if (!skipped[id])
+                {
+                    lock.unlock();
+                    try
+                    {
+                        _tasks[id].Fn();
+                        ran = true;
+                    }
+                    catch (...)
+                    {
+                        lock.lock();
+                        if (firstException == nullptr)
+                        {
+                            firstException = std::current_exception();
+                        }
+                        lock.unlock();
+                    }
+                    lock.lock();
+                }
+
+                auto& timing = _timings[id];
+                timing.Start = start;
+                timing.Duration = timer.GetElapsedTime().count() - start;
+                timing.Ran = ran;
+
+                for (auto dependent : _tasks[id].Dependents)
+                {
+                    if (!ran)
+                    {
+                        skipped[dependent] = true;
+                    }
+                    if (--remainingDependencies[dependent] == 0)
+                    {
+                        ready.push_back(dependent);
+                    }
+                }
+                numFinished++;
+                cond.notify_all();
+            }
+        };
+
+        if (maxThreads == 0)
+        {
+            maxThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        auto numThreads = std::min(maxThreads, _tasks.size());
+
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < numThreads; i++)
+        {
+            threads.emplace_back(worker);
+        }
+        // The calling thread does its share of the work too
+        worker();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        _totalTime = timer.GetElapsedTime().count();
+        if (firstException != nullptr)
+        {
+            std::rethrow_exception(firstException);
+        }
+    }
+} // namespace OpenRCT2
@@ -0,0 +1,77 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace OpenRCT2
+{
+    /**
+     * A set of named tasks with dependencies between them. When run, every task whose dependencies have finished is
+     * started straight away, so independent tasks run concurrently.
+     */
+    class TaskGraph
+    {
+    public:
+        using TaskId = size_t;
+
+        struct TaskTiming
+        {
+            std::string Name;
+            // Seconds from the start of Run
+            float Start{};
+            float Duration{};
+            bool Ran{};
+        };
+
+    private:
+        struct Task
+        {
+            std::string Name;
+            std::function<void()> Fn;
+            std::vector<TaskId> Dependents;
+            size_t NumDependencies{};
+        };
+
+        std::vector<Task> _tasks;
+        std::vector<TaskTiming> _timings;
+        float _totalTime{};
+
+    public:
+        /**
+         * Adds a task. Dependencies must refer to tasks that have already been added, which keeps the graph acyclic.
+         */
+        TaskId AddTask(std::string name, std::function<void()> fn, std::initializer_list<TaskId> dependencies = {});
+
+        /**
+         * Runs every task and waits for them all to finish. If a task throws, the tasks that depend on it are skipped
+         * and the first exception is rethrown once everything else has finished.
+         * @param maxThreads The maximum number of tasks to run at once, or 0 for the hardware concurrency.
+         */
+        void Run(size_t maxThreads = 0);
+
+        const std::vector<TaskTiming>& GetTimings() const
+        {
+            return _timings;
+        }
+
+        /**
+         * The wall time taken by the last call to Run, in seconds.
+         */
+        float GetTotalTime() const
+        {
+            return _totalTime;
+        }
+    };
+} // namespace OpenRCT2
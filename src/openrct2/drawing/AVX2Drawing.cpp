@@ -8,10 +8,12 @@
  *****************************************************************************/
 
 #include "../core/Guard.hpp"
+#include "../paint/Paint.h"
 #include "Drawing.h"
 
 #ifdef __AVX2__
 
+#    include <bit>
 #    include <immintrin.h>
 
 void MaskAvx2(
@@ -41,6 +43,177 @@ void MaskAvx2(
     }
 }
 
+size_t PaintSortCollectAvx2(
+    const PaintSortBounds& bounds, size_t begin, size_t end, const PaintStructBoundBox& initialBBox, uint8_t rotation,
+    uint32_t* matches)
+{
+    // Rotations 1 and 2 reverse the x comparisons, rotations 2 and 3 reverse the y comparisons.
+    const __m256i allSet = _mm256_set1_epi32(-1);
+    const __m256i flipX = (rotation == 1 || rotation == 2) ? allSet : _mm256_setzero_si256();
+    const __m256i flipY = (rotation == 2 || rotation == 3) ? allSet : _mm256_setzero_si256();
+    const __m256i keepX = _mm256_xor_si256(flipX, allSet);
+    const __m256i keepY = _mm256_xor_si256(flipY, allSet);
+
+    const __m256i initX = _mm256_set1_epi32(initialBBox.x);
+    const __m256i initY = _mm256_set1_epi32(initialBBox.y);
+    const __m256i initZ = _mm256_set1_epi32(initialBBox.z);
+    const __m256i initXEnd = _mm256_set1_epi32(initialBBox.x_end);
+    const __m256i initYEnd = _mm256_set1_epi32(initialBBox.y_end);
+    const __m256i initZEnd = _mm256_set1_epi32(initialBBox.z_end);
+
+    size_t count = 0;
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8)
+    {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bounds.X + i));
+        const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bounds.Y + i));
+        const __m256i z = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bounds.Z + i));
+        const __m256i xEnd = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bounds.XEnd + i));
+        const __m256i yEnd = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bounds.YEnd + i));
+        const __m256i zEnd = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bounds.ZEnd + i));
+        const __m256i neighbour = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bounds.NeighbourMask + i));
+
+        // initial.end >= current.start on each axis, inverted for reversed axes.
+        const __m256i beforeX = _mm256_xor_si256(_mm256_cmpgt_epi32(x, initXEnd), keepX);
+        const __m256i beforeY = _mm256_xor_si256(_mm256_cmpgt_epi32(y, initYEnd), keepY);
+        const __m256i beforeZ = _mm256_xor_si256(_mm256_cmpgt_epi32(z, initZEnd), allSet);
+        // initial.start < current.end on each axis, inverted for reversed axes.
+        const __m256i overlapX = _mm256_xor_si256(_mm256_cmpgt_epi32(xEnd, initX), flipX);
+        const __m256i overlapY = _mm256_xor_si256(_mm256_cmpgt_epi32(yEnd, initY), flipY);
+        const __m256i overlapZ = _mm256_cmpgt_epi32(zEnd, initZ);
+
+        const __m256i before = _mm256_and_si256(_mm256_and_si256(beforeX, beforeY), _mm256_and_si256(beforeZ, neighbour));
+        const __m256i overlap = _mm256_and_si256(_mm256_and_si256(overlapX, overlapY), overlapZ);
+        auto bits = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_andnot_si256(overlap, before))));
+        while (bits != 0)
+        {
+            matches[count++] = static_cast<uint32_t>(i + std::countr_zero(bits));
+            bits &= bits - 1;
+        }
+    }
+    return count + PaintSortCollectScalar(bounds, i, end, initialBBox, rotation, matches + count);
+}
+
+// Looks up 32 palette indices at once by shuffling each 16 entry slice of the palette and keeping the lanes whose
+// high nibble selects that slice.
+static __m256i PaletteLookupAvx2(const uint8_t* palette, __m256i indices)
+{
+    const __m256i lowMask = _mm256_set1_epi8(0x0F);
+    const __m256i low = _mm256_and_si256(indices, lowMask);
+    const __m256i high = _mm256_and_si256(_mm256_srli_epi16(indices, 4), lowMask);
+    __m256i result = _mm256_setzero_si256();
+    for (int32_t slice = 0; slice < 16; slice++)
+    {
+        const __m256i table = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(palette + (slice * 16))));
+        const __m256i select = _mm256_cmpeq_epi8(high, _mm256_set1_epi8(static_cast<char>(slice)));
+        result = _mm256_or_si256(result, _mm256_and_si256(_mm256_shuffle_epi8(table, low), select));
+    }
+    return result;
+}
+
+template<DrawBlendOp TBlendOp>
+static void BlitRowAvx2(const uint8_t* src, uint8_t* dst, size_t count, const PaletteMap& paletteMap)
+{
+    if constexpr ((TBlendOp & (BLEND_SRC | BLEND_DST)) != 0)
+    {
+        // Indices past the end of the map resolve to 0, leave those to the scalar path.
+        if (paletteMap.GetDataLength() < 256)
+        {
+            BlitRowScalar<TBlendOp>(src, dst, count, paletteMap);
+            return;
+        }
+    }
+
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m256i source = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i dest = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i pixel = source;
+        if constexpr ((TBlendOp & BLEND_SRC) != 0)
+        {
+            pixel = PaletteLookupAvx2(paletteMap.GetData(), source);
+        }
+        else if constexpr ((TBlendOp & BLEND_DST) != 0)
+        {
+            pixel = PaletteLookupAvx2(paletteMap.GetData(), dest);
+        }
+
+        // Transparent source pixels and pixels remapped to 0 keep the destination.
+        __m256i keep = _mm256_cmpeq_epi8(source, zero);
+        if constexpr ((TBlendOp & (BLEND_SRC | BLEND_DST)) != 0)
+        {
+            keep = _mm256_or_si256(keep, _mm256_cmpeq_epi8(pixel, zero));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_blendv_epi8(pixel, dest, keep));
+    }
+    BlitRowScalar<TBlendOp>(src + i, dst + i, count - i, paletteMap);
+}
+
+// Blends 8 pixels per iteration by gathering from the 2D blend table, index (src - 1) * 256 + dst.
+static void BlitRowBlendAvx2(const uint8_t* src, uint8_t* dst, size_t count, const PaletteMap& paletteMap)
+{
+    constexpr auto kBlendOp = BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST;
+
+    // The gather reads whole aligned dwords, which only stays within the map if its length is a multiple of 4.
+    const auto dataLength = paletteMap.GetDataLength();
+    if ((dataLength & 3) != 0)
+    {
+        BlitRowScalar<kBlendOp>(src, dst, count, paletteMap);
+        return;
+    }
+
+    const auto* table = reinterpret_cast<const int32_t*>(paletteMap.GetData());
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i length = _mm256_set1_epi32(static_cast<int32_t>(dataLength));
+    const __m256i byteMask = _mm256_set1_epi32(0xFF);
+    const __m256i alignMask = _mm256_set1_epi32(~3);
+    const __m256i packBytes = _mm256_setr_epi8(
+        0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1);
+    const __m256i packLanes = _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i source = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)));
+        const __m256i dest = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(dst + i)));
+        const __m256i index = _mm256_add_epi32(_mm256_slli_epi32(_mm256_sub_epi32(source, _mm256_set1_epi32(1)), 8), dest);
+
+        // Only gather lanes that are opaque and within the map, the rest resolve to 0 like PaletteMap::Blend.
+        const __m256i valid = _mm256_andnot_si256(_mm256_cmpeq_epi32(source, zero), _mm256_cmpgt_epi32(length, index));
+        const __m256i words = _mm256_mask_i32gather_epi32(
+            zero, table, _mm256_srli_epi32(_mm256_and_si256(index, alignMask), 2), valid, 4);
+        const __m256i shift = _mm256_slli_epi32(_mm256_and_si256(index, _mm256_set1_epi32(3)), 3);
+        const __m256i pixel = _mm256_and_si256(_mm256_srlv_epi32(words, shift), byteMask);
+
+        const __m256i keep = _mm256_or_si256(_mm256_xor_si256(valid, _mm256_set1_epi32(-1)), _mm256_cmpeq_epi32(pixel, zero));
+        const __m256i result = _mm256_blendv_epi8(pixel, dest, keep);
+        const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(result, packBytes), packLanes);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm256_castsi256_si128(packed));
+    }
+    BlitRowScalar<kBlendOp>(src + i, dst + i, count - i, paletteMap);
+}
+
+BlitRowFunc GetBlitRowAvx2(DrawBlendOp blendOp)
+{
+    switch (blendOp)
+    {
+        case BLEND_TRANSPARENT:
+            return BlitRowAvx2<BLEND_TRANSPARENT>;
+        case BLEND_TRANSPARENT | BLEND_SRC:
+            return BlitRowAvx2<BLEND_TRANSPARENT | BLEND_SRC>;
+        case BLEND_TRANSPARENT | BLEND_DST:
+            return BlitRowAvx2<BLEND_TRANSPARENT | BLEND_DST>;
+        case BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST:
+            return BlitRowBlendAvx2;
+        default:
+            return nullptr;
+    }
+}
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -54,4 +227,18 @@ void MaskAvx2(
     OpenRCT2::Guard::Fail("AVX2 function called on a CPU that doesn't support AVX2");
 }
 
+size_t PaintSortCollectAvx2(
+    const PaintSortBounds& bounds, size_t begin, size_t end, const PaintStructBoundBox& initialBBox, uint8_t rotation,
+    uint32_t* matches)
+{
+    OpenRCT2::Guard::Fail("AVX2 function called on a CPU that doesn't support AVX2");
+    return 0;
+}
+
+BlitRowFunc GetBlitRowAvx2(DrawBlendOp blendOp)
+{
+    OpenRCT2::Guard::Fail("AVX2 function called on a CPU that doesn't support AVX2");
+    return nullptr;
+}
+
 #endif // __AVX2__
@@ -47,6 +47,16 @@ template<DrawBlendOp TBlendOp> static void FASTCALL DrawBMPSpriteMinify(DrawPixe
     size_t srcLineWidth = zoomLevel.ApplyTo(g1.width);
     size_t dstLineWidth = zoomLevel.ApplyInversedTo(static_cast<size_t>(dpi.width)) + dpi.pitch;
     uint8_t zoom = zoomLevel.ApplyTo(1);
+    if (zoom == 1)
+    {
+        // Source and destination rows are both contiguous, hand whole rows to the row blitter.
+        const auto blitRow = GetBlitRowFunction(TBlendOp);
+        for (; height > 0 && width > 0; height--, src += srcLineWidth, dst += dstLineWidth)
+        {
+            blitRow(src, dst, width, paletteMap);
+        }
+        return;
+    }
     for (; height > 0; height -= zoom)
     {
         auto nextSrc = src + srcLineWidth;
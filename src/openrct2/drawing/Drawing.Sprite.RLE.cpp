@@ -8,10 +8,14 @@
  *****************************************************************************/
 
 #include "Drawing.h"
+#include "SpriteLodCache.h"
 
 #include <cassert>
 #include <cstring>
 
+// The vectorised row blitters work in blocks of 16 pixels, shorter runs are blitted inline instead of paying for the call.
+static constexpr int32_t kMinBlitRowLength = 16;
+
 template<DrawBlendOp TBlendOp, size_t TZoom>
 static void FASTCALL DrawRLESpriteMagnify(DrawPixelInfo& dpi, const DrawSpriteArgs& args)
 {
@@ -94,6 +98,7 @@ static void FASTCALL DrawRLESpriteMinify(DrawPixelInfo& dpi, const DrawSpriteArg
     auto height = args.Height;
     auto zoom = 1 << TZoom;
     auto dstLineWidth = (static_cast<size_t>(dpi.width) >> TZoom) + dpi.pitch;
+    [[maybe_unused]] const auto blitRow = GetBlitRowFunction(TBlendOp);
 
     // Move up to the first line of the image if source_y_start is negative. Why does this even occur?
     if (srcY < 0)
@@ -163,6 +168,17 @@ static void FASTCALL DrawRLESpriteMinify(DrawPixelInfo& dpi, const DrawSpriteArg
                     std::memcpy(dst, src, numPixels);
                 }
             }
+            else if constexpr (TZoom == 0)
+            {
+                if (numPixels >= kMinBlitRowLength)
+                {
+                    blitRow(src, dst, numPixels, args.PalMap);
+                }
+                else if (numPixels > 0)
+                {
+                    BlitRowScalar<TBlendOp>(src, dst, numPixels, args.PalMap);
+                }
+            }
             else
             {
                 auto& paletteMap = args.PalMap;
@@ -207,13 +223,7 @@ template<DrawBlendOp TBlendOp> static void FASTCALL DrawRLESprite(DrawPixelInfo&
     }
 }
 
-/**
- * Transfers readied images onto buffers
- * This function copies the sprite data onto the screen
- *  rct2: 0x0067AA18
- * @param imageId Only flags are used.
- */
-void FASTCALL GfxRleSpriteToBuffer(DrawPixelInfo& dpi, const DrawSpriteArgs& args)
+static void FASTCALL GfxRleSpriteToBufferUncached(DrawPixelInfo& dpi, const DrawSpriteArgs& args)
 {
     if (args.Image.HasPrimary())
     {
@@ -235,3 +245,36 @@ void FASTCALL GfxRleSpriteToBuffer(DrawPixelInfo& dpi, const DrawSpriteArgs& arg
         DrawRLESprite<BLEND_TRANSPARENT>(dpi, args);
     }
 }
+
+/**
+ * Transfers readied images onto buffers
+ * This function copies the sprite data onto the screen
+ *  rct2: 0x0067AA18
+ * @param imageId Only flags are used.
+ */
+void FASTCALL GfxRleSpriteToBuffer(DrawPixelInfo& dpi, const DrawSpriteArgs& args)
+{
+    if (dpi.zoom_level > ZoomLevel{ 0 })
+    {
+        // Minifying only reads every zoom-th pixel, draw a pre-downsampled copy at zoom 0 instead. The copy starts
+        // at the same sampling phase so the result is identical.
+        const auto zoomShift = static_cast<uint8_t>(static_cast<int8_t>(dpi.zoom_level));
+        const int32_t zoomMask = (1 << zoomShift) - 1;
+        const auto phaseX = static_cast<uint8_t>(args.SrcX & zoomMask);
+        const auto phaseY = static_cast<uint8_t>(args.SrcY & zoomMask);
+        auto lod = SpriteLodCacheGet(args.Image.GetIndex(), args.SourceImage, zoomShift, phaseX, phaseY);
+        if (lod != nullptr)
+        {
+            DrawPixelInfo lodDpi = dpi;
+            lodDpi.zoom_level = ZoomLevel{ 0 };
+            lodDpi.width = dpi.width >> zoomShift;
+
+            DrawSpriteArgs lodArgs(
+                args.Image, args.PalMap, lod->Element, args.SrcX >> zoomShift, args.SrcY >> zoomShift,
+                (args.Width + zoomMask) >> zoomShift, (args.Height + zoomMask) >> zoomShift, args.DestinationBits);
+            GfxRleSpriteToBufferUncached(lodDpi, lodArgs);
+            return;
+        }
+    }
+    GfxRleSpriteToBufferUncached(dpi, args);
+}
@@ -14,7 +14,7 @@
 #include "../OpenRCT2.h"
 #include "../PlatformEnvironment.h"
 #include "../config/Config.h"
-#include "../core/FileStream.h"
+#include "../core/MemoryMappedFile.h"
 #include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
 #include "../platform/Platform.h"
@@ -22,9 +22,13 @@
 #include "../sprites.h"
 #include "../ui/UiContext.h"
 #include "ScrollingText.h"
+#include "SpriteLodCache.h"
 
+#include <atomic>
 #include <cassert>
+#include <cstring>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <vector>
 
@@ -113,91 +117,93 @@ static inline uint32_t rctc_to_rct2_index(uint32_t image)
     if (image >= 28246                 ) return image - 49;
     throw std::runtime_error("Invalid RCTC g1.dat file");
 }
+
+static inline uint32_t rct2_to_rctc_index(uint32_t image)
+{
+    // RCTC's g1.dat has a number of additional elements added between the RCT2 elements.
+    if (image <  1542) return image;
+    if (image <  4951) return image + 32;
+    if (image < 17154) return image + 35;
+    if (image < 18084) return image + 37;
+    if (image < 23761) return image + 39;
+    if (image < 24627) return image + 43;
+    if (image < 28197) return image + 47;
+    return image + 49;
+}
 // clang-format on
 
-static void ReadAndConvertGxDat(IStream* stream, size_t count, bool is_rctc, G1Element* elements)
+enum class GxLayout : uint8_t
 {
-    auto g1Elements32 = std::make_unique<RCTG1Element[]>(count);
-    stream->Read(g1Elements32.get(), count * sizeof(RCTG1Element));
-    if (is_rctc)
-    {
-        // Process RCTC's g1.dat file
-        uint32_t rctc = 0;
-        for (size_t i = 0; i < SPR_G1_END; ++i)
-        {
-            // RCTC's g1.dat has a number of additional elements
-            // added between the RCT2 elements. This switch
-            // statement skips over the elements we don't want.
-            switch (i)
-            {
-                case 1542:
-                    rctc += 32;
-                    break;
-                case 23761:
-                case 24627:
-                    rctc += 4;
-                    break;
-                case 4951:
-                    rctc += 3;
-                    break;
-                case 17154:
-                case 18084:
-                case 28197:
-                    rctc += 2;
-                    break;
-            }
+    Standard,
+    Rctc,
+    Csg,
+};
 
-            const RCTG1Element& src = g1Elements32[rctc];
+/**
+ * Converts a single element from its on-disk form. The offset is made relative to data, or left as a file-relative
+ * offset when data is null.
+ */
+static G1Element ConvertGxElement(const RCTG1Element* srcElements, size_t index, GxLayout layout, const uint8_t* data)
+{
+    if (layout == GxLayout::Rctc && index >= SPR_G1_END)
+    {
+        return {};
+    }
 
-            // Double cast to silence compiler warning about casting to
-            // pointer from integer of mismatched length.
-            elements[i].offset = reinterpret_cast<uint8_t*>(static_cast<uintptr_t>(src.offset));
-            elements[i].width = src.width;
-            elements[i].height = src.height;
-            elements[i].x_offset = src.x_offset;
-            elements[i].y_offset = src.y_offset;
-            elements[i].flags = src.flags;
+    auto srcIndex = layout == GxLayout::Rctc ? rct2_to_rctc_index(static_cast<uint32_t>(index)) : index;
+    const RCTG1Element& src = srcElements[srcIndex];
 
-            if (src.flags & G1_FLAG_HAS_ZOOM_SPRITE)
-            {
-                elements[i].zoomed_offset = static_cast<int32_t>(i - rctc_to_rct2_index(rctc - src.zoomed_offset));
-            }
-            else
-            {
-                elements[i].zoomed_offset = src.zoomed_offset;
-            }
+    G1Element dst;
+    // Double cast to silence compiler warning about casting to
+    // pointer from integer of mismatched length.
+    dst.offset = reinterpret_cast<uint8_t*>(reinterpret_cast<uintptr_t>(data) + static_cast<uintptr_t>(src.offset));
+    dst.width = src.width;
+    dst.height = src.height;
+    dst.x_offset = src.x_offset;
+    dst.y_offset = src.y_offset;
+    dst.flags = src.flags;
+    dst.zoomed_offset = src.zoomed_offset;
 
-            ++rctc;
+    if (src.flags & G1_FLAG_HAS_ZOOM_SPRITE)
+    {
+        if (layout == GxLayout::Rctc)
+        {
+            auto zoomedIndex = rctc_to_rct2_index(static_cast<uint32_t>(srcIndex - src.zoomed_offset));
+            dst.zoomed_offset = static_cast<int32_t>(index - zoomedIndex);
         }
+        else if (layout == GxLayout::Csg)
+        {
+            // RCT1 used zoomed offsets that counted from the beginning of the file, rather than from the current sprite.
+            dst.zoomed_offset = static_cast<int32_t>(index - src.zoomed_offset);
+        }
+    }
 
+    if (layout == GxLayout::Rctc)
+    {
         // The pincer graphic for picking up peeps is different in
         // RCTC, and the sprites have different offsets to accommodate
         // the change. This reverts the offsets to their RCT2 values.
         for (const auto& animation : sprite_peep_pickup_starts)
         {
-            for (auto i = 0u; i < SPR_PEEP_PICKUP_COUNT; ++i)
+            if (index >= static_cast<size_t>(animation.start)
+                && index < static_cast<size_t>(animation.start) + SPR_PEEP_PICKUP_COUNT)
             {
-                elements[animation.start + i].x_offset -= animation.x_offset;
-                elements[animation.start + i].y_offset -= animation.y_offset;
+                dst.x_offset -= animation.x_offset;
+                dst.y_offset -= animation.y_offset;
+                break;
             }
         }
     }
-    else
+    return dst;
+}
+
+static void ReadAndConvertGxDat(IStream* stream, size_t count, G1Element* elements)
+{
+    auto g1Elements32 = std::make_unique<RCTG1Element[]>(count);
+    stream->Read(g1Elements32.get(), count * sizeof(RCTG1Element));
+    for (size_t i = 0; i < count; i++)
     {
-        for (size_t i = 0; i < count; i++)
-        {
-            const RCTG1Element& src = g1Elements32[i];
-
-            // Double cast to silence compiler warning about casting to
-            // pointer from integer of mismatched length.
-            elements[i].offset = reinterpret_cast<uint8_t*>(static_cast<uintptr_t>(src.offset));
-            elements[i].width = src.width;
-            elements[i].height = src.height;
-            elements[i].x_offset = src.x_offset;
-            elements[i].y_offset = src.y_offset;
-            elements[i].flags = src.flags;
-            elements[i].zoomed_offset = src.zoomed_offset;
-        }
+        elements[i] = ConvertGxElement(g1Elements32.get(), i, GxLayout::Standard, nullptr);
     }
 }
 
@@ -225,9 +231,27 @@ void MaskScalar(
     }
 }
 
+/**
+ * Backing store for a sprite catalogue that is read straight out of a file mapping. Element headers are only decoded
+ * the first time they are requested, so loading a catalogue costs little more than mapping its files.
+ */
+struct GxMapping
+{
+    std::unique_ptr<MemoryMappedFile> HeaderFile;
+    std::unique_ptr<MemoryMappedFile> DataFile;
+    const RCTG1Element* RawElements = nullptr;
+    const uint8_t* Data = nullptr;
+    GxLayout Layout = GxLayout::Standard;
+    std::unique_ptr<std::atomic<bool>[]> Decoded;
+};
+
 static Gx _g1 = {};
 static Gx _g2 = {};
 static Gx _csg = {};
+static GxMapping _g1Mapping;
+static GxMapping _g2Mapping;
+static GxMapping _csgMapping;
+static std::mutex _gxDecodeMutex;
 static G1Element _scrollingText[MaxScrollingTextEntries]{};
 static bool _csgLoaded = false;
 
@@ -235,6 +259,57 @@ static G1Element _g1Temp = {};
 static std::vector<G1Element> _imageListElements;
 bool gTinyFontAntiAliased = false;
 
+/**
+ * Points gx at the element table and pixel data of the given files. The header must already be set.
+ */
+static void MapGx(
+    Gx& gx, GxMapping& mapping, std::unique_ptr<MemoryMappedFile> headerFile, size_t elementsOffset,
+    std::unique_ptr<MemoryMappedFile> dataFile, size_t dataOffset, GxLayout layout)
+{
+    size_t numEntries = gx.header.num_entries;
+    if (headerFile->GetSize() < elementsOffset + (numEntries * sizeof(RCTG1Element)))
+    {
+        throw IOException("Sprite file is missing element headers.");
+    }
+    if (dataFile != nullptr && dataFile->GetSize() < dataOffset + gx.header.total_size)
+    {
+        throw IOException("Sprite file is missing element data.");
+    }
+
+    mapping.RawElements = reinterpret_cast<const RCTG1Element*>(headerFile->GetData() + elementsOffset);
+    mapping.Data = (dataFile != nullptr ? dataFile->GetData() : headerFile->GetData()) + dataOffset;
+    mapping.Layout = layout;
+    mapping.Decoded = std::make_unique<std::atomic<bool>[]>(numEntries);
+    mapping.HeaderFile = std::move(headerFile);
+    mapping.DataFile = std::move(dataFile);
+
+    gx.elements.resize(numEntries);
+    gx.data.reset();
+}
+
+static void UnmapGx(Gx& gx, GxMapping& mapping)
+{
+    gx.elements.clear();
+    gx.elements.shrink_to_fit();
+    gx.data.reset();
+    mapping = {};
+}
+
+static const G1Element* GetMappedGxElement(Gx& gx, GxMapping& mapping, size_t index)
+{
+    auto& decoded = mapping.Decoded[index];
+    if (!decoded.load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lock(_gxDecodeMutex);
+        if (!decoded.load(std::memory_order_relaxed))
+        {
+            gx.elements[index] = ConvertGxElement(mapping.RawElements, index, mapping.Layout, mapping.Data);
+            decoded.store(true, std::memory_order_release);
+        }
+    }
+    return &gx.elements[index];
+}
+
 /**
  *
  *  rct2: 0x00678998
@@ -245,8 +320,12 @@ bool GfxLoadG1(const IPlatformEnvironment& env)
     try
     {
         auto path = env.FindFile(DIRBASE::RCT2, DIRID::DATA, u8"g1.dat");
-        auto fs = FileStream(path, FILE_MODE_OPEN);
-        _g1.header = fs.ReadValue<RCTG1Header>();
+        auto file = std::make_unique<MemoryMappedFile>(path);
+        if (file->GetSize() < sizeof(RCTG1Header))
+        {
+            throw IOException("g1.dat is too small.");
+        }
+        std::memcpy(&_g1.header, file->GetData(), sizeof(RCTG1Header));
 
         LOG_VERBOSE("g1.dat, number of entries: %u", _g1.header.num_entries);
 
@@ -255,26 +334,18 @@ bool GfxLoadG1(const IPlatformEnvironment& env)
             throw std::runtime_error("Not enough elements in g1.dat");
         }
 
-        // Read element headers
+        // Element headers are decoded on demand, and element data is read directly from the mapping
         bool is_rctc = _g1.header.num_entries == SPR_RCTC_G1_END;
-        _g1.elements.resize(_g1.header.num_entries);
-        ReadAndConvertGxDat(&fs, _g1.header.num_entries, is_rctc, _g1.elements.data());
+        size_t dataOffset = sizeof(RCTG1Header) + (_g1.header.num_entries * sizeof(RCTG1Element));
+        MapGx(
+            _g1, _g1Mapping, std::move(file), sizeof(RCTG1Header), nullptr, dataOffset,
+            is_rctc ? GxLayout::Rctc : GxLayout::Standard);
         gTinyFontAntiAliased = is_rctc;
-
-        // Read element data
-        _g1.data = fs.ReadArray<uint8_t>(_g1.header.total_size);
-
-        // Fix entry data offsets
-        for (uint32_t i = 0; i < _g1.header.num_entries; i++)
-        {
-            _g1.elements[i].offset += reinterpret_cast<uintptr_t>(_g1.data.get());
-        }
         return true;
     }
     catch (const std::exception&)
     {
-        _g1.elements.clear();
-        _g1.elements.shrink_to_fit();
+        UnmapGx(_g1, _g1Mapping);
 
         LOG_FATAL("Unable to load g1 graphics");
         if (!gOpenRCT2Headless)
@@ -288,23 +359,20 @@ bool GfxLoadG1(const IPlatformEnvironment& env)
 
 void GfxUnloadG1()
 {
-    _g1.data.reset();
-    _g1.elements.clear();
-    _g1.elements.shrink_to_fit();
+    SpriteLodCacheClear();
+    UnmapGx(_g1, _g1Mapping);
 }
 
 void GfxUnloadG2()
 {
-    _g2.data.reset();
-    _g2.elements.clear();
-    _g2.elements.shrink_to_fit();
+    SpriteLodCacheClear();
+    UnmapGx(_g2, _g2Mapping);
 }
 
 void GfxUnloadCsg()
 {
-    _csg.data.reset();
-    _csg.elements.clear();
-    _csg.elements.shrink_to_fit();
+    SpriteLodCacheClear();
+    UnmapGx(_csg, _csgMapping);
 }
 
 bool GfxLoadG2()
@@ -317,15 +385,16 @@ bool GfxLoadG2()
 
     try
     {
-        auto fs = FileStream(path, FILE_MODE_OPEN);
-        _g2.header = fs.ReadValue<RCTG1Header>();
+        auto file = std::make_unique<MemoryMappedFile>(path);
+        if (file->GetSize() < sizeof(RCTG1Header))
+        {
+            throw IOException("g2.dat is too small.");
+        }
+        std::memcpy(&_g2.header, file->GetData(), sizeof(RCTG1Header));
 
-        // Read element headers
-        _g2.elements.resize(_g2.header.num_entries);
-        ReadAndConvertGxDat(&fs, _g2.header.num_entries, false, _g2.elements.data());
-
-        // Read element data
-        _g2.data = fs.ReadArray<uint8_t>(_g2.header.total_size);
+        // Element headers are decoded on demand, and element data is read directly from the mapping
+        size_t dataOffset = sizeof(RCTG1Header) + (_g2.header.num_entries * sizeof(RCTG1Element));
+        MapGx(_g2, _g2Mapping, std::move(file), sizeof(RCTG1Header), nullptr, dataOffset, GxLayout::Standard);
 
         if (_g2.header.num_entries != G2_SPRITE_COUNT)
         {
@@ -342,18 +411,11 @@ bool GfxLoadG2()
                                           "that you update g2.dat if you're seeing this message");
             }
         }
-
-        // Fix entry data offsets
-        for (uint32_t i = 0; i < _g2.header.num_entries; i++)
-        {
-            _g2.elements[i].offset += reinterpret_cast<uintptr_t>(_g2.data.get());
-        }
         return true;
     }
     catch (const std::exception&)
     {
-        _g2.elements.clear();
-        _g2.elements.shrink_to_fit();
+        UnmapGx(_g2, _g2Mapping);
 
         LOG_FATAL("Unable to load g2 graphics");
         if (!gOpenRCT2Headless)
@@ -379,10 +441,10 @@ bool GfxLoadCsg()
     auto pathDataPath = FindCsg1datAtLocation(Config::Get().general.RCT1Path);
     try
     {
-        auto fileHeader = FileStream(pathHeaderPath, FILE_MODE_OPEN);
-        auto fileData = FileStream(pathDataPath, FILE_MODE_OPEN);
-        size_t fileHeaderSize = fileHeader.GetLength();
-        size_t fileDataSize = fileData.GetLength();
+        auto fileHeader = std::make_unique<MemoryMappedFile>(pathHeaderPath);
+        auto fileData = std::make_unique<MemoryMappedFile>(pathDataPath);
+        size_t fileHeaderSize = fileHeader->GetSize();
+        size_t fileDataSize = fileData->GetSize();
 
         _csg.header.num_entries = static_cast<uint32_t>(fileHeaderSize / sizeof(RCTG1Element));
         _csg.header.total_size = static_cast<uint32_t>(fileDataSize);
@@ -393,30 +455,14 @@ bool GfxLoadCsg()
             return false;
         }
 
-        // Read element headers
-        _csg.elements.resize(_csg.header.num_entries);
-        ReadAndConvertGxDat(&fileHeader, _csg.header.num_entries, false, _csg.elements.data());
-
-        // Read element data
-        _csg.data = fileData.ReadArray<uint8_t>(_csg.header.total_size);
-
-        // Fix entry data offsets
-        for (uint32_t i = 0; i < _csg.header.num_entries; i++)
-        {
-            _csg.elements[i].offset += reinterpret_cast<uintptr_t>(_csg.data.get());
-            // RCT1 used zoomed offsets that counted from the beginning of the file, rather than from the current sprite.
-            if (_csg.elements[i].flags & G1_FLAG_HAS_ZOOM_SPRITE)
-            {
-                _csg.elements[i].zoomed_offset = i - _csg.elements[i].zoomed_offset;
-            }
-        }
+        // Element headers are decoded on demand, and element data is read directly from the mapping
+        MapGx(_csg, _csgMapping, std::move(fileHeader), 0, std::move(fileData), 0, GxLayout::Csg);
         _csgLoaded = true;
         return true;
     }
     catch (const std::exception&)
     {
-        _csg.elements.clear();
-        _csg.elements.shrink_to_fit();
+        UnmapGx(_csg, _csgMapping);
 
         LOG_ERROR("Unable to load csg graphics");
         return false;
@@ -434,7 +480,7 @@ std::optional<Gx> GfxLoadGx(const std::vector<uint8_t>& buffer)
 
         // Read element headers
         gx.elements.resize(gx.header.num_entries);
-        ReadAndConvertGxDat(&istream, gx.header.num_entries, false, gx.elements.data());
+        ReadAndConvertGxDat(&istream, gx.header.num_entries, gx.elements.data());
 
         // Read element data
         gx.data = istream.ReadArray<uint8_t>(gx.header.total_size);
@@ -761,7 +807,7 @@ const G1Element* GfxGetG1Element(ImageIndex image_id)
     {
         if (offset < _g1.elements.size())
         {
-            return &_g1.elements[offset];
+            return GetMappedGxElement(_g1, _g1Mapping, offset);
         }
     }
     else if (offset < SPR_G2_END)
@@ -769,7 +815,7 @@ const G1Element* GfxGetG1Element(ImageIndex image_id)
         size_t idx = offset - SPR_G2_BEGIN;
         if (idx < _g2.header.num_entries)
         {
-            return &_g2.elements[idx];
+            return GetMappedGxElement(_g2, _g2Mapping, idx);
         }
 
         LOG_WARNING("Invalid entry in g2.dat requested, idx = %u. You may have to update your g2.dat.", idx);
@@ -781,7 +827,7 @@ const G1Element* GfxGetG1Element(ImageIndex image_id)
             size_t idx = offset - SPR_CSG_BEGIN;
             if (idx < _csg.header.num_entries)
             {
-                return &_csg.elements[idx];
+                return GetMappedGxElement(_csg, _csgMapping, idx);
             }
 
             LOG_WARNING("Invalid entry in csg.dat requested, idx = %u.", idx);
@@ -820,6 +866,11 @@ void GfxSetG1Element(ImageIndex imageId, const G1Element* g1)
 
     if (g1 != nullptr)
     {
+        if (isValid && imageId >= SPR_IMAGE_LIST_BEGIN)
+        {
+            SpriteLodCacheInvalidate(imageId);
+        }
+
         if (isTemp)
         {
             _g1Temp = *g1;
@@ -831,6 +882,7 @@ void GfxSetG1Element(ImageIndex imageId, const G1Element* g1)
                 if (imageId < static_cast<ImageIndex>(_g1.elements.size()))
                 {
                     _g1.elements[imageId] = *g1;
+                    _g1Mapping.Decoded[imageId].store(true, std::memory_order_release);
                 }
             }
             else if (imageId < SPR_SCROLLING_TEXT_END)
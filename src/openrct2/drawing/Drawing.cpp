@@ -25,6 +25,7 @@
 #include "../world/Location.hpp"
 #include "LightFX.h"
 
+#include <array>
 #include <cassert>
 #include <cstring>
 
@@ -694,6 +695,63 @@ void MaskFn(
     MaskFunc(width, height, maskSrc, colourSrc, dst, maskWrap, colourWrap, dstWrap);
 }
 
+static BlitRowFunc GetBlitRowScalar(DrawBlendOp blendOp)
+{
+    switch (blendOp)
+    {
+        case BLEND_NONE:
+            return BlitRowScalar<BLEND_NONE>;
+        case BLEND_TRANSPARENT:
+            return BlitRowScalar<BLEND_TRANSPARENT>;
+        case BLEND_TRANSPARENT | BLEND_SRC:
+            return BlitRowScalar<BLEND_TRANSPARENT | BLEND_SRC>;
+        case BLEND_TRANSPARENT | BLEND_DST:
+            return BlitRowScalar<BLEND_TRANSPARENT | BLEND_DST>;
+        case BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST:
+            return BlitRowScalar<BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST>;
+        default:
+            return nullptr;
+    }
+}
+
+static constexpr size_t kNumBlendOps = (BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST) + 1;
+
+static std::array<BlitRowFunc, kNumBlendOps> CreateBlitRowFunctions(bool vectorised)
+{
+    std::array<BlitRowFunc, kNumBlendOps> functions{};
+    for (size_t i = 0; i < functions.size(); i++)
+    {
+        const auto blendOp = static_cast<DrawBlendOp>(i);
+        BlitRowFunc func = nullptr;
+        if (vectorised && Platform::AVX2Available())
+        {
+            func = GetBlitRowAvx2(blendOp);
+        }
+        if (func == nullptr && vectorised && Platform::SSE41Available())
+        {
+            func = GetBlitRowSse4_1(blendOp);
+        }
+        if (func == nullptr)
+        {
+            func = GetBlitRowScalar(blendOp);
+        }
+        functions[i] = func;
+    }
+    return functions;
+}
+
+static auto _blitRowFunctions = CreateBlitRowFunctions(true);
+
+BlitRowFunc GetBlitRowFunction(DrawBlendOp blendOp)
+{
+    return _blitRowFunctions[blendOp];
+}
+
+void GfxSetVectorisedBlitting(bool enabled)
+{
+    _blitRowFunctions = CreateBlitRowFunctions(enabled);
+}
+
 void GfxFilterPixel(DrawPixelInfo& dpi, const ScreenCoordsXY& coords, FilterPaletteID palette)
 {
     GfxFilterRect(dpi, { coords, coords }, palette);
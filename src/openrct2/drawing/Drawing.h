@@ -401,6 +401,16 @@ public:
     {
     }
 
+    const uint8_t* GetData() const
+    {
+        return _data;
+    }
+
+    uint32_t GetDataLength() const
+    {
+        return _dataLength;
+    }
+
     uint8_t& operator[](size_t index);
     uint8_t operator[](size_t index) const;
     uint8_t Blend(uint8_t src, uint8_t dst) const;
@@ -505,6 +515,31 @@ void FASTCALL BlitPixels(const uint8_t* src, uint8_t* dst, const PaletteMap& pal
     }
 }
 
+/**
+ * Blits a row of count contiguous source pixels onto count contiguous destination pixels, the result is the same as
+ * calling BlitPixel for each pixel.
+ */
+using BlitRowFunc = void (*)(const uint8_t* src, uint8_t* dst, size_t count, const PaletteMap& paletteMap);
+
+template<DrawBlendOp TBlendOp> void BlitRowScalar(const uint8_t* src, uint8_t* dst, size_t count, const PaletteMap& paletteMap)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        BlitPixel<TBlendOp>(src + i, dst + i, paletteMap);
+    }
+}
+
+// Return nullptr for blend operations without a vectorised kernel.
+BlitRowFunc GetBlitRowSse4_1(DrawBlendOp blendOp);
+BlitRowFunc GetBlitRowAvx2(DrawBlendOp blendOp);
+
+BlitRowFunc GetBlitRowFunction(DrawBlendOp blendOp);
+
+/**
+ * Switches the row blitters between the best kernels supported by the CPU and the scalar ones, for comparing them.
+ */
+void GfxSetVectorisedBlitting(bool enabled);
+
 constexpr uint8_t kPaletteTotalOffsets = 192;
 
 #define INSET_RECT_F_30 (INSET_RECT_FLAG_BORDER_INSET | INSET_RECT_FLAG_FILL_NONE)
@@ -17,7 +17,8 @@
 #include "Drawing.h"
 
 #include <algorithm>
-#include <list>
+#include <map>
+#include <set>
 
 using namespace OpenRCT2;
 
@@ -25,11 +26,16 @@ constexpr uint32_t BASE_IMAGE_ID = SPR_IMAGE_LIST_BEGIN;
 constexpr uint32_t MAX_IMAGES = SPR_IMAGE_LIST_END - BASE_IMAGE_ID;
 
 static bool _initialised = false;
-static std::list<ImageList> _freeLists;
 static uint32_t _allocatedImageCount;
 
+// Free ranges are indexed twice: by base ID so that neighbours can be found and coalesced on free, and by
+// (count, base ID) so that the smallest range that fits can be found on allocation. Both are kept in sync and
+// never contain adjacent ranges, so allocate and free are O(log n) in the number of free ranges.
+static std::map<ImageIndex, ImageIndex> _freeRangesByBase;
+static std::set<std::pair<ImageIndex, ImageIndex>> _freeRangesBySize;
+
 #ifdef DEBUG_LEVEL_1
-static std::list<ImageList> _allocatedLists;
+static std::map<ImageIndex, ImageIndex> _allocatedLists;
 
 // MSVC's compiler doesn't support the [[maybe_unused]] attribute for unused static functions. Until this has been resolved, we
 // need to explicitly tell the compiler to temporarily disable the warning.
@@ -39,24 +45,18 @@ static std::list<ImageList> _allocatedLists;
 
 [[maybe_unused]] static bool AllocatedListContains(uint32_t baseImageId, uint32_t count)
 {
-    bool contains = std::any_of(
-        _allocatedLists.begin(), _allocatedLists.end(), [baseImageId, count](const ImageList& imageList) -> bool {
-            return imageList.BaseId == baseImageId && imageList.Count == count;
-        });
-    return contains;
+    auto it = _allocatedLists.find(baseImageId);
+    return it != _allocatedLists.end() && it->second == count;
 }
 
 #    pragma warning(pop)
 
 static bool AllocatedListRemove(uint32_t baseImageId, uint32_t count)
 {
-    auto foundItem = std::find_if(
-        _allocatedLists.begin(), _allocatedLists.end(), [baseImageId, count](const ImageList& imageList) -> bool {
-            return imageList.BaseId == baseImageId && imageList.Count == count;
-        });
-    if (foundItem != _allocatedLists.end())
+    auto it = _allocatedLists.find(baseImageId);
+    if (it != _allocatedLists.end() && it->second == count)
     {
-        _allocatedLists.erase(foundItem);
+        _allocatedLists.erase(it);
         return true;
     }
     return false;
@@ -68,12 +68,25 @@ static uint32_t GetNumFreeImagesRemaining()
     return MAX_IMAGES - _allocatedImageCount;
 }
 
+static void InsertFreeRange(ImageIndex baseId, ImageIndex count)
+{
+    _freeRangesByBase.emplace(baseId, count);
+    _freeRangesBySize.emplace(count, baseId);
+}
+
+static void EraseFreeRange(std::map<ImageIndex, ImageIndex>::iterator it)
+{
+    _freeRangesBySize.erase({ it->second, it->first });
+    _freeRangesByBase.erase(it);
+}
+
 static void InitialiseImageList()
 {
     Guard::Assert(!_initialised, GUARD_LINE);
 
-    _freeLists.clear();
-    _freeLists.push_back({ BASE_IMAGE_ID, MAX_IMAGES });
+    _freeRangesByBase.clear();
+    _freeRangesBySize.clear();
+    InsertFreeRange(BASE_IMAGE_ID, MAX_IMAGES);
 #ifdef DEBUG_LEVEL_1
     _allocatedLists.clear();
 #endif
@@ -82,77 +95,40 @@ static void InitialiseImageList()
 }
 
 /**
- * Merges all the free lists into one, a process of defragmentation.
+ * Takes the smallest free range that can hold the requested count, ties going to the lowest base ID so that
+ * allocations stay packed towards the start of the image list.
  */
-static void MergeFreeLists()
+static uint32_t AllocateImageList(uint32_t count)
 {
-    _freeLists.sort([](const ImageList& a, const ImageList& b) -> bool { return a.BaseId < b.BaseId; });
-    for (auto it = _freeLists.begin(); it != _freeLists.end(); it++)
+    Guard::Assert(count != 0, GUARD_LINE);
+
+    if (!_initialised)
     {
-        bool mergeHappened;
-        do
-        {
-            mergeHappened = false;
-            auto nextIt = std::next(it);
-            if (nextIt != _freeLists.end())
-            {
-                if (it->BaseId + it->Count == nextIt->BaseId)
-                {
-                    // Merge next list into this list
-                    it->Count += nextIt->Count;
-                    _freeLists.erase(nextIt);
-                    mergeHappened = true;
-                }
-            }
-        } while (mergeHappened);
+        InitialiseImageList();
     }
-}
 
-static uint32_t TryAllocateImageList(uint32_t count)
-{
-    for (auto it = _freeLists.begin(); it != _freeLists.end(); it++)
+    if (GetNumFreeImagesRemaining() < count)
     {
-        ImageList imageList = *it;
-        if (imageList.Count >= count)
-        {
-            _freeLists.erase(it);
-            if (imageList.Count > count)
-            {
-                ImageList remainder = { imageList.BaseId + count, imageList.Count - count };
-                _freeLists.push_back(remainder);
-            }
-
-#ifdef DEBUG_LEVEL_1
-            _allocatedLists.push_back({ imageList.BaseId, count });
-#endif
-            _allocatedImageCount += count;
-            return imageList.BaseId;
-        }
+        return ImageIndexUndefined;
     }
-    return ImageIndexUndefined;
-}
-
-static uint32_t AllocateImageList(uint32_t count)
-{
-    Guard::Assert(count != 0, GUARD_LINE);
 
-    if (!_initialised)
+    auto sizeIt = _freeRangesBySize.lower_bound({ count, 0 });
+    if (sizeIt == _freeRangesBySize.end())
     {
-        InitialiseImageList();
+        return ImageIndexUndefined;
     }
 
-    uint32_t baseImageId = ImageIndexUndefined;
-    uint32_t freeImagesRemaining = GetNumFreeImagesRemaining();
-    if (freeImagesRemaining >= count)
+    const auto [rangeCount, baseImageId] = *sizeIt;
+    EraseFreeRange(_freeRangesByBase.find(baseImageId));
+    if (rangeCount > count)
     {
-        baseImageId = TryAllocateImageList(count);
-        if (baseImageId == ImageIndexUndefined)
-        {
-            // Defragment and try again
-            MergeFreeLists();
-            baseImageId = TryAllocateImageList(count);
-        }
+        InsertFreeRange(baseImageId + count, rangeCount - count);
     }
+
+#ifdef DEBUG_LEVEL_1
+    _allocatedLists.emplace(baseImageId, count);
+#endif
+    _allocatedImageCount += count;
     return baseImageId;
 }
 
@@ -169,23 +145,30 @@ static void FreeImageList(uint32_t baseImageId, uint32_t count)
 #endif
     _allocatedImageCount -= count;
 
-    for (auto it = _freeLists.begin(); it != _freeLists.end(); it++)
+    auto newBase = baseImageId;
+    auto newEnd = baseImageId + count;
+
+    // Coalesce with the free range that follows
+    auto nextIt = _freeRangesByBase.lower_bound(baseImageId);
+    if (nextIt != _freeRangesByBase.end() && nextIt->first == newEnd)
     {
-        if (it->BaseId + it->Count == baseImageId)
-        {
-            it->Count += count;
-            return;
-        }
+        newEnd += nextIt->second;
+        auto eraseIt = nextIt++;
+        EraseFreeRange(eraseIt);
+    }
 
-        if (baseImageId + count == it->BaseId)
+    // Coalesce with the free range that precedes
+    if (nextIt != _freeRangesByBase.begin())
+    {
+        auto prevIt = std::prev(nextIt);
+        if (prevIt->first + prevIt->second == newBase)
         {
-            it->BaseId = baseImageId;
-            it->Count += count;
-            return;
+            newBase = prevIt->first;
+            EraseFreeRange(prevIt);
         }
     }
 
-    _freeLists.push_back({ baseImageId, count });
+    InsertFreeRange(newBase, newEnd - newBase);
 }
 
 uint32_t GfxObjectAllocateImages(const G1Element* images, uint32_t count)
@@ -253,7 +236,33 @@ size_t ImageListGetMaximum()
     return MAX_IMAGES;
 }
 
-const std::list<ImageList>& GetAvailableAllocationRanges()
+std::vector<ImageList> GetAvailableAllocationRanges()
+{
+    std::vector<ImageList> ranges;
+    ranges.reserve(_freeRangesByBase.size());
+    for (const auto& [baseId, count] : _freeRangesByBase)
+    {
+        ranges.emplace_back(baseId, count);
+    }
+    return ranges;
+}
+
+ImageListFragmentation ImageListGetFragmentation()
 {
-    return _freeLists;
+    ImageListFragmentation result;
+    if (!_initialised)
+    {
+        result.FreeRangeCount = 1;
+        result.FreeImageCount = MAX_IMAGES;
+        result.LargestFreeRange = MAX_IMAGES;
+        return result;
+    }
+
+    result.FreeRangeCount = _freeRangesByBase.size();
+    result.FreeImageCount = GetNumFreeImagesRemaining();
+    if (!_freeRangesBySize.empty())
+    {
+        result.LargestFreeRange = _freeRangesBySize.rbegin()->first;
+    }
+    return result;
 }
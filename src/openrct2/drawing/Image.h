@@ -13,7 +13,7 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <list>
+#include <vector>
 
 struct G1Element;
 
@@ -60,4 +60,21 @@ void GfxObjectFreeImages(uint32_t baseImageId, uint32_t count);
 void GfxObjectCheckAllImagesFreed();
 size_t ImageListGetUsedCount();
 size_t ImageListGetMaximum();
-const std::list<ImageList>& GetAvailableAllocationRanges();
+std::vector<ImageList> GetAvailableAllocationRanges();
+
+struct ImageListFragmentation
+{
+    size_t FreeRangeCount{};
+    size_t FreeImageCount{};
+    size_t LargestFreeRange{};
+
+    /**
+     * The proportion of free images that can not be handed out as a single allocation, 0 being no fragmentation.
+     */
+    double GetRatio() const
+    {
+        return FreeImageCount == 0 ? 0.0 : 1.0 - (static_cast<double>(LargestFreeRange) / FreeImageCount);
+    }
+};
+
+ImageListFragmentation ImageListGetFragmentation();
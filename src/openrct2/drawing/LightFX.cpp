@@ -13,7 +13,9 @@
 #include "../Game.h"
 #include "../GameState.h"
 #include "../config/Config.h"
+#include "../core/JobPool.h"
 #include "../entity/EntityRegistry.h"
+#include "../entity/EntityTweener.h"
 #include "../interface/Viewport.h"
 #include "../interface/Window.h"
 #include "../interface/Window_internal.h"
@@ -24,8 +26,11 @@
 #include "../world/Map.h"
 #include "Drawing.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <memory>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -85,6 +90,52 @@ static ZoomLevel _current_view_zoom_back_delay{ 0 };
 
 static GamePalette gPalette_light;
 
+// Size in pixels of the square screen tiles lights are binned into
+static constexpr int32_t kLightTileSize = 64;
+// Number of occlusion samples (and so paint sessions) in flight at once
+static constexpr size_t kLightOcclusionBatchSize = 256;
+static constexpr size_t kLightOcclusionJobSize = 16;
+
+// clang-format off
+static constexpr int16_t kOcclusionSamplePattern[] = {
+    0, 0,
+    -4, 0, 0, -3, 4, 0, 0, 3,
+    -2, -1, -1, -1, 2, 1, 1, 1,
+    -3, -2, -3, 2, 3, -2, 3, 2,
+};
+// clang-format on
+
+struct LightOcclusionState
+{
+    uint32_t Light;
+    int32_t StartPattern;
+    int32_t NextPattern;
+    int32_t EndPattern;
+    uint32_t Occluded;
+    bool Pending;
+};
+
+struct LightOcclusionSample
+{
+    uint32_t State;
+    int32_t Pattern;
+    PaintSession* Session;
+    int32_t Occlusion;
+};
+
+struct LightStamp
+{
+    const uint8_t* Texture;
+    int32_t TextureWidth;
+    int32_t X;
+    int32_t Y;
+    int32_t Width;
+    int32_t Height;
+    uint8_t Intensity;
+};
+
+static std::unique_ptr<JobPool> _lightJobs;
+
 static uint8_t CalcLightIntensityLantern(int32_t x, int32_t y)
 {
     double distance = static_cast<double>(x * x + y * y);
@@ -187,203 +238,281 @@ void LightFXUpdateBuffers(DrawPixelInfo& info)
     _pixelInfo = info;
 }
 
-void LightFXPrepareLightList()
+static JobPool* LightFXGetJobPool()
 {
-    for (uint32_t light = 0; light < LightListCurrentCountFront; light++)
+    if (!Config::Get().general.MultiThreading)
     {
-        LightListEntry* entry = &_LightListFront[light];
+        _lightJobs.reset();
+        return nullptr;
+    }
+    if (_lightJobs == nullptr)
+    {
+        _lightJobs = std::make_unique<JobPool>();
+    }
+    return _lightJobs.get();
+}
 
-        if (entry->Position.z == 0x7FFF)
-        {
-            entry->LightIntensity = 0xFF;
-            continue;
-        }
+/**
+ * Runs fn(begin, end) over [0, count) in chunks, on the light job pool when multithreading is enabled.
+ */
+template<typename TFn> static void LightFXParallelFor(size_t count, size_t chunkSize, TFn&& fn)
+{
+    auto* jobs = LightFXGetJobPool();
+    if (jobs == nullptr || count <= chunkSize)
+    {
+        fn(size_t{ 0 }, count);
+        return;
+    }
 
-        int32_t posOnScreenX = entry->ViewCoords.x - _current_view_x_front;
-        int32_t posOnScreenY = entry->ViewCoords.y - _current_view_y_front;
+    // Jobs read the same park as the thread drawing the lights
+    auto* gameState = &GetGameState();
+    for (size_t begin = 0; begin < count; begin += chunkSize)
+    {
+        auto end = std::min(count, begin + chunkSize);
+        jobs->AddTask([&fn, begin, end, gameState]() {
+            GameStateScope scope(*gameState);
+            fn(begin, end);
+        });
+    }
+    jobs->Join();
+}
 
-        posOnScreenX = _current_view_zoom_front.ApplyInversedTo(posOnScreenX);
-        posOnScreenY = _current_view_zoom_front.ApplyInversedTo(posOnScreenY);
+static void LightFXEvaluateOcclusionSample(
+    LightOcclusionSample& sample, const LightListEntry& entry, const CoordsXY& tileOffset, const CoordsXY& dirVec,
+    uint32_t viewFlags)
+{
+    CoordsXY mapCoord{};
+    TileElement* tileElement = nullptr;
+    ViewportInteractionItem interactionType = ViewportInteractionItem::None;
 
-        if ((posOnScreenX < -128) || (posOnScreenY < -128) || (posOnScreenX > _pixelInfo.width + 128)
-            || (posOnScreenY > _pixelInfo.height + 128))
-        {
-            entry->Type = LightType::None;
-            continue;
-        }
+    if (sample.Session != nullptr)
+    {
+        // based on GetMapCoordinatesFromPosWindow
+        PaintSessionGenerate(*sample.Session);
+        PaintSessionArrange(*sample.Session);
+        auto info = SetInteractionInfoFromPaintSession(sample.Session, viewFlags, ViewportInteractionItemAll);
+
+        mapCoord = info.Loc + tileOffset;
+        interactionType = info.SpriteType;
+        tileElement = info.Element;
+    }
 
-        uint32_t lightIntensityOccluded = 0x0;
+    int32_t baseHeight = (-999) * kCoordsZStep;
+    if (interactionType != ViewportInteractionItem::Entity && tileElement != nullptr)
+    {
+        baseHeight = tileElement->GetBaseZ();
+    }
 
-        int32_t dirVecX = 707;
-        int32_t dirVecY = 707;
+    int32_t minDist = (baseHeight - entry.Position.z) / 2;
 
-        switch (_current_view_rotation_front)
-        {
-            case 0:
-                dirVecX = 707;
-                dirVecY = 707;
-                break;
-            case 1:
-                dirVecX = -707;
-                dirVecY = 707;
-                break;
-            case 2:
-                dirVecX = -707;
-                dirVecY = -707;
-                break;
-            case 3:
-                dirVecX = 707;
-                dirVecY = -707;
-                break;
-            default:
-                dirVecX = 0;
-                dirVecY = 0;
-                break;
-        }
+    int32_t deltaX = mapCoord.x - entry.Position.x;
+    int32_t deltaY = mapCoord.y - entry.Position.y;
 
-        int32_t tileOffsetX = 0;
-        int32_t tileOffsetY = 0;
-        switch (_current_view_rotation_front)
-        {
-            case 0:
-                tileOffsetX = 0;
-                tileOffsetY = 0;
-                break;
-            case 1:
-                tileOffsetX = 16;
-                tileOffsetY = 0;
-                break;
-            case 2:
-                tileOffsetX = 32;
-                tileOffsetY = 32;
-                break;
-            case 3:
-                tileOffsetX = 0;
-                tileOffsetY = 16;
-                break;
-        }
+    int32_t projDot = (dirVec.x * deltaX + dirVec.y * deltaY) / 1000;
+    projDot = std::max(minDist, projDot);
 
-        int32_t mapFrontDiv = _current_view_zoom_front.ApplyTo(1);
+    if (projDot < 5)
+    {
+        sample.Occlusion = 100;
+    }
+    else
+    {
+        sample.Occlusion = std::max(0, 200 - (projDot * 20));
+    }
+}
+
+/**
+ * Decides which sample points a light needs next, based on the samples taken so far. Lights that are fully lit or
+ * fully occluded after the first few samples, or that are far enough zoomed out, are not refined further.
+ */
+static void LightFXAdvanceOcclusion(LightOcclusionState& state)
+{
+    int32_t lastPattern = state.EndPattern - 1;
+    state.Pending = false;
+    if (lastPattern == 0)
+    {
+        if (state.Occluded == 100 || _current_view_zoom_front > ZoomLevel{ 2 })
+            return;
+    }
+    else if (lastPattern == 4)
+    {
+        if (_current_view_zoom_front > ZoomLevel{ 1 })
+            return;
+        if (state.Occluded == 0 || state.Occluded == 500)
+            return;
+    }
+    else
+    {
+        return;
+    }
+    state.NextPattern = state.EndPattern;
+    state.EndPattern += 4;
+    state.Pending = true;
+}
 
-        // clang-format off
-        static int16_t offsetPattern[26] = {
-            0, 0,
-            -4, 0, 0, -3, 4, 0, 0, 3,
-            -2, -1, -1, -1, 2, 1, 1, 1,
-            -3, -2, -3, 2, 3, -2, 3, 2,
-        };
-        // clang-format on
+/**
+ * Estimates how much of each light is occluded by sampling the scene around it. Every sample needs a paint session
+ * of its own, so samples are gathered across all lights and evaluated in parallel batches.
+ */
+static void LightFXComputeOcclusion(std::vector<LightOcclusionState>& states)
+{
+    static std::vector<LightOcclusionSample> samples;
 
-        // Light occlusion code
-        if (true)
+    CoordsXY dirVec{};
+    CoordsXY tileOffset{};
+    switch (_current_view_rotation_front)
+    {
+        case 0:
+            dirVec = { 707, 707 };
+            tileOffset = { 0, 0 };
+            break;
+        case 1:
+            dirVec = { -707, 707 };
+            tileOffset = { 16, 0 };
+            break;
+        case 2:
+            dirVec = { -707, -707 };
+            tileOffset = { 32, 32 };
+            break;
+        case 3:
+            dirVec = { 707, -707 };
+            tileOffset = { 0, 16 };
+            break;
+    }
+
+    int32_t mapFrontDiv = std::max(1, _current_view_zoom_front.ApplyTo(1));
+
+    auto* w = WindowGetMain();
+    auto viewFlags = w != nullptr ? w->viewport->flags : 0;
+
+    bool pending = !states.empty();
+    while (pending)
+    {
+        samples.clear();
+        for (uint32_t i = 0; i < states.size(); i++)
         {
-            int32_t totalSamplePoints = 5;
-            int32_t startSamplePoint = 1;
+            const auto& state = states[i];
+            if (!state.Pending)
+                continue;
 
-            if (entry->Qualifier == LightFXQualifier::Map)
+            for (int32_t pat = state.NextPattern; pat < state.EndPattern; pat++)
             {
-                startSamplePoint = 0;
-                totalSamplePoints = 1;
+                samples.push_back({ i, pat, nullptr, 0 });
             }
+        }
 
-            for (int32_t pat = startSamplePoint; pat < totalSamplePoints; pat++)
-            {
-                CoordsXY mapCoord{};
-
-                TileElement* tileElement = nullptr;
-
-                ViewportInteractionItem interactionType = ViewportInteractionItem::None;
+        for (size_t batchStart = 0; batchStart < samples.size(); batchStart += kLightOcclusionBatchSize)
+        {
+            auto batchEnd = std::min(samples.size(), batchStart + kLightOcclusionBatchSize);
 
-                auto* w = WindowGetMain();
-                if (w != nullptr)
+            // Paint sessions can only be created and released on this thread
+            if (w != nullptr)
+            {
+                for (size_t i = batchStart; i < batchEnd; i++)
                 {
-                    // based on GetMapCoordinatesFromPosWindow
+                    auto& sample = samples[i];
+                    const auto& entry = _LightListFront[states[sample.State].Light];
+
                     DrawPixelInfo dpi;
-                    dpi.x = entry->ViewCoords.x + offsetPattern[0 + pat * 2] / mapFrontDiv;
-                    dpi.y = entry->ViewCoords.y + offsetPattern[1 + pat * 2] / mapFrontDiv;
+                    dpi.x = entry.ViewCoords.x + kOcclusionSamplePattern[0 + sample.Pattern * 2] / mapFrontDiv;
+                    dpi.y = entry.ViewCoords.y + kOcclusionSamplePattern[1 + sample.Pattern * 2] / mapFrontDiv;
                     dpi.height = 1;
                     dpi.zoom_level = _current_view_zoom_front;
                     dpi.width = 1;
-
-                    PaintSession* session = PaintSessionAlloc(dpi, w->viewport->flags, w->viewport->rotation);
-                    PaintSessionGenerate(*session);
-                    PaintSessionArrange(*session);
-                    auto info = SetInteractionInfoFromPaintSession(session, w->viewport->flags, ViewportInteractionItemAll);
-                    PaintSessionFree(session);
-
-                    //  LOG_WARNING("[%i, %i]", dpi->x, dpi->y);
-
-                    mapCoord = info.Loc;
-                    mapCoord.x += tileOffsetX;
-                    mapCoord.y += tileOffsetY;
-                    interactionType = info.SpriteType;
-                    tileElement = info.Element;
+                    sample.Session = PaintSessionAlloc(dpi, w->viewport->flags, w->viewport->rotation);
                 }
+            }
 
-                int32_t minDist = 0;
-                int32_t baseHeight = (-999) * kCoordsZStep;
-
-                if (interactionType != ViewportInteractionItem::Entity && tileElement != nullptr)
+            LightFXParallelFor(
+                batchEnd - batchStart, kLightOcclusionJobSize, [&, batchStart](size_t begin, size_t end) {
+                    for (size_t i = batchStart + begin; i < batchStart + end; i++)
+                    {
+                        auto& sample = samples[i];
+                        const auto& entry = _LightListFront[states[sample.State].Light];
+                        LightFXEvaluateOcclusionSample(sample, entry, tileOffset, dirVec, viewFlags);
+                    }
+                });
+
+            for (size_t i = batchStart; i < batchEnd; i++)
+            {
+                if (samples[i].Session != nullptr)
                 {
-                    baseHeight = tileElement->GetBaseZ();
+                    PaintSessionFree(samples[i].Session);
+                    samples[i].Session = nullptr;
                 }
+            }
+        }
 
-                minDist = (baseHeight - entry->Position.z) / 2;
+        for (const auto& sample : samples)
+        {
+            states[sample.State].Occluded += sample.Occlusion;
+        }
 
-                int32_t deltaX = mapCoord.x - entry->Position.x;
-                int32_t deltaY = mapCoord.y - entry->Position.y;
+        pending = false;
+        for (auto& state : states)
+        {
+            if (state.Pending)
+            {
+                LightFXAdvanceOcclusion(state);
+                pending |= state.Pending;
+            }
+        }
+    }
+}
 
-                int32_t projDot = (dirVecX * deltaX + dirVecY * deltaY) / 1000;
+void LightFXPrepareLightList()
+{
+    static std::vector<LightOcclusionState> occlusionStates;
+    occlusionStates.clear();
 
-                projDot = std::max(minDist, projDot);
+    for (uint32_t light = 0; light < LightListCurrentCountFront; light++)
+    {
+        LightListEntry* entry = &_LightListFront[light];
 
-                if (projDot < 5)
-                {
-                    lightIntensityOccluded += 100;
-                }
-                else
-                {
-                    lightIntensityOccluded += std::max(0, 200 - (projDot * 20));
-                }
+        if (entry->Position.z == 0x7FFF)
+        {
+            entry->LightIntensity = 0xFF;
+            continue;
+        }
 
-                //  LOG_WARNING("light %i [%i, %i, %i], [%i, %i] minDist to %i: %i; projdot: %i", light, coord_3d.x, coord_3d.y,
-                //  coord_3d.z, mapCoord.x, mapCoord.y, baseHeight, minDist, projDot);
+        int32_t posOnScreenX = entry->ViewCoords.x - _current_view_x_front;
+        int32_t posOnScreenY = entry->ViewCoords.y - _current_view_y_front;
 
-                if (pat == 0)
-                {
-                    if (lightIntensityOccluded == 100)
-                        break;
-                    if (_current_view_zoom_front > ZoomLevel{ 2 })
-                        break;
-                    totalSamplePoints += 4;
-                }
-                else if (pat == 4)
-                {
-                    if (_current_view_zoom_front > ZoomLevel{ 1 })
-                        break;
-                    if (lightIntensityOccluded == 0 || lightIntensityOccluded == 500)
-                        break;
-                    // lastSampleCount = lightIntensityOccluded / 500;
-                    //  break;
-                    totalSamplePoints += 4;
-                }
-                else if (pat == 8)
-                {
-                    break;
-                }
-            }
+        posOnScreenX = _current_view_zoom_front.ApplyInversedTo(posOnScreenX);
+        posOnScreenY = _current_view_zoom_front.ApplyInversedTo(posOnScreenY);
 
-            totalSamplePoints -= startSamplePoint;
+        if ((posOnScreenX < -128) || (posOnScreenY < -128) || (posOnScreenX > _pixelInfo.width + 128)
+            || (posOnScreenY > _pixelInfo.height + 128))
+        {
+            entry->Type = LightType::None;
+            continue;
+        }
 
-            if (lightIntensityOccluded == 0)
-            {
-                entry->Type = LightType::None;
-                continue;
-            }
+        // Map lights start with a single centre sample, entity lights with the four surrounding ones
+        LightOcclusionState state{};
+        state.Light = light;
+        state.StartPattern = entry->Qualifier == LightFXQualifier::Map ? 0 : 1;
+        state.NextPattern = state.StartPattern;
+        state.EndPattern = entry->Qualifier == LightFXQualifier::Map ? 1 : 5;
+        state.Pending = true;
+        occlusionStates.push_back(state);
+    }
+
+    LightFXComputeOcclusion(occlusionStates);
+
+    for (const auto& state : occlusionStates)
+    {
+        LightListEntry* entry = &_LightListFront[state.Light];
 
-            entry->LightIntensity = static_cast<uint8_t>(
-                std::min<uint32_t>(0xFF, (entry->LightIntensity * lightIntensityOccluded) / (totalSamplePoints * 100)));
+        if (state.Occluded == 0)
+        {
+            entry->Type = LightType::None;
+            continue;
         }
+
+        uint32_t totalSamplePoints = state.EndPattern - state.StartPattern;
+        entry->LightIntensity = static_cast<uint8_t>(
+            std::min<uint32_t>(0xFF, (entry->LightIntensity * state.Occluded) / (totalSamplePoints * 100)));
         entry->LightIntensity = static_cast<uint8_t>(
             std::max<uint32_t>(0x00, entry->LightIntensity - static_cast<int8_t>(_current_view_zoom_front) * 5));
 
@@ -442,176 +571,253 @@ void LightFXUpdateViewportSettings()
     }
 }
 
-void LightFXRenderLightsToFrontBuffer()
+/**
+ * Works out which part of the light buffer a light covers and which part of its baked texture is read for it.
+ * Returns false if the light is not visible.
+ */
+static bool LightFXGetStamp(const LightListEntry& entry, LightStamp& stamp)
 {
-    if (_light_rendered_buffer_front == nullptr)
+    int32_t inRectCentreX = entry.ViewCoords.x;
+    int32_t inRectCentreY = entry.ViewCoords.y;
+
+    if (entry.Position.z != 0x7FFF)
     {
-        return;
+        inRectCentreX -= _current_view_x_front;
+        inRectCentreY -= _current_view_y_front;
+        inRectCentreX = _current_view_zoom_front.ApplyInversedTo(inRectCentreX);
+        inRectCentreY = _current_view_zoom_front.ApplyInversedTo(inRectCentreY);
     }
 
-    std::memset(_light_rendered_buffer_front, 0, _pixelInfo.width * _pixelInfo.height);
+    const uint8_t* bufReadBase = nullptr;
+    uint32_t bufReadWidth, bufReadHeight;
+    switch (entry.Type)
+    {
+        case LightType::Lantern0:
+            bufReadWidth = 32;
+            bufReadHeight = 32;
+            bufReadBase = _bakedLightTexture_lantern_0;
+            break;
+        case LightType::Lantern1:
+            bufReadWidth = 64;
+            bufReadHeight = 64;
+            bufReadBase = _bakedLightTexture_lantern_1;
+            break;
+        case LightType::Lantern2:
+            bufReadWidth = 128;
+            bufReadHeight = 128;
+            bufReadBase = _bakedLightTexture_lantern_2;
+            break;
+        case LightType::Lantern3:
+            bufReadWidth = 256;
+            bufReadHeight = 256;
+            bufReadBase = _bakedLightTexture_lantern_3;
+            break;
+        case LightType::Spot0:
+            bufReadWidth = 32;
+            bufReadHeight = 32;
+            bufReadBase = _bakedLightTexture_spot_0;
+            break;
+        case LightType::Spot1:
+            bufReadWidth = 64;
+            bufReadHeight = 64;
+            bufReadBase = _bakedLightTexture_spot_1;
+            break;
+        case LightType::Spot2:
+            bufReadWidth = 128;
+            bufReadHeight = 128;
+            bufReadBase = _bakedLightTexture_spot_2;
+            break;
+        case LightType::Spot3:
+            bufReadWidth = 256;
+            bufReadHeight = 256;
+            bufReadBase = _bakedLightTexture_spot_3;
+            break;
+        default:
+            return false;
+    }
 
-    _lightPolution_back = 0;
+    // Clamp the reads to be no larger than the buffer size
+    bufReadHeight = std::min<uint32_t>(_pixelInfo.height, bufReadHeight);
+    bufReadWidth = std::min<uint32_t>(_pixelInfo.width, bufReadWidth);
 
-    //  LOG_WARNING("%i lights", LightListCurrentCountFront);
+    int32_t bufWriteX = inRectCentreX - bufReadWidth / 2;
+    int32_t bufWriteY = inRectCentreY - bufReadHeight / 2;
+    int32_t bufWriteWidth = bufReadWidth;
+    int32_t bufWriteHeight = bufReadHeight;
 
-    for (uint32_t light = 0; light < LightListCurrentCountFront; light++)
+    if (bufWriteX < 0)
     {
-        const uint8_t* bufReadBase = nullptr;
-        uint8_t* bufWriteBase = static_cast<uint8_t*>(_light_rendered_buffer_front);
-        uint32_t bufReadWidth, bufReadHeight;
-        int32_t bufWriteX, bufWriteY;
-        int32_t bufWriteWidth, bufWriteHeight;
-        uint32_t bufReadSkip, bufWriteSkip;
+        bufReadBase += -bufWriteX;
+        bufWriteWidth += bufWriteX;
+        bufWriteX = 0;
+    }
 
-        LightListEntry* entry = &_LightListFront[light];
+    if (bufWriteWidth <= 0)
+        return false;
 
-        int32_t inRectCentreX = entry->ViewCoords.x;
-        int32_t inRectCentreY = entry->ViewCoords.y;
+    if (bufWriteY < 0)
+    {
+        bufReadBase += -bufWriteY * bufReadWidth;
+        bufWriteHeight += bufWriteY;
+        bufWriteY = 0;
+    }
 
-        if (entry->Position.z != 0x7FFF)
-        {
-            inRectCentreX -= _current_view_x_front;
-            inRectCentreY -= _current_view_y_front;
-            inRectCentreX = _current_view_zoom_front.ApplyInversedTo(inRectCentreX);
-            inRectCentreY = _current_view_zoom_front.ApplyInversedTo(inRectCentreY);
-        }
+    if (bufWriteHeight <= 0)
+        return false;
 
-        switch (entry->Type)
-        {
-            case LightType::Lantern0:
-                bufReadWidth = 32;
-                bufReadHeight = 32;
-                bufReadBase = _bakedLightTexture_lantern_0;
-                break;
-            case LightType::Lantern1:
-                bufReadWidth = 64;
-                bufReadHeight = 64;
-                bufReadBase = _bakedLightTexture_lantern_1;
-                break;
-            case LightType::Lantern2:
-                bufReadWidth = 128;
-                bufReadHeight = 128;
-                bufReadBase = _bakedLightTexture_lantern_2;
-                break;
-            case LightType::Lantern3:
-                bufReadWidth = 256;
-                bufReadHeight = 256;
-                bufReadBase = _bakedLightTexture_lantern_3;
-                break;
-            case LightType::Spot0:
-                bufReadWidth = 32;
-                bufReadHeight = 32;
-                bufReadBase = _bakedLightTexture_spot_0;
-                break;
-            case LightType::Spot1:
-                bufReadWidth = 64;
-                bufReadHeight = 64;
-                bufReadBase = _bakedLightTexture_spot_1;
-                break;
-            case LightType::Spot2:
-                bufReadWidth = 128;
-                bufReadHeight = 128;
-                bufReadBase = _bakedLightTexture_spot_2;
-                break;
-            case LightType::Spot3:
-                bufReadWidth = 256;
-                bufReadHeight = 256;
-                bufReadBase = _bakedLightTexture_spot_3;
-                break;
-            default:
-                continue;
-        }
+    int32_t rightEdge = bufWriteX + bufWriteWidth;
+    int32_t bottomEdge = bufWriteY + bufWriteHeight;
 
-        // Clamp the reads to be no larger than the buffer size
-        bufReadHeight = std::min<uint32_t>(_pixelInfo.height, bufReadHeight);
-        bufReadWidth = std::min<uint32_t>(_pixelInfo.width, bufReadWidth);
+    if (rightEdge > _pixelInfo.width)
+    {
+        bufWriteWidth -= rightEdge - _pixelInfo.width;
+    }
+    if (bottomEdge > _pixelInfo.height)
+    {
+        bufWriteHeight -= bottomEdge - _pixelInfo.height;
+    }
 
-        bufWriteX = inRectCentreX - bufReadWidth / 2;
-        bufWriteY = inRectCentreY - bufReadHeight / 2;
+    if (bufWriteWidth <= 0)
+        return false;
+    if (bufWriteHeight <= 0)
+        return false;
+
+    stamp.Texture = bufReadBase;
+    stamp.TextureWidth = bufReadWidth;
+    stamp.X = bufWriteX;
+    stamp.Y = bufWriteY;
+    stamp.Width = bufWriteWidth;
+    stamp.Height = bufWriteHeight;
+    stamp.Intensity = entry.LightIntensity;
+    return true;
+}
 
-        bufWriteWidth = bufReadWidth;
-        bufWriteHeight = bufReadHeight;
+/**
+ * Adds the part of a light that falls inside the given rectangle of the light buffer.
+ */
+static void LightFXAccumulateStamp(const LightStamp& stamp, uint8_t* buffer, const ScreenRect& clip)
+{
+    int32_t left = std::max(stamp.X, clip.GetLeft());
+    int32_t top = std::max(stamp.Y, clip.GetTop());
+    int32_t right = std::min(stamp.X + stamp.Width, clip.GetRight());
+    int32_t bottom = std::min(stamp.Y + stamp.Height, clip.GetBottom());
+    if (left >= right || top >= bottom)
+        return;
 
-        if (bufWriteX < 0)
+    for (int32_t y = top; y < bottom; y++)
+    {
+        const uint8_t* src = stamp.Texture + (y - stamp.Y) * stamp.TextureWidth + (left - stamp.X);
+        uint8_t* dst = buffer + y * _pixelInfo.width + left;
+        if (stamp.Intensity == 0xFF)
         {
-            bufReadBase += -bufWriteX;
-            bufWriteWidth += bufWriteX;
+            for (int32_t x = left; x < right; x++)
+            {
+                *dst = std::min(0xFF, *dst + *src);
+                dst++;
+                src++;
+            }
         }
         else
         {
-            bufWriteBase += bufWriteX;
+            for (int32_t x = left; x < right; x++)
+            {
+                *dst = std::min(0xFF, *dst + (((*src) * (1 + stamp.Intensity)) >> 8));
+                dst++;
+                src++;
+            }
         }
+    }
+}
 
-        if (bufWriteWidth <= 0)
-            continue;
+void LightFXRenderLightsToFrontBuffer()
+{
+    if (_light_rendered_buffer_front == nullptr)
+    {
+        return;
+    }
 
-        if (bufWriteY < 0)
-        {
-            bufReadBase += -bufWriteY * bufReadWidth;
-            bufWriteHeight += bufWriteY;
-        }
-        else
-        {
-            bufWriteBase += bufWriteY * _pixelInfo.width;
-        }
+    static std::vector<LightStamp> stamps;
+    static std::vector<uint32_t> binOffsets;
+    static std::vector<uint32_t> binStamps;
 
-        if (bufWriteHeight <= 0)
-            continue;
+    _lightPolution_back = 0;
 
-        int32_t rightEdge = bufWriteX + bufWriteWidth;
-        int32_t bottomEdge = bufWriteY + bufWriteHeight;
+    //  LOG_WARNING("%i lights", LightListCurrentCountFront);
 
-        if (rightEdge > _pixelInfo.width)
-        {
-            bufWriteWidth -= rightEdge - _pixelInfo.width;
-        }
-        if (bottomEdge > _pixelInfo.height)
+    stamps.clear();
+    for (uint32_t light = 0; light < LightListCurrentCountFront; light++)
+    {
+        LightStamp stamp;
+        if (LightFXGetStamp(_LightListFront[light], stamp))
         {
-            bufWriteHeight -= bottomEdge - _pixelInfo.height;
+            _lightPolution_back += (stamp.Width * stamp.Height) / 256;
+            stamps.push_back(stamp);
         }
+    }
 
-        if (bufWriteWidth <= 0)
-            continue;
-        if (bufWriteHeight <= 0)
-            continue;
-
-        _lightPolution_back += (bufWriteWidth * bufWriteHeight) / 256;
+    // Bin the lights by the screen tiles they overlap, keeping them in list order within each tile
+    int32_t tilesX = (_pixelInfo.width + kLightTileSize - 1) / kLightTileSize;
+    int32_t tilesY = (_pixelInfo.height + kLightTileSize - 1) / kLightTileSize;
+    if (tilesX <= 0 || tilesY <= 0)
+    {
+        return;
+    }
 
-        bufReadSkip = bufReadWidth - bufWriteWidth;
-        bufWriteSkip = _pixelInfo.width - bufWriteWidth;
+    binOffsets.assign(static_cast<size_t>(tilesX) * tilesY + 1, 0);
+    for (const auto& stamp : stamps)
+    {
+        for (int32_t ty = stamp.Y / kLightTileSize; ty <= (stamp.Y + stamp.Height - 1) / kLightTileSize; ty++)
+        {
+            for (int32_t tx = stamp.X / kLightTileSize; tx <= (stamp.X + stamp.Width - 1) / kLightTileSize; tx++)
+            {
+                binOffsets[ty * tilesX + tx + 1]++;
+            }
+        }
+    }
+    for (size_t i = 1; i < binOffsets.size(); i++)
+    {
+        binOffsets[i] += binOffsets[i - 1];
+    }
 
-        if (entry->LightIntensity == 0xFF)
+    binStamps.resize(binOffsets.back());
+    {
+        std::vector<uint32_t> binFill(binOffsets.begin(), binOffsets.end() - 1);
+        for (uint32_t i = 0; i < stamps.size(); i++)
         {
-            for (int32_t y = 0; y < bufWriteHeight; y++)
+            const auto& stamp = stamps[i];
+            for (int32_t ty = stamp.Y / kLightTileSize; ty <= (stamp.Y + stamp.Height - 1) / kLightTileSize; ty++)
             {
-                for (int32_t x = 0; x < bufWriteWidth; x++)
+                for (int32_t tx = stamp.X / kLightTileSize; tx <= (stamp.X + stamp.Width - 1) / kLightTileSize; tx++)
                 {
-                    *bufWriteBase = std::min(0xFF, *bufWriteBase + *bufReadBase);
-                    bufWriteBase++;
-                    bufReadBase++;
+                    binStamps[binFill[ty * tilesX + tx]++] = i;
                 }
-
-                bufWriteBase += bufWriteSkip;
-                bufReadBase += bufReadSkip;
             }
         }
-        else
+    }
+
+    // Each tile row is cleared and accumulated independently, so rows can be processed in parallel
+    auto* buffer = static_cast<uint8_t*>(_light_rendered_buffer_front);
+    LightFXParallelFor(tilesY, 1, [&](size_t begin, size_t end) {
+        for (auto ty = static_cast<int32_t>(begin); ty < static_cast<int32_t>(end); ty++)
         {
-            for (int32_t y = 0; y < bufWriteHeight; y++)
+            int32_t top = ty * kLightTileSize;
+            int32_t bottom = std::min(top + kLightTileSize, _pixelInfo.height);
+            std::memset(buffer + top * _pixelInfo.width, 0, (bottom - top) * _pixelInfo.width);
+
+            for (int32_t tx = 0; tx < tilesX; tx++)
             {
-                for (int32_t x = 0; x < bufWriteWidth; x++)
+                int32_t left = tx * kLightTileSize;
+                int32_t right = std::min(left + kLightTileSize, _pixelInfo.width);
+                ScreenRect clip{ { left, top }, { right, bottom } };
+
+                auto bin = static_cast<size_t>(ty) * tilesX + tx;
+                for (auto i = binOffsets[bin]; i < binOffsets[bin + 1]; i++)
                 {
-                    *bufWriteBase = std::min(0xFF, *bufWriteBase + (((*bufReadBase) * (1 + entry->LightIntensity)) >> 8));
-                    bufWriteBase++;
-                    bufReadBase++;
+                    LightFXAccumulateStamp(stamps[binStamps[i]], buffer, clip);
                 }
-
-                bufWriteBase += bufWriteSkip;
-                bufReadBase += bufReadSkip;
             }
         }
-    }
+    });
 }
 
 void* LightFXGetFrontBuffer()
@@ -698,29 +904,29 @@ uint32_t LightFXGetLightPolution()
 static constexpr int16_t offsetLookup[] = {
     10, 10, 9, 8, 7, 6, 4, 2, 0, -2, -4, -6, -7, -8, -9, -10, -10, -10, -9, -8, -7, -6, -4, -2, 0, 2, 4, 6, 7, 8, 9, 10,
 };
-void LightFxAddLightsMagicVehicle_ObservationTower(const Vehicle* vehicle)
+void LightFxAddLightsMagicVehicle_ObservationTower(const Vehicle* vehicle, const CoordsXYZ& drawPos)
 {
-    LightFXAdd3DLight(*vehicle, 0, { vehicle->x, vehicle->y + 16, vehicle->z }, LightType::Spot3);
-    LightFXAdd3DLight(*vehicle, 1, { vehicle->x + 16, vehicle->y, vehicle->z }, LightType::Spot3);
-    LightFXAdd3DLight(*vehicle, 2, { vehicle->x - 16, vehicle->y, vehicle->z }, LightType::Spot3);
-    LightFXAdd3DLight(*vehicle, 3, { vehicle->x, vehicle->y - 16, vehicle->z }, LightType::Spot3);
+    LightFXAdd3DLight(*vehicle, 0, { drawPos.x, drawPos.y + 16, drawPos.z }, LightType::Spot3);
+    LightFXAdd3DLight(*vehicle, 1, { drawPos.x + 16, drawPos.y, drawPos.z }, LightType::Spot3);
+    LightFXAdd3DLight(*vehicle, 2, { drawPos.x - 16, drawPos.y, drawPos.z }, LightType::Spot3);
+    LightFXAdd3DLight(*vehicle, 3, { drawPos.x, drawPos.y - 16, drawPos.z }, LightType::Spot3);
 }
 
-void LightFxAddLightsMagicVehicle_MineTrainCoaster(const Vehicle* vehicle)
+void LightFxAddLightsMagicVehicle_MineTrainCoaster(const Vehicle* vehicle, const CoordsXYZ& drawPos)
 {
     if (vehicle == vehicle->TrainHead())
     {
-        int16_t place_x = vehicle->x - offsetLookup[(vehicle->Orientation + 0) % 32] * 2;
-        int16_t place_y = vehicle->y - offsetLookup[(vehicle->Orientation + 8) % 32] * 2;
-        LightFXAdd3DLight(*vehicle, 0, { place_x, place_y, vehicle->z }, LightType::Spot3);
+        int16_t place_x = drawPos.x - offsetLookup[(vehicle->Orientation + 0) % 32] * 2;
+        int16_t place_y = drawPos.y - offsetLookup[(vehicle->Orientation + 8) % 32] * 2;
+        LightFXAdd3DLight(*vehicle, 0, { place_x, place_y, drawPos.z }, LightType::Spot3);
     }
 }
 
-void LightFxAddLightsMagicVehicle_ChairLift(const Vehicle* vehicle)
+void LightFxAddLightsMagicVehicle_ChairLift(const Vehicle* vehicle, const CoordsXYZ& drawPos)
 {
-    LightFXAdd3DLight(*vehicle, 0, { vehicle->x, vehicle->y, vehicle->z - 16 }, LightType::Lantern2);
+    LightFXAdd3DLight(*vehicle, 0, { drawPos.x, drawPos.y, drawPos.z - 16 }, LightType::Lantern2);
 }
-void LightFxAddLightsMagicVehicle_BoatHire(const Vehicle* vehicle)
+void LightFxAddLightsMagicVehicle_BoatHire(const Vehicle* vehicle, const CoordsXYZ& drawPos)
 {
     Vehicle* vehicle_draw = vehicle->TrainHead();
     auto* nextVeh = GetEntity<Vehicle>(vehicle_draw->next_vehicle_on_train);
@@ -728,57 +934,59 @@ void LightFxAddLightsMagicVehicle_BoatHire(const Vehicle* vehicle)
     {
         vehicle_draw = nextVeh;
     }
-    int16_t place_x = vehicle_draw->x;
-    int16_t place_y = vehicle_draw->y;
+    // The lights are placed relative to the second car, which is drawn at its own tweened position
+    const auto followedPos = vehicle_draw == vehicle ? drawPos : EntityTweener::Get().GetDrawPosition(*vehicle_draw);
+    int16_t place_x = followedPos.x;
+    int16_t place_y = followedPos.y;
     place_x -= offsetLookup[(vehicle_draw->Orientation + 0) % 32];
     place_y -= offsetLookup[(vehicle_draw->Orientation + 8) % 32];
-    LightFXAdd3DLight(*vehicle, 0, { place_x, place_y, vehicle_draw->z }, LightType::Spot2);
+    LightFXAdd3DLight(*vehicle, 0, { place_x, place_y, followedPos.z }, LightType::Spot2);
     place_x -= offsetLookup[(vehicle_draw->Orientation + 0) % 32];
     place_y -= offsetLookup[(vehicle_draw->Orientation + 8) % 32];
-    LightFXAdd3DLight(*vehicle, 1, { place_x, place_y, vehicle_draw->z }, LightType::Spot2);
+    LightFXAdd3DLight(*vehicle, 1, { place_x, place_y, followedPos.z }, LightType::Spot2);
 }
-void LightFxAddLightsMagicVehicle_Monorail(const Vehicle* vehicle)
+void LightFxAddLightsMagicVehicle_Monorail(const Vehicle* vehicle, const CoordsXYZ& drawPos)
 {
-    LightFXAdd3DLight(*vehicle, 0, { vehicle->x, vehicle->y, vehicle->z + 12 }, LightType::Spot2);
-    int16_t place_x = vehicle->x;
-    int16_t place_y = vehicle->y;
+    LightFXAdd3DLight(*vehicle, 0, { drawPos.x, drawPos.y, drawPos.z + 12 }, LightType::Spot2);
+    int16_t place_x = drawPos.x;
+    int16_t place_y = drawPos.y;
     if (vehicle == vehicle->TrainHead())
     {
         place_x -= offsetLookup[(vehicle->Orientation + 0) % 32] * 2;
         place_y -= offsetLookup[(vehicle->Orientation + 8) % 32] * 2;
-        LightFXAdd3DLight(*vehicle, 1, { place_x, place_y, vehicle->z + 10 }, LightType::Lantern3);
+        LightFXAdd3DLight(*vehicle, 1, { place_x, place_y, drawPos.z + 10 }, LightType::Lantern3);
         place_x -= offsetLookup[(vehicle->Orientation + 0) % 32] * 3;
         place_y -= offsetLookup[(vehicle->Orientation + 8) % 32] * 3;
-        LightFXAdd3DLight(*vehicle, 2, { place_x, place_y, vehicle->z + 2 }, LightType::Lantern3);
+        LightFXAdd3DLight(*vehicle, 2, { place_x, place_y, drawPos.z + 2 }, LightType::Lantern3);
     }
     if (vehicle == vehicle->TrainTail())
     {
         place_x += offsetLookup[(vehicle->Orientation + 0) % 32] * 2;
         place_y += offsetLookup[(vehicle->Orientation + 8) % 32] * 2;
-        LightFXAdd3DLight(*vehicle, 3, { place_x, place_y, vehicle->z + 10 }, LightType::Lantern3);
+        LightFXAdd3DLight(*vehicle, 3, { place_x, place_y, drawPos.z + 10 }, LightType::Lantern3);
         place_x += offsetLookup[(vehicle->Orientation + 0) % 32] * 2;
         place_y += offsetLookup[(vehicle->Orientation + 8) % 32] * 2;
-        LightFXAdd3DLight(*vehicle, 4, { place_x, place_y, vehicle->z + 2 }, LightType::Lantern3);
+        LightFXAdd3DLight(*vehicle, 4, { place_x, place_y, drawPos.z + 2 }, LightType::Lantern3);
     }
 }
-void LightFxAddLightsMagicVehicle_MiniatureRailway(const Vehicle* vehicle)
+void LightFxAddLightsMagicVehicle_MiniatureRailway(const Vehicle* vehicle, const CoordsXYZ& drawPos)
 {
     if (vehicle == vehicle->TrainHead())
     {
-        int16_t place_x = vehicle->x - offsetLookup[(vehicle->Orientation + 0) % 32] * 2;
-        int16_t place_y = vehicle->y - offsetLookup[(vehicle->Orientation + 8) % 32] * 2;
-        LightFXAdd3DLight(*vehicle, 1, { place_x, place_y, vehicle->z + 10 }, LightType::Lantern3);
+        int16_t place_x = drawPos.x - offsetLookup[(vehicle->Orientation + 0) % 32] * 2;
+        int16_t place_y = drawPos.y - offsetLookup[(vehicle->Orientation + 8) % 32] * 2;
+        LightFXAdd3DLight(*vehicle, 1, { place_x, place_y, drawPos.z + 10 }, LightType::Lantern3);
         place_x -= offsetLookup[(vehicle->Orientation + 0) % 32] * 2;
         place_y -= offsetLookup[(vehicle->Orientation + 8) % 32] * 2;
-        LightFXAdd3DLight(*vehicle, 2, { place_x, place_y, vehicle->z + 2 }, LightType::Lantern3);
+        LightFXAdd3DLight(*vehicle, 2, { place_x, place_y, drawPos.z + 2 }, LightType::Lantern3);
     }
     else
     {
-        LightFXAdd3DLight(*vehicle, 0, { vehicle->x, vehicle->y, vehicle->z + 10 }, LightType::Lantern3);
+        LightFXAdd3DLight(*vehicle, 0, { drawPos.x, drawPos.y, drawPos.z + 10 }, LightType::Lantern3);
     }
 }
 
-void LightFXAddLightsMagicVehicle(const Vehicle* vehicle)
+void LightFXAddLightsMagicVehicle(const Vehicle* vehicle, const CoordsXYZ& drawPos)
 {
     auto ride = vehicle->GetRide();
     if (ride == nullptr)
@@ -786,7 +994,7 @@ void LightFXAddLightsMagicVehicle(const Vehicle* vehicle)
 
     const auto& rtd = GetRideTypeDescriptor(ride->type);
     if (rtd.LightFXAddLightsMagicVehicle != nullptr)
-        rtd.LightFXAddLightsMagicVehicle(vehicle);
+        rtd.LightFXAddLightsMagicVehicle(vehicle, drawPos);
 }
 
 void LightFxAddKioskLights(const CoordsXY& mapPosition, const int32_t height, const uint8_t zOffset)
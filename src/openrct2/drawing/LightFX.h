@@ -63,13 +63,13 @@ void LightFXAdd3DLight(const EntityBase& entity, const uint8_t id, const CoordsX
 void LightFXAdd3DLightMagicFromDrawingTile(
     const CoordsXY& mapPosition, int16_t offsetX, int16_t offsetY, int16_t offsetZ, LightType lightType);
 
-void LightFXAddLightsMagicVehicle(const Vehicle* vehicle);
-void LightFxAddLightsMagicVehicle_ObservationTower(const Vehicle* vehicle);
-void LightFxAddLightsMagicVehicle_MineTrainCoaster(const Vehicle* vehicle);
-void LightFxAddLightsMagicVehicle_ChairLift(const Vehicle* vehicle);
-void LightFxAddLightsMagicVehicle_BoatHire(const Vehicle* vehicle);
-void LightFxAddLightsMagicVehicle_Monorail(const Vehicle* vehicle);
-void LightFxAddLightsMagicVehicle_MiniatureRailway(const Vehicle* vehicle);
+void LightFXAddLightsMagicVehicle(const Vehicle* vehicle, const CoordsXYZ& drawPos);
+void LightFxAddLightsMagicVehicle_ObservationTower(const Vehicle* vehicle, const CoordsXYZ& drawPos);
+void LightFxAddLightsMagicVehicle_MineTrainCoaster(const Vehicle* vehicle, const CoordsXYZ& drawPos);
+void LightFxAddLightsMagicVehicle_ChairLift(const Vehicle* vehicle, const CoordsXYZ& drawPos);
+void LightFxAddLightsMagicVehicle_BoatHire(const Vehicle* vehicle, const CoordsXYZ& drawPos);
+void LightFxAddLightsMagicVehicle_Monorail(const Vehicle* vehicle, const CoordsXYZ& drawPos);
+void LightFxAddLightsMagicVehicle_MiniatureRailway(const Vehicle* vehicle, const CoordsXYZ& drawPos);
 
 void LightFxAddKioskLights(const CoordsXY& mapPosition, const int32_t height, const uint8_t zOffset);
 void LightFxAddShopLights(const CoordsXY& mapPosition, const uint8_t direction, const int32_t height, const uint8_t zOffset);
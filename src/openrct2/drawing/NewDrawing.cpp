@@ -15,6 +15,7 @@
 #include "../localisation/StringIds.h"
 #include "../paint/Painter.h"
 #include "../platform/Platform.h"
+#include "../ui/DeferredUi.h"
 #include "../ui/UiContext.h"
 #include "../world/Location.hpp"
 #include "IDrawingContext.h"
@@ -153,6 +154,12 @@ void DrawingEngineSetVSync(bool vsync)
 
 void GfxSetDirtyBlocks(const ScreenRect& rect)
 {
+    if (auto* deferred = GetDeferredInvalidations(); deferred != nullptr)
+    {
+        deferred->ScreenAreas.push_back(rect);
+        return;
+    }
+
     auto drawingEngine = GetDrawingEngine();
     if (drawingEngine != nullptr)
     {
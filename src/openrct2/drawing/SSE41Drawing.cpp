@@ -8,10 +8,12 @@
  *****************************************************************************/
 
 #include "../core/Guard.hpp"
+#include "../paint/Paint.h"
 #include "Drawing.h"
 
 #ifdef __SSE4_1__
 
+#    include <bit>
 #    include <immintrin.h>
 
 void MaskSse4_1(
@@ -55,6 +57,129 @@ void MaskSse4_1(
     }
 }
 
+size_t PaintSortCollectSse4_1(
+    const PaintSortBounds& bounds, size_t begin, size_t end, const PaintStructBoundBox& initialBBox, uint8_t rotation,
+    uint32_t* matches)
+{
+    // Rotations 1 and 2 reverse the x comparisons, rotations 2 and 3 reverse the y comparisons.
+    const __m128i allSet = _mm_set1_epi32(-1);
+    const __m128i flipX = (rotation == 1 || rotation == 2) ? allSet : _mm_setzero_si128();
+    const __m128i flipY = (rotation == 2 || rotation == 3) ? allSet : _mm_setzero_si128();
+    const __m128i keepX = _mm_xor_si128(flipX, allSet);
+    const __m128i keepY = _mm_xor_si128(flipY, allSet);
+
+    const __m128i initX = _mm_set1_epi32(initialBBox.x);
+    const __m128i initY = _mm_set1_epi32(initialBBox.y);
+    const __m128i initZ = _mm_set1_epi32(initialBBox.z);
+    const __m128i initXEnd = _mm_set1_epi32(initialBBox.x_end);
+    const __m128i initYEnd = _mm_set1_epi32(initialBBox.y_end);
+    const __m128i initZEnd = _mm_set1_epi32(initialBBox.z_end);
+
+    size_t count = 0;
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4)
+    {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bounds.X + i));
+        const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bounds.Y + i));
+        const __m128i z = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bounds.Z + i));
+        const __m128i xEnd = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bounds.XEnd + i));
+        const __m128i yEnd = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bounds.YEnd + i));
+        const __m128i zEnd = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bounds.ZEnd + i));
+        const __m128i neighbour = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bounds.NeighbourMask + i));
+
+        // initial.end >= current.start on each axis, inverted for reversed axes.
+        const __m128i beforeX = _mm_xor_si128(_mm_cmpgt_epi32(x, initXEnd), keepX);
+        const __m128i beforeY = _mm_xor_si128(_mm_cmpgt_epi32(y, initYEnd), keepY);
+        const __m128i beforeZ = _mm_xor_si128(_mm_cmpgt_epi32(z, initZEnd), allSet);
+        // initial.start < current.end on each axis, inverted for reversed axes.
+        const __m128i overlapX = _mm_xor_si128(_mm_cmpgt_epi32(xEnd, initX), flipX);
+        const __m128i overlapY = _mm_xor_si128(_mm_cmpgt_epi32(yEnd, initY), flipY);
+        const __m128i overlapZ = _mm_cmpgt_epi32(zEnd, initZ);
+
+        const __m128i before = _mm_and_si128(_mm_and_si128(beforeX, beforeY), _mm_and_si128(beforeZ, neighbour));
+        const __m128i overlap = _mm_and_si128(_mm_and_si128(overlapX, overlapY), overlapZ);
+        auto bits = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_andnot_si128(overlap, before))));
+        while (bits != 0)
+        {
+            matches[count++] = static_cast<uint32_t>(i + std::countr_zero(bits));
+            bits &= bits - 1;
+        }
+    }
+    return count + PaintSortCollectScalar(bounds, i, end, initialBBox, rotation, matches + count);
+}
+
+// Looks up 16 palette indices at once by shuffling each 16 entry slice of the palette and keeping the lanes whose
+// high nibble selects that slice.
+static __m128i PaletteLookupSse4_1(const uint8_t* palette, __m128i indices)
+{
+    const __m128i lowMask = _mm_set1_epi8(0x0F);
+    const __m128i low = _mm_and_si128(indices, lowMask);
+    const __m128i high = _mm_and_si128(_mm_srli_epi16(indices, 4), lowMask);
+    __m128i result = _mm_setzero_si128();
+    for (int32_t slice = 0; slice < 16; slice++)
+    {
+        const __m128i table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(palette + (slice * 16)));
+        const __m128i select = _mm_cmpeq_epi8(high, _mm_set1_epi8(static_cast<char>(slice)));
+        result = _mm_or_si128(result, _mm_and_si128(_mm_shuffle_epi8(table, low), select));
+    }
+    return result;
+}
+
+template<DrawBlendOp TBlendOp>
+static void BlitRowSse4_1(const uint8_t* src, uint8_t* dst, size_t count, const PaletteMap& paletteMap)
+{
+    if constexpr ((TBlendOp & (BLEND_SRC | BLEND_DST)) != 0)
+    {
+        // Indices past the end of the map resolve to 0, leave those to the scalar path.
+        if (paletteMap.GetDataLength() < 256)
+        {
+            BlitRowScalar<TBlendOp>(src, dst, count, paletteMap);
+            return;
+        }
+    }
+
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i pixel = source;
+        if constexpr ((TBlendOp & BLEND_SRC) != 0)
+        {
+            pixel = PaletteLookupSse4_1(paletteMap.GetData(), source);
+        }
+        else if constexpr ((TBlendOp & BLEND_DST) != 0)
+        {
+            pixel = PaletteLookupSse4_1(paletteMap.GetData(), dest);
+        }
+
+        // Transparent source pixels and pixels remapped to 0 keep the destination.
+        __m128i keep = _mm_cmpeq_epi8(source, zero);
+        if constexpr ((TBlendOp & (BLEND_SRC | BLEND_DST)) != 0)
+        {
+            keep = _mm_or_si128(keep, _mm_cmpeq_epi8(pixel, zero));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_blendv_epi8(pixel, dest, keep));
+    }
+    BlitRowScalar<TBlendOp>(src + i, dst + i, count - i, paletteMap);
+}
+
+BlitRowFunc GetBlitRowSse4_1(DrawBlendOp blendOp)
+{
+    switch (blendOp)
+    {
+        case BLEND_TRANSPARENT:
+            return BlitRowSse4_1<BLEND_TRANSPARENT>;
+        case BLEND_TRANSPARENT | BLEND_SRC:
+            return BlitRowSse4_1<BLEND_TRANSPARENT | BLEND_SRC>;
+        case BLEND_TRANSPARENT | BLEND_DST:
+            return BlitRowSse4_1<BLEND_TRANSPARENT | BLEND_DST>;
+        default:
+            return nullptr;
+    }
+}
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -68,4 +193,18 @@ void MaskSse4_1(
     OpenRCT2::Guard::Fail("SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
 }
 
+size_t PaintSortCollectSse4_1(
+    const PaintSortBounds& bounds, size_t begin, size_t end, const PaintStructBoundBox& initialBBox, uint8_t rotation,
+    uint32_t* matches)
+{
+    OpenRCT2::Guard::Fail("SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+    return 0;
+}
+
+BlitRowFunc GetBlitRowSse4_1(DrawBlendOp blendOp)
+{
+    OpenRCT2::Guard::Fail("SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+    return nullptr;
+}
+
 #endif // __SSE4_1__
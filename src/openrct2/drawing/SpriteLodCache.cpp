@@ -0,0 +1,447 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "SpriteLodCache.h"
+
+#include "../sprites.h"
+
+#include <algorithm>
+#include <array>
+#include <list>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+struct SpriteLodClockEntry
+{
+    ImageIndex Image{};
+    const SpriteLod* Lod{};
+};
+
+struct SpriteLodCacheEntry
+{
+    const uint8_t* SourceData{};
+    uint8_t ZoomShift{};
+    uint8_t PhaseX{};
+    uint8_t PhaseY{};
+    std::shared_ptr<const SpriteLod> Lod;
+    std::list<SpriteLodClockEntry>::iterator ClockIt;
+};
+
+struct SpriteLodCacheCounters
+{
+    std::atomic<uint64_t> Hits{};
+    std::atomic<uint64_t> Misses{};
+};
+
+/**
+ * The LODs a drawing thread used most recently, so drawing the same sprites again skips the shared lock and the hash
+ * lookup. The slots are dropped whenever the generation changes.
+ */
+struct SpriteLodThreadCache
+{
+    struct Slot
+    {
+        ImageIndex Image = ImageIndexUndefined;
+        const uint8_t* SourceData{};
+        uint8_t ZoomShift{};
+        uint8_t PhaseX{};
+        uint8_t PhaseY{};
+        std::shared_ptr<const SpriteLod> Lod;
+    };
+
+    static constexpr size_t kNumSlots = 64;
+
+    uint32_t Generation{};
+    std::array<Slot, kNumSlots> Slots;
+    std::shared_ptr<SpriteLodCacheCounters> Counters;
+};
+
+// Lookups take a shared lock, building and evicting take an exclusive one. Callers keep the LOD alive through the
+// shared pointer, so an entry can be evicted while another thread is still drawing it.
+static std::shared_mutex _mutex;
+static std::unordered_map<ImageIndex, std::vector<SpriteLodCacheEntry>> _entries;
+static size_t _entryCount{};
+static size_t _bytes{};
+static size_t _budget = kSpriteLodCacheDefaultBudget;
+static uint64_t _evictions{};
+
+// Every cached LOD in insertion order, the hand points at the next eviction candidate.
+static std::list<SpriteLodClockEntry> _clock;
+static std::list<SpriteLodClockEntry>::iterator _clockHand = _clock.end();
+
+// Bumped when LODs are evicted or may no longer match their source images, which drops the thread caches.
+static std::atomic<uint32_t> _generation{};
+
+// Hits and misses are counted per thread so drawing threads do not contend on them.
+static std::mutex _countersMutex;
+static std::vector<std::shared_ptr<SpriteLodCacheCounters>> _threadCounters;
+
+static SpriteLodThreadCache& GetThreadCache()
+{
+    thread_local SpriteLodThreadCache cache = [] {
+        SpriteLodThreadCache result;
+        result.Counters = std::make_shared<SpriteLodCacheCounters>();
+        std::lock_guard lock(_countersMutex);
+        _threadCounters.push_back(result.Counters);
+        return result;
+    }();
+    return cache;
+}
+
+static void IncrementCounter(std::atomic<uint64_t>& counter)
+{
+    // Only the owning thread writes its counters, so a plain load and store is enough.
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+static size_t GetThreadCacheSlot(ImageIndex imageIndex, uint8_t zoomShift, uint8_t phaseX, uint8_t phaseY)
+{
+    const uint32_t key = imageIndex ^ (zoomShift << 29) ^ (phaseX << 21) ^ (phaseY << 13);
+    return ((key * 2654435761u) >> 16) % SpriteLodThreadCache::kNumSlots;
+}
+
+static void MarkReferenced(const SpriteLod& lod)
+{
+    // Avoid writing to the shared cache line when the bit is already set.
+    if (!lod.Referenced.load(std::memory_order_relaxed))
+    {
+        lod.Referenced.store(true, std::memory_order_relaxed);
+    }
+}
+
+static bool IsCacheable(ImageIndex imageIndex)
+{
+    // Scrolling text and the temporary image are rewritten in place, so their contents can change without notice.
+    if (imageIndex == ImageIndexUndefined || imageIndex == SPR_TEMP)
+    {
+        return false;
+    }
+    return imageIndex < SPR_SCROLLING_TEXT_START || imageIndex >= SPR_SCROLLING_TEXT_END;
+}
+
+static size_t GetEntrySize(const SpriteLod& lod)
+{
+    return sizeof(SpriteLod) + lod.Data.capacity();
+}
+
+/**
+ * Decodes the sampled pixels of each source row and re-encodes them as RLE. Colour 0 is transparent when minifying,
+ * so it is left out of the runs to keep zoom 0 drawing identical.
+ */
+static std::shared_ptr<SpriteLod> BuildSpriteLod(const G1Element& source, uint8_t zoomShift, uint8_t phaseX, uint8_t phaseY)
+{
+    const int32_t zoom = 1 << zoomShift;
+    const int32_t width = std::max(0, (source.width - phaseX + zoom - 1) >> zoomShift);
+    const int32_t height = std::max(0, (source.height - phaseY + zoom - 1) >> zoomShift);
+    if (width > 256)
+    {
+        // Run start positions are stored in a byte.
+        return nullptr;
+    }
+
+    auto lod = std::make_shared<SpriteLod>();
+    auto& data = lod->Data;
+    data.resize(static_cast<size_t>(height) * 2);
+
+    std::vector<uint8_t> row(width);
+    for (int32_t y = 0; y < height; y++)
+    {
+        std::fill(row.begin(), row.end(), 0);
+
+        const int32_t sourceY = phaseY + (y << zoomShift);
+        const uint8_t* src0 = source.offset;
+        const uint16_t lineOffset = src0[sourceY * 2] | (src0[sourceY * 2 + 1] << 8);
+        const uint8_t* nextRun = src0 + lineOffset;
+        bool isEndOfLine = false;
+        while (!isEndOfLine)
+        {
+            const uint8_t* src = nextRun;
+            uint8_t dataSize = *src++;
+            const int32_t firstPixelX = *src++;
+            isEndOfLine = (dataSize & 0x80) != 0;
+            dataSize &= 0x7F;
+            nextRun = src + dataSize;
+
+            for (int32_t i = 0; i < dataSize; i++)
+            {
+                const int32_t x = firstPixelX + i - phaseX;
+                if (x >= 0 && (x & (zoom - 1)) == 0 && (x >> zoomShift) < width)
+                {
+                    row[x >> zoomShift] = src[i];
+                }
+            }
+        }
+
+        const size_t lineStart = data.size();
+        if (lineStart > UINT16_MAX)
+        {
+            return nullptr;
+        }
+        data[y * 2] = lineStart & 0xFF;
+        data[y * 2 + 1] = (lineStart >> 8) & 0xFF;
+
+        size_t lastRun = SIZE_MAX;
+        for (int32_t x = 0; x < width;)
+        {
+            if (row[x] == 0)
+            {
+                x++;
+                continue;
+            }
+            int32_t runLength = 0;
+            while (x + runLength < width && row[x + runLength] != 0 && runLength < 0x7F)
+            {
+                runLength++;
+            }
+            lastRun = data.size();
+            data.push_back(static_cast<uint8_t>(runLength));
+            data.push_back(static_cast<uint8_t>(x));
+            data.insert(data.end(), row.begin() + x, row.begin() + x + runLength);
+            x += runLength;
+        }
+        if (lastRun == SIZE_MAX)
+        {
+            data.push_back(0x80);
+            data.push_back(0);
+        }
+        else
+        {
+            data[lastRun] |= 0x80;
+        }
+    }
+
+    data.shrink_to_fit();
+    lod->Element.offset = data.data();
+    lod->Element.width = width;
+    lod->Element.height = height;
+    lod->Element.flags = G1_FLAG_RLE_COMPRESSION;
+    return lod;
+}
+
+static void RemoveEntry(const SpriteLodCacheEntry& entry)
+{
+    if (_clockHand == entry.ClockIt)
+    {
+        _clockHand++;
+    }
+    _clock.erase(entry.ClockIt);
+    _bytes -= GetEntrySize(*entry.Lod);
+    _entryCount--;
+}
+
+/**
+ * Second chance (clock) eviction. The hand gives entries drawn since it last passed them another round and evicts the
+ * first one that was not drawn, stopping as soon as the required space is free.
+ */
+static void EvictUntilFits(size_t required)
+{
+    bool evicted = false;
+    while (_bytes + required > _budget && !_clock.empty())
+    {
+        if (_clockHand == _clock.end())
+        {
+            _clockHand = _clock.begin();
+        }
+
+        const auto candidate = *_clockHand;
+        if (candidate.Lod->Referenced.exchange(false, std::memory_order_relaxed))
+        {
+            _clockHand++;
+            continue;
+        }
+
+        auto it = _entries.find(candidate.Image);
+        auto& list = it->second;
+        auto entryIt = std::find_if(
+            list.begin(), list.end(), [&](const SpriteLodCacheEntry& entry) { return entry.Lod.get() == candidate.Lod; });
+        RemoveEntry(*entryIt);
+        list.erase(entryIt);
+        if (list.empty())
+        {
+            _entries.erase(it);
+        }
+        _evictions++;
+        evicted = true;
+    }
+
+    if (evicted)
+    {
+        _generation++;
+    }
+}
+
+std::shared_ptr<const SpriteLod> SpriteLodCacheGet(
+    ImageIndex imageIndex, const G1Element& source, uint8_t zoomShift, uint8_t phaseX, uint8_t phaseY)
+{
+    if (!IsCacheable(imageIndex) || !(source.flags & G1_FLAG_RLE_COMPRESSION))
+    {
+        return nullptr;
+    }
+
+    auto& threadCache = GetThreadCache();
+    const auto generation = _generation.load(std::memory_order_acquire);
+    if (threadCache.Generation != generation)
+    {
+        threadCache.Slots = {};
+        threadCache.Generation = generation;
+    }
+
+    auto& slot = threadCache.Slots[GetThreadCacheSlot(imageIndex, zoomShift, phaseX, phaseY)];
+    if (slot.Lod != nullptr && slot.Image == imageIndex && slot.SourceData == source.offset && slot.ZoomShift == zoomShift
+        && slot.PhaseX == phaseX && slot.PhaseY == phaseY)
+    {
+        IncrementCounter(threadCache.Counters->Hits);
+        MarkReferenced(*slot.Lod);
+        return slot.Lod;
+    }
+
+    const auto matches = [&](const SpriteLodCacheEntry& entry) {
+        return entry.SourceData == source.offset && entry.ZoomShift == zoomShift && entry.PhaseX == phaseX
+            && entry.PhaseY == phaseY;
+    };
+    const auto remember = [&](const std::shared_ptr<const SpriteLod>& lod) {
+        slot = { imageIndex, source.offset, zoomShift, phaseX, phaseY, lod };
+        return lod;
+    };
+
+    {
+        std::shared_lock lock(_mutex);
+        if (_budget == 0)
+        {
+            return nullptr;
+        }
+        auto it = _entries.find(imageIndex);
+        if (it != _entries.end())
+        {
+            auto entryIt = std::find_if(it->second.begin(), it->second.end(), matches);
+            if (entryIt != it->second.end())
+            {
+                IncrementCounter(threadCache.Counters->Hits);
+                MarkReferenced(*entryIt->Lod);
+                return remember(entryIt->Lod);
+            }
+        }
+    }
+
+    IncrementCounter(threadCache.Counters->Misses);
+    auto lod = BuildSpriteLod(source, zoomShift, phaseX, phaseY);
+    if (lod == nullptr)
+    {
+        return nullptr;
+    }
+
+    const auto size = GetEntrySize(*lod);
+    std::unique_lock lock(_mutex);
+    if (size > _budget)
+    {
+        return nullptr;
+    }
+
+    auto& list = _entries[imageIndex];
+    auto entryIt = std::find_if(list.begin(), list.end(), matches);
+    if (entryIt != list.end())
+    {
+        // Another thread built the same LOD in the meantime.
+        return remember(entryIt->Lod);
+    }
+
+    // Drop any copies built from data that has since been replaced.
+    list.erase(
+        std::remove_if(
+            list.begin(), list.end(),
+            [&](const SpriteLodCacheEntry& entry) {
+                if (entry.SourceData == source.offset)
+                {
+                    return false;
+                }
+                RemoveEntry(entry);
+                return true;
+            }),
+        list.end());
+
+    EvictUntilFits(size);
+
+    // New entries go just behind the hand, so they are the last to be considered for eviction.
+    auto clockIt = _clock.insert(_clockHand, { imageIndex, lod.get() });
+    _entries[imageIndex].push_back({ source.offset, zoomShift, phaseX, phaseY, lod, clockIt });
+    _entryCount++;
+    _bytes += size;
+    return remember(lod);
+}
+
+void SpriteLodCacheInvalidate(ImageIndex imageIndex)
+{
+    std::unique_lock lock(_mutex);
+    auto it = _entries.find(imageIndex);
+    if (it != _entries.end())
+    {
+        for (const auto& entry : it->second)
+        {
+            RemoveEntry(entry);
+        }
+        _entries.erase(it);
+    }
+    _generation++;
+}
+
+void SpriteLodCacheClear()
+{
+    std::unique_lock lock(_mutex);
+    _entries.clear();
+    _clock.clear();
+    _clockHand = _clock.end();
+    _entryCount = 0;
+    _bytes = 0;
+    _generation++;
+}
+
+void SpriteLodCacheSetBudget(size_t bytes)
+{
+    std::unique_lock lock(_mutex);
+    _budget = bytes;
+    EvictUntilFits(0);
+    _generation++;
+}
+
+SpriteLodCacheStats SpriteLodCacheGetStats()
+{
+    SpriteLodCacheStats stats;
+    {
+        std::lock_guard lock(_countersMutex);
+        for (const auto& counters : _threadCounters)
+        {
+            stats.Hits += counters->Hits.load(std::memory_order_relaxed);
+            stats.Misses += counters->Misses.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::shared_lock lock(_mutex);
+    stats.Evictions = _evictions;
+    stats.Entries = _entryCount;
+    stats.Bytes = _bytes;
+    stats.Budget = _budget;
+    return stats;
+}
+
+void SpriteLodCacheResetStats()
+{
+    {
+        // A hit or miss counted by another thread at the same time may survive the reset.
+        std::lock_guard lock(_countersMutex);
+        for (const auto& counters : _threadCounters)
+        {
+            counters->Hits.store(0, std::memory_order_relaxed);
+            counters->Misses.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    std::unique_lock lock(_mutex);
+    _evictions = 0;
+}
@@ -0,0 +1,58 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "Drawing.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * An RLE sprite holding every zoom-th pixel of a source sprite, starting at (PhaseX, PhaseY). Drawing it at zoom 0
+ * gives the same pixels as drawing the source sprite at that zoom level.
+ */
+struct SpriteLod
+{
+    G1Element Element;
+    std::vector<uint8_t> Data;
+    mutable std::atomic<bool> Referenced{ true };
+};
+
+struct SpriteLodCacheStats
+{
+    uint64_t Hits{};
+    uint64_t Misses{};
+    uint64_t Evictions{};
+    size_t Entries{};
+    size_t Bytes{};
+    size_t Budget{};
+
+    double GetHitRate() const
+    {
+        const auto lookups = Hits + Misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(Hits) / lookups;
+    }
+};
+
+constexpr size_t kSpriteLodCacheDefaultBudget = 16 * 1024 * 1024;
+
+/**
+ * Returns the downsampled copy of an RLE sprite for the given zoom level and sampling phase, building it if needed.
+ * Returns nullptr if the image can not be cached or does not fit in the memory budget.
+ */
+std::shared_ptr<const SpriteLod> SpriteLodCacheGet(
+    ImageIndex imageIndex, const G1Element& source, uint8_t zoomShift, uint8_t phaseX, uint8_t phaseY);
+void SpriteLodCacheInvalidate(ImageIndex imageIndex);
+void SpriteLodCacheClear();
+void SpriteLodCacheSetBudget(size_t bytes);
+SpriteLodCacheStats SpriteLodCacheGetStats();
+void SpriteLodCacheResetStats();
@@ -163,6 +163,8 @@ void X8DrawingEngine::Invalidate(int32_t left, int32_t top, int32_t right, int32
     if (top >= bottom)
         return;
 
+    _dirtyStats.PixelsInvalidated += static_cast<uint64_t>(right - left) * (bottom - top);
+
     right--;
     bottom--;
 
@@ -288,6 +290,16 @@ DrawPixelInfo* X8DrawingEngine::GetDPI()
     return &_bitsDPI;
 }
 
+const DirtyRegionStats& X8DrawingEngine::GetDirtyStats() const
+{
+    return _dirtyStats;
+}
+
+void X8DrawingEngine::ResetDirtyStats()
+{
+    _dirtyStats = {};
+}
+
 void X8DrawingEngine::ConfigureBits(uint32_t width, uint32_t height, uint32_t pitch)
 {
     size_t newBitsSize = pitch * height;
@@ -365,45 +377,47 @@ void X8DrawingEngine::ConfigureDirtyGrid()
 
 void X8DrawingEngine::DrawAllDirtyBlocks()
 {
-    // TODO: For optimal performance it is currently limited to a single column.
-    // The optimal approach would be to extract all dirty regions as rectangles not including
-    // parts that are not marked dirty and have the grid more fine grained.
-    // A situation like following:
+    // Merge the dirty blocks into rectangles that do not include any clean blocks. Each rectangle is grown to the right
+    // first and then downwards for as long as the whole span of the row is dirty. A situation like following:
     //
     //   0 1 2 3 4 5 6 7 8 9
     //   1 - - - - - - - - -
     //   2 - x x x x - - - -
     //   3 - x x - - - - - -
     //   4 - - - - - - - - -
-    //   5 - - - - - - - - -
-    //   6 - - - - - - - - -
-    //   7 - - - - - - - - -
-    //   8 - - - - - - - - -
-    //   9 - - - - - - - - -
     //
-    // Would currently redraw {2,2} to {3,5} where {3,4} and {3,5} are not dirty. Choosing to do this
-    // per column eliminates this issue but limits it to rendering just a single column at a time.
+    // Is drawn as {1,2} to {4,2} and {1,3} to {2,3}, so every window is only traversed once per rectangle rather than
+    // once per column. The viewports inside each rectangle are still painted in parallel columns, see ViewportRender.
 
-    for (uint32_t x = 0; x < _dirtyGrid.BlockColumns; x++)
+    for (uint32_t y = 0; y < _dirtyGrid.BlockRows; y++)
     {
-        for (uint32_t y = 0; y < _dirtyGrid.BlockRows; y++)
+        uint32_t yOffset = y * _dirtyGrid.BlockColumns;
+        for (uint32_t x = 0; x < _dirtyGrid.BlockColumns; x++)
         {
-            uint32_t yOffset = y * _dirtyGrid.BlockColumns;
             if (_dirtyGrid.Blocks[yOffset + x] == 0)
             {
                 continue;
             }
 
-            // See comment above as to why this is 1.
-            const uint32_t columns = 1;
-
-            // Check rows
+            auto columns = GetNumDirtyColumns(x, y);
             auto rows = GetNumDirtyRows(x, y, columns);
             DrawDirtyBlocks(x, y, columns, rows);
+            x += columns - 1;
         }
     }
 }
 
+uint32_t X8DrawingEngine::GetNumDirtyColumns(const uint32_t x, const uint32_t y)
+{
+    uint32_t yOffset = y * _dirtyGrid.BlockColumns;
+    uint32_t xx = x;
+    while (xx < _dirtyGrid.BlockColumns && _dirtyGrid.Blocks[yOffset + xx] != 0)
+    {
+        xx++;
+    }
+    return xx - x;
+}
+
 uint32_t X8DrawingEngine::GetNumDirtyRows(const uint32_t x, const uint32_t y, const uint32_t columns)
 {
     uint32_t yy = y;
@@ -447,6 +461,9 @@ void X8DrawingEngine::DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns,
         return;
     }
 
+    _dirtyStats.RectanglesDrawn++;
+    _dirtyStats.PixelsRedrawn += static_cast<uint64_t>(right - left) * (bottom - top);
+
     // Draw region
     OnDrawDirtyBlock(x, y, columns, rows);
     WindowDrawAll(_bitsDPI, left, top, right, bottom);
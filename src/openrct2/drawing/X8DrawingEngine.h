@@ -36,6 +36,15 @@ namespace OpenRCT2
             uint8_t* Blocks;
         };
 
+        struct DirtyRegionStats
+        {
+            // Area passed to Invalidate, overlapping invalidations are counted each time.
+            uint64_t PixelsInvalidated;
+            // Area of the dirty rectangles that were actually redrawn.
+            uint64_t PixelsRedrawn;
+            uint32_t RectanglesDrawn;
+        };
+
         class X8WeatherDrawer final : public IWeatherDrawer
         {
         private:
@@ -74,6 +83,7 @@ namespace OpenRCT2
             uint8_t* _bits = nullptr;
 
             DirtyGrid _dirtyGrid = {};
+            DirtyRegionStats _dirtyStats = {};
 
             DrawPixelInfo _bitsDPI = {};
 
@@ -112,6 +122,8 @@ namespace OpenRCT2
             void InvalidateImage(uint32_t image) override;
 
             DrawPixelInfo* GetDPI();
+            const DirtyRegionStats& GetDirtyStats() const;
+            void ResetDirtyStats();
 
         protected:
             void ConfigureBits(uint32_t width, uint32_t height, uint32_t pitch);
@@ -120,6 +132,7 @@ namespace OpenRCT2
         private:
             void ConfigureDirtyGrid();
             void DrawAllDirtyBlocks();
+            uint32_t GetNumDirtyColumns(const uint32_t x, const uint32_t y);
             uint32_t GetNumDirtyRows(const uint32_t x, const uint32_t y, const uint32_t columns);
             void DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns, uint32_t rows);
         };
@@ -12,6 +12,7 @@
 #include "../Diagnostic.h"
 #include "../Game.h"
 #include "../GameState.h"
+#include "../GameStateTransient.h"
 #include "../core/Algorithm.hpp"
 #include "../core/ChecksumStream.h"
 #include "../core/Crypt.h"
@@ -41,16 +42,9 @@
 
 using namespace OpenRCT2;
 
-static std::array<std::list<EntityId>, EnumValue(EntityType::Count)> gEntityLists;
-static std::vector<EntityId> _freeIdList;
-
-static bool _entityFlashingList[MAX_ENTITIES];
-
 constexpr const uint32_t SPATIAL_INDEX_SIZE = (kMaximumMapSizeTechnical * kMaximumMapSizeTechnical) + 1;
 constexpr uint32_t SPATIAL_INDEX_LOCATION_NULL = SPATIAL_INDEX_SIZE - 1;
 
-static std::array<std::vector<EntityId>, SPATIAL_INDEX_SIZE> gEntitySpatialIndex;
-
 static void FreeEntity(EntityBase& entity);
 
 static constexpr size_t GetSpatialIndexOffset(const CoordsXY& loc)
@@ -68,6 +62,15 @@ static constexpr size_t GetSpatialIndexOffset(const CoordsXY& loc)
     return tileX * kMaximumMapSizeTechnical + tileY;
 }
 
+static std::vector<EntityId>& GetSpatialIndexTile(size_t offset)
+{
+    // Sized on first use, so game states that never hold entities stay small
+    auto& spatialIndex = GetGameState().Transient->EntitySpatialIndex;
+    if (spatialIndex.empty())
+        spatialIndex.resize(SPATIAL_INDEX_SIZE);
+    return spatialIndex[offset];
+}
+
 constexpr bool EntityTypeIsMiscEntity(const EntityType type)
 {
     switch (type)
@@ -89,12 +92,12 @@ constexpr bool EntityTypeIsMiscEntity(const EntityType type)
 
 uint16_t GetEntityListCount(EntityType type)
 {
-    return static_cast<uint16_t>(gEntityLists[EnumValue(type)].size());
+    return static_cast<uint16_t>(GetGameState().Transient->EntityLists[EnumValue(type)].size());
 }
 
 uint16_t GetNumFreeEntities()
 {
-    return static_cast<uint16_t>(_freeIdList.size());
+    return static_cast<uint16_t>(GetGameState().Transient->EntityFreeIds.size());
 }
 
 std::string EntitiesChecksum::ToString() const
@@ -121,12 +124,12 @@ EntityBase* GetEntity(EntityId entityIndex)
 
 const std::vector<EntityId>& GetEntityTileList(const CoordsXY& spritePos)
 {
-    return gEntitySpatialIndex[GetSpatialIndexOffset(spritePos)];
+    return GetSpatialIndexTile(GetSpatialIndexOffset(spritePos));
 }
 
 static void ResetEntityLists()
 {
-    for (auto& list : gEntityLists)
+    for (auto& list : GetGameState().Transient->EntityLists)
     {
         list.clear();
     }
@@ -134,12 +137,13 @@ static void ResetEntityLists()
 
 static void ResetFreeIds()
 {
-    _freeIdList.clear();
-    _freeIdList.resize(MAX_ENTITIES);
+    auto& freeIdList = GetGameState().Transient->EntityFreeIds;
+    freeIdList.clear();
+    freeIdList.resize(MAX_ENTITIES);
 
     // List needs to be back to front to simplify removing
     auto nextId = 0;
-    std::for_each(std::rbegin(_freeIdList), std::rend(_freeIdList), [&](auto& elem) {
+    std::for_each(std::rbegin(freeIdList), std::rend(freeIdList), [&](auto& elem) {
         elem = EntityId::FromUnderlying(nextId);
         nextId++;
     });
@@ -147,7 +151,7 @@ static void ResetFreeIds()
 
 const std::list<EntityId>& GetEntityList(const EntityType id)
 {
-    return gEntityLists[EnumValue(id)];
+    return GetGameState().Transient->EntityLists[EnumValue(id)];
 }
 
 /**
@@ -181,7 +185,7 @@ void ResetAllEntities()
         spr->Type = EntityType::Null;
         spr->Id = EntityId::FromUnderlying(i);
 
-        _entityFlashingList[i] = false;
+        gameState.Transient->EntityFlashing[i] = false;
     }
     ResetEntityLists();
     ResetFreeIds();
@@ -198,7 +202,9 @@ static void EntitySpatialInsert(EntityBase* entity, const CoordsXY& newLoc);
  */
 void ResetEntitySpatialIndices()
 {
-    for (auto& vec : gEntitySpatialIndex)
+    auto& spatialIndex = GetGameState().Transient->EntitySpatialIndex;
+    spatialIndex.resize(SPATIAL_INDEX_SIZE);
+    for (auto& vec : spatialIndex)
     {
         vec.clear();
     }
@@ -250,7 +256,7 @@ static void EntityReset(EntityBase* entity)
 {
     // Need to retain how the sprite is linked in lists
     auto entityIndex = entity->Id;
-    _entityFlashingList[entityIndex.ToUnderlying()] = false;
+    GetGameState().Transient->EntityFlashing[entityIndex.ToUnderlying()] = false;
 
     Entity_t* tempEntity = reinterpret_cast<Entity_t*>(entity);
     *tempEntity = Entity_t();
@@ -263,7 +269,7 @@ static constexpr uint16_t MAX_MISC_SPRITES = 1600;
 
 static void AddToEntityList(EntityBase* entity)
 {
-    auto& list = gEntityLists[EnumValue(entity->Type)];
+    auto& list = GetGameState().Transient->EntityLists[EnumValue(entity->Type)];
     // Entity list must be in sprite_index order to prevent desync issues
     list.insert(std::lower_bound(std::begin(list), std::end(list), entity->Id), entity->Id);
 }
@@ -271,12 +277,13 @@ static void AddToEntityList(EntityBase* entity)
 static void AddToFreeList(EntityId index)
 {
     // Free list must be in reverse sprite_index order to prevent desync issues
-    _freeIdList.insert(std::upper_bound(std::rbegin(_freeIdList), std::rend(_freeIdList), index).base(), index);
+    auto& freeIdList = GetGameState().Transient->EntityFreeIds;
+    freeIdList.insert(std::upper_bound(std::rbegin(freeIdList), std::rend(freeIdList), index).base(), index);
 }
 
 static void RemoveFromEntityList(EntityBase* entity)
 {
-    auto& list = gEntityLists[EnumValue(entity->Type)];
+    auto& list = GetGameState().Transient->EntityLists[EnumValue(entity->Type)];
     auto ptr = BinaryFind(std::begin(list), std::end(list), entity->Id);
     if (ptr != std::end(list))
     {
@@ -318,7 +325,8 @@ static void PrepareNewEntity(EntityBase* base, const EntityType type)
 
 EntityBase* CreateEntity(EntityType type)
 {
-    if (_freeIdList.size() == 0)
+    auto& freeIdList = GetGameState().Transient->EntityFreeIds;
+    if (freeIdList.size() == 0)
     {
         // No free sprites.
         return nullptr;
@@ -333,18 +341,18 @@ EntityBase* CreateEntity(EntityType type)
         }
 
         // If there are less than MAX_MISC_SPRITES free slots, ensure other entities can be created.
-        if (_freeIdList.size() < MAX_MISC_SPRITES)
+        if (freeIdList.size() < MAX_MISC_SPRITES)
         {
             return nullptr;
         }
     }
 
-    auto* entity = GetEntity(_freeIdList.back());
+    auto* entity = GetEntity(freeIdList.back());
     if (entity == nullptr)
     {
         return nullptr;
     }
-    _freeIdList.pop_back();
+    freeIdList.pop_back();
 
     PrepareNewEntity(entity, type);
 
@@ -353,8 +361,9 @@ EntityBase* CreateEntity(EntityType type)
 
 EntityBase* CreateEntityAt(const EntityId index, const EntityType type)
 {
-    auto id = BinaryFind(std::rbegin(_freeIdList), std::rend(_freeIdList), index);
-    if (id == std::rend(_freeIdList))
+    auto& freeIdList = GetGameState().Transient->EntityFreeIds;
+    auto id = BinaryFind(std::rbegin(freeIdList), std::rend(freeIdList), index);
+    if (id == std::rend(freeIdList))
     {
         return nullptr;
     }
@@ -365,7 +374,7 @@ EntityBase* CreateEntityAt(const EntityId index, const EntityType type)
         return nullptr;
     }
 
-    _freeIdList.erase(std::next(id).base());
+    freeIdList.erase(std::next(id).base());
 
     PrepareNewEntity(entity, type);
     return entity;
@@ -406,7 +415,7 @@ void UpdateMoneyEffect()
 static void EntitySpatialInsert(EntityBase* entity, const CoordsXY& newLoc)
 {
     size_t newIndex = GetSpatialIndexOffset(newLoc);
-    auto& spatialVector = gEntitySpatialIndex[newIndex];
+    auto& spatialVector = GetSpatialIndexTile(newIndex);
     auto index = std::lower_bound(std::begin(spatialVector), std::end(spatialVector), entity->Id);
     spatialVector.insert(index, entity->Id);
 }
@@ -414,7 +423,7 @@ static void EntitySpatialInsert(EntityBase* entity, const CoordsXY& newLoc)
 static void EntitySpatialRemove(EntityBase* entity)
 {
     size_t currentIndex = GetSpatialIndexOffset({ entity->x, entity->y });
-    auto& spatialVector = gEntitySpatialIndex[currentIndex];
+    auto& spatialVector = GetSpatialIndexTile(currentIndex);
     auto index = BinaryFind(std::begin(spatialVector), std::end(spatialVector), entity->Id);
     if (index != std::end(spatialVector))
     {
@@ -544,11 +553,11 @@ uint16_t RemoveFloatingEntities()
 void EntitySetFlashing(EntityBase* entity, bool flashing)
 {
     assert(entity->Id.ToUnderlying() < MAX_ENTITIES);
-    _entityFlashingList[entity->Id.ToUnderlying()] = flashing;
+    GetGameState().Transient->EntityFlashing[entity->Id.ToUnderlying()] = flashing;
 }
 
 bool EntityGetFlashing(EntityBase* entity)
 {
     assert(entity->Id.ToUnderlying() < MAX_ENTITIES);
-    return _entityFlashingList[entity->Id.ToUnderlying()];
+    return GetGameState().Transient->EntityFlashing[entity->Id.ToUnderlying()];
 }
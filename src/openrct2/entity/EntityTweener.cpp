@@ -8,23 +8,50 @@
  *****************************************************************************/
 #include "EntityTweener.h"
 
+#include "../GameState.h"
+#include "../GameStateTransient.h"
 #include "../entity/Guest.h"
 #include "../entity/Staff.h"
+#include "../interface/Viewport.h"
 #include "../ride/Vehicle.h"
+#include "../ui/DeferredUi.h"
 #include "EntityList.h"
 #include "EntityRegistry.h"
 
-#include <algorithm>
 #include <cmath>
+#include <limits>
+
+static constexpr uint32_t kNoSlot = std::numeric_limits<uint32_t>::max();
+
+// Peeps and vehicles are the only entities that are drawn at the zoom levels they are tweened for
+static constexpr ZoomLevel kTweenMaxZoom{ 2 };
+
+static bool IsEntityVisible(const EntityBase& entity, const CoordsXYZ& pos)
+{
+    const auto& spriteData = entity.SpriteData;
+    return ViewportsContain(pos, spriteData.Width, spriteData.HeightMin, spriteData.HeightMax, kTweenMaxZoom);
+}
 
 void EntityTweener::AddEntity(EntityBase* entity)
 {
-    Entities.push_back(entity);
-    PrePos.emplace_back(entity->GetLocation());
+    const auto pos = entity->GetLocation();
+    if (pos.x == kLocationNull)
+        return;
+    // Threads that do not own the user interface can not look at the viewports, so they track every entity
+    if (OpenRCT2::Ui::GetDeferredWindowCalls() == nullptr && !IsEntityVisible(*entity, pos))
+        return;
+
+    Slots[entity->Id.ToUnderlying()] = static_cast<uint32_t>(Entities.size());
+    Entities.push_back(entity->Id);
+    PrePos.emplace_back(pos);
 }
 
 void EntityTweener::PopulateEntities()
 {
+    if (Slots.empty())
+    {
+        Slots.resize(MAX_ENTITIES, kNoSlot);
+    }
     for (auto ent : EntityList<Guest>())
     {
         AddEntity(ent);
@@ -41,25 +68,31 @@ void EntityTweener::PopulateEntities()
 
 void EntityTweener::PreTick()
 {
-    Restore();
     Reset();
     PopulateEntities();
 }
 
 void EntityTweener::PostTick()
 {
-    for (auto* ent : Entities)
+    for (size_t i = 0; i < Entities.size(); ++i)
     {
+        auto* ent = Entities[i].IsNull() ? nullptr : GetEntity(Entities[i]);
         if (ent == nullptr)
         {
             // Sprite was removed, add a dummy position to keep the index aligned.
             PostPos.emplace_back(0, 0, 0);
+            continue;
         }
-        else
+
+        PostPos.emplace_back(ent->GetLocation());
+        if (PostPos[i] == PrePos[i])
         {
-            PostPos.emplace_back(ent->GetLocation());
+            // Nothing to interpolate, draw at the entity location.
+            Slots[Entities[i].ToUnderlying()] = kNoSlot;
+            Entities[i] = EntityId::GetNull();
         }
     }
+    HasPostPos = true;
 }
 
 static bool CanTweenEntity(EntityBase* ent)
@@ -77,58 +110,70 @@ void EntityTweener::RemoveEntity(EntityBase* entity)
         return;
     }
 
-    auto it = std::find(Entities.begin(), Entities.end(), entity);
-    if (it != Entities.end())
-        *it = nullptr;
+    const auto id = entity->Id.ToUnderlying();
+    if (id >= Slots.size() || Slots[id] == kNoSlot)
+        return;
+
+    Entities[Slots[id]] = EntityId::GetNull();
+    Slots[id] = kNoSlot;
 }
 
 void EntityTweener::Tween(float alpha)
 {
-    const float inv = (1.0f - alpha);
+    Alpha = alpha;
+    InvalidateEntities();
+}
+
+void EntityTweener::InvalidateEntities() const
+{
+    if (!HasPostPos)
+        return;
+
+    // The entity moves along the line between both positions, redraw the area covering it.
     for (size_t i = 0; i < Entities.size(); ++i)
     {
-        auto* ent = Entities[i];
-        if (ent == nullptr)
+        if (Entities[i].IsNull())
             continue;
 
-        auto& posA = PrePos[i];
-        auto& posB = PostPos[i];
-
-        if (posA == posB)
+        const auto* ent = GetEntity(Entities[i]);
+        if (ent == nullptr)
             continue;
 
-        EntitySetCoordinates(
-            { static_cast<int32_t>(std::round(posB.x * alpha + posA.x * inv)),
-              static_cast<int32_t>(std::round(posB.y * alpha + posA.y * inv)),
-              static_cast<int32_t>(std::round(posB.z * alpha + posA.z * inv)) },
-            ent);
-        ent->Invalidate();
+        const auto& spriteData = ent->SpriteData;
+        ViewportsInvalidate(
+            PrePos[i], PostPos[i], spriteData.Width, spriteData.HeightMin, spriteData.HeightMax, kTweenMaxZoom);
     }
 }
 
-void EntityTweener::Restore()
+CoordsXYZ EntityTweener::GetDrawPosition(const EntityBase& entity) const
 {
-    for (size_t i = 0; i < Entities.size(); ++i)
-    {
-        auto* ent = Entities[i];
-        if (ent == nullptr)
-            continue;
-
-        EntitySetCoordinates(PostPos[i], ent);
-        ent->Invalidate();
-    }
+    const auto id = entity.Id.ToUnderlying();
+    if (!HasPostPos || id >= Slots.size() || Slots[id] == kNoSlot)
+        return entity.GetLocation();
+
+    const auto& posA = PrePos[Slots[id]];
+    const auto& posB = PostPos[Slots[id]];
+    const float inv = (1.0f - Alpha);
+    return { static_cast<int32_t>(std::round(posB.x * Alpha + posA.x * inv)),
+             static_cast<int32_t>(std::round(posB.y * Alpha + posA.y * inv)),
+             static_cast<int32_t>(std::round(posB.z * Alpha + posA.z * inv)) };
 }
 
 void EntityTweener::Reset()
 {
+    for (auto id : Entities)
+    {
+        if (!id.IsNull())
+            Slots[id.ToUnderlying()] = kNoSlot;
+    }
     Entities.clear();
     PrePos.clear();
     PostPos.clear();
+    Alpha = 1.0f;
+    HasPostPos = false;
 }
 
-static EntityTweener tweener;
-
 EntityTweener& EntityTweener::Get()
 {
-    return tweener;
+    return OpenRCT2::GetGameState().Transient->Tweener;
 }
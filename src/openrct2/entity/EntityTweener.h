@@ -13,23 +13,35 @@
 
 #include <vector>
 
+/**
+ * Interpolates the positions of moving entities between two ticks for drawing. Only entities visible in a viewport are
+ * tracked and the interpolated positions are kept in a side table, the entities themselves are never moved.
+ */
 class EntityTweener
 {
-    std::vector<EntityBase*> Entities;
+    std::vector<EntityId> Entities;
     std::vector<CoordsXYZ> PrePos;
     std::vector<CoordsXYZ> PostPos;
+    // Index into the lists above for each entity id, kNoSlot if the entity is not tweened
+    std::vector<uint32_t> Slots;
+    float Alpha{ 1.0f };
+    bool HasPostPos{};
 
 private:
     void PopulateEntities();
     void AddEntity(EntityBase* entity);
+    void InvalidateEntities() const;
 
 public:
+    // The tweener of the park GetGameState returns
     static EntityTweener& Get();
 
     void PreTick();
     void PostTick();
     void RemoveEntity(EntityBase* entity);
     void Tween(float alpha);
-    void Restore();
     void Reset();
+
+    // Position the entity should be drawn at, its current location if it is not tweened
+    CoordsXYZ GetDrawPosition(const EntityBase& entity) const;
 };
@@ -445,7 +445,6 @@ static bool PeepReallyLikedRide(Guest* peep, const Ride& ride);
 static PeepThoughtType PeepAssessSurroundings(int16_t centre_x, int16_t centre_y, int16_t centre_z);
 static void PeepUpdateHunger(Guest* peep);
 static void PeepDecideWhetherToLeavePark(Guest* peep);
-static void PeepLeavePark(Guest* peep);
 static void PeepHeadForNearestRideWithFlag(Guest* peep, bool considerOnlyCloseRides, RtdFlag rtdFlag);
 bool Loc690FD0(Peep* peep, RideId* rideToView, uint8_t* rideSeatToView, TileElement* tileElement);
 
@@ -898,7 +897,37 @@ void Guest::UpdateConsumptionMotives()
     }
 }
 
-void Guest::Tick128UpdateGuest(uint32_t index)
+/**
+ * Works out the parts of Tick128UpdateGuest that only read the game state. Must not modify anything, as it is called
+ * for many guests at once from worker threads.
+ * @param random A random number from the guest's own stream, used in place of ScenarioRand.
+ */
+GuestDecision Guest::MakeDecision(uint32_t random) const
+{
+    GuestDecision decision;
+    decision.Id = Id;
+    decision.Location = GetLocation();
+    decision.WantsToPickRide = (random & 0xFFFF) <= ((HasItem(ShopItem::Map)) ? 8192u : 2184u);
+    if (x == kLocationNull)
+        return decision;
+
+    if ((State == PeepState::Walking || State == PeepState::Sitting) && SurroundingsThoughtTimeout + 1 >= 18)
+    {
+        decision.HasSurroundingsThought = true;
+        decision.SurroundingsThought = PeepAssessSurroundings(x & 0xFFE0, y & 0xFFE0, z);
+    }
+
+    // Guests that have not been on a ride yet also pick one once they have been in the park for a while
+    if ((decision.WantsToPickRide || GuestNumRides == 0) && State == PeepState::Walking && GuestHeadingToRideId.IsNull()
+        && !(PeepFlags & PEEP_FLAGS_LEAVING_PARK) && !HasFoodOrDrink())
+    {
+        decision.HasRidesToGoOn = true;
+        decision.RidesToGoOn = FindRidesToGoOn();
+    }
+    return decision;
+}
+
+void Guest::Tick128UpdateGuest(uint32_t index, const GuestDecision* decision)
 {
     const auto currentTicks = GetGameState().CurrentTicks;
     if ((index & 0x1FF) != (currentTicks & 0x1FF))
@@ -971,7 +1000,10 @@ void Guest::Tick128UpdateGuest(uint32_t index)
             SurroundingsThoughtTimeout = 0;
             if (x != kLocationNull)
             {
-                PeepThoughtType thought_type = PeepAssessSurroundings(x & 0xFFE0, y & 0xFFE0, z);
+                PeepThoughtType thought_type = (decision != nullptr && decision->HasSurroundingsThought
+                                                && decision->Location == GetLocation())
+                    ? decision->SurroundingsThought
+                    : PeepAssessSurroundings(x & 0xFFE0, y & 0xFFE0, z);
 
                 if (thought_type != PeepThoughtType::None)
                 {
@@ -1028,7 +1060,7 @@ void Guest::Tick128UpdateGuest(uint32_t index)
 
         if (time_duration >= 5)
         {
-            PickRideToGoOn();
+            PickRideToGoOn(decision);
 
             if (GuestHeadingToRideId.IsNull())
             {
@@ -1042,9 +1074,12 @@ void Guest::Tick128UpdateGuest(uint32_t index)
         }
     }
 
-    if ((ScenarioRand() & 0xFFFF) <= ((HasItem(ShopItem::Map)) ? 8192u : 2184u))
+    const bool wantsToPickRide = decision != nullptr
+        ? decision->WantsToPickRide
+        : (ScenarioRand() & 0xFFFF) <= ((HasItem(ShopItem::Map)) ? 8192u : 2184u);
+    if (wantsToPickRide)
     {
-        PickRideToGoOn();
+        PickRideToGoOn(decision);
     }
 
     if ((index & 0x3FF) == (currentTicks & 0x3FF))
@@ -1819,7 +1854,7 @@ void Guest::OnExitRide(Ride& ride)
  *
  *  rct2: 0x00695DD2
  */
-void Guest::PickRideToGoOn()
+void Guest::PickRideToGoOn(const GuestDecision* decision)
 {
     if (State != PeepState::Walking)
         return;
@@ -1832,7 +1867,11 @@ void Guest::PickRideToGoOn()
     if (x == kLocationNull)
         return;
 
-    auto ride = FindBestRideToGoOn();
+    Ride* ride;
+    if (decision != nullptr && decision->HasRidesToGoOn && decision->Location == GetLocation())
+        ride = FindBestRideToGoOn(decision->RidesToGoOn);
+    else
+        ride = FindBestRideToGoOn(FindRidesToGoOn());
     if (ride != nullptr)
     {
         // Head to that ride
@@ -1849,10 +1888,9 @@ void Guest::PickRideToGoOn()
     }
 }
 
-Ride* Guest::FindBestRideToGoOn()
+Ride* Guest::FindBestRideToGoOn(const OpenRCT2::BitSet<OpenRCT2::Limits::kMaxRidesInPark>& rideConsideration)
 {
     // Pick the most exciting ride
-    auto rideConsideration = FindRidesToGoOn();
     Ride* mostExcitingRide = nullptr;
     for (auto& ride : GetRideManager())
     {
@@ -1874,7 +1912,7 @@ Ride* Guest::FindBestRideToGoOn()
     return mostExcitingRide;
 }
 
-OpenRCT2::BitSet<OpenRCT2::Limits::kMaxRidesInPark> Guest::FindRidesToGoOn()
+OpenRCT2::BitSet<OpenRCT2::Limits::kMaxRidesInPark> Guest::FindRidesToGoOn() const
 {
     OpenRCT2::BitSet<OpenRCT2::Limits::kMaxRidesInPark> rideConsideration;
 
@@ -3110,7 +3148,7 @@ static void PeepDecideWhetherToLeavePark(Guest* peep)
  *
  *  rct2: 0x0068F93E
  */
-static void PeepLeavePark(Guest* peep)
+void PeepLeavePark(Guest* peep)
 {
     peep->GuestHeadingToRideId = RideId::GetNull();
     if (peep->PeepFlags & PEEP_FLAGS_LEAVING_PARK)
@@ -5729,6 +5767,10 @@ void Guest::UpdateEnteringPark()
     DecrementGuestsHeadingForPark();
     auto intent = Intent(INTENT_ACTION_UPDATE_GUEST_COUNT);
     ContextBroadcastIntent(&intent);
+
+    auto entryIntent = Intent(INTENT_ACTION_UPDATE_GUEST_LIST_ENTRY);
+    entryIntent.PutExtra(INTENT_EXTRA_PEEP_ID, Id);
+    ContextBroadcastIntent(&entryIntent);
 }
 
 /**
@@ -5758,6 +5800,9 @@ void Guest::UpdateLeavingPark()
     DecrementGuestsInPark();
     auto intent = Intent(INTENT_ACTION_UPDATE_GUEST_COUNT);
     ContextBroadcastIntent(&intent);
+    auto entryIntent = Intent(INTENT_ACTION_UPDATE_GUEST_LIST_ENTRY);
+    entryIntent.PutExtra(INTENT_EXTRA_PEEP_ID, Id);
+    ContextBroadcastIntent(&entryIntent);
     Var37 = 1;
 
     WindowInvalidateByClass(WindowClass::GuestList);
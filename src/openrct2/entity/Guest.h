@@ -256,6 +256,21 @@ public:
     }
 };
 
+/**
+ * Read-only part of a guest's 512 tick update, worked out for all guests due this tick before any of them is updated.
+ * Making it only depend on the state at the start of the tick lets the decisions be made in any order.
+ */
+struct GuestDecision
+{
+    EntityId Id;
+    CoordsXYZ Location;
+    bool WantsToPickRide{};
+    bool HasSurroundingsThought{};
+    PeepThoughtType SurroundingsThought{};
+    bool HasRidesToGoOn{};
+    OpenRCT2::BitSet<OpenRCT2::Limits::kMaxRidesInPark> RidesToGoOn;
+};
+
 struct Guest : Peep
 {
     static constexpr auto cEntityType = EntityType::Guest;
@@ -321,7 +336,8 @@ public:
     uint64_t ItemFlags;
 
     void UpdateGuest();
-    void Tick128UpdateGuest(uint32_t index);
+    void Tick128UpdateGuest(uint32_t index, const GuestDecision* decision = nullptr);
+    GuestDecision MakeDecision(uint32_t random) const;
     uint64_t GetFoodOrDrinkFlags() const;
     uint64_t GetEmptyContainerFlags() const;
     bool HasDrink() const;
@@ -335,7 +351,7 @@ public:
     void TryGetUpFromSitting();
     bool ShouldRideWhileRaining(const Ride& ride);
     void ChoseNotToGoOnRide(const Ride& ride, bool peepAtRide, bool updateLastRide);
-    void PickRideToGoOn();
+    void PickRideToGoOn(const GuestDecision* decision = nullptr);
     void ReadMap();
     bool ShouldGoOnRide(Ride& ride, StationIndex entranceNum, bool atQueue, bool thinking);
     bool ShouldGoToShop(Ride& ride, bool peepAtShop);
@@ -421,8 +437,8 @@ private:
     void GivePassingPeepsPizza(Guest* passingPeep);
     void MakePassingPeepsSick(Guest* passingPeep);
     void GivePassingPeepsIceCream(Guest* passingPeep);
-    Ride* FindBestRideToGoOn();
-    OpenRCT2::BitSet<OpenRCT2::Limits::kMaxRidesInPark> FindRidesToGoOn();
+    Ride* FindBestRideToGoOn(const OpenRCT2::BitSet<OpenRCT2::Limits::kMaxRidesInPark>& rideConsideration);
+    OpenRCT2::BitSet<OpenRCT2::Limits::kMaxRidesInPark> FindRidesToGoOn() const;
     bool FindVehicleToEnter(const Ride& ride, std::vector<uint8_t>& car_array);
     void GoToRideEntrance(const Ride& ride);
 };
@@ -466,6 +482,7 @@ void IncrementGuestsInPark();
 void IncrementGuestsHeadingForPark();
 void DecrementGuestsInPark();
 void DecrementGuestsHeadingForPark();
+void PeepLeavePark(Guest* peep);
 
 void PeepUpdateRideLeaveEntranceMaze(Guest* peep, Ride& ride, CoordsXYZD& entrance_loc);
 void PeepUpdateRideLeaveEntranceSpiralSlide(Guest* peep, Ride& ride, CoordsXYZD& entrance_loc);
@@ -16,12 +16,14 @@
 #include "../GameState.h"
 #include "../Input.h"
 #include "../OpenRCT2.h"
+#include "../ReplayManager.h"
 #include "../actions/GameAction.h"
 #include "../audio/AudioChannel.h"
 #include "../audio/AudioMixer.h"
 #include "../audio/audio.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/JobPool.h"
 #include "../drawing/LightFX.h"
 #include "../entity/Balloon.h"
 #include "../entity/EntityRegistry.h"
@@ -75,6 +77,9 @@ static TileElement* _peepRideEntranceExitElement;
 
 static std::shared_ptr<IAudioChannel> _crowdSoundChannel = nullptr;
 
+GuestDecisionMode gGuestDecisionMode = GuestDecisionMode::Original;
+static std::unique_ptr<JobPool> _guestDecisionJobs;
+
 static void GuestReleaseBalloon(Guest* peep, int16_t spawn_height);
 
 static PeepActionSpriteType PeepSpecialSpriteToSpriteTypeMap[] = {
@@ -189,6 +194,87 @@ int32_t PeepGetStaffCount()
     return GetEntityListCount(EntityType::Staff);
 }
 
+/**
+ * Returns how the guests whose 512 tick update is due make their decisions this tick.
+ */
+static GuestDecisionMode GetGuestDecisionMode()
+{
+    // Other players and recorded replays expect the original sequence of random numbers
+    if (NetworkGetMode() != NETWORK_MODE_NONE)
+        return GuestDecisionMode::Original;
+
+    auto* context = GetContext();
+    auto* replayManager = context != nullptr ? context->GetReplayManager() : nullptr;
+    if (replayManager != nullptr && (replayManager->IsReplaying() || replayManager->IsRecording()))
+        return GuestDecisionMode::Original;
+
+    if (gGuestDecisionMode == GuestDecisionMode::Original && Config::Get().general.ParallelGuestUpdate)
+        return GuestDecisionMode::Parallel;
+    return gGuestDecisionMode;
+}
+
+/**
+ * Gives each guest a random number of its own that does not depend on the order in which guests are processed.
+ */
+static uint32_t GetGuestRandom(uint64_t seed, EntityId id)
+{
+    // SplitMix64 finaliser
+    uint64_t value = seed + (static_cast<uint64_t>(id.ToUnderlying()) + 1) * 0x9E3779B97F4A7C15uLL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9uLL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBuLL;
+    return static_cast<uint32_t>(value ^ (value >> 31));
+}
+
+/**
+ * Makes the decisions of all guests whose 512 tick update is due, using the game state from before any guest is updated.
+ */
+static std::vector<GuestDecision> PeepMakeGuestDecisions(GuestDecisionMode mode, uint64_t seed, uint32_t currentTicks)
+{
+    PROFILED_FUNCTION();
+
+    std::vector<const Guest*> guests;
+    uint32_t index = 0;
+    for (auto peep : EntityList<Guest>())
+    {
+        if ((index & 0x1FF) == (currentTicks & 0x1FF))
+        {
+            guests.push_back(peep);
+        }
+        index++;
+    }
+
+    std::vector<GuestDecision> decisions(guests.size());
+    auto* gameState = &GetGameState();
+    auto makeDecisions = [&guests, &decisions, gameState, seed](size_t begin, size_t end) {
+        // Worker threads need to read the same game state as the thread running the update
+        GameStateScope scope(*gameState);
+        for (size_t i = begin; i < end; i++)
+        {
+            decisions[i] = guests[i]->MakeDecision(GetGuestRandom(seed, guests[i]->Id));
+        }
+    };
+
+    constexpr size_t kGuestsPerJob = 8;
+    if (mode == GuestDecisionMode::Parallel && !guests.empty())
+    {
+        if (_guestDecisionJobs == nullptr)
+        {
+            _guestDecisionJobs = std::make_unique<JobPool>();
+        }
+        for (size_t begin = 0; begin < guests.size(); begin += kGuestsPerJob)
+        {
+            const auto end = std::min(guests.size(), begin + kGuestsPerJob);
+            _guestDecisionJobs->AddTask([&makeDecisions, begin, end]() { makeDecisions(begin, end); });
+        }
+        _guestDecisionJobs->Join();
+    }
+    else
+    {
+        makeDecisions(0, guests.size());
+    }
+    return decisions;
+}
+
 /**
  *
  *  rct2: 0x0068F0A9
@@ -205,13 +291,44 @@ void PeepUpdateAll()
     constexpr auto kTicks128Mask = 128u - 1u;
     const auto currentTicksMasked = currentTicks & kTicks128Mask;
 
+    // The random streams of the guests are seeded from the scenario random state at the start of the update
+    const auto& randState = ScenarioRandState();
+    const auto decisionSeed = (static_cast<uint64_t>(randState.s0) << 32) | randState.s1;
+    const auto decisionMode = GetGuestDecisionMode();
+    std::vector<GuestDecision> decisions;
+    if (decisionMode != GuestDecisionMode::Original)
+    {
+        decisions = PeepMakeGuestDecisions(decisionMode, decisionSeed, currentTicks);
+    }
+    auto nextDecision = decisions.begin();
+
     uint32_t index = 0;
     // Warning this loop can delete peeps
     for (auto peep : EntityList<Guest>())
     {
         if ((index & kTicks128Mask) == currentTicksMasked)
         {
-            peep->Tick128UpdateGuest(index);
+            if (decisionMode == GuestDecisionMode::Original || (index & 0x1FF) != (currentTicks & 0x1FF))
+            {
+                peep->Tick128UpdateGuest(index);
+            }
+            else
+            {
+                // Decisions are in update order. If a guest removed earlier in the loop shifted the indices, the guest
+                // may not have one and makes it now instead.
+                auto it = std::find_if(
+                    nextDecision, decisions.end(), [peep](const GuestDecision& decision) { return decision.Id == peep->Id; });
+                if (it != decisions.end())
+                {
+                    peep->Tick128UpdateGuest(index, &*it);
+                    nextDecision = it + 1;
+                }
+                else
+                {
+                    auto decision = peep->MakeDecision(GetGuestRandom(decisionSeed, peep->Id));
+                    peep->Tick128UpdateGuest(index, &decision);
+                }
+            }
         }
 
         // 128 tick can delete so double check its not deleted
@@ -717,9 +834,11 @@ void PeepEntityRemove(Peep* peep)
 
         News::DisableNewsItems(News::ItemType::Peep, staff->Id.ToUnderlying());
     }
+    auto peepId = peep->Id;
     EntityRemove(peep);
 
-    auto intent = Intent(wasGuest ? INTENT_ACTION_REFRESH_GUEST_LIST : INTENT_ACTION_REFRESH_STAFF_LIST);
+    auto intent = Intent(wasGuest ? INTENT_ACTION_UPDATE_GUEST_LIST_ENTRY : INTENT_ACTION_REFRESH_STAFF_LIST);
+    intent.PutExtra(INTENT_EXTRA_PEEP_ID, peepId);
     ContextBroadcastIntent(&intent);
 }
 
@@ -2824,7 +2943,7 @@ void Peep::Paint(PaintSession& session, int32_t imageDirection) const
     {
         if (Is<Staff>())
         {
-            auto loc = GetLocation();
+            auto loc = session.CurrentlyDrawnEntityPos;
             switch (Orientation)
             {
                 case 0:
@@ -2873,9 +2992,10 @@ void Peep::Paint(PaintSession& session, int32_t imageDirection) const
 
     auto imageId = ImageId(baseImageId, TshirtColour, TrousersColour);
 
-    auto bb = BoundBoxXYZ{ { 0, 0, z + 5 }, { 1, 1, 11 } };
-    auto offset = CoordsXYZ{ 0, 0, z };
-    PaintAddImageAsParent(session, imageId, { 0, 0, z }, bb);
+    const auto drawZ = session.CurrentlyDrawnEntityPos.z;
+    auto bb = BoundBoxXYZ{ { 0, 0, drawZ + 5 }, { 1, 1, 11 } };
+    auto offset = CoordsXYZ{ 0, 0, drawZ };
+    PaintAddImageAsParent(session, imageId, offset, bb);
 
     auto* guest = As<Guest>();
     if (guest != nullptr)
@@ -441,7 +441,18 @@ enum
     PATHING_RIDE_ENTRANCE = 1 << 3,
 };
 
+enum class GuestDecisionMode : uint8_t
+{
+    // Decisions are made while each guest is updated, using the scenario random number generator
+    Original,
+    // Decisions are made for all guests before updating them, using a random stream per guest
+    Streams,
+    // As Streams, with the decisions made on worker threads. Produces the same game state as Streams.
+    Parallel,
+};
+
 extern const bool gSpriteTypeToSlowWalkMap[48];
+extern GuestDecisionMode gGuestDecisionMode;
 
 int32_t PeepGetStaffCount();
 void PeepUpdateAll();
@@ -35,6 +35,8 @@
 #include "../drawing/Drawing.h"
 #include "../drawing/Font.h"
 #include "../drawing/Image.h"
+#include "../drawing/SpriteLodCache.h"
+#include "../drawing/X8DrawingEngine.h"
 #include "../entity/Balloon.h"
 #include "../entity/EntityList.h"
 #include "../entity/EntityRegistry.h"
@@ -56,6 +58,7 @@
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
 #include "../ride/Vehicle.h"
+#include "../scripting/ScriptEngine.h"
 #include "../util/Util.h"
 #include "../windows/Intent.h"
 #include "../world/Climate.h"
@@ -1427,6 +1430,11 @@ static int32_t ConsoleCommandShowLimits(InteractiveConsole& console, [[maybe_unu
     console.WriteFormatLine("Banners: %d/%zu", bannerCount, MAX_BANNERS);
     console.WriteFormatLine("Rides: %d/%d", rideCount, OpenRCT2::Limits::kMaxRidesInPark);
     console.WriteFormatLine("Images: %zu/%zu", ImageListGetUsedCount(), ImageListGetMaximum());
+
+    auto imageFragmentation = ImageListGetFragmentation();
+    console.WriteFormatLine(
+        "Image free ranges: %zu, largest: %zu, fragmentation: %.1f%%", imageFragmentation.FreeRangeCount,
+        imageFragmentation.LargestFreeRange, imageFragmentation.GetRatio() * 100.0);
     return 0;
 }
 
@@ -1668,10 +1676,13 @@ static int32_t ConsoleCommandReplayStart(InteractiveConsole& console, const argu
                              "  Date Recorded: %s\n"
                              "  Ticks: %u\n"
                              "  Commands: %u\n"
-                             "  Checksums: %u";
+                             "  Checksums: %u\n"
+                             "  Keyframes: %u";
 
-        console.WriteFormatLine(logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums);
-        Console::WriteLine(logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums);
+        console.WriteFormatLine(
+            logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums, info.NumKeyframes);
+        Console::WriteLine(
+            logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums, info.NumKeyframes);
 
         return 1;
     }
@@ -1697,6 +1708,32 @@ static int32_t ConsoleCommandReplayStop(InteractiveConsole& console, const argum
     return 0;
 }
 
+static int32_t ConsoleCommandReplaySeek(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (NetworkGetMode() != NETWORK_MODE_NONE)
+    {
+        console.WriteFormatLine("This command is currently not supported in multiplayer mode.");
+        return 0;
+    }
+
+    if (argv.size() < 1)
+    {
+        console.WriteFormatLine("Parameters required <tick>");
+        return 0;
+    }
+
+    uint32_t tick = atol(argv[0].c_str());
+
+    auto* replayManager = OpenRCT2::GetContext()->GetReplayManager();
+    if (replayManager->SeekPlayback(tick))
+    {
+        console.WriteFormatLine("Replay moved to tick %u", tick);
+        return 1;
+    }
+
+    return 0;
+}
+
 static int32_t ConsoleCommandReplayNormalise(InteractiveConsole& console, const arguments_t& argv)
 {
     if (NetworkGetMode() != NETWORK_MODE_NONE)
@@ -1919,6 +1956,130 @@ static int32_t ConsoleCommandProfilerStop(
     return 0;
 }
 
+static int32_t ConsoleCommandDirtyStats(InteractiveConsole& console, const arguments_t& argv)
+{
+    auto* engine = dynamic_cast<OpenRCT2::Drawing::X8DrawingEngine*>(GetContext()->GetDrawingEngine());
+    if (engine == nullptr)
+    {
+        console.WriteLineError("The current drawing engine does not track dirty regions.");
+        return 1;
+    }
+
+    if (argv.size() >= 1 && argv[0] == "reset")
+    {
+        engine->ResetDirtyStats();
+        console.WriteLine("Reset dirty region statistics");
+        return 0;
+    }
+
+    const auto& stats = engine->GetDirtyStats();
+    console.WriteFormatLine("Rectangles drawn:   %u", stats.RectanglesDrawn);
+    console.WriteFormatLine("Pixels invalidated: %llu", static_cast<unsigned long long>(stats.PixelsInvalidated));
+    console.WriteFormatLine("Pixels redrawn:     %llu", static_cast<unsigned long long>(stats.PixelsRedrawn));
+    if (stats.PixelsInvalidated != 0)
+    {
+        console.WriteFormatLine(
+            "Redraw ratio:       %.2f", static_cast<double>(stats.PixelsRedrawn) / static_cast<double>(stats.PixelsInvalidated));
+    }
+    return 0;
+}
+
+static int32_t ConsoleCommandSpriteLodCache(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (argv.size() >= 1 && argv[0] == "clear")
+    {
+        SpriteLodCacheClear();
+        SpriteLodCacheResetStats();
+        console.WriteLine("Cleared the sprite LOD cache");
+        return 0;
+    }
+    if (argv.size() >= 2 && argv[0] == "budget")
+    {
+        auto megabytes = atoi(argv[1].c_str());
+        if (megabytes < 0)
+        {
+            console.WriteLineError("Budget must be zero or more megabytes.");
+            return 1;
+        }
+        SpriteLodCacheSetBudget(static_cast<size_t>(megabytes) * 1024 * 1024);
+        console.WriteFormatLine("Sprite LOD cache budget set to %d MiB", megabytes);
+        return 0;
+    }
+
+    const auto stats = SpriteLodCacheGetStats();
+    console.WriteFormatLine("Entries:   %zu", stats.Entries);
+    console.WriteFormatLine(
+        "Memory:    %.1f / %.1f MiB", stats.Bytes / (1024.0 * 1024.0), stats.Budget / (1024.0 * 1024.0));
+    console.WriteFormatLine(
+        "Hits:      %llu, misses: %llu, evictions: %llu", static_cast<unsigned long long>(stats.Hits),
+        static_cast<unsigned long long>(stats.Misses), static_cast<unsigned long long>(stats.Evictions));
+    console.WriteFormatLine("Hit rate:  %.1f%%", stats.GetHitRate() * 100.0);
+    return 0;
+}
+
+#ifdef ENABLE_SCRIPTING
+static int32_t ConsoleCommandPluginProfiler(InteractiveConsole& console, const arguments_t& argv)
+{
+    using namespace OpenRCT2::Scripting;
+
+    auto& profiler = GetContext()->GetScriptEngine().GetPluginProfiler();
+    if (argv.size() < 1 || argv[0] == "report")
+    {
+        console.WriteLine("plugin / hook: calls, total ms, p50 us, p99 us, max us");
+        for (const auto* stats : profiler.GetData())
+        {
+            console.WriteFormatLine(
+                "%s / %s: %llu, %.2f, %.1f, %.1f, %.1f", stats->PluginName.c_str(), stats->Category.c_str(),
+                static_cast<unsigned long long>(stats->CallCount), stats->TotalTime / 1000.0, stats->GetPercentile(50),
+                stats->GetPercentile(99), stats->MaxTime);
+        }
+    }
+    else if (argv[0] == "start")
+    {
+        profiler.Enable();
+        console.WriteLine("Started plugin profiler");
+    }
+    else if (argv[0] == "stop")
+    {
+        profiler.Disable();
+        console.WriteLine("Stopped plugin profiler");
+    }
+    else if (argv[0] == "reset")
+    {
+        profiler.Reset();
+    }
+    else if (argv[0] == "budget")
+    {
+        if (argv.size() < 2)
+        {
+            console.WriteLineError("Missing argument: <milliseconds>");
+            return 1;
+        }
+
+        auto action = PluginBudgetAction::Log;
+        if (argv.size() >= 3 && argv[2] == "throttle")
+        {
+            action = PluginBudgetAction::Throttle;
+        }
+        profiler.SetBudget(std::atof(argv[1].c_str()), action);
+        if (profiler.GetBudgetAction() == PluginBudgetAction::None)
+        {
+            console.WriteLine("Removed plugin budget");
+        }
+        else
+        {
+            console.WriteFormatLine("Set plugin budget to %.2f ms per tick", profiler.GetBudget());
+        }
+    }
+    else
+    {
+        console.WriteLineError("Unknown subcommand");
+        return 1;
+    }
+    return 0;
+}
+#endif
+
 static int32_t ConsoleSpawnBalloon(InteractiveConsole& console, const arguments_t& argv)
 {
     if (argv.size() < 3)
@@ -2004,6 +2165,8 @@ static constexpr ConsoleCommand console_command_table[] = {
     { "close", ConsoleCommandClose, "Closes the console.", "close" },
     { "date", ConsoleCommandForceDate, "Sets the date to a given date.", "Format <year>[ <month>[ <day>]]." },
     { "dereference", ConsoleCommandDereference, "Dereferences a nullptr, for testing purposes only", "dereference" },
+    { "dirty_stats", ConsoleCommandDirtyStats, "Shows how many pixels were redrawn compared to how many were invalidated.",
+      "dirty_stats [reset]" },
     { "echo", ConsoleCommandEcho, "Echoes the text to the console.", "echo <text>" },
     { "exit", ConsoleCommandClose, "Closes the console.", "exit" },
     { "get", ConsoleCommandGet, "Gets the value of the specified variable.", "get <variable>" },
@@ -2027,6 +2190,9 @@ static constexpr ConsoleCommand console_command_table[] = {
     { "say", ConsoleCommandSay, "Say to other players.", "say <message>" },
     { "set", ConsoleCommandSet, "Sets the variable to the specified value.", "set <variable> <value>" },
     { "show_limits", ConsoleCommandShowLimits, "Shows the map data counts and limits.", "show_limits" },
+    { "sprite_lod_cache", ConsoleCommandSpriteLodCache,
+      "Shows or controls the cache of downsampled sprites for far zoom levels.",
+      "sprite_lod_cache [stats|clear|budget <MiB>]" },
     { "spawn_balloon", ConsoleSpawnBalloon, "Spawns a balloon.", "spawn_balloon <x> <y> <z> <colour>" },
     { "staff", ConsoleCommandStaff, "Staff management.", "staff <subcommand>" },
     { "terminate", ConsoleCommandTerminate, "Calls std::terminate(), for testing purposes only.", "terminate" },
@@ -2038,6 +2204,7 @@ static constexpr ConsoleCommand console_command_table[] = {
     { "replay_stoprecord", ConsoleCommandReplayStopRecord, "Stops recording a new replay.", "replay_stoprecord" },
     { "replay_start", ConsoleCommandReplayStart, "Starts a replay", "replay_start <name>" },
     { "replay_stop", ConsoleCommandReplayStop, "Stops the replay", "replay_stop" },
+    { "replay_seek", ConsoleCommandReplaySeek, "Moves the replay to the given tick", "replay_seek <tick>" },
     { "replay_normalise", ConsoleCommandReplayNormalise, "Normalises the replay to remove all gaps",
       "replay_normalise <input file> <output file>" },
     { "mp_desync", ConsoleCommandMpDesync, "Forces a multiplayer desync",
@@ -2047,6 +2214,10 @@ static constexpr ConsoleCommand console_command_table[] = {
     { "profiler_stop", ConsoleCommandProfilerStop, "Stops the profiler.", "profiler_stop [<output file>]" },
     { "profiler_exportcsv", ConsoleCommandProfilerExportCSV, "Exports the current profiler data.",
       "profiler_exportcsv <output file>" },
+#ifdef ENABLE_SCRIPTING
+    { "plugin_profiler", ConsoleCommandPluginProfiler, "Profiles the time spent in plugin hooks and intervals.",
+      "plugin_profiler [start|stop|reset|report|budget <milliseconds> [log|throttle]]" },
+#endif
 };
 
 static int32_t ConsoleCommandWindows(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
@@ -33,6 +33,7 @@
 #include "../ride/RideData.h"
 #include "../ride/TrackDesign.h"
 #include "../ride/Vehicle.h"
+#include "../ui/DeferredUi.h"
 #include "../ui/UiContext.h"
 #include "../ui/WindowManager.h"
 #include "../util/Math.hpp"
@@ -42,6 +43,7 @@
 #include "Window.h"
 #include "Window_internal.h"
 
+#include <algorithm>
 #include <cstring>
 #include <list>
 #include <unordered_map>
@@ -244,6 +246,13 @@ static Viewport* ViewportGetMain()
 
 void ViewportsInvalidate(int32_t x, int32_t y, int32_t z0, int32_t z1, ZoomLevel maxZoom)
 {
+    if (auto* deferred = Ui::GetDeferredInvalidations(); deferred != nullptr)
+    {
+        const auto centre = CoordsXYZ{ x + 16, y + 16, 0 };
+        deferred->WorldAreas.push_back({ centre, centre, 32, 32 + z1, 32 - z0, maxZoom });
+        return;
+    }
+
     for (auto& vp : _viewports)
     {
         if (maxZoom == ZoomLevel{ -1 } || vp.zoom <= ZoomLevel{ maxZoom })
@@ -266,6 +275,12 @@ void ViewportsInvalidate(int32_t x, int32_t y, int32_t z0, int32_t z1, ZoomLevel
 
 void ViewportsInvalidate(const CoordsXYZ& pos, int32_t width, int32_t minHeight, int32_t maxHeight, ZoomLevel maxZoom)
 {
+    if (auto* deferred = Ui::GetDeferredInvalidations(); deferred != nullptr)
+    {
+        deferred->WorldAreas.push_back({ pos, pos, width, minHeight, maxHeight, maxZoom });
+        return;
+    }
+
     for (auto& vp : _viewports)
     {
         if (maxZoom == ZoomLevel{ -1 } || vp.zoom <= ZoomLevel{ maxZoom })
@@ -281,6 +296,12 @@ void ViewportsInvalidate(const CoordsXYZ& pos, int32_t width, int32_t minHeight,
 
 void ViewportsInvalidate(const ScreenRect& screenRect, ZoomLevel maxZoom)
 {
+    if (auto* deferred = Ui::GetDeferredInvalidations(); deferred != nullptr)
+    {
+        deferred->ViewportAreas.push_back({ screenRect, maxZoom });
+        return;
+    }
+
     for (auto& vp : _viewports)
     {
         if (maxZoom == ZoomLevel{ -1 } || vp.zoom <= ZoomLevel{ maxZoom })
@@ -290,6 +311,58 @@ void ViewportsInvalidate(const ScreenRect& screenRect, ZoomLevel maxZoom)
     }
 }
 
+/**
+ * Invalidates the screen area an entity covers anywhere on the line between two positions.
+ */
+void ViewportsInvalidate(
+    const CoordsXYZ& from, const CoordsXYZ& to, int32_t width, int32_t minHeight, int32_t maxHeight, ZoomLevel maxZoom)
+{
+    if (auto* deferred = Ui::GetDeferredInvalidations(); deferred != nullptr)
+    {
+        deferred->WorldAreas.push_back({ from, to, width, minHeight, maxHeight, maxZoom });
+        return;
+    }
+
+    for (auto& vp : _viewports)
+    {
+        if (maxZoom == ZoomLevel{ -1 } || vp.zoom <= ZoomLevel{ maxZoom })
+        {
+            auto fromCoords = Translate3DTo2DWithZ(vp.rotation, from);
+            auto toCoords = Translate3DTo2DWithZ(vp.rotation, to);
+            auto topLeft = ScreenCoordsXY{ std::min(fromCoords.x, toCoords.x), std::min(fromCoords.y, toCoords.y) };
+            auto bottomRight = ScreenCoordsXY{ std::max(fromCoords.x, toCoords.x), std::max(fromCoords.y, toCoords.y) };
+            auto screenPos = ScreenRect(
+                topLeft - ScreenCoordsXY{ width, minHeight }, bottomRight + ScreenCoordsXY{ width, maxHeight });
+
+            ViewportInvalidate(&vp, screenPos);
+        }
+    }
+}
+
+/**
+ * Checks whether the screen area of an entity at pos is shown by any viewport that is not covered.
+ */
+bool ViewportsContain(const CoordsXYZ& pos, int32_t width, int32_t minHeight, int32_t maxHeight, ZoomLevel maxZoom)
+{
+    for (const auto& vp : _viewports)
+    {
+        if (vp.visibility == VisibilityCache::Covered)
+            continue;
+        if (maxZoom != ZoomLevel{ -1 } && vp.zoom > maxZoom)
+            continue;
+
+        auto screenCoords = Translate3DTo2DWithZ(vp.rotation, pos);
+        auto screenRect = ScreenRect(
+            screenCoords - ScreenCoordsXY{ width, minHeight }, screenCoords + ScreenCoordsXY{ width, maxHeight });
+        if (screenRect.GetRight() > vp.viewPos.x && screenRect.GetBottom() > vp.viewPos.y
+            && screenRect.GetLeft() < vp.viewPos.x + vp.view_width && screenRect.GetTop() < vp.viewPos.y + vp.view_height)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 /**
  *
  *  rct2: 0x00689174
@@ -1077,6 +1150,9 @@ static void ViewportPaint(const Viewport* viewport, DrawPixelInfo& dpi, const Sc
         useParallelDrawing = true;
     }
 
+    // Jobs draw the same park as the thread drawing the viewport, which may not be the one being updated
+    auto* gameState = &GetGameState();
+
     // Generate and sort columns.
     for (x = alignedX; x < rightBorder; x += 32)
     {
@@ -1104,7 +1180,10 @@ static void ViewportPaint(const Viewport* viewport, DrawPixelInfo& dpi, const Sc
 
         if (useMultithreading)
         {
-            _paintJobs->AddTask([session]() -> void { ViewportFillColumn(*session); });
+            _paintJobs->AddTask([session, gameState]() -> void {
+                GameStateScope scope(*gameState);
+                ViewportFillColumn(*session);
+            });
         }
         else
         {
@@ -1122,7 +1201,10 @@ static void ViewportPaint(const Viewport* viewport, DrawPixelInfo& dpi, const Sc
     {
         if (useParallelDrawing)
         {
-            _paintJobs->AddTask([session]() -> void { ViewportPaintColumn(*session); });
+            _paintJobs->AddTask([session, gameState]() -> void {
+                GameStateScope scope(*gameState);
+                ViewportPaintColumn(*session);
+            });
         }
         else
         {
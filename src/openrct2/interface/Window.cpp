@@ -26,6 +26,7 @@
 #include "../platform/Platform.h"
 #include "../ride/RideAudio.h"
 #include "../scenario/Scenario.h"
+#include "../ui/DeferredUi.h"
 #include "../ui/UiContext.h"
 #include "../ui/WindowManager.h"
 #include "../world/Map.h"
@@ -227,6 +228,24 @@ void WindowSetWindowLimit(int32_t value)
  */
 void WindowClose(WindowBase& w)
 {
+    if (auto* deferred = Ui::GetDeferredWindowCalls(); deferred != nullptr)
+    {
+        // Closed by the thread owning the windows, unless it has been closed by then
+        auto it = WindowGetIterator(&w);
+        if (it != g_window_list.end())
+        {
+            std::weak_ptr<WindowBase> window = *it;
+            deferred->Queue([window](Ui::IWindowManager&) {
+                auto openWindow = window.lock();
+                if (openWindow != nullptr && !(openWindow->flags & WF_DEAD))
+                {
+                    WindowClose(*openWindow);
+                }
+            });
+        }
+        return;
+    }
+
     w.OnClose();
 
     // Remove viewport
@@ -0,0 +1,132 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CompiledObjectCache.h"
+
+#include "../Context.h"
+#include "../Diagnostic.h"
+#include "../PlatformEnvironment.h"
+#include "../core/Crypt.h"
+#include "../core/File.h"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
+#include "../drawing/Drawing.h"
+#include "Object.h"
+
+#include <cinttypes>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+namespace OpenRCT2::CompiledObjectCache
+{
+    // Bump when the image encoding or the file layout changes to invalidate existing cache files
+    static constexpr uint32_t kCacheVersion = 1;
+    static constexpr uint32_t kCacheFileMagic = 0x4A424F43; // COBJ
+
+    static u8string GetCacheDirectory()
+    {
+        auto* context = GetContext();
+        if (context == nullptr)
+            return {};
+
+        auto env = context->GetPlatformEnvironment();
+        return Path::Combine(env->GetDirectoryPath(DIRBASE::CACHE), u8"objects");
+    }
+
+    static u8string GetCachePath(const u8string& directory, uint64_t key)
+    {
+        return Path::Combine(directory, String::StdFormat("%016" PRIx64 ".cobj", key));
+    }
+
+    uint64_t GetKey(const std::vector<uint8_t>& objectFile)
+    {
+        // Objects without CSG use their fallback images, so the loaded CSG is part of the key
+        const uint8_t csgLoaded = IsCsgLoaded() ? 1 : 0;
+        auto hash = Crypt::CreateFNV1a()
+                        ->Update(&kCacheVersion, sizeof(kCacheVersion))
+                        ->Update(&csgLoaded, sizeof(csgLoaded))
+                        ->Update(objectFile.data(), objectFile.size())
+                        ->Finish();
+
+        uint64_t key{};
+        std::memcpy(&key, hash.data(), sizeof(key));
+        return key;
+    }
+
+    std::optional<CompiledObject> Load(uint64_t key, uint64_t objectFileSize)
+    {
+        auto directory = GetCacheDirectory();
+        if (directory.empty())
+            return std::nullopt;
+
+        auto path = GetCachePath(directory, key);
+        if (!File::Exists(path))
+            return std::nullopt;
+
+        try
+        {
+            CompiledObject result{ {}, MemoryStream(File::ReadAllBytes(path)) };
+            auto& stream = result.Images;
+            if (stream.ReadValue<uint32_t>() != kCacheFileMagic || stream.ReadValue<uint64_t>() != objectFileSize)
+            {
+                LOG_WARNING("Discarding invalid compiled object: %s", path.c_str());
+                return std::nullopt;
+            }
+
+            auto jsonSize = stream.ReadValue<uint32_t>();
+            if (stream.GetPosition() + jsonSize > stream.GetLength())
+                throw IOException("Compiled object is truncated.");
+
+            const auto* json = static_cast<const uint8_t*>(stream.GetData()) + stream.GetPosition();
+            result.Root = json_t::from_cbor(json, json + jsonSize);
+            stream.Seek(jsonSize, STREAM_SEEK_CURRENT);
+            return result;
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARNING("Unable to read compiled object %s: %s", path.c_str(), e.what());
+        }
+        return std::nullopt;
+    }
+
+    void Save(uint64_t key, uint64_t objectFileSize, const json_t& root, const Object& object)
+    {
+        auto directory = GetCacheDirectory();
+        if (directory.empty())
+            return;
+
+        try
+        {
+            auto json = json_t::to_cbor(root);
+
+            MemoryStream stream;
+            stream.WriteValue<uint32_t>(kCacheFileMagic);
+            stream.WriteValue<uint64_t>(objectFileSize);
+            stream.WriteValue<uint32_t>(static_cast<uint32_t>(json.size()));
+            stream.Write(json.data(), json.size());
+            object.WriteCompiledImages(&stream);
+
+            // Objects are loaded on several threads, so write to a file of our own and move it into place
+            Path::CreateDirectory(directory);
+            auto path = GetCachePath(directory, key);
+            auto tempPath = String::StdFormat(
+                "%s.%zu.tmp", path.c_str(), std::hash<std::thread::id>{}(std::this_thread::get_id()));
+            File::WriteAllBytes(tempPath, stream.GetData(), stream.GetLength());
+            if (!File::Move(tempPath, path))
+            {
+                File::Delete(tempPath);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARNING("Unable to save compiled object: %s", e.what());
+        }
+    }
+} // namespace OpenRCT2::CompiledObjectCache
@@ -0,0 +1,38 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../core/Json.hpp"
+#include "../core/MemoryStream.h"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+class Object;
+
+/**
+ * On-disk cache of .parkobj files in a form that is quick to load: object.json stored as CBOR and the image table
+ * already decoded to G1 data. Entries are keyed by a hash of the object file, so changing the file makes a new entry.
+ * Only objects whose images all come from their own file are cached.
+ */
+namespace OpenRCT2::CompiledObjectCache
+{
+    struct CompiledObject
+    {
+        json_t Root;
+        // Positioned at the data for Object::ReadCompiledImages
+        MemoryStream Images;
+    };
+
+    uint64_t GetKey(const std::vector<uint8_t>& objectFile);
+    std::optional<CompiledObject> Load(uint64_t key, uint64_t objectFileSize);
+    void Save(uint64_t key, uint64_t objectFileSize, const json_t& root, const Object& object);
+} // namespace OpenRCT2::CompiledObjectCache
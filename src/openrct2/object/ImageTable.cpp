@@ -625,3 +625,86 @@ void ImageTable::AddImage(const G1Element* g1)
     }
     _entries.push_back(std::move(newg1));
 }
+
+void ImageTable::WriteCompiled(IStream* stream) const
+{
+    std::vector<uint32_t> lengths;
+    lengths.reserve(_entries.size());
+    stream->WriteValue<uint32_t>(static_cast<uint32_t>(_entries.size()));
+    for (const auto& entry : _entries)
+    {
+        auto length = entry.offset != nullptr ? static_cast<uint32_t>(G1CalculateDataSize(&entry)) : 0;
+        lengths.push_back(length);
+        stream->WriteValue<uint32_t>(length);
+        stream->WriteValue<int16_t>(entry.width);
+        stream->WriteValue<int16_t>(entry.height);
+        stream->WriteValue<int16_t>(entry.x_offset);
+        stream->WriteValue<int16_t>(entry.y_offset);
+        stream->WriteValue<uint16_t>(entry.flags);
+        stream->WriteValue<int32_t>(entry.zoomed_offset);
+    }
+    for (size_t i = 0; i < _entries.size(); i++)
+    {
+        stream->Write(_entries[i].offset, lengths[i]);
+    }
+}
+
+void ImageTable::ReadCompiled(IStream* stream)
+{
+    auto numImages = stream->ReadValue<uint32_t>();
+    std::vector<G1Element> newEntries(numImages);
+    std::vector<uint32_t> lengths(numImages);
+    size_t dataSize = 0;
+    for (uint32_t i = 0; i < numImages; i++)
+    {
+        lengths[i] = stream->ReadValue<uint32_t>();
+        auto& entry = newEntries[i];
+        entry.width = stream->ReadValue<int16_t>();
+        entry.height = stream->ReadValue<int16_t>();
+        entry.x_offset = stream->ReadValue<int16_t>();
+        entry.y_offset = stream->ReadValue<int16_t>();
+        entry.flags = stream->ReadValue<uint16_t>();
+        entry.zoomed_offset = stream->ReadValue<int32_t>();
+        dataSize += lengths[i];
+    }
+
+    // All images share one block, the same as a legacy image table
+    auto data = std::make_unique<uint8_t[]>(dataSize);
+    stream->Read(data.get(), dataSize);
+    size_t offset = 0;
+    for (uint32_t i = 0; i < numImages; i++)
+    {
+        newEntries[i].offset = lengths[i] != 0 ? data.get() + offset : nullptr;
+        offset += lengths[i];
+    }
+
+    if (_data == nullptr)
+    {
+        for (auto& entry : _entries)
+        {
+            delete[] entry.offset;
+        }
+    }
+    _data = std::move(data);
+    _entries = std::move(newEntries);
+}
+
+bool ImageTable::IsSelfContained(json_t& root)
+{
+    auto isFromObjectFiles = [](const std::string& s) { return !String::StartsWith(s, "$") || String::StartsWith(s, "$LGX:"); };
+    for (const auto* key : { "images", "noCsgImages" })
+    {
+        // Only look up keys that exist, indexing a missing key would add it
+        if (!root.contains(key))
+            continue;
+
+        for (auto& jsonImage : root[key])
+        {
+            if (jsonImage.is_string() && !isFromObjectFiles(jsonImage.get<std::string>()))
+                return false;
+            if (jsonImage.is_object() && jsonImage.contains("gx") && !isFromObjectFiles(Json::GetString(jsonImage["gx"])))
+                return false;
+        }
+    }
+    return true;
+}
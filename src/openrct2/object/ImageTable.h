@@ -67,4 +67,19 @@ public:
         return static_cast<uint32_t>(_entries.size());
     }
     void AddImage(const G1Element* g1);
+
+    /**
+     * Writes the decoded images in a form ReadCompiled can restore without decoding them again.
+     */
+    void WriteCompiled(OpenRCT2::IStream* stream) const;
+    /**
+     * Replaces all images with the ones written by WriteCompiled.
+     */
+    void ReadCompiled(OpenRCT2::IStream* stream);
+
+    /**
+     * Returns true if ReadJson would only read images from the object's own files, i.e. not from G1, CSG or other
+     * objects, so the decoded images only depend on the object file and on whether CSG is loaded.
+     */
+    static bool IsSelfContained(json_t& root);
 };
@@ -225,6 +225,18 @@ void Object::UnloadImages()
     }
 }
 
+void Object::WriteCompiledImages(OpenRCT2::IStream* stream) const
+{
+    stream->WriteValue<uint8_t>(_usesFallbackImages ? 1 : 0);
+    _imageTable.WriteCompiled(stream);
+}
+
+void Object::ReadCompiledImages(OpenRCT2::IStream* stream)
+{
+    _usesFallbackImages = stream->ReadValue<uint8_t>() != 0;
+    _imageTable.ReadCompiled(stream);
+}
+
 void RCTObjectEntry::SetName(std::string_view value)
 {
     std::memset(name, ' ', sizeof(name));
@@ -335,6 +335,12 @@ public:
 
     uint32_t LoadImages();
     void UnloadImages();
+
+    /**
+     * Stores or restores the decoded image table for CompiledObjectCache.
+     */
+    void WriteCompiledImages(OpenRCT2::IStream* stream) const;
+    void ReadCompiledImages(OpenRCT2::IStream* stream);
 };
 #ifdef __WARN_SUGGEST_FINAL_TYPES__
 #    pragma GCC diagnostic pop
@@ -26,6 +26,7 @@
 #include "../rct12/SawyerChunkReader.h"
 #include "AudioObject.h"
 #include "BannerObject.h"
+#include "CompiledObjectCache.h"
 #include "EntranceObject.h"
 #include "FootpathObject.h"
 #include "FootpathRailingsObject.h"
@@ -112,6 +113,36 @@ public:
     }
 };
 
+/**
+ * Opens the zip file only when data is requested, for objects restored from CompiledObjectCache.
+ */
+class LazyZipDataRetriever : public IFileDataRetriever
+{
+private:
+    const std::string _path;
+    mutable std::unique_ptr<IZipArchive> _zipArchive;
+
+public:
+    LazyZipDataRetriever(std::string_view path)
+        : _path(path)
+    {
+    }
+
+    std::vector<uint8_t> GetData(std::string_view path) const override
+    {
+        if (_zipArchive == nullptr)
+        {
+            _zipArchive = Zip::Open(_path, ZIP_ACCESS::READ);
+        }
+        return _zipArchive->GetFileData(path);
+    }
+
+    ObjectAsset GetAsset(std::string_view path) const override
+    {
+        return ObjectAsset(_path, path);
+    }
+};
+
 class ReadObjectContext : public IReadObjectContext
 {
 private:
@@ -427,10 +458,51 @@ namespace OpenRCT2::ObjectFactory
         return ObjectType::None;
     }
 
+    static std::unique_ptr<Object> CreateObjectFromCompiled(
+        IObjectRepository& objectRepository, std::string_view path, CompiledObjectCache::CompiledObject& compiled)
+    {
+        try
+        {
+            if (!compiled.Root.is_object())
+                return nullptr;
+
+            // The image table is restored as a whole afterwards, other assets are still read from the file
+            auto fileDataRetriever = LazyZipDataRetriever(path);
+            auto result = CreateObjectFromJson(objectRepository, compiled.Root, &fileDataRetriever, false);
+            if (result != nullptr)
+            {
+                result->ReadCompiledImages(&compiled.Images);
+            }
+            return result;
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARNING("Unable to use compiled object for '%s': %s", std::string(path).c_str(), e.what());
+        }
+        return nullptr;
+    }
+
     std::unique_ptr<Object> CreateObjectFromZipFile(IObjectRepository& objectRepository, std::string_view path, bool loadImages)
     {
         try
         {
+            // Only loads with images gain from the cache, scanning reads object.json alone
+            std::vector<uint8_t> objectFile;
+            uint64_t cacheKey{};
+            if (loadImages)
+            {
+                objectFile = File::ReadAllBytes(path);
+                cacheKey = CompiledObjectCache::GetKey(objectFile);
+                if (auto compiled = CompiledObjectCache::Load(cacheKey, objectFile.size()); compiled.has_value())
+                {
+                    auto result = CreateObjectFromCompiled(objectRepository, path, *compiled);
+                    if (result != nullptr)
+                    {
+                        return result;
+                    }
+                }
+            }
+
             auto archive = Zip::Open(path, ZIP_ACCESS::READ);
             auto jsonBytes = archive->GetFileData("object.json");
             if (jsonBytes.empty())
@@ -442,8 +514,20 @@ namespace OpenRCT2::ObjectFactory
 
             if (jRoot.is_object())
             {
+                // Reading the object adds missing keys to jRoot, so keep the original for the cache
+                std::optional<json_t> jCompiled;
+                if (loadImages && ImageTable::IsSelfContained(jRoot))
+                {
+                    jCompiled = jRoot;
+                }
+
                 auto fileDataRetriever = ZipDataRetriever(path, *archive);
-                return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever, loadImages);
+                auto result = CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever, loadImages);
+                if (result != nullptr && jCompiled.has_value())
+                {
+                    CompiledObjectCache::Save(cacheKey, objectFile.size(), *jCompiled, *result);
+                }
+                return result;
             }
         }
         catch (const std::exception& e)
@@ -14,6 +14,7 @@
 #include "../entity/Balloon.h"
 #include "../entity/Duck.h"
 #include "../entity/EntityList.h"
+#include "../entity/EntityTweener.h"
 #include "../entity/Fountain.h"
 #include "../entity/Litter.h"
 #include "../entity/MoneyEffect.h"
@@ -55,6 +56,7 @@ void EntityPaintSetup(PaintSession& session, const CoordsXY& pos)
     }
 
     const bool highlightPathIssues = (session.ViewFlags & VIEWPORT_FLAG_HIGHLIGHT_PATH_ISSUES);
+    const auto& tweener = EntityTweener::Get();
 
     for (auto* spr : EntityTileList(pos))
     {
@@ -74,7 +76,7 @@ void EntityPaintSetup(PaintSession& session, const CoordsXY& pos)
             }
         }
 
-        const auto entityPos = spr->GetLocation();
+        const auto entityPos = tweener.GetDrawPosition(*spr);
 
         // Only paint sprites that are below the clip height and inside the clip selection.
         // Here converting from land/path/etc height scale to pixel height scale.
@@ -96,7 +98,7 @@ void EntityPaintSetup(PaintSession& session, const CoordsXY& pos)
             }
         }
 
-        auto screenCoords = Translate3DTo2DWithZ(session.CurrentRotation, spr->GetLocation());
+        auto screenCoords = Translate3DTo2DWithZ(session.CurrentRotation, entityPos);
         auto spriteRect = ScreenRect(
             screenCoords - ScreenCoordsXY{ spr->SpriteData.Width, spr->SpriteData.HeightMin },
             screenCoords + ScreenCoordsXY{ spr->SpriteData.Width, spr->SpriteData.HeightMax });
@@ -113,6 +115,7 @@ void EntityPaintSetup(PaintSession& session, const CoordsXY& pos)
         image_direction &= 0x1F;
 
         session.CurrentlyDrawnEntity = spr;
+        session.CurrentlyDrawnEntityPos = entityPos;
         session.SpritePosition.x = entityPos.x;
         session.SpritePosition.y = entityPos.y;
         session.InteractionType = ViewportInteractionItem::Entity;
@@ -123,7 +126,7 @@ void EntityPaintSetup(PaintSession& session, const CoordsXY& pos)
                 spr->As<Vehicle>()->Paint(session, image_direction);
                 if (LightFXForVehiclesIsAvailable())
                 {
-                    LightFXAddLightsMagicVehicle(spr->As<Vehicle>());
+                    LightFXAddLightsMagicVehicle(spr->As<Vehicle>(), entityPos);
                 }
                 break;
             case EntityType::Guest:
@@ -10,6 +10,7 @@
 #include "Paint.h"
 
 #include "../Context.h"
+#include "../Diagnostic.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
 #include "../drawing/Drawing.h"
@@ -18,6 +19,7 @@
 #include "../localisation/Formatting.h"
 #include "../localisation/LocalisationService.h"
 #include "../paint/Painter.h"
+#include "../platform/Platform.h"
 #include "../profiling/Profiling.h"
 #include "../util/Math.hpp"
 #include "../util/Prefetch.h"
@@ -28,6 +30,7 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -449,6 +452,240 @@ static PaintStruct* PaintArrangeStructsHelperRotation(PaintStruct* psQuadrantEnt
     return psQuadrantEntry;
 }
 
+size_t PaintSortCollectScalar(
+    const PaintSortBounds& bounds, size_t begin, size_t end, const PaintStructBoundBox& initialBBox, uint8_t rotation,
+    uint32_t* matches)
+{
+    // Same test as CheckBoundingBox, rotations 1 and 2 reverse the x comparisons, rotations 2 and 3 the y comparisons.
+    const bool flipX = rotation == 1 || rotation == 2;
+    const bool flipY = rotation == 2 || rotation == 3;
+
+    size_t count = 0;
+    for (size_t i = begin; i < end; i++)
+    {
+        if (bounds.NeighbourMask[i] == 0)
+        {
+            continue;
+        }
+
+        const bool before = initialBBox.z_end >= bounds.Z[i] && ((initialBBox.y_end >= bounds.Y[i]) != flipY)
+            && ((initialBBox.x_end >= bounds.X[i]) != flipX);
+        const bool overlap = initialBBox.z < bounds.ZEnd[i] && ((initialBBox.y < bounds.YEnd[i]) != flipY)
+            && ((initialBBox.x < bounds.XEnd[i]) != flipX);
+        if (before && !overlap)
+        {
+            matches[count++] = static_cast<uint32_t>(i);
+        }
+    }
+    return count;
+}
+
+using PaintSortCollectFunc = size_t (*)(
+    const PaintSortBounds& bounds, size_t begin, size_t end, const PaintStructBoundBox& initialBBox, uint8_t rotation,
+    uint32_t* matches);
+
+static PaintSortCollectFunc GetPaintSortCollectFunction()
+{
+    if (Platform::AVX2Available())
+    {
+        LOG_VERBOSE("registering AVX2 paint sort function");
+        return PaintSortCollectAvx2;
+    }
+    else if (Platform::SSE41Available())
+    {
+        LOG_VERBOSE("registering SSE4.1 paint sort function");
+        return PaintSortCollectSse4_1;
+    }
+    else
+    {
+        LOG_VERBOSE("registering scalar paint sort function");
+        return PaintSortCollectScalar;
+    }
+}
+
+static const auto PaintSortCollect = GetPaintSortCollectFunction();
+
+// Without SIMD support the overhead of packing the quadrants is not worth it.
+static const auto DefaultPaintSortMethod = PaintSortCollect == PaintSortCollectScalar ? PaintSortMethod::Scalar
+                                                                                       : PaintSortMethod::Vectorised;
+
+// Contiguous copy of the nodes between the quadrant entry and the first node outside the quadrant. The sort only
+// ever re-orders nodes within this range so it can work on the copy and re-link the list once at the end.
+struct PaintSortScratch
+{
+    std::vector<PaintStruct*> Nodes;
+    std::vector<int32_t> X;
+    std::vector<int32_t> Y;
+    std::vector<int32_t> Z;
+    std::vector<int32_t> XEnd;
+    std::vector<int32_t> YEnd;
+    std::vector<int32_t> ZEnd;
+    std::vector<int32_t> NeighbourMask;
+    std::vector<uint8_t> Pending;
+    std::vector<uint32_t> Matches;
+    std::vector<size_t> Moved;
+    PaintStruct* Terminator{};
+
+    void Load(PaintStruct* psQuadrantEntry)
+    {
+        Nodes.clear();
+        X.clear();
+        Y.clear();
+        Z.clear();
+        XEnd.clear();
+        YEnd.clear();
+        ZEnd.clear();
+        NeighbourMask.clear();
+        Pending.clear();
+
+        auto* ps = psQuadrantEntry->NextQuadrantEntry;
+        for (; ps != nullptr && !(ps->SortFlags & PaintSortFlags::OutsideQuadrant); ps = ps->NextQuadrantEntry)
+        {
+            Nodes.push_back(ps);
+            X.push_back(ps->Bounds.x);
+            Y.push_back(ps->Bounds.y);
+            Z.push_back(ps->Bounds.z);
+            XEnd.push_back(ps->Bounds.x_end);
+            YEnd.push_back(ps->Bounds.y_end);
+            ZEnd.push_back(ps->Bounds.z_end);
+            NeighbourMask.push_back((ps->SortFlags & PaintSortFlags::Neighbour) ? -1 : 0);
+            Pending.push_back(ps->SortFlags & PaintSortFlags::PendingVisit);
+        }
+        Terminator = ps;
+        Matches.resize(Nodes.size());
+    }
+
+    PaintSortBounds GetBounds() const
+    {
+        return { X.data(), Y.data(), Z.data(), XEnd.data(), YEnd.data(), ZEnd.data(), NeighbourMask.data() };
+    }
+
+    void Move(size_t from, size_t to)
+    {
+        Nodes[to] = Nodes[from];
+        X[to] = X[from];
+        Y[to] = Y[from];
+        Z[to] = Z[from];
+        XEnd[to] = XEnd[from];
+        YEnd[to] = YEnd[from];
+        ZEnd[to] = ZEnd[from];
+        NeighbourMask[to] = NeighbourMask[from];
+        Pending[to] = Pending[from];
+    }
+
+    // Mirrors PaintStructsSortQuadrant: each match is unlinked and inserted straight after the parent, so the
+    // matches end up in reverse order in front of the visited node, followed by the remaining nodes in order.
+    void MoveMatchesInFront(size_t visited, size_t matchCount)
+    {
+        // Compact the non-matching nodes towards the back. Matches are copied past the end in reverse order, which
+        // is the order they go in front of the visited node.
+        Moved.clear();
+        size_t match = matchCount;
+        size_t write = Nodes.size();
+        for (size_t read = Nodes.size(); read-- > visited + 1;)
+        {
+            if (match != 0 && Matches[match - 1] == read)
+            {
+                match--;
+                Moved.push_back(Nodes.size());
+                AppendCopy(read);
+                continue;
+            }
+            Move(read, --write);
+        }
+        Move(visited, --write);
+
+        for (size_t i = 0; i < matchCount; i++)
+        {
+            Move(Moved[i], visited + i);
+        }
+        Truncate(Nodes.size() - matchCount);
+    }
+
+    void Relink(PaintStruct* psQuadrantEntry) const
+    {
+        if (Nodes.empty())
+        {
+            return;
+        }
+        psQuadrantEntry->NextQuadrantEntry = Nodes.front();
+        for (size_t i = 0; i + 1 < Nodes.size(); i++)
+        {
+            Nodes[i]->NextQuadrantEntry = Nodes[i + 1];
+        }
+        Nodes.back()->NextQuadrantEntry = Terminator;
+    }
+
+private:
+    void AppendCopy(size_t index)
+    {
+        Nodes.push_back(Nodes[index]);
+        X.push_back(X[index]);
+        Y.push_back(Y[index]);
+        Z.push_back(Z[index]);
+        XEnd.push_back(XEnd[index]);
+        YEnd.push_back(YEnd[index]);
+        ZEnd.push_back(ZEnd[index]);
+        NeighbourMask.push_back(NeighbourMask[index]);
+        Pending.push_back(Pending[index]);
+    }
+
+    void Truncate(size_t size)
+    {
+        Nodes.resize(size);
+        X.resize(size);
+        Y.resize(size);
+        Z.resize(size);
+        XEnd.resize(size);
+        YEnd.resize(size);
+        ZEnd.resize(size);
+        NeighbourMask.resize(size);
+        Pending.resize(size);
+    }
+};
+
+// Paint sessions are arranged on the paint job threads, so each thread gets its own scratch buffers.
+static thread_local PaintSortScratch _paintSortScratch;
+
+static PaintStruct* PaintArrangeStructsHelperVectorised(
+    PaintStruct* psQuadrantEntry, uint16_t quadrantIndex, uint8_t flag, uint8_t rotation)
+{
+    psQuadrantEntry = PaintStructsFirstInQuadrant(psQuadrantEntry, quadrantIndex);
+    PaintStructsInitializeSort(psQuadrantEntry, quadrantIndex, flag);
+
+    auto& scratch = _paintSortScratch;
+    scratch.Load(psQuadrantEntry);
+
+    // The cursor is the position after the parent of the next node to visit, which stays put after a visit
+    // because matches are inserted in front of the visited node.
+    size_t cursor = 0;
+    for (;;)
+    {
+        while (cursor < scratch.Nodes.size() && !scratch.Pending[cursor])
+        {
+            cursor++;
+        }
+        if (cursor == scratch.Nodes.size())
+        {
+            break;
+        }
+
+        scratch.Pending[cursor] = 0;
+        scratch.Nodes[cursor]->SortFlags &= ~PaintSortFlags::PendingVisit;
+
+        const auto initialBBox = scratch.Nodes[cursor]->Bounds;
+        const auto matchCount = PaintSortCollect(
+            scratch.GetBounds(), cursor + 1, scratch.Nodes.size(), initialBBox, rotation, scratch.Matches.data());
+        if (matchCount != 0)
+        {
+            scratch.MoveMatchesInFront(cursor, matchCount);
+        }
+    }
+
+    scratch.Relink(psQuadrantEntry);
+    return psQuadrantEntry;
+}
+
 // Iterates over all the quadrant lists and links them together as a
 // singly linked list.
 // The paint session has a head member which is the first entry.
@@ -474,7 +711,20 @@ static void PaintStructsLinkQuadrants(PaintSessionCore& session, PaintStruct& ps
     } while (++quadrantIndex <= session.QuadrantFrontIndex);
 }
 
-template<int TRotation> static void PaintSessionArrangeImpl(PaintSessionCore& session)
+template<int TRotation, PaintSortMethod TMethod>
+static PaintStruct* PaintArrangeStructsHelper(PaintStruct* psQuadrantEntry, uint16_t quadrantIndex, uint8_t flag)
+{
+    if constexpr (TMethod == PaintSortMethod::Vectorised)
+    {
+        return PaintArrangeStructsHelperVectorised(psQuadrantEntry, quadrantIndex, flag, TRotation);
+    }
+    else
+    {
+        return PaintArrangeStructsHelperRotation<TRotation>(psQuadrantEntry, quadrantIndex, flag);
+    }
+}
+
+template<int TRotation, PaintSortMethod TMethod> static void PaintSessionArrangeImpl(PaintSessionCore& session)
 {
     uint32_t quadrantIndex = session.QuadrantBackIndex;
     if (quadrantIndex == UINT32_MAX)
@@ -488,12 +738,12 @@ template<int TRotation> static void PaintSessionArrangeImpl(PaintSessionCore& se
     PaintStruct psHead{};
     PaintStructsLinkQuadrants(session, psHead);
 
-    PaintStruct* psNextQuadrant = PaintArrangeStructsHelperRotation<TRotation>(
+    PaintStruct* psNextQuadrant = PaintArrangeStructsHelper<TRotation, TMethod>(
         &psHead, session.QuadrantBackIndex, PaintSortFlags::Neighbour);
 
     while (++quadrantIndex < session.QuadrantFrontIndex)
     {
-        psNextQuadrant = PaintArrangeStructsHelperRotation<TRotation>(psNextQuadrant, quadrantIndex, PaintSortFlags::None);
+        psNextQuadrant = PaintArrangeStructsHelper<TRotation, TMethod>(psNextQuadrant, quadrantIndex, PaintSortFlags::None);
     }
 
     session.PaintHead = psHead.NextQuadrantEntry;
@@ -502,10 +752,10 @@ template<int TRotation> static void PaintSessionArrangeImpl(PaintSessionCore& se
 using PaintArrangeWithRotation = void (*)(PaintSessionCore& session);
 
 constexpr std::array _paintArrangeFuncs = {
-    PaintSessionArrangeImpl<0>,
-    PaintSessionArrangeImpl<1>,
-    PaintSessionArrangeImpl<2>,
-    PaintSessionArrangeImpl<3>,
+    PaintSessionArrangeImpl<0, PaintSortMethod::Scalar>,     PaintSessionArrangeImpl<1, PaintSortMethod::Scalar>,
+    PaintSessionArrangeImpl<2, PaintSortMethod::Scalar>,     PaintSessionArrangeImpl<3, PaintSortMethod::Scalar>,
+    PaintSessionArrangeImpl<0, PaintSortMethod::Vectorised>, PaintSessionArrangeImpl<1, PaintSortMethod::Vectorised>,
+    PaintSessionArrangeImpl<2, PaintSortMethod::Vectorised>, PaintSessionArrangeImpl<3, PaintSortMethod::Vectorised>,
 };
 
 /**
@@ -513,9 +763,15 @@ constexpr std::array _paintArrangeFuncs = {
  *  rct2: 0x00688217
  */
 void PaintSessionArrange(PaintSessionCore& session)
+{
+    PaintSessionArrange(session, DefaultPaintSortMethod);
+}
+
+void PaintSessionArrange(PaintSessionCore& session, PaintSortMethod method)
 {
     PROFILED_FUNCTION();
-    return _paintArrangeFuncs[session.CurrentRotation](session);
+    const auto methodOffset = method == PaintSortMethod::Vectorised ? 4 : 0;
+    return _paintArrangeFuncs[methodOffset + session.CurrentRotation](session);
 }
 
 static void PaintDrawStruct(PaintSession& session, PaintStruct* ps)
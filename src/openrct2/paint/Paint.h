@@ -171,6 +171,39 @@ public:
     void FreeNodes(Node* head);
 };
 
+enum class PaintSortMethod : uint8_t
+{
+    // Walks the quadrant linked list comparing one pair of bounding boxes at a time.
+    Scalar,
+    // Packs each quadrant into a contiguous buffer and compares a node against several others at once.
+    Vectorised,
+};
+
+// Structure of arrays view of the bounding boxes in a quadrant, used by the vectorised sort kernels.
+// NeighbourMask is -1 for nodes that may be moved by the sort and 0 for the rest.
+struct PaintSortBounds
+{
+    const int32_t* X;
+    const int32_t* Y;
+    const int32_t* Z;
+    const int32_t* XEnd;
+    const int32_t* YEnd;
+    const int32_t* ZEnd;
+    const int32_t* NeighbourMask;
+};
+
+// Writes the indices in [begin, end) whose bounding box has to be drawn before initialBBox to matches, in ascending
+// order, and returns how many were written.
+size_t PaintSortCollectScalar(
+    const PaintSortBounds& bounds, size_t begin, size_t end, const PaintStructBoundBox& initialBBox, uint8_t rotation,
+    uint32_t* matches);
+size_t PaintSortCollectSse4_1(
+    const PaintSortBounds& bounds, size_t begin, size_t end, const PaintStructBoundBox& initialBBox, uint8_t rotation,
+    uint32_t* matches);
+size_t PaintSortCollectAvx2(
+    const PaintSortBounds& bounds, size_t begin, size_t end, const PaintStructBoundBox& initialBBox, uint8_t rotation,
+    uint32_t* matches);
+
 struct PaintSessionCore
 {
     PaintStruct* PaintHead;
@@ -181,6 +214,8 @@ struct PaintSessionCore
     AttachedPaintStruct* LastAttachedPS;
     const SurfaceElement* Surface;
     EntityBase* CurrentlyDrawnEntity;
+    // Position CurrentlyDrawnEntity is drawn at, which is interpolated between ticks for moving entities
+    CoordsXYZ CurrentlyDrawnEntityPos;
     TileElement* CurrentlyDrawnTileElement;
     const TileElement* PathElementOnSameHeight;
     const TileElement* TrackElementOnSameHeight;
@@ -334,5 +369,6 @@ PaintSession* PaintSessionAlloc(DrawPixelInfo& dpi, uint32_t viewFlags, uint8_t
 void PaintSessionFree(PaintSession* session);
 void PaintSessionGenerate(PaintSession& session);
 void PaintSessionArrange(PaintSessionCore& session);
+void PaintSessionArrange(PaintSessionCore& session, PaintSortMethod method);
 void PaintDrawStructs(PaintSession& session);
 void PaintDrawMoneyStructs(DrawPixelInfo& dpi, PaintStringStruct* ps);
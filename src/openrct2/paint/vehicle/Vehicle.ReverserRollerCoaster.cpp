@@ -10,6 +10,7 @@
 #include "../../ride/Vehicle.h"
 
 #include "../../entity/EntityRegistry.h"
+#include "../../entity/EntityTweener.h"
 #include "../Paint.h"
 #include "VehiclePaint.h"
 
@@ -31,9 +32,12 @@ namespace OpenRCT2
         {
             return;
         }
-        x = (v1->x + v2->x) / 2;
-        y = (v1->y + v2->y) / 2;
-        z = (v1->z + v2->z) / 2;
+        const auto& tweener = EntityTweener::Get();
+        const auto pos1 = tweener.GetDrawPosition(*v1);
+        const auto pos2 = tweener.GetDrawPosition(*v2);
+        x = (pos1.x + pos2.x) / 2;
+        y = (pos1.y + pos2.y) / 2;
+        z = (pos1.z + pos2.z) / 2;
         session.SpritePosition.x = x;
         session.SpritePosition.y = y;
         VehicleVisualDefault(session, imageDirection, z, vehicle, carEntry);
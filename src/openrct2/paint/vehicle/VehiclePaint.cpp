@@ -3963,11 +3963,13 @@ void VehicleVisualDefault(
 void Vehicle::Paint(PaintSession& session, int32_t imageDirection) const
 {
     const CarEntry* carEntry;
+    const auto& drawPos = session.CurrentlyDrawnEntityPos;
 
     if (HasFlag(VehicleFlags::Crashed))
     {
         PaintAddImageAsParent(
-            session, ImageId(SPR_WATER_PARTICLES_DENSE_0 + animation_frame), { 0, 0, z }, { { 0, 0, z + 2 }, { 1, 1, 0 } });
+            session, ImageId(SPR_WATER_PARTICLES_DENSE_0 + animation_frame), { 0, 0, drawPos.z },
+            { { 0, 0, drawPos.z + 2 }, { 1, 1, 0 } });
         return;
     }
 
@@ -3998,40 +4000,41 @@ void Vehicle::Paint(PaintSession& session, int32_t imageDirection) const
         carEntry = &rideEntry->Cars[carEntryIndex];
     }
 
+    const auto drawZ = drawPos.z + zOffset;
     switch (carEntry->PaintStyle)
     {
         case VEHICLE_VISUAL_DEFAULT:
-            VehicleVisualDefault(session, imageDirection, z + zOffset, this, carEntry);
+            VehicleVisualDefault(session, imageDirection, drawZ, this, carEntry);
             break;
         case VEHICLE_VISUAL_LAUNCHED_FREEFALL:
-            VehicleVisualLaunchedFreefall(session, x, imageDirection, y, z + zOffset, this, carEntry);
+            VehicleVisualLaunchedFreefall(session, drawPos.x, imageDirection, drawPos.y, drawZ, this, carEntry);
             break;
         case VEHICLE_VISUAL_OBSERVATION_TOWER:
-            VehicleVisualObservationTower(session, x, imageDirection, y, z + zOffset, this, carEntry);
+            VehicleVisualObservationTower(session, drawPos.x, imageDirection, drawPos.y, drawZ, this, carEntry);
             break;
         case VEHICLE_VISUAL_RIVER_RAPIDS:
-            VehicleVisualRiverRapids(session, x, imageDirection, y, z + zOffset, this, carEntry);
+            VehicleVisualRiverRapids(session, drawPos.x, imageDirection, drawPos.y, drawZ, this, carEntry);
             break;
         case VEHICLE_VISUAL_MINI_GOLF_PLAYER:
-            VehicleVisualMiniGolfPlayer(session, x, imageDirection, y, z + zOffset, this);
+            VehicleVisualMiniGolfPlayer(session, drawPos.x, imageDirection, drawPos.y, drawZ, this);
             break;
         case VEHICLE_VISUAL_MINI_GOLF_BALL:
-            VehicleVisualMiniGolfBall(session, x, imageDirection, y, z + zOffset, this);
+            VehicleVisualMiniGolfBall(session, drawPos.x, imageDirection, drawPos.y, drawZ, this);
             break;
         case VEHICLE_VISUAL_REVERSER:
-            VehicleVisualReverser(session, x, imageDirection, y, z + zOffset, this, carEntry);
+            VehicleVisualReverser(session, drawPos.x, imageDirection, drawPos.y, drawZ, this, carEntry);
             break;
         case VEHICLE_VISUAL_SPLASH_BOATS_OR_WATER_COASTER:
-            VehicleVisualSplashBoatsOrWaterCoaster(session, x, imageDirection, y, z + zOffset, this, carEntry);
+            VehicleVisualSplashBoatsOrWaterCoaster(session, drawPos.x, imageDirection, drawPos.y, drawZ, this, carEntry);
             break;
         case VEHICLE_VISUAL_ROTO_DROP:
-            VehicleVisualRotoDrop(session, x, imageDirection, y, z + zOffset, this, carEntry);
+            VehicleVisualRotoDrop(session, drawPos.x, imageDirection, drawPos.y, drawZ, this, carEntry);
             break;
         case VEHICLE_VISUAL_VIRGINIA_REEL:
-            VehicleVisualVirginiaReel(session, x, imageDirection, y, z + zOffset, this, carEntry);
+            VehicleVisualVirginiaReel(session, drawPos.x, imageDirection, drawPos.y, drawZ, this, carEntry);
             break;
         case VEHICLE_VISUAL_SUBMARINE:
-            VehicleVisualSubmarine(session, x, imageDirection, y, z + zOffset, this, carEntry);
+            VehicleVisualSubmarine(session, drawPos.x, imageDirection, drawPos.y, drawZ, this, carEntry);
             break;
     }
 }
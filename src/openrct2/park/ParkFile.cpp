@@ -106,6 +106,8 @@ namespace OpenRCT2
         bool OmitTracklessRides{};
 
     private:
+        // Owns the file when loading from a path, chunks are read from it on demand
+        std::unique_ptr<IStream> _stream;
         std::unique_ptr<OrcaStream> _os;
         ObjectEntryIndex _pathToSurfaceMap[kMaxPathObjects];
         ObjectEntryIndex _pathToQueueSurfaceMap[kMaxPathObjects];
@@ -131,8 +133,8 @@ namespace OpenRCT2
 
         void Load(const std::string_view path)
         {
-            FileStream fs(path, FILE_MODE_OPEN);
-            Load(fs);
+            _stream = std::make_unique<FileStream>(path, FILE_MODE_OPEN);
+            Load(*_stream);
         }
 
         void Load(IStream& stream)
@@ -142,7 +144,22 @@ namespace OpenRCT2
 
             RequiredObjects = {};
             ReadWriteObjectsChunk(*_os);
-            ReadWritePackedObjectsChunk(*_os);
+        }
+
+        /**
+         * Adds the objects packed in the park to the repository if any required object is not installed. The packed
+         * objects chunk is usually by far the largest, so it is left compressed when it is not needed.
+         */
+        void LoadPackedObjects(const IObjectRepository& objectRepository)
+        {
+            for (const auto& descriptor : RequiredObjects)
+            {
+                if (descriptor.HasValue() && objectRepository.FindObject(descriptor) == nullptr)
+                {
+                    ReadWritePackedObjectsChunk(*_os);
+                    return;
+                }
+            }
         }
 
         void Import(GameState_t& gameState)
@@ -179,6 +196,7 @@ namespace OpenRCT2
             header.Magic = PARK_FILE_MAGIC;
             header.TargetVersion = PARK_FILE_CURRENT_VERSION;
             header.MinVersion = PARK_FILE_MIN_VERSION;
+            header.Compression = OrcaStream::COMPRESSION_GZIP_CHUNKED;
 
             ReadWriteAuthoringChunk(os);
             ReadWriteObjectsChunk(os);
@@ -2600,9 +2618,6 @@ int32_t ScenarioSave(GameState_t& gameState, u8string_view path, int32_t flags)
 class ParkFileImporter final : public IParkImporter
 {
 private:
-#ifdef __clang__
-    [[maybe_unused]]
-#endif
     const IObjectRepository& _objectRepository;
     std::unique_ptr<OpenRCT2::ParkFile> _parkFile;
 
@@ -2616,6 +2631,7 @@ public:
     {
         _parkFile = std::make_unique<OpenRCT2::ParkFile>();
         _parkFile->Load(path);
+        _parkFile->LoadPackedObjects(_objectRepository);
 
         auto result = ParkLoadResult(std::move(_parkFile->RequiredObjects));
         result.SemiCompatibleVersion = _parkFile->IsSemiCompatibleVersion(result.MinVersion, result.TargetVersion);
@@ -2637,6 +2653,7 @@ public:
     {
         _parkFile = std::make_unique<OpenRCT2::ParkFile>();
         _parkFile->Load(*stream);
+        _parkFile->LoadPackedObjects(_objectRepository);
 
         auto result = ParkLoadResult(std::move(_parkFile->RequiredObjects));
         result.SemiCompatibleVersion = _parkFile->IsSemiCompatibleVersion(result.MinVersion, result.TargetVersion);
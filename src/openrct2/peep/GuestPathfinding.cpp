@@ -9,11 +9,16 @@
 
 #include "GuestPathfinding.h"
 
+#include "../Context.h"
 #include "../Diagnostic.h"
 #include "../GameState.h"
+#include "../GameStateTransient.h"
+#include "../ReplayManager.h"
+#include "../config/Config.h"
 #include "../core/Guard.hpp"
 #include "../entity/Guest.h"
 #include "../entity/Staff.h"
+#include "../network/network.h"
 #include "../profiling/Profiling.h"
 #include "../ride/RideData.h"
 #include "../ride/Station.h"
@@ -30,6 +35,8 @@
 
 bool gPeepPathFindIgnoreForeignQueues;
 RideId gPeepPathFindQueueRideIndex;
+bool gPeepPathFindWalkSegments = true;
+std::optional<bool> gPeepPathFindFlowFields;
 
 namespace OpenRCT2::PathFinding
 {
@@ -627,6 +634,146 @@ namespace OpenRCT2::PathFinding
         return xDelta + yDelta + zDelta;
     }
 
+    // Segments are capped so that entering a long path part way along does not copy all of it
+    static constexpr size_t kMaxPathSegmentLength = 64;
+
+    /**
+     * Returns the path a search entering loc in the given direction walks onto, or nullptr if there is no such path or
+     * anything else on the tile could be walked onto or restrict the path's edges.
+     */
+    static PathElement* GetOnlyPathInDirection(const TileCoordsXYZ& loc, Direction direction)
+    {
+        TileElement* firstElement = MapGetFirstElementAt(loc);
+        if (firstElement == nullptr)
+            return nullptr;
+
+        PathElement* result = nullptr;
+        TileElement* tileElement = firstElement;
+        do
+        {
+            if (tileElement->IsGhost() || tileElement->GetType() != TileElementType::Path)
+                continue;
+            if (!IsValidPathZAndDirection(tileElement, loc.z, direction))
+                continue;
+            if (result != nullptr)
+                return nullptr;
+            result = tileElement->AsPath();
+        } while (!(tileElement++)->IsLastForTile());
+
+        if (result == nullptr)
+            return nullptr;
+
+        // The search compares elements at both the height it entered at and the height of the path
+        tileElement = firstElement;
+        do
+        {
+            if (tileElement->IsGhost())
+                continue;
+            switch (tileElement->GetType())
+            {
+                case TileElementType::Track:
+                case TileElementType::Entrance:
+                    if (tileElement->BaseHeight == loc.z || tileElement->BaseHeight == result->BaseHeight)
+                        return nullptr;
+                    break;
+                case TileElementType::Path:
+                    if (tileElement->AsPath() != result
+                        && (IsValidPathZAndDirection(tileElement, loc.z, direction)
+                            || IsValidPathZAndDirection(tileElement, result->BaseHeight, direction)))
+                        return nullptr;
+                    break;
+                case TileElementType::Banner:
+                    return nullptr;
+                default:
+                    break;
+            }
+        } while (!(tileElement++)->IsLastForTile());
+        return result;
+    }
+
+    static PathSegment BuildPathSegment(TileCoordsXYZ loc, Direction direction)
+    {
+        const auto& tileElements = GetGameState().TileElements;
+
+        PathSegment segment;
+        while (true)
+        {
+            PathSegmentTile tile;
+            tile.Location = loc;
+            tile.EntryZ = loc.z;
+            tile.ElementIndex = PathSegmentCache::kNoElement;
+
+            auto* pathElement = GetOnlyPathInDirection(loc, direction);
+            if (pathElement != nullptr)
+            {
+                tile.ElementIndex = static_cast<uint32_t>(reinterpret_cast<TileElement*>(pathElement) - tileElements.data());
+                tile.Signature = PathSegmentCache::GetSignature(*reinterpret_cast<TileElement*>(pathElement));
+            }
+
+            uint32_t edges = pathElement != nullptr ? pathElement->GetEdges() : 0;
+            if (pathElement == nullptr || pathElement->IsWide() || std::popcount(edges) != 2
+                || !(edges & (1 << DirectionReverse(direction))) || segment.Tiles.size() >= kMaxPathSegmentLength)
+            {
+                segment.End = tile;
+                return segment;
+            }
+
+            tile.PathZ = pathElement->BaseHeight;
+            tile.ExitDirection = UtilBitScanForward(edges & ~(1u << DirectionReverse(direction)));
+            tile.ExitZ = tile.PathZ;
+            if (pathElement->IsSloped() && pathElement->GetSlopeDirection() == tile.ExitDirection)
+            {
+                tile.ExitZ += 2;
+            }
+            if (pathElement->IsQueue())
+            {
+                tile.QueueRideIndex = pathElement->GetRideIndex();
+            }
+            segment.Tiles.push_back(tile);
+
+            direction = tile.ExitDirection;
+            loc = TileCoordsXYZ(tile.Location + TileDirectionDelta[direction], tile.ExitZ);
+        }
+    }
+
+    /**
+     * Returns the segment a search walks along after stepping from loc in the given direction.
+     */
+    static const PathSegment& GetPathSegment(const TileCoordsXYZ& loc, Direction direction)
+    {
+        auto& gameState = GetGameState();
+        TileCoordsXYZ start = loc;
+        start += TileDirectionDelta[direction];
+        const auto* segment = gameState.Transient->PathSegments.Find(start, direction, gameState.TileElements);
+        if (segment != nullptr)
+            return *segment;
+        return gameState.Transient->PathSegments.Store(start, direction, BuildPathSegment(start, direction));
+    }
+
+    static void UpdateSearchResult(
+        const TileCoordsXYZ& loc, uint16_t newScore, uint8_t numSteps, uint16_t* endScore, uint8_t* endJunctions,
+        TileCoordsXYZ junctionList[16], uint8_t directionList[16], TileCoordsXYZ* endXYZ, uint8_t* endSteps)
+    {
+        /* If the search result is better than the best so far (in the parameters),
+         * then update the parameters with this search. */
+        if (newScore < *endScore || (newScore == *endScore && numSteps < *endSteps))
+        {
+            // Update the search results
+            *endScore = newScore;
+            *endSteps = numSteps;
+            // Update the end x,y,z
+            *endXYZ = loc;
+            // Update the telemetry
+            *endJunctions = _peepPathFindMaxJunctions - _peepPathFindNumJunctions;
+            for (uint8_t junctInd = 0; junctInd < *endJunctions; junctInd++)
+            {
+                uint8_t histIdx = _peepPathFindMaxJunctions - junctInd;
+                junctionList[junctInd] = _peepPathFindHistory[histIdx].location;
+                directionList[junctInd] = _peepPathFindHistory[histIdx].direction;
+            }
+        }
+    }
+
     /**
      * Searches for the tile with the best heuristic score within the search limits
      * starting from the given tile x,y,z and going in the given direction test_edge.
@@ -710,6 +857,40 @@ namespace OpenRCT2::PathFinding
     {
         PathSearchResult searchResult = PathSearchResult::Failed;
 
+        /* Walk along the path segment ahead in one go. Nothing on these tiles
+         * ends the search path unless it is the goal or a search limit is
+         * reached, so this gives the same result as searching them one by one.
+         * Mechanics check their patrol area on every tile and do not use it. */
+        const auto* searchingStaff = peep.As<Staff>();
+        if (gPeepPathFindWalkSegments && !kLogPathfinding && (searchingStaff == nullptr || !searchingStaff->IsMechanic()))
+        {
+            for (const auto& tile : GetPathSegment(loc, testEdge).Tiles)
+            {
+                // A queue of another ride ends the search path, leave it to the search below
+                if (gPeepPathFindIgnoreForeignQueues && !tile.QueueRideIndex.IsNull()
+                    && tile.QueueRideIndex != gPeepPathFindQueueRideIndex)
+                    break;
+
+                ++numSteps;
+                _peepPathFindTilesChecked--;
+                if (_peepPathFindHistory[0].location == TileCoordsXYZ(tile.Location, tile.EntryZ))
+                    return;
+
+                TileCoordsXYZ pathLoc(tile.Location, tile.PathZ);
+                uint16_t newScore = CalculateHeuristicPathingScore(pathLoc, goal);
+                if (newScore == 0 || numSteps >= 200 || _peepPathFindTilesChecked <= 0)
+                {
+                    UpdateSearchResult(
+                        pathLoc, newScore, numSteps, endScore, endJunctions, junctionList, directionList, endXYZ, endSteps);
+                    return;
+                }
+
+                loc = TileCoordsXYZ(tile.Location, tile.ExitZ);
+                currentTileElement = &GetGameState().TileElements[tile.ElementIndex];
+                testEdge = tile.ExitDirection;
+            }
+        }
+
         bool currentElementIsWide = currentTileElement->AsPath()->IsWide();
         if (currentElementIsWide)
         {
@@ -902,24 +1083,8 @@ namespace OpenRCT2::PathFinding
             {
                 /* If the search result is better than the best so far (in the parameters),
                  * then update the parameters with this search before continuing to the next map element. */
-                if (newScore < *endScore || (newScore == *endScore && numSteps < *endSteps))
-                {
-                    // Update the search results
-                    *endScore = newScore;
-                    *endSteps = numSteps;
-                    // Update the end x,y,z
-                    *endXYZ = loc;
-                    // Update the telemetry
-                    *endJunctions = _peepPathFindMaxJunctions - _peepPathFindNumJunctions;
-                    for (uint8_t junctInd = 0; junctInd < *endJunctions; junctInd++)
-                    {
-                        uint8_t histIdx = _peepPathFindMaxJunctions - junctInd;
-                        junctionList[junctInd].x = _peepPathFindHistory[histIdx].location.x;
-                        junctionList[junctInd].y = _peepPathFindHistory[histIdx].location.y;
-                        junctionList[junctInd].z = _peepPathFindHistory[histIdx].location.z;
-                        directionList[junctInd] = _peepPathFindHistory[histIdx].direction;
-                    }
-                }
+                UpdateSearchResult(
+                    loc, newScore, numSteps, endScore, endJunctions, junctionList, directionList, endXYZ, endSteps);
                 LogPathfinding(
                     &peep, "Search path ends at %d,%d,%d; Steps: %u; At goal; Score: %d", loc.x >> 5, loc.y >> 5, loc.z,
                     numSteps, newScore);
@@ -953,23 +1118,10 @@ namespace OpenRCT2::PathFinding
                  * If the search result is better than the best so far
                  * (in the parameters), then update the parameters with
                  * this search before continuing to the next map element. */
-                if (currentElementIsWide && (newScore < *endScore || (newScore == *endScore && numSteps < *endSteps)))
+                if (currentElementIsWide)
                 {
-                    // Update the search results
-                    *endScore = newScore;
-                    *endSteps = numSteps;
-                    // Update the end x,y,z
-                    *endXYZ = loc;
-                    // Update the telemetry
-                    *endJunctions = _peepPathFindMaxJunctions - _peepPathFindNumJunctions;
-                    for (uint8_t junctInd = 0; junctInd < *endJunctions; junctInd++)
-                    {
-                        uint8_t histIdx = _peepPathFindMaxJunctions - junctInd;
-                        junctionList[junctInd].x = _peepPathFindHistory[histIdx].location.x;
-                        junctionList[junctInd].y = _peepPathFindHistory[histIdx].location.y;
-                        junctionList[junctInd].z = _peepPathFindHistory[histIdx].location.z;
-                        directionList[junctInd] = _peepPathFindHistory[histIdx].direction;
-                    }
+                    UpdateSearchResult(
+                        loc, newScore, numSteps, endScore, endJunctions, junctionList, directionList, endXYZ, endSteps);
                 }
                 LogPathfinding(
                     &peep, "Search path ends at %d,%d,%d; Steps: %u; Wide path; Score: %d", loc.x >> 5, loc.y >> 5, loc.z,
@@ -1010,24 +1162,8 @@ namespace OpenRCT2::PathFinding
                  * The path continues, so the goal could still be reachable from here.
                  * If the search result is better than the best so far (in the parameters),
                  * then update the parameters with this search before continuing to the next map element. */
-                if (newScore < *endScore || (newScore == *endScore && numSteps < *endSteps))
-                {
-                    // Update the search results
-                    *endScore = newScore;
-                    *endSteps = numSteps;
-                    // Update the end x,y,z
-                    *endXYZ = loc;
-                    // Update the telemetry
-                    *endJunctions = _peepPathFindMaxJunctions - _peepPathFindNumJunctions;
-                    for (uint8_t junctInd = 0; junctInd < *endJunctions; junctInd++)
-                    {
-                        uint8_t histIdx = _peepPathFindMaxJunctions - junctInd;
-                        junctionList[junctInd].x = _peepPathFindHistory[histIdx].location.x;
-                        junctionList[junctInd].y = _peepPathFindHistory[histIdx].location.y;
-                        junctionList[junctInd].z = _peepPathFindHistory[histIdx].location.z;
-                        directionList[junctInd] = _peepPathFindHistory[histIdx].direction;
-                    }
-                }
+                UpdateSearchResult(
+                    loc, newScore, numSteps, endScore, endJunctions, junctionList, directionList, endXYZ, endSteps);
                 LogPathfinding(
                     &peep, "Search path ends at %d,%d,%d; Steps: %u; Search limit reached; Score: %d", loc.x >> 5, loc.y >> 5,
                     loc.z, numSteps, newScore);
@@ -1109,22 +1245,9 @@ namespace OpenRCT2::PathFinding
                      * then update the parameters with this search before continuing to the next map element. */
                     if (_peepPathFindNumJunctions <= 0)
                     {
-                        if (newScore < *endScore || (newScore == *endScore && numSteps < *endSteps))
-                        {
-                            // Update the search results
-                            *endScore = newScore;
-                            *endSteps = numSteps;
-                            // Update the end x,y,z
-                            *endXYZ = loc;
-                            // Update the telemetry
-                            *endJunctions = _peepPathFindMaxJunctions; // - _peepPathFindNumJunctions;
-                            for (uint8_t junctInd = 0; junctInd < *endJunctions; junctInd++)
-                            {
-                                uint8_t histIdx = _peepPathFindMaxJunctions - junctInd;
-                                junctionList[junctInd] = _peepPathFindHistory[histIdx].location;
-                                directionList[junctInd] = _peepPathFindHistory[histIdx].direction;
-                            }
-                        }
+                        UpdateSearchResult(
+                            loc, newScore, numSteps, endScore, endJunctions, junctionList, directionList, endXYZ,
+                            endSteps);
                         LogPathfinding(
                             &peep, "Search path ends at %d,%d,%d; Steps: %u; NumJunctions < 0; Score: %d", loc.x >> 5,
                             loc.y >> 5, loc.z, numSteps, newScore);
@@ -1207,6 +1330,25 @@ namespace OpenRCT2::PathFinding
         }
     }
 
+    /**
+     * If this is a new goal for the peep, stores it and resets the peep's PathfindHistory.
+     */
+    static void SetPathfindGoal(Peep& peep, const TileCoordsXYZ& goal)
+    {
+        if (!DirectionValid(peep.PathfindGoal.direction) || peep.PathfindGoal != goal)
+        {
+            peep.PathfindGoal = { goal, 0 };
+
+            // Clear pathfinding history
+            TileCoordsXYZD nullPos;
+            nullPos.SetNull();
+
+            std::fill(std::begin(peep.PathfindHistory), std::end(peep.PathfindHistory), nullPos);
+
+            LogPathfinding(&peep, "New goal; clearing pf_history.");
+        }
+    }
+
     /**
      * Returns:
      *   -1   - no direction chosen
@@ -1335,20 +1477,7 @@ namespace OpenRCT2::PathFinding
             }
         }
 
-        /* If this is a new goal for the peep. Store it and reset the peep's
-         * PathfindHistory. */
-        if (!DirectionValid(peep.PathfindGoal.direction) || peep.PathfindGoal != goal)
-        {
-            peep.PathfindGoal = { goal, 0 };
-
-            // Clear pathfinding history
-            TileCoordsXYZD nullPos;
-            nullPos.SetNull();
-
-            std::fill(std::begin(peep.PathfindHistory), std::end(peep.PathfindHistory), nullPos);
-
-            LogPathfinding(&peep, "New goal; clearing pf_history.");
-        }
+        SetPathfindGoal(peep, goal);
 
         // Peep has tried all edges.
         if (edges == 0)
@@ -1541,6 +1670,270 @@ namespace OpenRCT2::PathFinding
         return chosenEdge;
     }
 
+#pragma region Flow fields
+    // Paths added to a flow field per call, so that a new field is built over several guests' decisions
+    static constexpr size_t kFlowFieldPathsPerUpdate = 4096;
+
+    static bool UseFlowFields()
+    {
+        // Other players and recorded replays expect every guest to take the route of the heuristic search
+        if (NetworkGetMode() != NETWORK_MODE_NONE)
+            return false;
+
+        auto* context = GetContext();
+        auto* replayManager = context != nullptr ? context->GetReplayManager() : nullptr;
+        if (replayManager != nullptr && (replayManager->IsReplaying() || replayManager->IsRecording()))
+            return false;
+
+        return gPeepPathFindFlowFields.value_or(Config::Get().general.FlowFieldPathfinding);
+    }
+
+    static bool IsForeignQueue(const PathElement& pathElement, RideId queueRideIndex)
+    {
+        return pathElement.IsQueue() && !pathElement.GetRideIndex().IsNull() && pathElement.GetRideIndex() != queueRideIndex;
+    }
+
+    /**
+     * Returns the height a peep leaving the path in the given direction enters the next tile at.
+     */
+    static int32_t GetPathExitZ(const PathElement& pathElement, Direction direction)
+    {
+        int32_t z = pathElement.BaseHeight;
+        if (pathElement.IsSloped() && pathElement.GetSlopeDirection() == direction)
+        {
+            z += 2;
+        }
+        return z;
+    }
+
+    /**
+     * Returns the base height of the path a peep walks onto when entering loc in the given direction, or -1 if there
+     * is none it may walk on.
+     */
+    static int32_t GetPathEnteredZ(const TileCoordsXYZ& loc, Direction direction, RideId queueRideIndex)
+    {
+        TileElement* tileElement = MapGetFirstElementAt(loc);
+        if (tileElement == nullptr)
+            return -1;
+        do
+        {
+            if (tileElement->IsGhost() || tileElement->GetType() != TileElementType::Path)
+                continue;
+            if (IsForeignQueue(*tileElement->AsPath(), queueRideIndex))
+                continue;
+            if (IsValidPathZAndDirection(tileElement, loc.z, direction))
+                return tileElement->BaseHeight;
+        } while (!(tileElement++)->IsLastForTile());
+        return -1;
+    }
+
+    /**
+     * Adds the paths next to loc that lead onto it, one step further from the goal than loc.
+     */
+    static void AddFlowFieldNeighbours(
+        PathFlowFieldCache& cache, PathFlowField& field, const TileCoordsXYZ& loc, uint16_t distance)
+    {
+        for (Direction direction : ALL_DIRECTIONS)
+        {
+            // Paths on the neighbouring tile reach loc by walking back in the reverse direction
+            const Direction towards = DirectionReverse(direction);
+            const TileCoordsXY neighbour = TileCoordsXY(loc) + TileDirectionDelta[direction];
+            TileElement* tileElement = MapGetFirstElementAt(neighbour);
+            if (tileElement == nullptr)
+                continue;
+            do
+            {
+                if (tileElement->IsGhost() || tileElement->GetType() != TileElementType::Path)
+                    continue;
+                auto* pathElement = tileElement->AsPath();
+                if (IsForeignQueue(*pathElement, field.QueueRideIndex))
+                    continue;
+                if (!(PathGetPermittedEdges(false, pathElement) & (1 << towards)))
+                    continue;
+
+                const TileCoordsXYZ entered{ TileCoordsXY(loc), GetPathExitZ(*pathElement, towards) };
+                if (GetPathEnteredZ(entered, towards, field.QueueRideIndex) != loc.z)
+                    continue;
+
+                const auto node = cache.GetNode({ neighbour, pathElement->BaseHeight });
+                if (field.GetDistance(node) != PathFlowField::kUnreachable)
+                    continue;
+                field.SetDistance(node, distance);
+                field.Frontier.push_back(node);
+            } while (!(tileElement++)->IsLastForTile());
+        }
+    }
+
+    /**
+     * Starts the field from its goal. When the goal is a path, such as the end of a queue or a peep spawn, that path is
+     * at distance 0. Otherwise, for entrances, the paths leading onto the goal are at distance 1.
+     */
+    static void StartFlowField(PathFlowFieldCache& cache, PathFlowField& field)
+    {
+        field.Started = true;
+
+        const auto& goal = field.Goal;
+        bool goalIsPath = false;
+        TileElement* tileElement = MapGetFirstElementAt(goal);
+        if (tileElement != nullptr)
+        {
+            do
+            {
+                if (tileElement->IsGhost() || tileElement->GetType() != TileElementType::Path)
+                    continue;
+                if (tileElement->BaseHeight != goal.z || IsForeignQueue(*tileElement->AsPath(), field.QueueRideIndex))
+                    continue;
+                goalIsPath = true;
+            } while (!(tileElement++)->IsLastForTile());
+        }
+
+        if (goalIsPath)
+        {
+            const auto node = cache.GetNode(goal);
+            field.SetDistance(node, 0);
+            field.Frontier.push_back(node);
+            return;
+        }
+
+        for (Direction direction : ALL_DIRECTIONS)
+        {
+            const Direction towards = DirectionReverse(direction);
+            const TileCoordsXY neighbour = TileCoordsXY(goal) + TileDirectionDelta[direction];
+            tileElement = MapGetFirstElementAt(neighbour);
+            if (tileElement == nullptr)
+                continue;
+            do
+            {
+                if (tileElement->IsGhost() || tileElement->GetType() != TileElementType::Path)
+                    continue;
+                auto* pathElement = tileElement->AsPath();
+                if (IsForeignQueue(*pathElement, field.QueueRideIndex))
+                    continue;
+                if (!(PathGetPermittedEdges(false, pathElement) & (1 << towards)))
+                    continue;
+                if (GetPathExitZ(*pathElement, towards) != goal.z)
+                    continue;
+
+                const auto node = cache.GetNode({ neighbour, pathElement->BaseHeight });
+                if (field.GetDistance(node) != PathFlowField::kUnreachable)
+                    continue;
+                field.SetDistance(node, 1);
+                field.Frontier.push_back(node);
+            } while (!(tileElement++)->IsLastForTile());
+        }
+    }
+
+    /**
+     * Continues the breadth first search of the field for up to the given number of paths.
+     */
+    static void AdvanceFlowField(PathFlowFieldCache& cache, PathFlowField& field, size_t budget)
+    {
+        if (!field.Started)
+        {
+            StartFlowField(cache, field);
+        }
+        for (; budget > 0 && !field.Frontier.empty(); budget--)
+        {
+            const auto node = field.Frontier.front();
+            field.Frontier.pop_front();
+
+            const auto distance = field.GetDistance(node);
+            if (distance >= PathFlowField::kUnreachable - 1)
+                continue;
+            // Copied, as adding nodes may move the location
+            const auto loc = cache.GetNodeLocation(node);
+            AddFlowFieldNeighbours(cache, field, loc, distance + 1);
+        }
+    }
+
+    /**
+     * Chooses the edge of the path at loc that leads to the neighbour nearest to the goal, using the flow field of
+     * the goal. Queues of rides other than queueRideIndex are not walked through. Returns INVALID_DIRECTION if the
+     * field has not reached loc yet, or loc is the goal.
+     */
+    Direction ChooseFlowFieldDirection(const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, RideId queueRideIndex)
+    {
+        PROFILED_FUNCTION();
+
+        auto& cache = GetGameState().Transient->PathFlowFields;
+        auto& field = cache.GetField(goal, queueRideIndex);
+
+        auto node = cache.FindNode(loc);
+        if ((node == PathFlowFieldCache::kNoNode || field.GetDistance(node) == PathFlowField::kUnreachable)
+            && !field.IsComplete())
+        {
+            AdvanceFlowField(cache, field, kFlowFieldPathsPerUpdate);
+            node = cache.FindNode(loc);
+        }
+        if (node == PathFlowFieldCache::kNoNode)
+            return INVALID_DIRECTION;
+        const auto distance = field.GetDistance(node);
+        if (distance == 0 || distance == PathFlowField::kUnreachable)
+            return INVALID_DIRECTION;
+
+        Direction bestDirection = INVALID_DIRECTION;
+        auto bestDistance = distance;
+        TileElement* tileElement = MapGetFirstElementAt(loc);
+        if (tileElement == nullptr)
+            return INVALID_DIRECTION;
+        do
+        {
+            if (tileElement->BaseHeight != loc.z || tileElement->GetType() != TileElementType::Path)
+                continue;
+            auto* pathElement = tileElement->AsPath();
+            const auto permittedEdges = PathGetPermittedEdges(false, pathElement);
+            for (Direction direction : ALL_DIRECTIONS)
+            {
+                if (!(permittedEdges & (1 << direction)))
+                    continue;
+
+                const TileCoordsXYZ next{ TileCoordsXY(loc) + TileDirectionDelta[direction],
+                                          GetPathExitZ(*pathElement, direction) };
+                uint16_t nextDistance = PathFlowField::kUnreachable;
+                if (next == goal)
+                {
+                    nextDistance = 0;
+                }
+                else
+                {
+                    const auto nextZ = GetPathEnteredZ(next, direction, field.QueueRideIndex);
+                    const auto nextNode = nextZ != -1 ? cache.FindNode({ next.x, next.y, nextZ })
+                                                      : PathFlowFieldCache::kNoNode;
+                    if (nextNode != PathFlowFieldCache::kNoNode)
+                    {
+                        nextDistance = field.GetDistance(nextNode);
+                    }
+                }
+                if (nextDistance < bestDistance)
+                {
+                    bestDistance = nextDistance;
+                    bestDirection = direction;
+                }
+            }
+        } while (!(tileElement++)->IsLastForTile());
+        return bestDirection;
+    }
+
+    /**
+     * Chooses the direction for a guest heading to a goal that many guests share. Uses the goal's flow field when
+     * enabled and it reaches the guest, otherwise the heuristic search.
+     */
+    static Direction ChooseGuestDirection(const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, Peep& peep)
+    {
+        if (UseFlowFields())
+        {
+            const auto queueRideIndex = gPeepPathFindIgnoreForeignQueues ? gPeepPathFindQueueRideIndex : RideId::GetNull();
+            const auto direction = ChooseFlowFieldDirection(loc, goal, queueRideIndex);
+            if (direction != INVALID_DIRECTION)
+            {
+                SetPathfindGoal(peep, goal);
+                return direction;
+            }
+        }
+        return ChooseDirection(loc, goal, peep);
+    }
+#pragma endregion
+
     /**
      * Gets the nearest park entrance relative to point, by using Manhattan distance.
      * @param x x coordinate of location
@@ -1580,7 +1973,7 @@ namespace OpenRCT2::PathFinding
         gPeepPathFindQueueRideIndex = RideId::GetNull();
 
         const auto goalPos = TileCoordsXYZ(chosenEntrance.value());
-        Direction chosenDirection = ChooseDirection(TileCoordsXYZ{ peep.NextLoc }, goalPos, peep);
+        Direction chosenDirection = ChooseGuestDirection(TileCoordsXYZ{ peep.NextLoc }, goalPos, peep);
 
         if (chosenDirection == INVALID_DIRECTION)
             return GuestPathfindAimless(peep, edges);
@@ -1637,7 +2030,7 @@ namespace OpenRCT2::PathFinding
         gPeepPathFindQueueRideIndex = RideId::GetNull();
 
         const auto goalPos = TileCoordsXYZ(peepSpawnLoc);
-        direction = ChooseDirection(TileCoordsXYZ{ peep.NextLoc }, goalPos, peep);
+        direction = ChooseGuestDirection(TileCoordsXYZ{ peep.NextLoc }, goalPos, peep);
         if (direction == INVALID_DIRECTION)
             return GuestPathfindAimless(peep, edges);
 
@@ -1676,7 +2069,7 @@ namespace OpenRCT2::PathFinding
         gPeepPathFindIgnoreForeignQueues = true;
         gPeepPathFindQueueRideIndex = RideId::GetNull();
 
-        Direction chosenDirection = ChooseDirection(TileCoordsXYZ{ peep.NextLoc }, entranceGoal, peep);
+        Direction chosenDirection = ChooseGuestDirection(TileCoordsXYZ{ peep.NextLoc }, entranceGoal, peep);
         if (chosenDirection == INVALID_DIRECTION)
             return GuestPathfindAimless(peep, edges);
 
@@ -2098,7 +2491,7 @@ namespace OpenRCT2::PathFinding
 
         gPeepPathFindIgnoreForeignQueues = true;
 
-        direction = ChooseDirection(TileCoordsXYZ{ peep.NextLoc }, loc, peep);
+        direction = ChooseGuestDirection(TileCoordsXYZ{ peep.NextLoc }, loc, peep);
 
         if (direction == INVALID_DIRECTION)
         {
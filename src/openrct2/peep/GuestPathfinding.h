@@ -13,6 +13,7 @@
 #include "../world/Location.hpp"
 
 #include <memory>
+#include <optional>
 
 struct Peep;
 struct Guest;
@@ -31,10 +32,20 @@ extern RideId gPeepPathFindQueueRideIndex;
 // In practice, if this is false, gPeepPathFindQueueRideIndex is always RIDE_ID_NULL.
 extern bool gPeepPathFindIgnoreForeignQueues;
 
+// The heuristic search walks along cached path segments in one go. Only turned off by tests, which check that the
+// search gives the same results either way.
+extern bool gPeepPathFindWalkSegments;
+
+// Whether guests route to goals that many of them share with flow fields rather than the heuristic search. Follows
+// the flow_field_pathfinding option unless set by tests and benchmarks. Never used in network games or replays.
+extern std::optional<bool> gPeepPathFindFlowFields;
+
 namespace OpenRCT2::PathFinding
 {
     Direction ChooseDirection(const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, Peep& peep);
 
+    Direction ChooseFlowFieldDirection(const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, RideId queueRideIndex);
+
     int32_t CalculateNextDestination(Guest& peep);
 
     int32_t GuestPathFindParkEntranceEntering(Peep& peep, uint8_t edges);
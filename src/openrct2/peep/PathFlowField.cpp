@@ -0,0 +1,93 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "PathFlowField.h"
+
+#include <algorithm>
+
+namespace OpenRCT2::PathFinding
+{
+    uint16_t PathFlowField::GetDistance(uint32_t node) const
+    {
+        return node < Distances.size() ? Distances[node] : kUnreachable;
+    }
+
+    void PathFlowField::SetDistance(uint32_t node, uint16_t distance)
+    {
+        if (node >= Distances.size())
+        {
+            Distances.resize(node + 1, kUnreachable);
+        }
+        Distances[node] = distance;
+    }
+
+    PathFlowField& PathFlowFieldCache::GetField(const TileCoordsXYZ& goal, RideId queueRideIndex)
+    {
+        auto key = GetKey(goal) ^ (static_cast<uint64_t>(queueRideIndex.ToUnderlying()) << 48);
+        auto it = _fields.find(key);
+        if (it == _fields.end())
+        {
+            if (_fields.size() >= kMaxFields)
+            {
+                auto leastUsed = std::min_element(_fields.begin(), _fields.end(), [](const auto& a, const auto& b) {
+                    return a.second.LastUsed < b.second.LastUsed;
+                });
+                _fields.erase(leastUsed);
+            }
+            it = _fields.emplace(key, PathFlowField{}).first;
+            it->second.Goal = goal;
+            it->second.QueueRideIndex = queueRideIndex;
+        }
+        it->second.LastUsed = ++_useCounter;
+        return it->second;
+    }
+
+    size_t PathFlowFieldCache::GetFieldCount() const
+    {
+        return _fields.size();
+    }
+
+    uint32_t PathFlowFieldCache::FindNode(const TileCoordsXYZ& loc) const
+    {
+        auto it = _nodeIds.find(GetKey(loc));
+        return it != _nodeIds.end() ? it->second : kNoNode;
+    }
+
+    uint32_t PathFlowFieldCache::GetNode(const TileCoordsXYZ& loc)
+    {
+        auto [it, inserted] = _nodeIds.emplace(GetKey(loc), static_cast<uint32_t>(_nodes.size()));
+        if (inserted)
+        {
+            _nodes.push_back(loc);
+        }
+        return it->second;
+    }
+
+    const TileCoordsXYZ& PathFlowFieldCache::GetNodeLocation(uint32_t node) const
+    {
+        return _nodes[node];
+    }
+
+    void PathFlowFieldCache::Clear()
+    {
+        // Called for every change to a path, so avoid touching the tables when there is nothing to clear
+        if (_fields.empty() && _nodes.empty())
+            return;
+
+        _fields.clear();
+        _nodeIds.clear();
+        _nodes.clear();
+    }
+
+    uint64_t PathFlowFieldCache::GetKey(const TileCoordsXYZ& loc)
+    {
+        return (static_cast<uint64_t>(static_cast<uint16_t>(loc.x)) << 24)
+            | (static_cast<uint64_t>(static_cast<uint16_t>(loc.y)) << 8) | static_cast<uint64_t>(loc.z & 0xFF);
+    }
+} // namespace OpenRCT2::PathFinding
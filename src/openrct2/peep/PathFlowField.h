@@ -0,0 +1,79 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../Identifiers.h"
+#include "../world/Location.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenRCT2::PathFinding
+{
+    /**
+     * Number of steps from each path to one goal, found by a breadth first search out from the goal. The search is
+     * advanced a limited number of paths at a time, so a field can be read while it is still being built: a path that
+     * has a distance already has its final one, and so does the neighbour that leads it towards the goal.
+     */
+    struct PathFlowField
+    {
+        static constexpr uint16_t kUnreachable = UINT16_MAX;
+
+        TileCoordsXYZ Goal;
+        // Ride whose queue may be walked through, queues of other rides are left out
+        RideId QueueRideIndex{ RideId::GetNull() };
+        std::vector<uint16_t> Distances;
+        std::deque<uint32_t> Frontier;
+        uint32_t LastUsed{};
+        bool Started{};
+
+        uint16_t GetDistance(uint32_t node) const;
+        void SetDistance(uint32_t node, uint16_t distance);
+        bool IsComplete() const
+        {
+            return Started && Frontier.empty();
+        }
+    };
+
+    /**
+     * Flow fields for goals that many guests share, such as park entrances, peep spawns and ride queues. Paths are
+     * numbered once for all fields, each path being a tile and the base height of the path elements on it. Any change to
+     * the path network clears everything.
+     */
+    class PathFlowFieldCache
+    {
+        std::unordered_map<uint64_t, uint32_t> _nodeIds;
+        std::vector<TileCoordsXYZ> _nodes;
+        std::unordered_map<uint64_t, PathFlowField> _fields;
+        uint32_t _useCounter{};
+
+    public:
+        static constexpr uint32_t kNoNode = UINT32_MAX;
+        static constexpr size_t kMaxFields = 64;
+
+        /**
+         * Returns the field for the given goal, creating an empty one if needed. The least recently used field is
+         * dropped once there are kMaxFields.
+         */
+        PathFlowField& GetField(const TileCoordsXYZ& goal, RideId queueRideIndex);
+        size_t GetFieldCount() const;
+
+        uint32_t FindNode(const TileCoordsXYZ& loc) const;
+        uint32_t GetNode(const TileCoordsXYZ& loc);
+        const TileCoordsXYZ& GetNodeLocation(uint32_t node) const;
+
+        void Clear();
+
+    private:
+        static uint64_t GetKey(const TileCoordsXYZ& loc);
+    };
+} // namespace OpenRCT2::PathFinding
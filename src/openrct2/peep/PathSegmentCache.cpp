@@ -0,0 +1,113 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "PathSegmentCache.h"
+
+#include "../world/Map.h"
+#include "../world/TileElement.h"
+
+#include <algorithm>
+
+namespace OpenRCT2::PathFinding
+{
+    const PathSegment* PathSegmentCache::Find(
+        const TileCoordsXYZ& loc, Direction direction, const std::vector<TileElement>& tileElements)
+    {
+        auto it = _segments.find(GetKey(loc, direction));
+        if (it == _segments.end())
+            return nullptr;
+
+        const auto& segment = it->second;
+        auto isValid = std::all_of(segment.Tiles.begin(), segment.Tiles.end(), [&](const PathSegmentTile& tile) {
+            return IsTileValid(tile, segment.Stamp, tileElements);
+        });
+        if (!isValid || !IsTileValid(segment.End, segment.Stamp, tileElements))
+        {
+            // Drop it, the same segment may never be asked for again
+            _segments.erase(it);
+            return nullptr;
+        }
+        return &segment;
+    }
+
+    const PathSegment& PathSegmentCache::Store(const TileCoordsXYZ& loc, Direction direction, PathSegment&& segment)
+    {
+        segment.Stamp = _stamp;
+        auto& result = _segments[GetKey(loc, direction)];
+        result = std::move(segment);
+        return result;
+    }
+
+    void PathSegmentCache::InvalidateTile(const TileCoordsXY& coords)
+    {
+        auto tileIndex = GetTileIndex(coords);
+        if (tileIndex == -1)
+            return;
+
+        if (_tileStamps.empty())
+        {
+            _tileStamps.resize(kMaximumMapSizeTechnical * kMaximumMapSizeTechnical);
+        }
+        _tileStamps[tileIndex] = ++_stamp;
+    }
+
+    void PathSegmentCache::Clear()
+    {
+        _segments.clear();
+    }
+
+    uint64_t PathSegmentCache::GetSignature(const TileElement& tileElement)
+    {
+        const auto* pathElement = tileElement.AsPath();
+        if (pathElement == nullptr)
+            return 0;
+
+        // Everything the search reads from a path, with the top bit set so that no path signs as 0
+        uint64_t signature = pathElement->BaseHeight;
+        signature |= static_cast<uint64_t>(pathElement->GetEdges()) << 8;
+        signature |= static_cast<uint64_t>(pathElement->GetSlopeDirection()) << 12;
+        signature |= static_cast<uint64_t>(pathElement->IsSloped()) << 14;
+        signature |= static_cast<uint64_t>(pathElement->IsQueue()) << 15;
+        signature |= static_cast<uint64_t>(pathElement->IsWide()) << 16;
+        signature |= static_cast<uint64_t>(pathElement->IsGhost()) << 17;
+        if (pathElement->IsQueue())
+        {
+            // Other paths keep litter bin state in the same field
+            signature |= static_cast<uint64_t>(pathElement->GetRideIndex().ToUnderlying()) << 18;
+        }
+        signature |= 1ULL << 63;
+        return signature;
+    }
+
+    bool PathSegmentCache::IsTileValid(
+        const PathSegmentTile& tile, uint32_t stamp, const std::vector<TileElement>& tileElements) const
+    {
+        auto tileIndex = GetTileIndex(tile.Location);
+        if (tileIndex != -1 && !_tileStamps.empty() && _tileStamps[tileIndex] > stamp)
+            return false;
+
+        if (tile.ElementIndex == kNoElement)
+            return true;
+        return tile.ElementIndex < tileElements.size() && GetSignature(tileElements[tile.ElementIndex]) == tile.Signature;
+    }
+
+    uint64_t PathSegmentCache::GetKey(const TileCoordsXYZ& loc, Direction direction)
+    {
+        return (static_cast<uint64_t>(static_cast<uint16_t>(loc.x)) << 32)
+            | (static_cast<uint64_t>(static_cast<uint16_t>(loc.y)) << 16) | (static_cast<uint64_t>(loc.z & 0xFF) << 2)
+            | (direction & 3);
+    }
+
+    int32_t PathSegmentCache::GetTileIndex(const TileCoordsXY& coords)
+    {
+        if (coords.x < 0 || coords.y < 0 || coords.x >= kMaximumMapSizeTechnical || coords.y >= kMaximumMapSizeTechnical)
+            return -1;
+        return coords.x * kMaximumMapSizeTechnical + coords.y;
+    }
+} // namespace OpenRCT2::PathFinding
@@ -0,0 +1,84 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../Identifiers.h"
+#include "../world/Location.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct TileElement;
+
+namespace OpenRCT2::PathFinding
+{
+    struct PathSegmentTile
+    {
+        TileCoordsXY Location;
+        // Height the tile is entered at, and the base height of its path
+        uint8_t EntryZ{};
+        uint8_t PathZ{};
+        // Height and direction the next tile is entered at
+        uint8_t ExitZ{};
+        Direction ExitDirection{};
+        // Ride of a queue path, null for other paths
+        RideId QueueRideIndex{ RideId::GetNull() };
+        // Path element on the tile, used to check that the tile has not changed since the segment was built
+        uint32_t ElementIndex{};
+        uint64_t Signature{};
+    };
+
+    /**
+     * A run of path tiles that the pathfinding search walks straight along: each tile holds a two edged path that is not
+     * wide and is the only element a peep could walk onto from the previous tile. A segment stops before junctions, dead
+     * ends, wide paths, banners, entrances and shops, which the search handles one tile at a time.
+     */
+    struct PathSegment
+    {
+        std::vector<PathSegmentTile> Tiles;
+        // Tile past the end of the segment, checked so that the segment is extended when that tile changes
+        PathSegmentTile End;
+        uint32_t Stamp{};
+    };
+
+    /**
+     * Segments of the path network keyed by the tile, height and direction they are entered from. Segments are built by
+     * the pathfinding on demand. Inserting elements on a tile marks it as changed, which drops the segments crossing it;
+     * changes to the path elements themselves are caught by comparing each tile's signature when a segment is read.
+     */
+    class PathSegmentCache
+    {
+        std::unordered_map<uint64_t, PathSegment> _segments;
+        // Stamp of the last change on each tile, or empty if no tile has changed yet
+        std::vector<uint32_t> _tileStamps;
+        uint32_t _stamp{};
+
+    public:
+        static constexpr uint32_t kNoElement = UINT32_MAX;
+
+        /**
+         * Returns the segment entered at the given location, or nullptr if it has not been built or is out of date. Out of
+         * date segments are removed.
+         */
+        const PathSegment* Find(const TileCoordsXYZ& loc, Direction direction, const std::vector<TileElement>& tileElements);
+        const PathSegment& Store(const TileCoordsXYZ& loc, Direction direction, PathSegment&& segment);
+
+        void InvalidateTile(const TileCoordsXY& coords);
+        void Clear();
+
+        static uint64_t GetSignature(const TileElement& tileElement);
+
+    private:
+        bool IsTileValid(const PathSegmentTile& tile, uint32_t stamp, const std::vector<TileElement>& tileElements) const;
+        static uint64_t GetKey(const TileCoordsXYZ& loc, Direction direction);
+        static int32_t GetTileIndex(const TileCoordsXY& coords);
+    };
+} // namespace OpenRCT2::PathFinding
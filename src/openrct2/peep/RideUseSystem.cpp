@@ -9,18 +9,17 @@
 
 #include "RideUseSystem.h"
 
+#include "../GameState.h"
+
 namespace OpenRCT2::RideUse
 {
-    static RideHistory _history;
-    static RideTypeHistory _typeHistory;
-
     RideHistory& GetHistory()
     {
-        return _history;
+        return GetGameState().RideUseHistory;
     }
 
     RideTypeHistory& GetTypeHistory()
     {
-        return _typeHistory;
+        return GetGameState().RideUseTypeHistory;
     }
 } // namespace OpenRCT2::RideUse
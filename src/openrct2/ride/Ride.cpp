@@ -480,42 +480,41 @@ bool RideTryGetOriginElement(const Ride& ride, CoordsXYE* output)
 {
     TileElement* resultTileElement = nullptr;
 
-    TileElementIterator it;
-    TileElementIteratorBegin(&it);
-    do
+    for (const auto& tilePos : MapGetRideTrackTiles(ride.id))
     {
-        if (it.element->GetType() != TileElementType::Track)
-            continue;
-        if (it.element->AsTrack()->GetRideIndex() != ride.id)
-            continue;
-
-        // Found a track piece for target ride
+        for (auto* trackElement : TileElementsView<TrackElement>(tilePos))
+        {
+            if (trackElement->GetRideIndex() != ride.id)
+                continue;
 
-        // Check if it's not the station or ??? (but allow end piece of station)
-        const auto& ted = GetTrackElementDescriptor(it.element->AsTrack()->GetTrackType());
-        bool specialTrackPiece
-            = (it.element->AsTrack()->GetTrackType() != TrackElemType::BeginStation
-               && it.element->AsTrack()->GetTrackType() != TrackElemType::MiddleStation
-               && (std::get<0>(ted.sequenceProperties) & TRACK_SEQUENCE_FLAG_ORIGIN));
+            // Found a track piece for target ride
 
-        // Set result tile to this track piece if first found track or a ???
-        if (resultTileElement == nullptr || specialTrackPiece)
-        {
-            resultTileElement = it.element;
+            // Check if it's not the station or ??? (but allow end piece of station)
+            const auto& ted = GetTrackElementDescriptor(trackElement->GetTrackType());
+            bool specialTrackPiece
+                = (trackElement->GetTrackType() != TrackElemType::BeginStation
+                   && trackElement->GetTrackType() != TrackElemType::MiddleStation
+                   && (std::get<0>(ted.sequenceProperties) & TRACK_SEQUENCE_FLAG_ORIGIN));
 
-            if (output != nullptr)
+            // Set result tile to this track piece if first found track or a ???
+            if (resultTileElement == nullptr || specialTrackPiece)
             {
-                output->element = resultTileElement;
-                output->x = it.x * kCoordsXYStep;
-                output->y = it.y * kCoordsXYStep;
+                resultTileElement = trackElement->as<TileElement>();
+
+                if (output != nullptr)
+                {
+                    output->element = resultTileElement;
+                    output->x = tilePos.x * kCoordsXYStep;
+                    output->y = tilePos.y * kCoordsXYStep;
+                }
             }
-        }
 
-        if (specialTrackPiece)
-        {
-            return true;
+            if (specialTrackPiece)
+            {
+                return true;
+            }
         }
-    } while (TileElementIteratorNext(&it));
+    }
 
     return resultTileElement != nullptr;
 }
@@ -4623,19 +4622,13 @@ bool Ride::IsBlockSectioned() const
 
 bool RideHasAnyTrackElements(const Ride& ride)
 {
-    TileElementIterator it;
-
-    TileElementIteratorBegin(&it);
-    while (TileElementIteratorNext(&it))
+    for (const auto& tilePos : MapGetRideTrackTiles(ride.id))
     {
-        if (it.element->GetType() != TileElementType::Track)
-            continue;
-        if (it.element->AsTrack()->GetRideIndex() != ride.id)
-            continue;
-        if (it.element->IsGhost())
-            continue;
-
-        return true;
+        for (auto* trackElement : TileElementsView<TrackElement>(tilePos))
+        {
+            if (trackElement->GetRideIndex() == ride.id && !trackElement->IsGhost())
+                return true;
+        }
     }
 
     return false;
@@ -5834,32 +5827,11 @@ bool Ride::HasStation() const
 
 std::vector<RideId> GetTracklessRides()
 {
-    // Iterate map and build list of seen ride IDs
-    std::vector<bool> seen;
-    seen.resize(256);
-    TileElementIterator it;
-    TileElementIteratorBegin(&it);
-    while (TileElementIteratorNext(&it))
-    {
-        auto trackEl = it.element->AsTrack();
-        if (trackEl != nullptr && !trackEl->IsGhost())
-        {
-            auto rideId = trackEl->GetRideIndex().ToUnderlying();
-            if (rideId >= seen.size())
-            {
-                seen.resize(rideId + 1);
-            }
-            seen[rideId] = true;
-        }
-    }
-
-    // Get all rides that did not get seen during map iteration
     const auto& rideManager = GetRideManager();
     std::vector<RideId> result;
     for (const auto& ride : rideManager)
     {
-        const auto rideIndex = ride.id.ToUnderlying();
-        if (seen.size() <= rideIndex || !seen[rideIndex])
+        if (!RideHasAnyTrackElements(ride))
         {
             result.push_back(ride.id);
         }
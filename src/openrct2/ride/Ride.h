@@ -305,7 +305,8 @@ public:
     uint16_t holes{};
     uint8_t sheltered_eighths{};
 
-    std::unique_ptr<RideMeasurement> measurement;
+    // Copies of the ride for drawing get a copy of the measurement, see GameStateCopyForDrawing
+    std::shared_ptr<RideMeasurement> measurement;
 
 private:
     void Update();
@@ -272,7 +272,7 @@ using UpdateRideApproachVehicleWaypointsFunction = void (*)(Guest&, const Coords
 using RideMusicUpdateFunction = void (*)(Ride&);
 using PeepUpdateRideLeaveEntranceFunc = void (*)(Guest*, Ride&, CoordsXYZD&);
 using StartRideMusicFunction = void (*)(const OpenRCT2::RideAudio::ViewportRideMusicInstance&);
-using LightFXAddLightsMagicVehicleFunction = void (*)(const Vehicle* vehicle);
+using LightFXAddLightsMagicVehicleFunction = void (*)(const Vehicle* vehicle, const CoordsXYZ& drawPos);
 using RideLocationFunction = CoordsXY (*)(const Vehicle& vehicle, const Ride& ride, const StationIndex& CurrentRideStation);
 using RideUpdateFunction = void (*)(Ride& ride);
 using RideUpdateMeasurementsSpecialElementsFunc = void (*)(Ride& ride, const track_type_t trackType);
@@ -0,0 +1,334 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TrackDesignPreviewCache.h"
+
+#include "../Context.h"
+#include "../Diagnostic.h"
+#include "../OpenRCT2.h"
+#include "../core/Crypt.h"
+#include "../core/File.h"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
+#include "../object/ObjectList.h"
+#include "../object/ObjectManager.h"
+#include "../util/Util.h"
+#include "TrackDesign.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+
+namespace OpenRCT2
+{
+    // Bump when the preview rendering or the file layout changes to invalidate existing cache files
+    static constexpr uint64_t kPreviewCacheVersion = 1;
+    static constexpr uint32_t kPreviewFileMagic = 0x56504454; // TDPV
+    static constexpr size_t kPreviewPixelsSize = 4 * kTrackPreviewImageSize;
+    static constexpr size_t kPreviewFileSize = sizeof(uint32_t) + sizeof(uint8_t) + sizeof(money64) + kPreviewPixelsSize;
+    static constexpr size_t kMaxPreviewsInMemory = 32;
+
+    static uint64_t GetHashValue(Crypt::FNV1aAlgorithm& hash)
+    {
+        auto result = hash.Finish();
+        uint64_t value{};
+        std::memcpy(&value, result.data(), sizeof(value));
+        return value;
+    }
+
+    TrackDesignPreviewCache::TrackDesignPreviewCache(u8string directory)
+        : _directory(std::move(directory))
+    {
+        _worker = std::thread(&TrackDesignPreviewCache::ProcessQueue, this);
+    }
+
+    TrackDesignPreviewCache::~TrackDesignPreviewCache()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _shouldStop = true;
+        }
+        _condition.notify_all();
+        _worker.join();
+    }
+
+    const TrackDesignPreview* TrackDesignPreviewCache::Get(const u8string& path, uint64_t environmentKey)
+    {
+        ApplyCompleted();
+        _selectedPath = path;
+        _currentEnvironmentKey = environmentKey;
+        Request(path, environmentKey, true);
+
+        auto it = _entries.find(path);
+        if (it == _entries.end() || it->second.State != EntryState::Ready)
+            return nullptr;
+
+        // Most recently shown previews are evicted last
+        _readyOrder.remove(path);
+        _readyOrder.push_back(path);
+        return &it->second.Preview;
+    }
+
+    void TrackDesignPreviewCache::Prefetch(const u8string& path, uint64_t environmentKey)
+    {
+        Request(path, environmentKey, false);
+    }
+
+    void TrackDesignPreviewCache::Request(const u8string& path, uint64_t environmentKey, bool selected)
+    {
+        auto& entry = _entries[path];
+        if (entry.State != EntryState::Unrequested && entry.EnvironmentKey == environmentKey)
+        {
+            // A design that was prefetched may still be waiting behind the other prefetches
+            if (selected && entry.State == EntryState::Loading)
+                QueueLoad(path, environmentKey, true);
+            return;
+        }
+
+        if (entry.State == EntryState::Ready)
+            _readyOrder.remove(path);
+
+        entry.State = EntryState::Loading;
+        entry.EnvironmentKey = environmentKey;
+        entry.Preview = {};
+        QueueLoad(path, environmentKey, selected);
+    }
+
+    void TrackDesignPreviewCache::ApplyCompleted()
+    {
+        std::deque<LoadResult> completed;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            completed.swap(_completed);
+        }
+
+        for (auto& result : completed)
+        {
+            auto it = _entries.find(result.Path);
+            if (it == _entries.end())
+                continue;
+
+            // Ignore results for requests that have since been superseded
+            auto& entry = it->second;
+            if (entry.State != EntryState::Loading || entry.EnvironmentKey != result.EnvironmentKey)
+                continue;
+
+            entry.Key = result.Key;
+            entry.State = result.State;
+            if (result.State == EntryState::Ready)
+            {
+                entry.Preview = std::move(result.Preview);
+                MarkReady(result.Path, entry);
+            }
+        }
+    }
+
+    void TrackDesignPreviewCache::MarkReady(const u8string& path, Entry& entry)
+    {
+        entry.State = EntryState::Ready;
+        _readyOrder.push_back(path);
+        _hasNewPreviews = true;
+
+        while (_readyOrder.size() > kMaxPreviewsInMemory)
+        {
+            _entries.erase(_readyOrder.front());
+            _readyOrder.pop_front();
+        }
+    }
+
+    bool TrackDesignPreviewCache::Update()
+    {
+        ApplyCompleted();
+
+        // Rendering stalls the main thread, so it is only done for the design the user is looking at. It must have been
+        // requested for the current settings, as rendering uses the current scenery toggle.
+        auto it = _entries.find(_selectedPath);
+        if (it != _entries.end() && it->second.State == EntryState::NeedsRender
+            && it->second.EnvironmentKey == _currentEnvironmentKey)
+        {
+            auto& entry = it->second;
+            auto td = TrackDesignImport(it->first.c_str());
+            if (td == nullptr)
+            {
+                entry.State = EntryState::Failed;
+            }
+            else
+            {
+                entry.Preview.Pixels.resize(kPreviewPixelsSize);
+                TrackDesignDrawPreview(*td, entry.Preview.Pixels.data());
+                entry.Preview.GameStateFlags = td->gameStateData.flags;
+                entry.Preview.Cost = td->gameStateData.cost;
+
+                QueueSave(entry.Key, entry.Preview);
+
+                // May evict, so the entry must not be used after this
+                MarkReady(it->first, entry);
+            }
+        }
+
+        auto hasNewPreviews = _hasNewPreviews;
+        _hasNewPreviews = false;
+        return hasNewPreviews;
+    }
+
+    uint64_t TrackDesignPreviewCache::GetEnvironmentKey()
+    {
+        auto hash = Crypt::CreateFNV1a();
+        hash->Update(&kPreviewCacheVersion, sizeof(kPreviewCacheVersion));
+
+        // Previews leave out scenery and vehicles that are not loaded, so they depend on the loaded objects
+        auto& objectManager = GetContext()->GetObjectManager();
+        for (const auto& entry : objectManager.GetLoadedObjects())
+        {
+            auto name = entry.GetName();
+            hash->Update(name.data(), name.size());
+        }
+
+        const uint8_t settings[] = {
+            static_cast<uint8_t>(gTrackDesignSceneryToggle),
+            static_cast<uint8_t>((gScreenFlags & SCREEN_FLAGS_TRACK_MANAGER) != 0),
+        };
+        hash->Update(settings, sizeof(settings));
+        return GetHashValue(*hash);
+    }
+
+    void TrackDesignPreviewCache::QueueLoad(const u8string& path, uint64_t environmentKey, bool selected)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = std::find_if(_loadQueue.begin(), _loadQueue.end(), [&](const LoadRequest& request) {
+                return request.Path == path && request.EnvironmentKey == environmentKey;
+            });
+            if (it != _loadQueue.end())
+                _loadQueue.erase(it);
+
+            // The selected design is loaded first, prefetches after any other request
+            if (selected)
+                _loadQueue.push_back({ path, environmentKey });
+            else
+                _loadQueue.push_front({ path, environmentKey });
+        }
+        _condition.notify_one();
+    }
+
+    void TrackDesignPreviewCache::QueueSave(uint64_t key, TrackDesignPreview preview)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _saveQueue.push_back({ key, std::move(preview) });
+        }
+        _condition.notify_one();
+    }
+
+    void TrackDesignPreviewCache::ProcessQueue()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true)
+        {
+            _condition.wait(lock, [this]() { return _shouldStop || !_loadQueue.empty() || !_saveQueue.empty(); });
+
+            // Pending loads are of no use once the window is closed, but rendered previews are still written out
+            if (!_shouldStop && !_loadQueue.empty())
+            {
+                auto request = std::move(_loadQueue.back());
+                _loadQueue.pop_back();
+
+                lock.unlock();
+                auto result = Load(request.Path, request.EnvironmentKey);
+                lock.lock();
+                _completed.push_back(std::move(result));
+            }
+            else if (!_saveQueue.empty())
+            {
+                auto request = std::move(_saveQueue.front());
+                _saveQueue.pop_front();
+
+                lock.unlock();
+                Save(request.Key, request.Preview);
+                lock.lock();
+            }
+            else if (_shouldStop)
+            {
+                break;
+            }
+        }
+    }
+
+    TrackDesignPreviewCache::LoadResult TrackDesignPreviewCache::Load(const u8string& path, uint64_t environmentKey) const
+    {
+        LoadResult result;
+        result.Path = path;
+        result.EnvironmentKey = environmentKey;
+        try
+        {
+            auto design = File::ReadAllBytes(path);
+            auto hash = Crypt::CreateFNV1a();
+            hash->Update(&environmentKey, sizeof(environmentKey))->Update(design.data(), design.size());
+            result.Key = GetHashValue(*hash);
+            result.State = EntryState::NeedsRender;
+
+            auto cachePath = GetCachePath(result.Key);
+            if (!File::Exists(cachePath))
+                return result;
+
+            auto compressed = File::ReadAllBytes(cachePath);
+            auto data = Ungzip(compressed.data(), compressed.size());
+            uint32_t magic{};
+            if (data.size() == kPreviewFileSize)
+                std::memcpy(&magic, data.data(), sizeof(magic));
+            if (magic != kPreviewFileMagic)
+            {
+                LOG_WARNING("Discarding invalid track design preview cache file: %s", cachePath.c_str());
+                return result;
+            }
+
+            const auto* src = data.data() + sizeof(magic);
+            result.Preview.GameStateFlags = *src++;
+            std::memcpy(&result.Preview.Cost, src, sizeof(result.Preview.Cost));
+            src += sizeof(result.Preview.Cost);
+            result.Preview.Pixels.assign(src, src + kPreviewPixelsSize);
+            result.State = EntryState::Ready;
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARNING("Unable to load track design preview for %s: %s", path.c_str(), e.what());
+            if (result.State != EntryState::NeedsRender)
+                result.State = EntryState::Failed;
+        }
+        return result;
+    }
+
+    void TrackDesignPreviewCache::Save(uint64_t key, const TrackDesignPreview& preview) const
+    {
+        try
+        {
+            std::vector<uint8_t> data(kPreviewFileSize);
+            auto* dst = data.data();
+            std::memcpy(dst, &kPreviewFileMagic, sizeof(kPreviewFileMagic));
+            dst += sizeof(kPreviewFileMagic);
+            *dst++ = preview.GameStateFlags;
+            std::memcpy(dst, &preview.Cost, sizeof(preview.Cost));
+            dst += sizeof(preview.Cost);
+            std::memcpy(dst, preview.Pixels.data(), kPreviewPixelsSize);
+
+            auto compressed = Gzip(data.data(), data.size());
+            Path::CreateDirectory(_directory);
+            File::WriteAllBytes(GetCachePath(key), compressed.data(), compressed.size());
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARNING("Unable to save track design preview: %s", e.what());
+        }
+    }
+
+    u8string TrackDesignPreviewCache::GetCachePath(uint64_t key) const
+    {
+        return Path::Combine(_directory, String::StdFormat("%016" PRIx64 ".tdp", key));
+    }
+} // namespace OpenRCT2
@@ -0,0 +1,134 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../core/Money.hpp"
+#include "../core/StringTypes.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenRCT2
+{
+    struct TrackDesignPreview
+    {
+        // Four rotations of kTrackPreviewImageSize pixels each
+        std::vector<uint8_t> Pixels;
+        // TrackDesignGameStateData values computed while placing the preview
+        uint8_t GameStateFlags{};
+        money64 Cost{};
+    };
+
+    /**
+     * Keeps rendered track design previews in memory and on disk, keyed by a hash of the design file and of everything
+     * else that affects the picture (loaded objects, scenery toggle). File reading, hashing and (de)compression run on a
+     * background thread. Rendering a missing preview needs the global map, so it is done by Update on the main thread,
+     * and only for the selected design.
+     */
+    class TrackDesignPreviewCache
+    {
+    public:
+        explicit TrackDesignPreviewCache(u8string directory);
+        ~TrackDesignPreviewCache();
+
+        /**
+         * Returns the preview for the design if it is ready, otherwise requests it and returns nullptr. The design
+         * becomes the selected one, which is loaded before any prefetched design and rendered if it is not on disk.
+         */
+        const TrackDesignPreview* Get(const u8string& path, uint64_t environmentKey);
+
+        /**
+         * Loads the preview from disk in the background if it was rendered before, e.g. for designs next to the
+         * selected one. Prefetched designs are never rendered until they are selected.
+         */
+        void Prefetch(const u8string& path, uint64_t environmentKey);
+
+        /**
+         * Renders the selected preview if it is missing. Returns true if any preview became ready since the last call.
+         */
+        bool Update();
+
+        /**
+         * Hash of the loaded objects and preview settings that the rendered image depends on.
+         */
+        static uint64_t GetEnvironmentKey();
+
+    private:
+        enum class EntryState : uint8_t
+        {
+            Unrequested,
+            Loading,
+            NeedsRender,
+            Ready,
+            Failed,
+        };
+
+        struct Entry
+        {
+            EntryState State = EntryState::Unrequested;
+            uint64_t EnvironmentKey{};
+            uint64_t Key{};
+            TrackDesignPreview Preview;
+        };
+
+        struct LoadRequest
+        {
+            u8string Path;
+            uint64_t EnvironmentKey{};
+        };
+
+        struct SaveRequest
+        {
+            uint64_t Key{};
+            TrackDesignPreview Preview;
+        };
+
+        struct LoadResult
+        {
+            u8string Path;
+            uint64_t EnvironmentKey{};
+            uint64_t Key{};
+            EntryState State{};
+            TrackDesignPreview Preview;
+        };
+
+        u8string _directory;
+        std::unordered_map<u8string, Entry> _entries;
+        std::list<u8string> _readyOrder;
+        u8string _selectedPath;
+        uint64_t _currentEnvironmentKey{};
+        bool _hasNewPreviews = false;
+
+        std::thread _worker;
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        // Loads are taken from the back, saves from the front
+        std::deque<LoadRequest> _loadQueue;
+        std::deque<SaveRequest> _saveQueue;
+        std::deque<LoadResult> _completed;
+        bool _shouldStop = false;
+
+        void Request(const u8string& path, uint64_t environmentKey, bool selected);
+        void ApplyCompleted();
+        void MarkReady(const u8string& path, Entry& entry);
+        void QueueLoad(const u8string& path, uint64_t environmentKey, bool selected);
+        void QueueSave(uint64_t key, TrackDesignPreview preview);
+        void ProcessQueue();
+        LoadResult Load(const u8string& path, uint64_t environmentKey) const;
+        void Save(uint64_t key, const TrackDesignPreview& preview) const;
+        u8string GetCachePath(uint64_t key) const;
+    };
+} // namespace OpenRCT2
@@ -43,6 +43,12 @@ HOOK_TYPE OpenRCT2::Scripting::GetHookType(const std::string& name)
     return (result != HooksLookupTable.end()) ? result->second : HOOK_TYPE::UNDEFINED;
 }
 
+std::string_view OpenRCT2::Scripting::GetHookName(HOOK_TYPE type)
+{
+    auto result = HooksLookupTable.find(type);
+    return (result != HooksLookupTable.end()) ? result->first : std::string_view();
+}
+
 HookEngine::HookEngine(ScriptEngine& scriptEngine)
     : _scriptEngine(scriptEngine)
 {
@@ -114,7 +120,7 @@ void HookEngine::Call(HOOK_TYPE type, bool isGameStateMutable)
     auto& hookList = GetHookList(type);
     for (auto& hook : hookList.Hooks)
     {
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, {}, isGameStateMutable);
+        CallHook(hook, type, {}, isGameStateMutable);
     }
 }
 
@@ -123,7 +129,7 @@ void HookEngine::Call(HOOK_TYPE type, const DukValue& arg, bool isGameStateMutab
     auto& hookList = GetHookList(type);
     for (auto& hook : hookList.Hooks)
     {
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, { arg }, isGameStateMutable);
+        CallHook(hook, type, { arg }, isGameStateMutable);
     }
 }
 
@@ -158,8 +164,22 @@ void HookEngine::Call(
 
         std::vector<DukValue> dukArgs;
         dukArgs.push_back(DukValue::take_from_stack(ctx));
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, dukArgs, isGameStateMutable);
+        CallHook(hook, type, dukArgs, isGameStateMutable);
+    }
+}
+
+void HookEngine::CallHook(const Hook& hook, HOOK_TYPE type, const std::vector<DukValue>& args, bool isGameStateMutable)
+{
+    auto& profiler = _scriptEngine.GetPluginProfiler();
+
+    // Only hooks that can not change the game state may be skipped, otherwise clients would desync
+    if (!isGameStateMutable && profiler.IsThrottled(hook.Owner))
+    {
+        return;
     }
+
+    PluginProfiler::ScopedCall profiledCall(profiler, hook.Owner, GetHookName(type));
+    _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, args, isGameStateMutable);
 }
 
 HookList& HookEngine::GetHookList(HOOK_TYPE type)
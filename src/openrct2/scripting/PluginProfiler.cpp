@@ -0,0 +1,226 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifdef ENABLE_SCRIPTING
+
+#    include "PluginProfiler.h"
+
+#    include "../Diagnostic.h"
+#    include "Plugin.h"
+
+#    include <algorithm>
+#    include <cmath>
+#    include <tuple>
+
+using namespace OpenRCT2::Scripting;
+
+// Number of ticks a plugin is throttled for after exceeding its budget, also used to rate limit the warnings.
+static constexpr uint32_t kCooldownTicks = 40;
+
+double PluginCallStats::GetPercentile(double percentile) const
+{
+    const auto numSamples = std::min(SampleIterator, Samples.size());
+    if (numSamples == 0)
+        return 0;
+
+    std::vector<double> sorted(Samples.begin(), Samples.begin() + numSamples);
+    auto index = static_cast<size_t>(std::ceil(percentile / 100.0 * numSamples));
+    index = std::clamp<size_t>(index, 1, numSamples) - 1;
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+PluginProfiler::ScopedCall::ScopedCall(
+    PluginProfiler& profiler, const std::shared_ptr<Plugin>& plugin, std::string_view category)
+    : _profiler(profiler)
+    , _plugin(plugin)
+    , _category(category)
+{
+    if (_profiler.IsTiming())
+    {
+        _start = Clock::now();
+    }
+}
+
+PluginProfiler::ScopedCall::~ScopedCall()
+{
+    if (_start != Clock::time_point{})
+    {
+        const std::chrono::duration<double, std::micro> elapsed = Clock::now() - _start;
+        _profiler.Record(_plugin, _category, elapsed.count());
+    }
+}
+
+void PluginProfiler::Enable()
+{
+    _enabled = true;
+}
+
+void PluginProfiler::Disable()
+{
+    _enabled = false;
+}
+
+bool PluginProfiler::IsEnabled() const
+{
+    return _enabled;
+}
+
+void PluginProfiler::Reset()
+{
+    _stats.clear();
+    _removedStats.clear();
+}
+
+bool PluginProfiler::IsTiming() const
+{
+    return _enabled || _budgetAction != PluginBudgetAction::None;
+}
+
+void PluginProfiler::SetBudget(double budgetMs, PluginBudgetAction action)
+{
+    _budgetUs = std::max(0.0, budgetMs * 1000.0);
+    _budgetAction = _budgetUs > 0 ? action : PluginBudgetAction::None;
+    _tickTimes.clear();
+    _cooldownTicks.clear();
+}
+
+double PluginProfiler::GetBudget() const
+{
+    return _budgetUs / 1000.0;
+}
+
+PluginBudgetAction PluginProfiler::GetBudgetAction() const
+{
+    return _budgetAction;
+}
+
+bool PluginProfiler::IsThrottled(const std::shared_ptr<Plugin>& plugin) const
+{
+    return _budgetAction == PluginBudgetAction::Throttle && _cooldownTicks.find(plugin.get()) != _cooldownTicks.end();
+}
+
+PluginCallStats& PluginProfiler::GetStats(const Plugin& plugin, std::string_view category)
+{
+    auto categoryIt = _categories.find(category);
+    if (categoryIt == _categories.end())
+    {
+        categoryIt = _categories.emplace(category).first;
+    }
+
+    const auto key = std::make_pair(&plugin, &*categoryIt);
+    auto it = _stats.find(key);
+    if (it != _stats.end())
+    {
+        return it->second;
+    }
+
+    // First call since the plugin was loaded, continue from an earlier load if there was one
+    const auto& pluginName = plugin.GetMetadata().Name;
+    auto removedIt = std::find_if(_removedStats.begin(), _removedStats.end(), [&](const PluginCallStats& stats) {
+        return stats.PluginName == pluginName && stats.Category == category;
+    });
+    if (removedIt != _removedStats.end())
+    {
+        it = _stats.emplace(key, std::move(*removedIt)).first;
+        _removedStats.erase(removedIt);
+    }
+    else
+    {
+        it = _stats.emplace(key, PluginCallStats{}).first;
+        it->second.PluginName = pluginName;
+        it->second.Category = category;
+    }
+    return it->second;
+}
+
+void PluginProfiler::Record(const std::shared_ptr<Plugin>& plugin, std::string_view category, double timeUs)
+{
+    if (plugin == nullptr)
+        return;
+
+    if (_enabled)
+    {
+        auto& stats = GetStats(*plugin, category);
+        stats.CallCount++;
+        stats.TotalTime += timeUs;
+        stats.MaxTime = std::max(stats.MaxTime, timeUs);
+        stats.Samples[stats.SampleIterator % stats.Samples.size()] = timeUs;
+        stats.SampleIterator++;
+    }
+
+    if (_budgetAction != PluginBudgetAction::None)
+    {
+        _tickTimes[plugin.get()] += timeUs;
+    }
+}
+
+void PluginProfiler::EndTick()
+{
+    for (auto it = _cooldownTicks.begin(); it != _cooldownTicks.end();)
+    {
+        if (--it->second == 0)
+            it = _cooldownTicks.erase(it);
+        else
+            it++;
+    }
+
+    if (_budgetAction != PluginBudgetAction::None)
+    {
+        for (const auto& [plugin, timeUs] : _tickTimes)
+        {
+            if (timeUs <= _budgetUs)
+                continue;
+
+            if (_cooldownTicks.find(plugin) == _cooldownTicks.end())
+            {
+                LOG_WARNING(
+                    "Plugin '%s' took %.2f ms in one tick, exceeding the budget of %.2f ms%s",
+                    plugin->GetMetadata().Name.c_str(), timeUs / 1000.0, _budgetUs / 1000.0,
+                    _budgetAction == PluginBudgetAction::Throttle ? ", throttling" : "");
+            }
+            _cooldownTicks[plugin] = kCooldownTicks;
+        }
+    }
+    _tickTimes.clear();
+}
+
+void PluginProfiler::RemovePlugin(const std::shared_ptr<Plugin>& plugin)
+{
+    _tickTimes.erase(plugin.get());
+    _cooldownTicks.erase(plugin.get());
+
+    // The address may be reused by the next plugin that is loaded, so the stats can no longer be keyed by it
+    auto it = _stats.lower_bound({ plugin.get(), nullptr });
+    while (it != _stats.end() && it->first.first == plugin.get())
+    {
+        _removedStats.push_back(std::move(it->second));
+        it = _stats.erase(it);
+    }
+}
+
+std::vector<const PluginCallStats*> PluginProfiler::GetData() const
+{
+    std::vector<const PluginCallStats*> result;
+    result.reserve(_stats.size() + _removedStats.size());
+    for (const auto& [key, stats] : _stats)
+    {
+        result.push_back(&stats);
+    }
+    for (const auto& stats : _removedStats)
+    {
+        result.push_back(&stats);
+    }
+    std::sort(result.begin(), result.end(), [](const PluginCallStats* a, const PluginCallStats* b) {
+        return std::tie(a->PluginName, a->Category) < std::tie(b->PluginName, b->Category);
+    });
+    return result;
+}
+
+#endif
@@ -0,0 +1,117 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifdef ENABLE_SCRIPTING
+
+#    include <array>
+#    include <chrono>
+#    include <cstdint>
+#    include <map>
+#    include <memory>
+#    include <set>
+#    include <string>
+#    include <string_view>
+#    include <utility>
+#    include <vector>
+
+namespace OpenRCT2::Scripting
+{
+    class Plugin;
+
+    enum class PluginBudgetAction
+    {
+        None,
+        Log,
+        Throttle,
+    };
+
+    struct PluginCallStats
+    {
+        static constexpr size_t MaxSamplesSize = 1024;
+
+        std::string PluginName;
+        std::string Category;
+
+        uint64_t CallCount{};
+
+        // Times in microseconds.
+        double TotalTime{};
+        double MaxTime{};
+        std::array<double, MaxSamplesSize> Samples{};
+        size_t SampleIterator{};
+
+        // Returns the given percentile (0-100) of the most recent samples.
+        double GetPercentile(double percentile) const;
+    };
+
+    /**
+     * Records how long each plugin spends in hooks, intervals and custom actions and optionally enforces a
+     * per-tick time budget for each plugin. The budget is enforced whether or not the profiler is enabled.
+     */
+    class PluginProfiler
+    {
+    private:
+        using Clock = std::chrono::high_resolution_clock;
+
+        bool _enabled{};
+        // Categories are interned so that stats can be looked up without building a string for every call
+        std::set<std::string, std::less<>> _categories;
+        std::map<std::pair<const Plugin*, const std::string*>, PluginCallStats> _stats;
+        // Stats of plugins that have been unloaded, carried over if the plugin is loaded again
+        std::vector<PluginCallStats> _removedStats;
+
+        double _budgetUs{};
+        PluginBudgetAction _budgetAction = PluginBudgetAction::None;
+        std::map<const Plugin*, double> _tickTimes;
+        std::map<const Plugin*, uint32_t> _cooldownTicks;
+
+    public:
+        class ScopedCall
+        {
+        private:
+            PluginProfiler& _profiler;
+            // Held by value, a JS function could destroy the original reference
+            std::shared_ptr<Plugin> _plugin;
+            std::string_view _category;
+            Clock::time_point _start;
+
+        public:
+            ScopedCall(PluginProfiler& profiler, const std::shared_ptr<Plugin>& plugin, std::string_view category);
+            ~ScopedCall();
+        };
+
+        void Enable();
+        void Disable();
+        bool IsEnabled() const;
+        void Reset();
+
+        // Whether calls need to be timed, either for the profiler or for the budget.
+        bool IsTiming() const;
+
+        void SetBudget(double budgetMs, PluginBudgetAction action);
+        double GetBudget() const;
+        PluginBudgetAction GetBudgetAction() const;
+
+        // Whether calls into the plugin that do not mutate the game state should be skipped this tick.
+        bool IsThrottled(const std::shared_ptr<Plugin>& plugin) const;
+
+        void Record(const std::shared_ptr<Plugin>& plugin, std::string_view category, double timeUs);
+        void EndTick();
+        void RemovePlugin(const std::shared_ptr<Plugin>& plugin);
+
+        std::vector<const PluginCallStats*> GetData() const;
+
+    private:
+        PluginCallStats& GetStats(const Plugin& plugin, std::string_view category);
+    };
+} // namespace OpenRCT2::Scripting
+
+#endif
@@ -772,6 +772,7 @@ void ScriptEngine::StopPlugin(std::shared_ptr<Plugin> plugin)
         RemoveIntervals(plugin);
         RemoveSockets(plugin);
         _hookEngine.UnsubscribeAll(plugin);
+        _pluginProfiler.RemovePlugin(plugin);
 
         plugin->StopEnd();
         LogPluginInfo(plugin, "Stopped");
@@ -929,6 +930,8 @@ void ScriptEngine::Tick()
     UpdateSockets();
     ProcessREPL();
     DoAutoReloadPluginCheck();
+
+    _pluginProfiler.EndTick();
 }
 
 void ScriptEngine::CheckAndStartPlugins()
@@ -1107,10 +1110,12 @@ GameActions::Result ScriptEngine::QueryOrExecuteCustomGameAction(const CustomAct
         DukValue dukResult;
         if (!isExecute)
         {
+            PluginProfiler::ScopedCall profiledCall(_pluginProfiler, customActionInfo.Owner, "action.custom.query");
             dukResult = ExecutePluginCall(customActionInfo.Owner, customActionInfo.Query, pluginCallArgs, false);
         }
         else
         {
+            PluginProfiler::ScopedCall profiledCall(_pluginProfiler, customActionInfo.Owner, "action.custom.execute");
             dukResult = ExecutePluginCall(customActionInfo.Owner, customActionInfo.Execute, pluginCallArgs, true);
         }
         return DukToGameActionResult(dukResult);
@@ -1721,7 +1726,16 @@ void ScriptEngine::UpdateIntervals()
             continue;
         }
 
-        ExecutePluginCall(interval.Owner, interval.Callback, {}, false);
+        if (_pluginProfiler.IsThrottled(interval.Owner))
+        {
+            // Run again once the plugin is no longer throttled
+            continue;
+        }
+
+        {
+            PluginProfiler::ScopedCall profiledCall(_pluginProfiler, interval.Owner, "interval");
+            ExecutePluginCall(interval.Owner, interval.Callback, {}, false);
+        }
 
         interval.LastTimestamp = timestamp;
         if (!interval.Repeat)
@@ -17,6 +17,7 @@
 #    include "../world/Location.hpp"
 #    include "HookEngine.h"
 #    include "Plugin.h"
+#    include "PluginProfiler.h"
 
 #    include <future>
 #    include <list>
@@ -46,7 +47,7 @@ namespace OpenRCT2
 
 namespace OpenRCT2::Scripting
 {
-    static constexpr int32_t OPENRCT2_PLUGIN_API_VERSION = 99;
+    static constexpr int32_t OPENRCT2_PLUGIN_API_VERSION = 100;
 
     // Versions marking breaking changes.
     static constexpr int32_t API_VERSION_33_PEEP_DEPRECATION = 33;
@@ -151,6 +152,7 @@ namespace OpenRCT2::Scripting
         std::vector<std::shared_ptr<Plugin>> _plugins;
         uint32_t _lastHotReloadCheckTick{};
         HookEngine _hookEngine;
+        PluginProfiler _pluginProfiler;
         ScriptExecutionInfo _execInfo;
         DukValue _sharedStorage;
         DukValue _parkStorage;
@@ -189,6 +191,10 @@ namespace OpenRCT2::Scripting
         {
             return _hookEngine;
         }
+        PluginProfiler& GetPluginProfiler()
+        {
+            return _pluginProfiler;
+        }
         ScriptExecutionInfo& GetExecInfo()
         {
             return _execInfo;
@@ -11,8 +11,10 @@
 
 #ifdef ENABLE_SCRIPTING
 
+#    include "../../../Context.h"
 #    include "../../../profiling/Profiling.h"
 #    include "../../Duktape.hpp"
+#    include "../../ScriptEngine.h"
 
 namespace OpenRCT2::Scripting
 {
@@ -69,19 +71,61 @@ namespace OpenRCT2::Scripting
             return DukValue::take_from_stack(_ctx);
         }
 
+        DukValue getPluginData()
+        {
+            const auto& data = GetPluginProfiler().GetData();
+            duk_push_array(_ctx);
+            duk_uarridx_t index = 0;
+            for (const auto* stats : data)
+            {
+                DukObject obj(_ctx);
+                obj.Set("plugin", stats->PluginName);
+                obj.Set("name", stats->Category);
+                obj.Set("callCount", stats->CallCount);
+                obj.Set("maxTime", stats->MaxTime);
+                obj.Set("totalTime", stats->TotalTime);
+                obj.Set("p50", stats->GetPercentile(50));
+                obj.Set("p99", stats->GetPercentile(99));
+                obj.Take().push();
+                duk_put_prop_index(_ctx, /* duk stack index */ -2, index);
+                index++;
+            }
+            return DukValue::take_from_stack(_ctx);
+        }
+
+        void setPluginBudget(double budgetMs, const std::string& action)
+        {
+            auto budgetAction = PluginBudgetAction::None;
+            if (action == "log")
+                budgetAction = PluginBudgetAction::Log;
+            else if (action == "throttle")
+                budgetAction = PluginBudgetAction::Throttle;
+            else if (action != "none")
+                duk_error(_ctx, DUK_ERR_ERROR, "Invalid budget action.");
+            GetPluginProfiler().SetBudget(budgetMs, budgetAction);
+        }
+
         void start()
         {
             OpenRCT2::Profiling::Enable();
+            GetPluginProfiler().Enable();
         }
 
         void stop()
         {
             OpenRCT2::Profiling::Disable();
+            GetPluginProfiler().Disable();
         }
 
         void reset()
         {
             OpenRCT2::Profiling::ResetData();
+            GetPluginProfiler().Reset();
+        }
+
+        static PluginProfiler& GetPluginProfiler()
+        {
+            return GetContext()->GetScriptEngine().GetPluginProfiler();
         }
 
         bool enabled_get() const
@@ -93,6 +137,8 @@ namespace OpenRCT2::Scripting
         static void Register(duk_context* ctx)
         {
             dukglue_register_method(ctx, &ScProfiler::getData, "getData");
+            dukglue_register_method(ctx, &ScProfiler::getPluginData, "getPluginData");
+            dukglue_register_method(ctx, &ScProfiler::setPluginBudget, "setPluginBudget");
             dukglue_register_method(ctx, &ScProfiler::start, "start");
             dukglue_register_method(ctx, &ScProfiler::stop, "stop");
             dukglue_register_method(ctx, &ScProfiler::reset, "reset");
@@ -12,6 +12,8 @@
 #    include "ScTile.hpp"
 
 #    include "../../../Context.h"
+#    include "../../../GameState.h"
+#    include "../../../GameStateTransient.h"
 #    include "../../../core/Guard.hpp"
 #    include "../../../entity/EntityRegistry.h"
 #    include "../../../object/LargeSceneryEntry.h"
@@ -125,6 +127,10 @@ namespace OpenRCT2::Scripting
                     first[numElements - 1].SetLastForTile(true);
                 }
             }
+            // The copied elements can be of any type
+            MapUpdateTileElementTypes(TileCoordsXY(_coords));
+            GetGameState().Transient->PathSegments.InvalidateTile(TileCoordsXY(_coords));
+            GetGameState().Transient->PathFlowFields.Clear();
             MapInvalidateTileFull(_coords);
         }
     }
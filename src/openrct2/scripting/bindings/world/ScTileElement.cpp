@@ -12,6 +12,8 @@
 #    include "ScTileElement.hpp"
 
 #    include "../../../Context.h"
+#    include "../../../GameState.h"
+#    include "../../../GameStateTransient.h"
 #    include "../../../core/Guard.hpp"
 #    include "../../../entity/EntityRegistry.h"
 #    include "../../../object/LargeSceneryEntry.h"
@@ -87,6 +89,7 @@ namespace OpenRCT2::Scripting
             scriptEngine.LogPluginInfo("Element type not recognised!");
             return;
         }
+        MapUpdateTileElementTypes(TileCoordsXY(_coords));
         CreateBannerEntryIfNeeded();
         Invalidate();
     }
@@ -655,6 +658,7 @@ namespace OpenRCT2::Scripting
 
                     auto* el = _element->AsTrack();
                     el->SetRideIndex(RideId::FromUnderlying(value.as_uint()));
+                    MapUpdateTileElementTypes(TileCoordsXY(_coords));
                     Invalidate();
                     break;
                 }
@@ -2145,6 +2149,9 @@ namespace OpenRCT2::Scripting
 
     void ScTileElement::Invalidate()
     {
+        // Scripts change elements in place, which the path segments would not otherwise notice
+        GetGameState().Transient->PathSegments.InvalidateTile(TileCoordsXY(_coords));
+        GetGameState().Transient->PathFlowFields.Clear();
         MapInvalidateTileFull(_coords);
     }
 
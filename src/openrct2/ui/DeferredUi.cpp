@@ -0,0 +1,192 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "DeferredUi.h"
+
+#include "../drawing/Drawing.h"
+#include "../interface/Viewport.h"
+#include "../localisation/Formatter.h"
+
+#include <string>
+#include <utility>
+
+namespace OpenRCT2::Ui
+{
+    static thread_local DeferredInvalidations* _deferredInvalidations = nullptr;
+    static thread_local DeferredWindowCalls* _deferredWindowCalls = nullptr;
+
+    template<typename T> static void TakeAll(std::vector<T>& dst, std::vector<T>& src)
+    {
+        if (dst.empty())
+        {
+            dst.swap(src);
+        }
+        else
+        {
+            dst.insert(dst.end(), src.begin(), src.end());
+        }
+        src.clear();
+    }
+
+    bool DeferredInvalidations::IsEmpty() const
+    {
+        return WorldAreas.empty() && ViewportAreas.empty() && ScreenAreas.empty();
+    }
+
+    void DeferredInvalidations::Take(DeferredInvalidations& other)
+    {
+        TakeAll(WorldAreas, other.WorldAreas);
+        TakeAll(ViewportAreas, other.ViewportAreas);
+        TakeAll(ScreenAreas, other.ScreenAreas);
+    }
+
+    void DeferredInvalidations::Apply()
+    {
+        for (const auto& area : WorldAreas)
+        {
+            ViewportsInvalidate(area.From, area.To, area.Width, area.MinHeight, area.MaxHeight, area.MaxZoom);
+        }
+        for (const auto& area : ViewportAreas)
+        {
+            ViewportsInvalidate(area.Rect, area.MaxZoom);
+        }
+        for (const auto& rect : ScreenAreas)
+        {
+            GfxSetDirtyBlocks(rect);
+        }
+        WorldAreas.clear();
+        ViewportAreas.clear();
+        ScreenAreas.clear();
+    }
+
+    void DeferredWindowCalls::Queue(std::function<void(IWindowManager&)> call)
+    {
+        _calls.push_back(std::move(call));
+    }
+
+    void DeferredWindowCalls::Run(IWindowManager& windowManager)
+    {
+        auto calls = std::move(_calls);
+        _calls.clear();
+        for (auto& call : calls)
+        {
+            call(windowManager);
+        }
+    }
+
+    void DeferredWindowCalls::Init()
+    {
+        Queue([](IWindowManager& windowManager) { windowManager.Init(); });
+    }
+
+    WindowBase* DeferredWindowCalls::OpenWindow(WindowClass wc)
+    {
+        Queue([wc](IWindowManager& windowManager) { windowManager.OpenWindow(wc); });
+        return nullptr;
+    }
+
+    WindowBase* DeferredWindowCalls::OpenView(uint8_t view)
+    {
+        Queue([view](IWindowManager& windowManager) { windowManager.OpenView(view); });
+        return nullptr;
+    }
+
+    WindowBase* DeferredWindowCalls::OpenDetails(uint8_t type, int32_t id)
+    {
+        Queue([type, id](IWindowManager& windowManager) { windowManager.OpenDetails(type, id); });
+        return nullptr;
+    }
+
+    WindowBase* DeferredWindowCalls::OpenIntent(Intent* intent)
+    {
+        Queue([intent = *intent](IWindowManager& windowManager) mutable { windowManager.OpenIntent(&intent); });
+        return nullptr;
+    }
+
+    void DeferredWindowCalls::BroadcastIntent(const Intent& intent)
+    {
+        Queue([intent](IWindowManager& windowManager) { windowManager.BroadcastIntent(intent); });
+    }
+
+    WindowBase* DeferredWindowCalls::ShowError(StringId title, StringId message, const Formatter& formatter, bool autoClose)
+    {
+        Queue([title, message, formatter, autoClose](IWindowManager& windowManager) {
+            windowManager.ShowError(title, message, formatter, autoClose);
+        });
+        return nullptr;
+    }
+
+    WindowBase* DeferredWindowCalls::ShowError(std::string_view title, std::string_view message, bool autoClose)
+    {
+        Queue([title = std::string(title), message = std::string(message), autoClose](IWindowManager& windowManager) {
+            windowManager.ShowError(title, message, autoClose);
+        });
+        return nullptr;
+    }
+
+    void DeferredWindowCalls::ForceClose(WindowClass windowClass)
+    {
+        Queue([windowClass](IWindowManager& windowManager) { windowManager.ForceClose(windowClass); });
+    }
+
+    void DeferredWindowCalls::UpdateMapTooltip()
+    {
+        Queue([](IWindowManager& windowManager) { windowManager.UpdateMapTooltip(); });
+    }
+
+    void DeferredWindowCalls::HandleInput()
+    {
+        Queue([](IWindowManager& windowManager) { windowManager.HandleInput(); });
+    }
+
+    void DeferredWindowCalls::HandleKeyboard(bool isTitle)
+    {
+        Queue([isTitle](IWindowManager& windowManager) { windowManager.HandleKeyboard(isTitle); });
+    }
+
+    std::string DeferredWindowCalls::GetKeyboardShortcutString(std::string_view /*shortcutId*/)
+    {
+        return std::string();
+    }
+
+    void DeferredWindowCalls::SetMainView(const ScreenCoordsXY& viewPos, ZoomLevel zoom, int32_t rotation)
+    {
+        Queue([viewPos, zoom, rotation](IWindowManager& windowManager) { windowManager.SetMainView(viewPos, zoom, rotation); });
+    }
+
+    void DeferredWindowCalls::UpdateMouseWheel()
+    {
+        Queue([](IWindowManager& windowManager) { windowManager.UpdateMouseWheel(); });
+    }
+
+    WindowBase* DeferredWindowCalls::GetOwner(const Viewport* /*viewport*/)
+    {
+        return nullptr;
+    }
+
+    void DeferInvalidations(DeferredInvalidations* invalidations)
+    {
+        _deferredInvalidations = invalidations;
+    }
+
+    DeferredInvalidations* GetDeferredInvalidations()
+    {
+        return _deferredInvalidations;
+    }
+
+    void DeferWindowCalls(DeferredWindowCalls* windowCalls)
+    {
+        _deferredWindowCalls = windowCalls;
+    }
+
+    DeferredWindowCalls* GetDeferredWindowCalls()
+    {
+        return _deferredWindowCalls;
+    }
+} // namespace OpenRCT2::Ui
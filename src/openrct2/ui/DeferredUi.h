@@ -0,0 +1,92 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../interface/ZoomLevel.h"
+#include "../world/Location.hpp"
+#include "WindowManager.h"
+
+#include <functional>
+#include <vector>
+
+namespace OpenRCT2::Ui
+{
+    /**
+     * Screen areas invalidated on a thread that records them, instead of being passed to the viewports and the drawing
+     * engine. Areas of the game world are kept in world coordinates, so recording them does not read the viewports.
+     */
+    struct DeferredInvalidations
+    {
+        struct WorldArea
+        {
+            CoordsXYZ From;
+            CoordsXYZ To;
+            int32_t Width;
+            int32_t MinHeight;
+            int32_t MaxHeight;
+            ZoomLevel MaxZoom;
+        };
+
+        struct ViewportArea
+        {
+            ScreenRect Rect;
+            ZoomLevel MaxZoom;
+        };
+
+        std::vector<WorldArea> WorldAreas;
+        std::vector<ViewportArea> ViewportAreas;
+        std::vector<ScreenRect> ScreenAreas;
+
+        bool IsEmpty() const;
+        // Moves the areas of other to this list
+        void Take(DeferredInvalidations& other);
+        // Invalidates the areas on the calling thread and clears the list
+        void Apply();
+    };
+
+    /**
+     * A window manager for threads that do not own the user interface. Calls are queued and run on the thread that
+     * owns it, windows are never returned.
+     */
+    class DeferredWindowCalls final : public IWindowManager
+    {
+        std::vector<std::function<void(IWindowManager&)>> _calls;
+
+    public:
+        void Queue(std::function<void(IWindowManager&)> call);
+        // Runs the queued calls on windowManager and clears the queue
+        void Run(IWindowManager& windowManager);
+
+        void Init() override;
+        WindowBase* OpenWindow(WindowClass wc) override;
+        WindowBase* OpenView(uint8_t view) override;
+        WindowBase* OpenDetails(uint8_t type, int32_t id) override;
+        WindowBase* OpenIntent(Intent* intent) override;
+        void BroadcastIntent(const Intent& intent) override;
+        WindowBase* ShowError(StringId title, StringId message, const Formatter& formatter, bool autoClose) override;
+        WindowBase* ShowError(std::string_view title, std::string_view message, bool autoClose) override;
+        void ForceClose(WindowClass windowClass) override;
+        void UpdateMapTooltip() override;
+        void HandleInput() override;
+        void HandleKeyboard(bool isTitle) override;
+        std::string GetKeyboardShortcutString(std::string_view shortcutId) override;
+        void SetMainView(const ScreenCoordsXY& viewPos, ZoomLevel zoom, int32_t rotation) override;
+        void UpdateMouseWheel() override;
+        WindowBase* GetOwner(const Viewport* viewport) override;
+    };
+
+    // Records the invalidations of the calling thread in the given list until it is called with nullptr
+    void DeferInvalidations(DeferredInvalidations* invalidations);
+    DeferredInvalidations* GetDeferredInvalidations();
+
+    // Queues the window calls of the calling thread in the given list until it is called with nullptr
+    void DeferWindowCalls(DeferredWindowCalls* windowCalls);
+    DeferredWindowCalls* GetDeferredWindowCalls();
+} // namespace OpenRCT2::Ui
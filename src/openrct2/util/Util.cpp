@@ -172,9 +172,20 @@ char* SafeStrCat(char* destination, const char* source, size_t size)
     return result;
 }
 
+static thread_local std::mt19937 _prng{ std::random_device{}() };
+static thread_local std::mt19937 _normalPrng{ std::random_device{}() };
+static thread_local std::normal_distribution<float> _normalDistributor{ 0.0f, 1.0f };
+
+// Reseeds the calling thread's generators, so that e.g. map generation can be reproduced.
+void UtilSrand(uint32_t seed)
+{
+    _prng.seed(seed);
+    _normalPrng.seed(seed);
+    _normalDistributor.reset();
+}
+
 uint32_t UtilRand()
 {
-    thread_local std::mt19937 _prng(std::random_device{}());
     return _prng();
 }
 
@@ -182,9 +193,7 @@ uint32_t UtilRand()
 // TODO: In C++20 this can be templated, where the standard deviation is passed as a value template argument.
 float UtilRandNormalDistributed()
 {
-    thread_local std::mt19937 _prng{ std::random_device{}() };
-    thread_local std::normal_distribution<float> _distributor{ 0.0f, 1.0f };
-    return _distributor(_prng);
+    return _normalDistributor(_normalPrng);
 }
 
 constexpr size_t CHUNK = 128 * 1024;
@@ -76,6 +76,7 @@ int32_t StrLogicalCmp(char const* a, char const* b);
 char* SafeStrCpy(char* destination, const char* source, size_t num);
 char* SafeStrCat(char* destination, const char* source, size_t size);
 
+void UtilSrand(uint32_t seed);
 uint32_t UtilRand();
 float UtilRandNormalDistributed();
 
@@ -52,6 +52,7 @@ enum IntentAction
     INTENT_ACTION_REMOVE_PROVISIONAL_ELEMENTS,
     INTENT_ACTION_RESTORE_PROVISIONAL_ELEMENTS,
     INTENT_ACTION_REMOVE_PROVISIONAL_FOOTPATH,
+    INTENT_ACTION_UPDATE_GUEST_LIST_ENTRY,
 
     INTENT_ACTION_NULL = 255,
 };
@@ -132,4 +133,5 @@ enum
     INTENT_EXTRA_PROGRESS_OFFSET,
     INTENT_EXTRA_PROGRESS_TOTAL,
     INTENT_EXTRA_STRING_ID,
+    INTENT_EXTRA_PEEP_ID,
 };
@@ -30,6 +30,7 @@
 #include "Map.h"
 #include "MapAnimation.h"
 #include "Park.h"
+#include "TileElementsView.h"
 
 using namespace OpenRCT2;
 
@@ -223,16 +224,17 @@ void ParkEntranceUpdateLocations()
 {
     auto& gameState = GetGameState();
     gameState.Park.Entrances.clear();
-    TileElementIterator it;
-    TileElementIteratorBegin(&it);
-    while (TileElementIteratorNext(&it))
+    for (const auto& tilePos : MapGetTilesWithElementTypes({ TileElementType::Entrance }))
     {
-        auto entranceElement = it.element->AsEntrance();
-        if (entranceElement != nullptr && entranceElement->GetEntranceType() == ENTRANCE_TYPE_PARK_ENTRANCE
-            && entranceElement->GetSequenceIndex() == 0 && !entranceElement->IsGhost())
+        for (auto* entranceElement : TileElementsView<EntranceElement>(tilePos))
         {
-            auto entrance = TileCoordsXYZD(it.x, it.y, it.element->BaseHeight, it.element->GetDirection()).ToCoordsXYZD();
-            gameState.Park.Entrances.push_back(entrance);
+            if (entranceElement->GetEntranceType() == ENTRANCE_TYPE_PARK_ENTRANCE && entranceElement->GetSequenceIndex() == 0
+                && !entranceElement->IsGhost())
+            {
+                auto entrance = TileCoordsXYZD(tilePos, entranceElement->BaseHeight, entranceElement->GetDirection())
+                                    .ToCoordsXYZD();
+                gameState.Park.Entrances.push_back(entrance);
+            }
         }
     }
 }
@@ -12,6 +12,7 @@
 #include "../Diagnostic.h"
 #include "../Game.h"
 #include "../GameState.h"
+#include "../GameStateTransient.h"
 #include "../Identifiers.h"
 #include "../OpenRCT2.h"
 #include "../actions/FootpathPlaceAction.h"
@@ -740,6 +741,8 @@ void FootpathConnectEdges(const CoordsXY& footpathPos, TileElement* tileElement,
     FootpathNeighbourList neighbourList;
     FootpathNeighbour neighbour;
 
+    // The guest flow fields are built from the edges and queues of paths
+    GetGameState().Transient->PathFlowFields.Clear();
     FootpathUpdateQueueChains();
 
     FootpathNeighbourListInit(&neighbourList);
@@ -809,6 +812,7 @@ void FootpathChainRideQueue(
 
     lastPathElement = nullptr;
     lastQueuePathElement = nullptr;
+    GetGameState().Transient->PathFlowFields.Clear();
     for (;;)
     {
         if (tileElement->GetType() == TileElementType::Path)
@@ -1779,6 +1783,7 @@ bool FootpathIsBlockedByVehicle(const TileCoordsXYZ& position)
  */
 void FootpathUpdateQueueEntranceBanner(const CoordsXY& footpathPos, TileElement* tileElement)
 {
+    GetGameState().Transient->PathFlowFields.Clear();
     const auto elementType = tileElement->GetType();
     if (elementType == TileElementType::Path)
     {
@@ -2025,6 +2030,7 @@ static void FootpathFixCornersAround(const TileCoordsXY& footpathPos, TileElemen
  */
 void FootpathRemoveEdgesAt(const CoordsXY& footpathPos, TileElement* tileElement)
 {
+    GetGameState().Transient->PathFlowFields.Clear();
     if (tileElement->GetType() == TileElementType::Track)
     {
         auto rideIndex = tileElement->AsTrack()->GetRideIndex();
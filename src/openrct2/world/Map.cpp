@@ -14,6 +14,7 @@
 #include "../Diagnostic.h"
 #include "../Game.h"
 #include "../GameState.h"
+#include "../GameStateTransient.h"
 #include "../Input.h"
 #include "../OpenRCT2.h"
 #include "../actions/BannerRemoveAction.h"
@@ -46,6 +47,7 @@
 #include "../scenario/Scenario.h"
 #include "../util/Util.h"
 #include "../windows/Intent.h"
+#include "../world/TileElementTypeIndex.h"
 #include "../world/TilePointerIndex.hpp"
 #include "../world/tile_element/Slope.h"
 #include "Banner.h"
@@ -101,29 +103,41 @@ uint32_t gLandRemainingConstructionSales;
 
 bool gMapLandRightsUpdateSuccess;
 
-static TilePointerIndex<TileElement> _tileIndex;
 static TilePointerIndex<TileElement> _tileIndexStash;
+static TileElementTypeIndex _tileTypeIndexStash;
+
+// GameStateTransient::RideTrackTiles holds the tiles that may hold track of each ride, rebuilt from the track tiles after the
+// map is replaced. GameStateTransient::NewTrackTiles holds the tiles that got a track element since the lists were last read,
+// their ride is not known until then.
+static constexpr size_t kMaxNewTrackTiles = 0x10000;
 static std::vector<TileElement> _tileElementsStash;
-static size_t _tileElementsInUse;
 static size_t _tileElementsInUseStash;
 static TileCoordsXY _mapSizeStash;
 
 void StashMap()
 {
     auto& gameState = GetGameState();
-    _tileIndexStash = std::move(_tileIndex);
+    _tileIndexStash = std::move(gameState.Transient->TileIndex);
+    _tileTypeIndexStash = std::move(gameState.Transient->TileTypeIndex);
+    gameState.Transient->RideTrackTilesValid = false;
+    gameState.Transient->PathSegments.Clear();
+    gameState.Transient->PathFlowFields.Clear();
     _tileElementsStash = std::move(gameState.TileElements);
     _mapSizeStash = gameState.MapSize;
-    _tileElementsInUseStash = _tileElementsInUse;
+    _tileElementsInUseStash = gameState.Transient->TileElementsInUse;
 }
 
 void UnstashMap()
 {
     auto& gameState = GetGameState();
-    _tileIndex = std::move(_tileIndexStash);
+    gameState.Transient->TileIndex = std::move(_tileIndexStash);
+    gameState.Transient->TileTypeIndex = std::move(_tileTypeIndexStash);
+    gameState.Transient->RideTrackTilesValid = false;
+    gameState.Transient->PathSegments.Clear();
+    gameState.Transient->PathFlowFields.Clear();
     gameState.TileElements = std::move(_tileElementsStash);
     gameState.MapSize = _mapSizeStash;
-    _tileElementsInUse = _tileElementsInUseStash;
+    gameState.Transient->TileElementsInUse = _tileElementsInUseStash;
 }
 
 CoordsXY GetMapSizeUnits()
@@ -150,9 +164,14 @@ const std::vector<TileElement>& GetTileElements()
 void SetTileElements(GameState_t& gameState, std::vector<TileElement>&& tileElements)
 {
     gameState.TileElements = std::move(tileElements);
-    _tileIndex = TilePointerIndex<TileElement>(
+    gameState.Transient->TileIndex = TilePointerIndex<TileElement>(
+        kMaximumMapSizeTechnical, gameState.TileElements.data(), gameState.TileElements.size());
+    gameState.Transient->TileTypeIndex = TileElementTypeIndex(
         kMaximumMapSizeTechnical, gameState.TileElements.data(), gameState.TileElements.size());
-    _tileElementsInUse = gameState.TileElements.size();
+    gameState.Transient->RideTrackTilesValid = false;
+    gameState.Transient->PathSegments.Clear();
+    gameState.Transient->PathFlowFields.Clear();
+    gameState.Transient->TileElementsInUse = gameState.TileElements.size();
 }
 
 static TileElement GetDefaultSurfaceElement()
@@ -253,12 +272,12 @@ void ReorganiseTileElements()
 static bool MapCheckFreeElementsAndReorganise(size_t numElementsOnTile, size_t numNewElements)
 {
     // Check hard cap on num in use tiles (this would be the size of _tileElements immediately after a reorg)
-    if (_tileElementsInUse + numNewElements > MAX_TILE_ELEMENTS)
+    auto& gameState = GetGameState();
+    if (gameState.Transient->TileElementsInUse + numNewElements > MAX_TILE_ELEMENTS)
     {
         return false;
     }
 
-    auto& gameState = GetGameState();
     auto totalElementsRequired = numElementsOnTile + numNewElements;
     auto freeElements = gameState.TileElements.capacity() - gameState.TileElements.size();
     if (freeElements >= totalElementsRequired)
@@ -267,7 +286,7 @@ static bool MapCheckFreeElementsAndReorganise(size_t numElementsOnTile, size_t n
     }
 
     // if space issue is due to fragmentation then Reorg Tiles without increasing capacity
-    if (gameState.TileElements.size() > totalElementsRequired + _tileElementsInUse)
+    if (gameState.TileElements.size() > totalElementsRequired + gameState.Transient->TileElementsInUse)
     {
         ReorganiseTileElements();
         // This check is not expected to fail
@@ -353,7 +372,7 @@ TileElement* MapGetFirstElementAt(const TileCoordsXY& tilePos)
         LOG_VERBOSE("Trying to access element outside of range");
         return nullptr;
     }
-    return _tileIndex.GetFirstElementAt(tilePos);
+    return GetGameState().Transient->TileIndex.GetFirstElementAt(tilePos);
 }
 
 TileElement* MapGetFirstElementAt(const CoordsXY& elementPos)
@@ -404,6 +423,130 @@ TileElement* MapGetFirstTileElementWithBaseHeightBetween(const TileCoordsXYRange
     return nullptr;
 }
 
+std::vector<TileCoordsXY> MapGetTilesWithElementTypes(std::initializer_list<TileElementType> types)
+{
+    uint8_t typeMask = 0;
+    for (auto type : types)
+    {
+        typeMask |= TileElementTypeIndex::GetTypeMask(type);
+    }
+
+    // Removing elements does not update the index, so check the listed tiles still hold one of the types
+    auto& gameState = GetGameState();
+    auto tiles = gameState.Transient->TileTypeIndex.GetTiles(types);
+    tiles.erase(
+        std::remove_if(
+            tiles.begin(), tiles.end(),
+            [&](const TileCoordsXY& coords) {
+                if (coords.x >= gameState.MapSize.x || coords.y >= gameState.MapSize.y)
+                    return true;
+
+                auto tileTypeMask = TileElementTypeIndex::GetTypeMask(MapGetFirstElementAt(coords));
+                gameState.Transient->TileTypeIndex.SetTileTypes(coords, tileTypeMask);
+                return (tileTypeMask & typeMask) == 0;
+            }),
+        tiles.end());
+    return tiles;
+}
+
+static void AddNewTrackTile(const TileCoordsXY& tilePos)
+{
+    auto& gameState = GetGameState();
+    if (!gameState.Transient->RideTrackTilesValid)
+        return;
+
+    // Rebuilding from the track tiles is cheaper than catching up with this many changes
+    if (gameState.Transient->NewTrackTiles.size() >= kMaxNewTrackTiles)
+    {
+        gameState.Transient->RideTrackTilesValid = false;
+        gameState.Transient->NewTrackTiles.clear();
+        return;
+    }
+    gameState.Transient->NewTrackTiles.push_back(tilePos);
+}
+
+static void AddRideTrackTile(const TileCoordsXY& tilePos)
+{
+    auto& rideTrackTiles = GetGameState().Transient->RideTrackTiles;
+    for (auto* trackElement : TileElementsView<TrackElement>(tilePos))
+    {
+        const auto rideIndex = trackElement->GetRideIndex();
+        if (rideIndex.IsNull())
+            continue;
+
+        const auto index = rideIndex.ToUnderlying();
+        if (index >= rideTrackTiles.size())
+        {
+            rideTrackTiles.resize(index + 1);
+        }
+        auto& tiles = rideTrackTiles[index];
+        if (tiles.empty() || tiles.back() != tilePos)
+        {
+            tiles.push_back(tilePos);
+        }
+    }
+}
+
+static void UpdateRideTrackTiles()
+{
+    auto& gameState = GetGameState();
+    if (!gameState.Transient->RideTrackTilesValid)
+    {
+        gameState.Transient->RideTrackTiles.clear();
+        gameState.Transient->NewTrackTiles = MapGetTilesWithElementTypes({ TileElementType::Track });
+        gameState.Transient->RideTrackTilesValid = true;
+    }
+
+    for (const auto& tilePos : gameState.Transient->NewTrackTiles)
+    {
+        AddRideTrackTile(tilePos);
+    }
+    gameState.Transient->NewTrackTiles.clear();
+}
+
+std::vector<TileCoordsXY> MapGetRideTrackTiles(RideId rideIndex)
+{
+    UpdateRideTrackTiles();
+
+    const auto index = rideIndex.ToUnderlying();
+    auto& rideTrackTiles = GetGameState().Transient->RideTrackTiles;
+    if (index >= rideTrackTiles.size())
+        return {};
+
+    // Removing track does not update the lists, so drop the tiles that no longer hold track of the ride
+    auto& tiles = rideTrackTiles[index];
+    tiles.erase(
+        std::remove_if(
+            tiles.begin(), tiles.end(),
+            [rideIndex](const TileCoordsXY& tilePos) {
+                for (auto* trackElement : TileElementsView<TrackElement>(tilePos))
+                {
+                    if (trackElement->GetRideIndex() == rideIndex)
+                        return false;
+                }
+                return true;
+            }),
+        tiles.end());
+    std::sort(tiles.begin(), tiles.end(), [](const TileCoordsXY& a, const TileCoordsXY& b) {
+        return a.x != b.x ? a.x < b.x : a.y < b.y;
+    });
+    tiles.erase(std::unique(tiles.begin(), tiles.end()), tiles.end());
+    return tiles;
+}
+
+void MapUpdateTileElementTypes(const TileCoordsXY& tilePos)
+{
+    if (!IsTileLocationValid(tilePos))
+        return;
+
+    auto typeMask = TileElementTypeIndex::GetTypeMask(MapGetFirstElementAt(tilePos));
+    GetGameState().Transient->TileTypeIndex.SetTileTypes(tilePos, typeMask);
+    if (typeMask & TileElementTypeIndex::GetTypeMask(TileElementType::Track))
+    {
+        AddNewTrackTile(tilePos);
+    }
+}
+
 void MapSetTileElement(const TileCoordsXY& tilePos, TileElement* elements)
 {
     if (!MapIsLocationValid(tilePos.ToCoordsXY()))
@@ -411,7 +554,10 @@ void MapSetTileElement(const TileCoordsXY& tilePos, TileElement* elements)
         LOG_ERROR("Trying to access element outside of range");
         return;
     }
-    _tileIndex.SetTile(tilePos, elements);
+    auto& gameState = GetGameState();
+    gameState.Transient->TileIndex.SetTile(tilePos, elements);
+    gameState.Transient->PathSegments.InvalidateTile(tilePos);
+    gameState.Transient->PathFlowFields.Clear();
 }
 
 SurfaceElement* MapGetSurfaceElementAt(const TileCoordsXY& coords)
@@ -532,6 +678,8 @@ void MapStripGhostFlagFromElements()
     {
         element.SetGhost(false);
     }
+    gameState.Transient->PathSegments.Clear();
+    gameState.Transient->PathFlowFields.Clear();
 }
 
 /**
@@ -1013,12 +1161,24 @@ bool MapIsLocationAtEdge(const CoordsXY& loc)
     return loc.x < 32 || loc.y < 32 || loc.x >= (MAXIMUM_TILE_START_XY) || loc.y >= (MAXIMUM_TILE_START_XY);
 }
 
+// Elements that the flow fields of the guest pathfinding depend on
+static bool IsPathNetworkElementType(TileElementType type)
+{
+    return type == TileElementType::Path || type == TileElementType::Entrance || type == TileElementType::Banner;
+}
+
 /**
  *
  *  rct2: 0x0068B280
  */
 void TileElementRemove(TileElement* tileElement)
 {
+    auto& gameState = GetGameState();
+    if (IsPathNetworkElementType(tileElement->GetType()))
+    {
+        gameState.Transient->PathFlowFields.Clear();
+    }
+
     // Replace Nth element by (N+1)th element.
     // This loop will make tileElement point to the old last element position,
     // after copy it to it's new position
@@ -1033,8 +1193,7 @@ void TileElementRemove(TileElement* tileElement)
     // Mark the latest element with the last element flag.
     (tileElement - 1)->SetLastForTile(true);
     tileElement->BaseHeight = MAX_ELEMENT_HEIGHT;
-    _tileElementsInUse--;
-    auto& gameState = GetGameState();
+    gameState.Transient->TileElementsInUse--;
     if (tileElement == &gameState.TileElements.back())
     {
         gameState.TileElements.pop_back();
@@ -1059,6 +1218,7 @@ void MapRemoveAllRides()
                 {
                     it.element->AsPath()->SetHasQueueBanner(false);
                     it.element->AsPath()->SetRideIndex(RideId::GetNull());
+                    GetGameState().Transient->PathFlowFields.Clear();
                 }
                 break;
             case TileElementType::Entrance:
@@ -1146,7 +1306,7 @@ void MapInvalidateSelectionRect()
 static size_t CountElementsOnTile(const CoordsXY& loc)
 {
     size_t count = 0;
-    auto* element = _tileIndex.GetFirstElementAt(TileCoordsXY(loc));
+    auto* element = GetGameState().Transient->TileIndex.GetFirstElementAt(TileCoordsXY(loc));
     do
     {
         count++;
@@ -1165,7 +1325,7 @@ static TileElement* AllocateTileElements(size_t numElementsOnTile, size_t numNew
     auto& gameState = GetGameState();
     auto oldSize = gameState.TileElements.size();
     gameState.TileElements.resize(gameState.TileElements.size() + numElementsOnTile + numNewElements);
-    _tileElementsInUse += numNewElements;
+    gameState.Transient->TileElementsInUse += numNewElements;
     return &gameState.TileElements[oldSize];
 }
 
@@ -1179,14 +1339,26 @@ TileElement* TileElementInsert(const CoordsXYZ& loc, int32_t occupiedQuadrants,
 
     auto numElementsOnTileOld = CountElementsOnTile(loc);
     auto* newTileElement = AllocateTileElements(numElementsOnTileOld, 1);
-    auto* originalTileElement = _tileIndex.GetFirstElementAt(tileLoc);
+    auto& gameState = GetGameState();
+    auto* originalTileElement = gameState.Transient->TileIndex.GetFirstElementAt(tileLoc);
     if (newTileElement == nullptr)
     {
         return nullptr;
     }
 
     // Set tile index pointer to point to new element block
-    _tileIndex.SetTile(tileLoc, newTileElement);
+    gameState.Transient->TileIndex.SetTile(tileLoc, newTileElement);
+    gameState.Transient->TileTypeIndex.Add(tileLoc, type);
+    gameState.Transient->PathSegments.InvalidateTile(tileLoc);
+    if (IsPathNetworkElementType(type))
+    {
+        gameState.Transient->PathFlowFields.Clear();
+    }
+    if (type == TileElementType::Track)
+    {
+        // The ride is set after insertion, so the tile is only sorted into its ride's list when next read
+        AddNewTrackTile(tileLoc);
+    }
 
     bool isLastForTile = false;
     if (originalTileElement == nullptr)
@@ -2214,7 +2386,7 @@ void ShiftMap(const TileCoordsXY& amount)
             if (x > 0 && y > 0 && x < gameState.MapSize.x - 1 && y < gameState.MapSize.y - 1 && srcX > 0 && srcY > 0
                 && srcX < gameState.MapSize.x - 1 && srcY < gameState.MapSize.y - 1)
             {
-                auto srcTile = _tileIndex.GetFirstElementAt(TileCoordsXY(srcX, srcY));
+                auto srcTile = gameState.Transient->TileIndex.GetFirstElementAt(TileCoordsXY(srcX, srcY));
                 do
                 {
                     newElements.push_back(*srcTile);
@@ -132,6 +132,23 @@ TileElement* MapGetFirstElementAt(const TileCoordsXY& tilePos);
 TileElement* MapGetNthElementAt(const CoordsXY& coords, int32_t n);
 TileElement* MapGetFirstTileElementWithBaseHeightBetween(const TileCoordsXYRangedZ& loc, TileElementType type);
 void MapSetTileElement(const TileCoordsXY& tilePos, TileElement* elements);
+
+/**
+ * Returns the tiles holding at least one element of the given types, ordered by x and then by y. Surface elements are on
+ * every tile and cannot be looked up this way.
+ */
+std::vector<TileCoordsXY> MapGetTilesWithElementTypes(std::initializer_list<TileElementType> types);
+
+/**
+ * Returns the tiles holding track elements of the given ride, including ghosts, ordered by x and then by y.
+ */
+std::vector<TileCoordsXY> MapGetRideTrackTiles(RideId rideIndex);
+
+/**
+ * Must be called after changing the type or the ride of an existing element, elements added with TileElementInsert are
+ * tracked.
+ */
+void MapUpdateTileElementTypes(const TileCoordsXY& tilePos);
 int32_t MapHeightFromSlope(const CoordsXY& coords, int32_t slopeDirection, bool isSloped);
 BannerElement* MapGetBannerElementAt(const CoordsXYZ& bannerPos, uint8_t direction);
 SurfaceElement* MapGetSurfaceElementAt(const TileCoordsXY& coords);
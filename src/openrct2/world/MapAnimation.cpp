@@ -13,6 +13,7 @@
 #include "../Diagnostic.h"
 #include "../Game.h"
 #include "../GameState.h"
+#include "../GameStateTransient.h"
 #include "../entity/EntityList.h"
 #include "../entity/Peep.h"
 #include "../interface/Viewport.h"
@@ -29,20 +30,19 @@
 #include "Footpath.h"
 #include "Map.h"
 #include "Scenery.h"
+#include "TileElementsView.h"
 
 using namespace OpenRCT2;
 
 using map_animation_invalidate_event_handler = bool (*)(const CoordsXYZ& loc);
 
-static std::vector<MapAnimation> _mapAnimations;
-
 constexpr size_t MAX_ANIMATED_OBJECTS = 2000;
 
 static bool InvalidateMapAnimation(const MapAnimation& obj);
 
 static bool DoesAnimationExist(int32_t type, const CoordsXYZ& location)
 {
-    for (const auto& a : _mapAnimations)
+    for (const auto& a : GetGameState().Transient->MapAnimations)
     {
         if (a.type == type && a.location == location)
         {
@@ -57,10 +57,11 @@ void MapAnimationCreate(int32_t type, const CoordsXYZ& loc)
 {
     if (!DoesAnimationExist(type, loc))
     {
-        if (_mapAnimations.size() < MAX_ANIMATED_OBJECTS)
+        auto& mapAnimations = GetGameState().Transient->MapAnimations;
+        if (mapAnimations.size() < MAX_ANIMATED_OBJECTS)
         {
             // Create new animation
-            _mapAnimations.push_back({ static_cast<uint8_t>(type), loc });
+            mapAnimations.push_back({ static_cast<uint8_t>(type), loc });
         }
         else
         {
@@ -77,13 +78,14 @@ void MapAnimationInvalidateAll()
 {
     PROFILED_FUNCTION();
 
-    auto it = _mapAnimations.begin();
-    while (it != _mapAnimations.end())
+    auto& mapAnimations = GetGameState().Transient->MapAnimations;
+    auto it = mapAnimations.begin();
+    while (it != mapAnimations.end())
     {
         if (InvalidateMapAnimation(*it))
         {
             // Map animation has finished, remove it
-            it = _mapAnimations.erase(it);
+            it = mapAnimations.erase(it);
         }
         else
         {
@@ -598,23 +600,28 @@ static bool InvalidateMapAnimation(const MapAnimation& a)
 
 const std::vector<MapAnimation>& GetMapAnimations()
 {
-    return _mapAnimations;
+    return GetGameState().Transient->MapAnimations;
 }
 
 void ClearMapAnimations()
 {
-    _mapAnimations.clear();
+    GetGameState().Transient->MapAnimations.clear();
 }
 
 void MapAnimationAutoCreate()
 {
     ClearMapAnimations();
 
-    TileElementIterator it;
-    TileElementIteratorBegin(&it);
-    while (TileElementIteratorNext(&it))
+    // Surfaces are never animated, so only tiles with other elements need to be visited
+    const auto tiles = MapGetTilesWithElementTypes(
+        { TileElementType::Path, TileElementType::Track, TileElementType::SmallScenery, TileElementType::Entrance,
+          TileElementType::Wall, TileElementType::LargeScenery, TileElementType::Banner });
+    for (const auto& tilePos : tiles)
     {
-        MapAnimationAutoCreateAtTileElement(TileCoordsXY(it.x, it.y), it.element);
+        for (auto* tileElement : TileElementsView(tilePos))
+        {
+            MapAnimationAutoCreateAtTileElement(tilePos, tileElement);
+        }
     }
 }
 
@@ -716,7 +723,7 @@ void ShiftAllMapAnimations(CoordsXY amount)
     if (amount.x == 0 && amount.y == 0)
         return;
 
-    for (auto& a : _mapAnimations)
+    for (auto& a : GetGameState().Transient->MapAnimations)
     {
         a.location += amount;
     }
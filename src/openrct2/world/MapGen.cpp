@@ -15,6 +15,7 @@
 #include "../GameState.h"
 #include "../core/Guard.hpp"
 #include "../core/Imaging.h"
+#include "../core/JobPool.h"
 #include "../core/String.hpp"
 #include "../localisation/StringIds.h"
 #include "../object/ObjectEntryManager.h"
@@ -33,9 +34,15 @@
 
 #include <cmath>
 #include <cstring>
+#include <functional>
 #include <iterator>
 #include <vector>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define MAPGEN_SSE2
+#    include <emmintrin.h>
+#endif
+
 using namespace OpenRCT2;
 
 #pragma region Height map struct
@@ -95,11 +102,11 @@ static constexpr std::string_view BaseTerrain[] = {
 
 static void MapGenPlaceTrees();
 static void MapGenSetWaterLevel(int32_t waterLevel);
-static void MapGenSmoothHeight(int32_t iterations);
+static void MapGenSmoothHeight(JobPool* jobPool, int32_t iterations);
 static void MapGenSetHeight(MapGenSettings* settings);
 
 static float FractalNoise(int32_t x, int32_t y, float frequency, int32_t octaves, float lacunarity, float persistence);
-static void MapGenSimplex(MapGenSettings* settings);
+static void MapGenSimplex(JobPool* jobPool, MapGenSettings* settings, bool vectorise);
 
 static TileCoordsXY _heightSize;
 static uint8_t* _height;
@@ -118,6 +125,60 @@ static void SetHeight(int32_t x, int32_t y, int32_t height)
         _height[x + y * _heightSize.x] = height;
 }
 
+/**
+ * Splits the rows of the height map into bands and runs fn(firstRow, endRow) for each band on the job pool. Without a
+ * job pool all rows are run as one band on the calling thread.
+ */
+static void MapGenForEachRowBand(JobPool* jobPool, int32_t rows, const std::function<void(int32_t, int32_t)>& fn)
+{
+    if (jobPool == nullptr)
+    {
+        fn(0, rows);
+        return;
+    }
+
+    constexpr int32_t kRowsPerBand = 16;
+    for (int32_t firstRow = 0; firstRow < rows; firstRow += kRowsPerBand)
+    {
+        const auto endRow = std::min(rows, firstRow + kRowsPerBand);
+        jobPool->AddTask([&fn, firstRow, endRow]() { fn(firstRow, endRow); });
+    }
+    jobPool->Join();
+}
+
+/**
+ * Allocates _height and fills it with smoothed simplex noise. Both paths draw the same random numbers in the same order,
+ * so for a given seed the vectorised and threaded path gives exactly the same height map as the scalar one.
+ */
+static void MapGenCreateHeightMap(MapGenSettings* settings, bool vectorise)
+{
+    const auto& mapSize = settings->mapSize;
+    _heightSize = { mapSize.x * 2, mapSize.y * 2 };
+    _height = new uint8_t[_heightSize.y * _heightSize.x];
+    std::fill_n(_height, _heightSize.y * _heightSize.x, 0x00);
+
+    if (vectorise)
+    {
+        JobPool jobPool;
+        MapGenSimplex(&jobPool, settings, true);
+        MapGenSmoothHeight(&jobPool, 2 + (UtilRand() % 6));
+    }
+    else
+    {
+        MapGenSimplex(nullptr, settings, false);
+        MapGenSmoothHeight(nullptr, 2 + (UtilRand() % 6));
+    }
+}
+
+std::vector<uint8_t> MapGenGenerateHeightMap(MapGenSettings* settings, bool vectorise)
+{
+    MapGenCreateHeightMap(settings, vectorise);
+    std::vector<uint8_t> result(_height, _height + (_heightSize.y * _heightSize.x));
+    delete[] _height;
+    _height = nullptr;
+    return result;
+}
+
 void MapGenGenerateBlank(MapGenSettings* settings)
 {
     int32_t x, y;
@@ -204,12 +265,7 @@ void MapGenGenerate(MapGenSettings* settings)
     }
 
     // Create the temporary height map and initialise
-    _heightSize = { mapSize.x * 2, mapSize.y * 2 };
-    _height = new uint8_t[_heightSize.y * _heightSize.x];
-    std::fill_n(_height, _heightSize.y * _heightSize.x, 0x00);
-
-    MapGenSimplex(settings);
-    MapGenSmoothHeight(2 + (UtilRand() % 6));
+    MapGenCreateHeightMap(settings, true);
 
     // Set the game map to the height map
     MapGenSetHeight(settings);
@@ -431,36 +487,40 @@ static void MapGenSetWaterLevel(int32_t waterLevel)
 }
 
 /**
- * Smooths the height map.
+ * Smooths the height map with a 3x3 box filter. Each pass sums the three source rows into column totals first, so the
+ * inner loops are plain element-wise integer arithmetic that the compiler vectorises.
  */
-static void MapGenSmoothHeight(int32_t iterations)
+static void MapGenSmoothHeight(JobPool* jobPool, int32_t iterations)
 {
-    int32_t i, x, y, xx, yy, avg;
-    int32_t arraySize = _heightSize.y * _heightSize.x * sizeof(uint8_t);
-    uint8_t* copyHeight = new uint8_t[arraySize];
+    const int32_t width = _heightSize.x;
+    const int32_t height = _heightSize.y;
+    if (width < 3 || height < 3)
+        return;
 
-    for (i = 0; i < iterations; i++)
+    std::vector<uint8_t> copyHeight(width * height);
+    for (int32_t i = 0; i < iterations; i++)
     {
-        std::memcpy(copyHeight, _height, arraySize);
-        for (y = 1; y < _heightSize.y - 1; y++)
-        {
-            for (x = 1; x < _heightSize.x - 1; x++)
+        std::memcpy(copyHeight.data(), _height, copyHeight.size());
+        MapGenForEachRowBand(jobPool, height, [&](int32_t firstRow, int32_t endRow) {
+            std::vector<uint16_t> columnTotals(width);
+            for (int32_t y = std::max(firstRow, 1); y < std::min(endRow, height - 1); y++)
             {
-                avg = 0;
-                for (yy = -1; yy <= 1; yy++)
+                const uint8_t* above = &copyHeight[(y - 1) * width];
+                const uint8_t* row = &copyHeight[y * width];
+                const uint8_t* below = &copyHeight[(y + 1) * width];
+                for (int32_t x = 0; x < width; x++)
                 {
-                    for (xx = -1; xx <= 1; xx++)
-                    {
-                        avg += copyHeight[(y + yy) * _heightSize.x + (x + xx)];
-                    }
+                    columnTotals[x] = above[x] + row[x] + below[x];
+                }
+
+                uint8_t* dst = &_height[y * width];
+                for (int32_t x = 1; x < width - 1; x++)
+                {
+                    dst[x] = (columnTotals[x - 1] + columnTotals[x] + columnTotals[x + 1]) / 9;
                 }
-                avg /= 9;
-                SetHeight(x, y, avg);
             }
-        }
+        });
     }
-
-    delete[] copyHeight;
 }
 
 /**
@@ -523,6 +583,9 @@ static void MapGenSetHeight(MapGenSettings* settings)
 static float Generate(float x, float y);
 static int32_t FastFloor(float x);
 static float Grad(int32_t hash, float x, float y);
+static void FractalNoiseRow(
+    int32_t y, int32_t width, float frequency, int32_t octaves, float lacunarity, float persistence, bool vectorise,
+    float* dst);
 
 static uint8_t perm[512];
 
@@ -591,8 +654,8 @@ static float Generate(float x, float y)
     float y2 = y0 - 1.0f + 2.0f * G2;
 
     // Wrap the integer indices at 256, to avoid indexing perm[] out of bounds
-    int32_t ii = i % 256;
-    int32_t jj = j % 256;
+    int32_t ii = i & 0xFF;
+    int32_t jj = j & 0xFF;
 
     // Calculate the contribution from the three corners
     float t0 = 0.5f - x0 * x0 - y0 * y0;
@@ -646,10 +709,130 @@ static float Grad(int32_t hash, float x, float y)
     return ((h & 1) != 0 ? -u : u) + ((h & 2) != 0 ? -2.0f * v : 2.0f * v);
 }
 
-static void MapGenSimplex(MapGenSettings* settings)
+#ifdef MAPGEN_SSE2
+
+static __m128i FastFloor4(__m128 x)
 {
-    int32_t x, y;
+    // Matches FastFloor, including whole numbers that are not positive rounding down by one
+    const __m128i truncated = _mm_cvttps_epi32(x);
+    const __m128i notPositive = _mm_castps_si128(_mm_cmpngt_ps(x, _mm_setzero_ps()));
+    return _mm_add_epi32(truncated, notPositive);
+}
 
+static __m128 Select4(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static __m128 Grad4(__m128i hash, __m128 x, __m128 y)
+{
+    const __m128i h = _mm_and_si128(hash, _mm_set1_epi32(7));
+    const __m128 lowHash = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4)));
+    const __m128 u = Select4(lowHash, x, y);
+    const __m128 v = Select4(lowHash, y, x);
+
+    // Negation only flips the sign bit, so move hash bits 0 and 1 into the sign position
+    const __m128 negateU = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), 31));
+    const __m128 negateV = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), 30));
+    return _mm_add_ps(_mm_xor_ps(u, negateU), _mm_xor_ps(_mm_mul_ps(_mm_set1_ps(2.0f), v), negateV));
+}
+
+static __m128 CornerContribution4(__m128i hash, __m128 x, __m128 y)
+{
+    const __m128 t = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(0.5f), _mm_mul_ps(x, x)), _mm_mul_ps(y, y));
+    const __m128 outside = _mm_cmplt_ps(t, _mm_setzero_ps());
+    const __m128 t2 = _mm_mul_ps(t, t);
+    return _mm_andnot_ps(outside, _mm_mul_ps(_mm_mul_ps(t2, t2), Grad4(hash, x, y)));
+}
+
+/**
+ * Four lane version of Generate. Every lane performs the same float operations in the same order as the scalar code,
+ * so the results are bit-identical. Only the permutation table lookups are done per lane.
+ */
+static __m128 Generate4(__m128 x, __m128 y)
+{
+    const __m128 F2 = _mm_set1_ps(0.366025403f);
+    const __m128 G2 = _mm_set1_ps(0.211324865f);
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    const __m128 s = _mm_mul_ps(_mm_add_ps(x, y), F2);
+    const __m128i i = FastFloor4(_mm_add_ps(x, s));
+    const __m128i j = FastFloor4(_mm_add_ps(y, s));
+
+    const __m128 t = _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(i, j)), G2);
+    const __m128 x0 = _mm_sub_ps(x, _mm_sub_ps(_mm_cvtepi32_ps(i), t));
+    const __m128 y0 = _mm_sub_ps(y, _mm_sub_ps(_mm_cvtepi32_ps(j), t));
+
+    const __m128 lowerTriangle = _mm_cmpgt_ps(x0, y0);
+    const __m128 x1 = _mm_add_ps(_mm_sub_ps(x0, _mm_and_ps(lowerTriangle, one)), G2);
+    const __m128 y1 = _mm_add_ps(_mm_sub_ps(y0, _mm_andnot_ps(lowerTriangle, one)), G2);
+    const __m128 x2 = _mm_add_ps(_mm_sub_ps(x0, one), _mm_set1_ps(2.0f * 0.211324865f));
+    const __m128 y2 = _mm_add_ps(_mm_sub_ps(y0, one), _mm_set1_ps(2.0f * 0.211324865f));
+
+    alignas(16) int32_t laneI[4];
+    alignas(16) int32_t laneJ[4];
+    alignas(16) int32_t laneLower[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(laneI), i);
+    _mm_store_si128(reinterpret_cast<__m128i*>(laneJ), j);
+    _mm_store_si128(reinterpret_cast<__m128i*>(laneLower), _mm_castps_si128(lowerTriangle));
+
+    alignas(16) int32_t hash0[4];
+    alignas(16) int32_t hash1[4];
+    alignas(16) int32_t hash2[4];
+    for (int32_t lane = 0; lane < 4; lane++)
+    {
+        const int32_t ii = laneI[lane] & 0xFF;
+        const int32_t jj = laneJ[lane] & 0xFF;
+        const int32_t i1 = laneLower[lane] != 0 ? 1 : 0;
+        const int32_t j1 = 1 - i1;
+        hash0[lane] = perm[ii + perm[jj]];
+        hash1[lane] = perm[ii + i1 + perm[jj + j1]];
+        hash2[lane] = perm[ii + 1 + perm[jj + 1]];
+    }
+
+    const __m128 n0 = CornerContribution4(_mm_load_si128(reinterpret_cast<const __m128i*>(hash0)), x0, y0);
+    const __m128 n1 = CornerContribution4(_mm_load_si128(reinterpret_cast<const __m128i*>(hash1)), x1, y1);
+    const __m128 n2 = CornerContribution4(_mm_load_si128(reinterpret_cast<const __m128i*>(hash2)), x2, y2);
+    return _mm_mul_ps(_mm_set1_ps(40.0f), _mm_add_ps(_mm_add_ps(n0, n1), n2));
+}
+
+#endif
+
+/**
+ * Evaluates FractalNoise for x = 0 .. width - 1 of row y, four columns at a time if vectorise is set.
+ */
+static void FractalNoiseRow(
+    int32_t y, int32_t width, float frequency, int32_t octaves, float lacunarity, float persistence,
+    [[maybe_unused]] bool vectorise, float* dst)
+{
+    int32_t x = 0;
+#ifdef MAPGEN_SSE2
+    const __m128 rowY = _mm_set1_ps(static_cast<float>(y));
+    for (; vectorise && x + 4 <= width; x += 4)
+    {
+        const __m128 columnX = _mm_cvtepi32_ps(_mm_setr_epi32(x, x + 1, x + 2, x + 3));
+        __m128 total = _mm_setzero_ps();
+        float octaveFrequency = frequency;
+        float amplitude = persistence;
+        for (int32_t i = 0; i < octaves; i++)
+        {
+            const __m128 f = _mm_set1_ps(octaveFrequency);
+            const __m128 noise = Generate4(_mm_mul_ps(columnX, f), _mm_mul_ps(rowY, f));
+            total = _mm_add_ps(total, _mm_mul_ps(noise, _mm_set1_ps(amplitude)));
+            octaveFrequency *= lacunarity;
+            amplitude *= persistence;
+        }
+        _mm_storeu_ps(dst + x, total);
+    }
+#endif
+    for (; x < width; x++)
+    {
+        dst[x] = FractalNoise(x, y, frequency, octaves, lacunarity, persistence);
+    }
+}
+
+static void MapGenSimplex(JobPool* jobPool, MapGenSettings* settings, bool vectorise)
+{
     float freq = settings->simplex_base_freq * (1.0f / _heightSize.x);
     int32_t octaves = settings->simplex_octaves;
 
@@ -657,16 +840,20 @@ static void MapGenSimplex(MapGenSettings* settings)
     int32_t high = settings->simplex_high;
 
     NoiseRand();
-    for (y = 0; y < _heightSize.y; y++)
-    {
-        for (x = 0; x < _heightSize.x; x++)
+    MapGenForEachRowBand(jobPool, _heightSize.y, [&](int32_t firstRow, int32_t endRow) {
+        std::vector<float> noiseRow(_heightSize.x);
+        for (int32_t y = firstRow; y < endRow; y++)
         {
-            float noiseValue = std::clamp(FractalNoise(x, y, freq, octaves, 2.0f, 0.65f), -1.0f, 1.0f);
-            float normalisedNoiseValue = (noiseValue + 1.0f) / 2.0f;
+            FractalNoiseRow(y, _heightSize.x, freq, octaves, 2.0f, 0.65f, vectorise, noiseRow.data());
+            for (int32_t x = 0; x < _heightSize.x; x++)
+            {
+                float noiseValue = std::clamp(noiseRow[x], -1.0f, 1.0f);
+                float normalisedNoiseValue = (noiseValue + 1.0f) / 2.0f;
 
-            SetHeight(x, y, low + static_cast<int32_t>(normalisedNoiseValue * high));
+                SetHeight(x, y, low + static_cast<int32_t>(normalisedNoiseValue * high));
+            }
         }
-    }
+    });
 }
 
 #pragma endregion
@@ -12,6 +12,8 @@
 #include "../core/StringTypes.h"
 #include "Location.hpp"
 
+#include <vector>
+
 struct MapGenSettings
 {
     // Base
@@ -39,6 +41,12 @@ struct MapGenSettings
 
 void MapGenGenerateBlank(MapGenSettings* settings);
 void MapGenGenerate(MapGenSettings* settings);
+
+/**
+ * Generates only the smoothed simplex height map that MapGenGenerate builds the terrain from, at two points per tile in
+ * each direction. With vectorise unset the noise is evaluated one point at a time on the calling thread.
+ */
+std::vector<uint8_t> MapGenGenerateHeightMap(MapGenSettings* settings, bool vectorise);
 bool MapGenLoadHeightmap(const utf8* path);
 void MapGenUnloadHeightmap();
 void MapGenGenerateFromHeightmap(MapGenSettings* settings);
@@ -0,0 +1,129 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TileElementTypeIndex.h"
+
+#include "TileElement.h"
+
+#include <algorithm>
+#include <cassert>
+
+TileElementTypeIndex::TileElementTypeIndex(uint16_t mapSize, const TileElement* tileElements, size_t count)
+    : _mapSize(mapSize)
+{
+    _tileTypes.resize(mapSize * mapSize);
+
+    // Same layout as TilePointerIndex, row by row with each tile's elements stored together
+    size_t index = 0;
+    for (int32_t y = 0; y < mapSize; y++)
+    {
+        for (int32_t x = 0; x < mapSize; x++)
+        {
+            assert(index < count);
+            auto typeMask = GetTypeMask(&tileElements[index]);
+            SetTileTypes({ x, y }, typeMask);
+            do
+            {
+                index++;
+            } while (!tileElements[index - 1].IsLastForTile());
+        }
+    }
+}
+
+void TileElementTypeIndex::Add(const TileCoordsXY& coords, TileElementType type)
+{
+    auto tileIndex = GetTileIndex(coords);
+    auto typeMask = GetTypeMask(type);
+    if ((_tileTypes[tileIndex] & typeMask) != 0)
+        return;
+
+    _tileTypes[tileIndex] |= typeMask;
+    if (type != TileElementType::Surface)
+    {
+        _tiles[static_cast<size_t>(type)].push_back(tileIndex);
+    }
+}
+
+void TileElementTypeIndex::SetTileTypes(const TileCoordsXY& coords, uint8_t typeMask)
+{
+    auto tileIndex = GetTileIndex(coords);
+    auto addedTypes = typeMask & ~_tileTypes[tileIndex];
+    _tileTypes[tileIndex] = typeMask;
+
+    // Tiles that lost a type are dropped from its list the next time it is read
+    for (size_t type = static_cast<size_t>(TileElementType::Surface) + 1; type < kTypeCount; type++)
+    {
+        if (addedTypes & (1u << type))
+        {
+            _tiles[type].push_back(tileIndex);
+        }
+    }
+}
+
+uint8_t TileElementTypeIndex::GetTileTypes(const TileCoordsXY& coords) const
+{
+    return _tileTypes[GetTileIndex(coords)];
+}
+
+std::vector<TileCoordsXY> TileElementTypeIndex::GetTiles(std::initializer_list<TileElementType> types)
+{
+    std::vector<uint32_t> tileIndices;
+    for (auto type : types)
+    {
+        assert(type != TileElementType::Surface);
+        auto typeMask = GetTypeMask(type);
+        auto& tiles = _tiles[static_cast<size_t>(type)];
+        tiles.erase(
+            std::remove_if(
+                tiles.begin(), tiles.end(), [&](uint32_t tileIndex) { return (_tileTypes[tileIndex] & typeMask) == 0; }),
+            tiles.end());
+
+        // A tile that lost a type and then got it back is listed twice
+        std::sort(tiles.begin(), tiles.end());
+        tiles.erase(std::unique(tiles.begin(), tiles.end()), tiles.end());
+        tileIndices.insert(tileIndices.end(), tiles.begin(), tiles.end());
+    }
+
+    if (types.size() > 1)
+    {
+        std::sort(tileIndices.begin(), tileIndices.end());
+        tileIndices.erase(std::unique(tileIndices.begin(), tileIndices.end()), tileIndices.end());
+    }
+
+    std::vector<TileCoordsXY> result;
+    result.reserve(tileIndices.size());
+    for (auto tileIndex : tileIndices)
+    {
+        result.emplace_back(static_cast<int32_t>(tileIndex / _mapSize), static_cast<int32_t>(tileIndex % _mapSize));
+    }
+    return result;
+}
+
+uint8_t TileElementTypeIndex::GetTypeMask(TileElementType type)
+{
+    return static_cast<uint8_t>(1u << static_cast<uint8_t>(type));
+}
+
+uint8_t TileElementTypeIndex::GetTypeMask(const TileElement* firstElement)
+{
+    uint8_t typeMask = 0;
+    if (firstElement != nullptr)
+    {
+        do
+        {
+            typeMask |= GetTypeMask(firstElement->GetType());
+        } while (!(firstElement++)->IsLastForTile());
+    }
+    return typeMask;
+}
+
+uint32_t TileElementTypeIndex::GetTileIndex(const TileCoordsXY& coords) const
+{
+    return static_cast<uint32_t>(coords.x) * _mapSize + static_cast<uint32_t>(coords.y);
+}
@@ -0,0 +1,55 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "Location.hpp"
+#include "tile_element/TileElementType.h"
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+struct TileElement;
+
+/**
+ * Lists the tiles that hold elements of each type, so code looking for one kind of element does not have to walk the
+ * whole map. Added elements are recorded straight away. Removed elements are not, so a listed tile may no longer hold
+ * the type; SetTileTypes corrects a tile once its actual contents are known. Surface elements are on every tile and are
+ * not listed.
+ */
+class TileElementTypeIndex
+{
+    static constexpr size_t kTypeCount = static_cast<size_t>(TileElementType::Banner) + 1;
+
+    // Tiles are numbered column by column, so sorted lists follow the order of TileElementIterator
+    std::vector<uint8_t> _tileTypes;
+    std::array<std::vector<uint32_t>, kTypeCount> _tiles;
+    uint16_t _mapSize{};
+
+public:
+    TileElementTypeIndex() = default;
+    explicit TileElementTypeIndex(uint16_t mapSize, const TileElement* tileElements, size_t count);
+
+    void Add(const TileCoordsXY& coords, TileElementType type);
+    void SetTileTypes(const TileCoordsXY& coords, uint8_t typeMask);
+    uint8_t GetTileTypes(const TileCoordsXY& coords) const;
+
+    /**
+     * Returns the tiles that may hold any of the given types, ordered by x and then by y.
+     */
+    std::vector<TileCoordsXY> GetTiles(std::initializer_list<TileElementType> types);
+
+    static uint8_t GetTypeMask(TileElementType type);
+    static uint8_t GetTypeMask(const TileElement* firstElement);
+
+private:
+    uint32_t GetTileIndex(const TileCoordsXY& coords) const;
+};
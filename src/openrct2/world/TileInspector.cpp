@@ -10,6 +10,8 @@
 #include "TileInspector.h"
 
 #include "../Diagnostic.h"
+#include "../GameState.h"
+#include "../GameStateTransient.h"
 #include "../actions/GameAction.h"
 #include "../interface/Window.h"
 #include "../object/LargeSceneryEntry.h"
@@ -70,6 +72,7 @@ namespace OpenRCT2::TileInspector
             firstElement->SetLastForTile(!firstElement->IsLastForTile());
             secondElement->SetLastForTile(!secondElement->IsLastForTile());
         }
+        GetGameState().Transient->PathSegments.InvalidateTile(TileCoordsXY(loc));
 
         return GameActions::Result();
     }
@@ -337,7 +340,7 @@ namespace OpenRCT2::TileInspector
 
             // The occupiedQuadrants will be automatically set when the element is copied over, so it's not necessary to set
             // them correctly _here_.
-            TileElement* const pastedElement = TileElementInsert({ loc, element.GetBaseZ() }, 0b0000, TileElementType::Surface);
+            TileElement* const pastedElement = TileElementInsert({ loc, element.GetBaseZ() }, 0b0000, element.GetType());
 
             bool lastForTile = pastedElement->IsLastForTile();
             *pastedElement = element;
@@ -479,6 +482,7 @@ namespace OpenRCT2::TileInspector
 
             tileElement->BaseHeight += heightOffset;
             tileElement->ClearanceHeight += heightOffset;
+            GetGameState().Transient->PathSegments.InvalidateTile(TileCoordsXY(loc));
         }
 
         return GameActions::Result();
@@ -43,6 +43,20 @@ public:
         }
     }
 
+    /**
+     * Makes this the index of a copy of the tile elements other points into.
+     */
+    void CopyFrom(const TilePointerIndex& other, const T* otherElements, T* elements)
+    {
+        MapSize = other.MapSize;
+        TilePointers.resize(other.TilePointers.size());
+        for (size_t i = 0; i < TilePointers.size(); i++)
+        {
+            const auto* tilePointer = other.TilePointers[i];
+            TilePointers[i] = tilePointer == nullptr ? nullptr : elements + (tilePointer - otherElements);
+        }
+    }
+
     T* GetFirstElementAt(TileCoordsXY coords)
     {
         return TilePointers[coords.x + (coords.y * MapSize)];
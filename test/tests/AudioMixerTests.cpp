@@ -0,0 +1,159 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <openrct2-ui/audio/AudioMixer.h>
+#include <openrct2-ui/audio/SDLAudioSource.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/config/Config.h>
+#include <vector>
+
+using namespace OpenRCT2;
+using namespace OpenRCT2::Audio;
+
+class AudioMixerTest : public testing::Test
+{
+protected:
+    static constexpr AudioFormat kSourceFormat = { 22050, AUDIO_S16SYS, 1 };
+    static constexpr size_t kFramesPerChunk = 2048;
+
+    AudioMixer _mixer;
+    Config::Sound _sound{};
+    uint8_t _screenFlags{};
+    std::vector<int16_t> _samples;
+
+    void SetUp() override
+    {
+        _sound = Config::Get().sound;
+        _screenFlags = gScreenFlags;
+        auto& sound = Config::Get().sound;
+        sound.MasterSoundEnabled = true;
+        sound.MasterVolume = 100;
+        sound.SoundEnabled = true;
+        sound.SoundVolume = 100;
+        gScreenFlags = 0;
+
+        _mixer.InitOffline();
+
+        // A saw wave that does not line up with the mix chunks
+        _samples.resize(1000);
+        for (size_t i = 0; i < _samples.size(); i++)
+        {
+            _samples[i] = static_cast<int16_t>((static_cast<int32_t>(i) * 61) % 16384 - 8192);
+        }
+    }
+
+    void TearDown() override
+    {
+        _mixer.Close();
+        Config::Get().sound = _sound;
+        gScreenFlags = _screenFlags;
+    }
+
+    SDLAudioSource* CreateSource()
+    {
+        std::vector<uint8_t> pcmData(_samples.size() * sizeof(int16_t));
+        std::copy_n(reinterpret_cast<const uint8_t*>(_samples.data()), pcmData.size(), pcmData.data());
+        return _mixer.AddSource(CreateMemoryAudioSource(_mixer.GetFormat(), kSourceFormat, std::move(pcmData)));
+    }
+
+    static double ToSeconds(size_t frames)
+    {
+        return static_cast<double>(frames) / kSourceFormat.freq;
+    }
+};
+
+TEST_F(AudioMixerTest, ConvertsSourcesWhenLoaded)
+{
+    const auto& format = _mixer.GetFormat();
+    ASSERT_EQ(format.format, AUDIO_F32SYS);
+    ASSERT_EQ(format.channels, 2);
+
+    auto* source = CreateSource();
+    ASSERT_NE(source, nullptr);
+    ASSERT_EQ(source->GetFormat(), format);
+    ASSERT_EQ(source->GetLength(), _samples.size() * format.GetByteRate());
+}
+
+TEST_F(AudioMixerTest, MixesSourceAtFullVolume)
+{
+    auto channel = _mixer.Play(CreateSource(), kMixerLoopInfinite, false);
+    ASSERT_NE(channel, nullptr);
+
+    // The first chunk fades in from silence
+    auto output = _mixer.RenderOffline(ToSeconds(kFramesPerChunk * 2));
+    ASSERT_EQ(output.size(), kFramesPerChunk * 2 * 2);
+    for (size_t frame = kFramesPerChunk; frame < kFramesPerChunk * 2; frame++)
+    {
+        const float expected = _samples[frame % _samples.size()] / 32768.0f;
+        ASSERT_FLOAT_EQ(output[frame * 2 + 0], expected) << "frame " << frame;
+        ASSERT_FLOAT_EQ(output[frame * 2 + 1], expected) << "frame " << frame;
+    }
+}
+
+TEST_F(AudioMixerTest, PansAndClampsChannels)
+{
+    auto* source = CreateSource();
+    auto left = _mixer.Play(source, kMixerLoopInfinite, false);
+    left->SetPan(0.0f);
+    for (int32_t i = 0; i < 7; i++)
+    {
+        _mixer.Play(source, kMixerLoopInfinite, false);
+    }
+
+    auto output = _mixer.RenderOffline(ToSeconds(kFramesPerChunk * 2));
+    float peak = 0.0f;
+    for (size_t frame = kFramesPerChunk; frame < kFramesPerChunk * 2; frame++)
+    {
+        const float l = output[frame * 2 + 0];
+        const float r = output[frame * 2 + 1];
+        ASSERT_GE(l, -1.0f);
+        ASSERT_LE(l, 1.0f);
+        ASSERT_GE(r, -1.0f);
+        ASSERT_LE(r, 1.0f);
+        // Only the left channel carries the panned channel
+        ASSERT_GE(std::abs(l), std::abs(r) - 1e-6f);
+        peak = std::max(peak, std::abs(l));
+    }
+    ASSERT_FLOAT_EQ(peak, 1.0f);
+}
+
+TEST_F(AudioMixerTest, MixesManyChannelsFasterThanRealTime)
+{
+    constexpr int32_t kChannels = 64;
+    constexpr double kSeconds = 10;
+
+    auto* source = CreateSource();
+    for (int32_t i = 0; i < kChannels; i++)
+    {
+        auto channel = _mixer.Play(source, kMixerLoopInfinite, false);
+        channel->SetVolume(kMixerVolumeMax / 8);
+        channel->SetPan(static_cast<float>(i) / (kChannels - 1));
+        // Every fourth channel needs resampling, like ride sounds that follow the vehicle speed
+        if (i % 4 == 0)
+        {
+            channel->SetRate(0.75 + i / 128.0);
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    auto output = _mixer.RenderOffline(kSeconds);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(output.size(), static_cast<size_t>(kSeconds * kSourceFormat.freq) * 2);
+    ASSERT_TRUE(std::any_of(output.begin(), output.end(), [](float sample) { return sample != 0.0f; }));
+    std::printf(
+        "mixed %d channels for %.0f s in %.3f s (%.0fx real time)\n", kChannels, kSeconds, elapsed.count(),
+        kSeconds / elapsed.count());
+    EXPECT_LT(elapsed.count(), kSeconds);
+}
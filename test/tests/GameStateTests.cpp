@@ -0,0 +1,116 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <limits>
+#include <memory>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/GameState.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/entity/EntityRegistry.h>
+#include <thread>
+
+using namespace OpenRCT2;
+
+TEST(GameStateTest, ScopeSelectsGameState)
+{
+    auto* globalState = &GetGameState();
+    auto first = std::make_unique<GameState_t>();
+    auto second = std::make_unique<GameState_t>();
+    {
+        GameStateScope firstScope(*first);
+        ASSERT_EQ(&GetGameState(), first.get());
+
+        ResetAllEntities();
+        ASSERT_NE(CreateEntity(EntityType::Litter), nullptr);
+        {
+            GameStateScope secondScope(*second);
+            ASSERT_EQ(&GetGameState(), second.get());
+
+            ResetAllEntities();
+            ASSERT_EQ(GetEntityListCount(EntityType::Litter), 0);
+        }
+        ASSERT_EQ(GetEntityListCount(EntityType::Litter), 1);
+    }
+    ASSERT_EQ(&GetGameState(), globalState);
+}
+
+TEST(GameStateTest, ThreadsUseTheirOwnGameState)
+{
+    auto first = std::make_unique<GameState_t>();
+    auto second = std::make_unique<GameState_t>();
+
+    auto createLitter = [](GameState_t* gameState, int32_t count) {
+        GameStateScope scope(*gameState);
+        ResetAllEntities();
+        for (int32_t i = 0; i < count; i++)
+        {
+            CreateEntity(EntityType::Litter);
+        }
+    };
+    std::thread firstThread(createLitter, first.get(), 10);
+    std::thread secondThread(createLitter, second.get(), 20);
+    firstThread.join();
+    secondThread.join();
+
+    {
+        GameStateScope scope(*first);
+        ASSERT_EQ(GetEntityListCount(EntityType::Litter), 10);
+    }
+    {
+        GameStateScope scope(*second);
+        ASSERT_EQ(GetEntityListCount(EntityType::Litter), 20);
+    }
+}
+
+// Every GetGameState call checks the state bound to the thread first. Ticking the main park through a scope takes the
+// other branch on every call, so the two timings together show what the thread local lookup costs a whole tick.
+TEST(GameStateTest, ThreadBindingTickCost)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    auto context = CreateContext();
+    ASSERT_TRUE(context->Initialise());
+    ASSERT_TRUE(context->LoadParkFromFile(TestData::GetParkPath("bpb.sv6")));
+    GameLoadInit();
+
+    // Rounds alternate so that the park changing over time affects both timings alike
+    constexpr int32_t kRounds = 5;
+    constexpr int32_t kTicksPerRound = 40;
+    const auto timeTicks = [](GameState_t* boundState) {
+        std::unique_ptr<GameStateScope> scope;
+        if (boundState != nullptr)
+        {
+            scope = std::make_unique<GameStateScope>(*boundState);
+        }
+        const auto start = std::chrono::steady_clock::now();
+        for (int32_t i = 0; i < kTicksPerRound; i++)
+        {
+            gameStateUpdateLogic();
+        }
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / kTicksPerRound;
+    };
+
+    auto unbound = std::numeric_limits<double>::max();
+    auto bound = std::numeric_limits<double>::max();
+    for (int32_t round = 0; round < kRounds; round++)
+    {
+        unbound = std::min(unbound, timeTicks(nullptr));
+        bound = std::min(bound, timeTicks(&GetGameState()));
+    }
+    std::printf("main state %.1f us, bound state %.1f us per tick\n", unbound, bound);
+    EXPECT_LT(bound, unbound * 1.25);
+}
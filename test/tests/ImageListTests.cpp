@@ -0,0 +1,217 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/drawing/Image.h>
+#include <vector>
+
+class ImageListTest : public testing::Test
+{
+protected:
+    std::vector<G1Element> _images = std::vector<G1Element>(64);
+    bool _noGraphics{};
+    ImageIndex _base{};
+
+    void SetUp() override
+    {
+        // Images are only handed out when graphics are loaded
+        _noGraphics = gOpenRCT2NoGraphics;
+        gOpenRCT2NoGraphics = false;
+
+        // The first allocation from an empty list is at the start of it
+        ASSERT_EQ(ImageListGetUsedCount(), 0u);
+        _base = Allocate(1);
+        ASSERT_NE(_base, ImageIndexUndefined);
+        GfxObjectFreeImages(_base, 1);
+        ASSERT_EQ(GetAvailableAllocationRanges().size(), 1u);
+    }
+
+    void TearDown() override
+    {
+        gOpenRCT2NoGraphics = _noGraphics;
+    }
+
+    ImageIndex Allocate(uint32_t count)
+    {
+        return GfxObjectAllocateImages(_images.data(), count);
+    }
+
+    ImageList GetTail(ImageIndex begin) const
+    {
+        return ImageList(begin, static_cast<ImageIndex>(_base + ImageListGetMaximum() - begin));
+    }
+};
+
+TEST_F(ImageListTest, SplitsFreeRange)
+{
+    auto a = Allocate(10);
+    auto b = Allocate(20);
+    ASSERT_EQ(a, _base);
+    ASSERT_EQ(b, _base + 10);
+    ASSERT_EQ(ImageListGetUsedCount(), 30u);
+
+    auto ranges = GetAvailableAllocationRanges();
+    ASSERT_EQ(ranges.size(), 1u);
+    ASSERT_EQ(ranges[0], GetTail(_base + 30));
+
+    GfxObjectFreeImages(b, 20);
+    GfxObjectFreeImages(a, 10);
+    ASSERT_EQ(ImageListGetUsedCount(), 0u);
+}
+
+TEST_F(ImageListTest, CoalescesWithFollowingRange)
+{
+    auto a = Allocate(10);
+    auto b = Allocate(20);
+    auto c = Allocate(30);
+
+    GfxObjectFreeImages(b, 20);
+    auto ranges = GetAvailableAllocationRanges();
+    ASSERT_EQ(ranges.size(), 2u);
+    ASSERT_EQ(ranges[0], ImageList(b, 20));
+
+    // a is followed by the free range left by b
+    GfxObjectFreeImages(a, 10);
+    ranges = GetAvailableAllocationRanges();
+    ASSERT_EQ(ranges.size(), 2u);
+    ASSERT_EQ(ranges[0], ImageList(a, 30));
+    ASSERT_EQ(ranges[1], GetTail(c + 30));
+
+    GfxObjectFreeImages(c, 30);
+    ranges = GetAvailableAllocationRanges();
+    ASSERT_EQ(ranges.size(), 1u);
+    ASSERT_EQ(ranges[0], GetTail(_base));
+}
+
+TEST_F(ImageListTest, CoalescesWithPrecedingRange)
+{
+    auto a = Allocate(10);
+    auto b = Allocate(20);
+    auto c = Allocate(30);
+
+    GfxObjectFreeImages(a, 10);
+
+    // b is preceded by the free range left by a
+    GfxObjectFreeImages(b, 20);
+    auto ranges = GetAvailableAllocationRanges();
+    ASSERT_EQ(ranges.size(), 2u);
+    ASSERT_EQ(ranges[0], ImageList(a, 30));
+
+    GfxObjectFreeImages(c, 30);
+    ranges = GetAvailableAllocationRanges();
+    ASSERT_EQ(ranges.size(), 1u);
+    ASSERT_EQ(ranges[0], GetTail(_base));
+}
+
+TEST_F(ImageListTest, CoalescesWithBothRanges)
+{
+    auto a = Allocate(10);
+    auto b = Allocate(20);
+    auto c = Allocate(30);
+    auto d = Allocate(40);
+
+    GfxObjectFreeImages(a, 10);
+    GfxObjectFreeImages(c, 30);
+    ASSERT_EQ(GetAvailableAllocationRanges().size(), 3u);
+
+    GfxObjectFreeImages(b, 20);
+    auto ranges = GetAvailableAllocationRanges();
+    ASSERT_EQ(ranges.size(), 2u);
+    ASSERT_EQ(ranges[0], ImageList(a, 60));
+    ASSERT_EQ(ranges[1], GetTail(d + 40));
+
+    GfxObjectFreeImages(d, 40);
+    ASSERT_EQ(ImageListGetUsedCount(), 0u);
+}
+
+TEST_F(ImageListTest, TakesBestFit)
+{
+    auto a = Allocate(10);
+    auto b = Allocate(5);
+    auto c = Allocate(4);
+    auto d = Allocate(5);
+
+    // Holes of 10 and 4, the 4 image request should fill the smaller one
+    GfxObjectFreeImages(a, 10);
+    GfxObjectFreeImages(c, 4);
+    auto e = Allocate(4);
+    ASSERT_EQ(e, c);
+
+    GfxObjectFreeImages(e, 4);
+    GfxObjectFreeImages(b, 5);
+    GfxObjectFreeImages(d, 5);
+    ASSERT_EQ(ImageListGetUsedCount(), 0u);
+}
+
+TEST_F(ImageListTest, ReportsExhaustion)
+{
+    const auto maximum = static_cast<uint32_t>(ImageListGetMaximum());
+    _images.resize(maximum);
+
+    auto a = Allocate(10);
+    auto b = Allocate(10);
+    auto c = Allocate(10);
+    auto rest = Allocate(maximum - 30);
+    ASSERT_NE(rest, ImageIndexUndefined);
+    ASSERT_EQ(ImageListGetUsedCount(), maximum);
+    ASSERT_TRUE(GetAvailableAllocationRanges().empty());
+    ASSERT_EQ(Allocate(1), ImageIndexUndefined);
+
+    // 20 images are free but no single range can hold 15 of them
+    GfxObjectFreeImages(a, 10);
+    GfxObjectFreeImages(c, 10);
+    ASSERT_EQ(Allocate(15), ImageIndexUndefined);
+    auto d = Allocate(10);
+    ASSERT_EQ(d, a);
+
+    GfxObjectFreeImages(d, 10);
+    GfxObjectFreeImages(b, 10);
+    GfxObjectFreeImages(rest, maximum - 30);
+    ASSERT_EQ(ImageListGetUsedCount(), 0u);
+    ASSERT_EQ(GetAvailableAllocationRanges().size(), 1u);
+}
+
+TEST_F(ImageListTest, MeasuresFragmentation)
+{
+    const auto maximum = static_cast<uint32_t>(ImageListGetMaximum());
+    _images.resize(maximum);
+
+    auto fragmentation = ImageListGetFragmentation();
+    ASSERT_EQ(fragmentation.FreeRangeCount, 1u);
+    ASSERT_EQ(fragmentation.FreeImageCount, maximum);
+    ASSERT_EQ(fragmentation.LargestFreeRange, maximum);
+    ASSERT_DOUBLE_EQ(fragmentation.GetRatio(), 0.0);
+
+    auto a = Allocate(10);
+    auto b = Allocate(10);
+    auto c = Allocate(10);
+    auto d = Allocate(maximum - 30);
+
+    // Two holes of 10 images each, only half of the free images can be allocated at once
+    GfxObjectFreeImages(a, 10);
+    GfxObjectFreeImages(c, 10);
+    fragmentation = ImageListGetFragmentation();
+    ASSERT_EQ(fragmentation.FreeRangeCount, 2u);
+    ASSERT_EQ(fragmentation.FreeImageCount, 20u);
+    ASSERT_EQ(fragmentation.LargestFreeRange, 10u);
+    ASSERT_DOUBLE_EQ(fragmentation.GetRatio(), 0.5);
+
+    GfxObjectFreeImages(d, maximum - 30);
+    fragmentation = ImageListGetFragmentation();
+    ASSERT_EQ(fragmentation.FreeRangeCount, 2u);
+    ASSERT_EQ(fragmentation.LargestFreeRange, maximum - 20);
+    ASSERT_DOUBLE_EQ(fragmentation.GetRatio(), 10.0 / (maximum - 10));
+
+    GfxObjectFreeImages(b, 10);
+    fragmentation = ImageListGetFragmentation();
+    ASSERT_EQ(fragmentation.FreeRangeCount, 1u);
+    ASSERT_DOUBLE_EQ(fragmentation.GetRatio(), 0.0);
+}
@@ -0,0 +1,71 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <openrct2/core/Json.hpp>
+#include <openrct2/core/MemoryStream.h>
+#include <openrct2/object/ImageTable.h>
+
+using namespace OpenRCT2;
+
+TEST(ImageTableTest, CompiledImagesRoundTrip)
+{
+    uint8_t pixels[6] = { 1, 2, 3, 4, 5, 6 };
+    G1Element image{};
+    image.offset = pixels;
+    image.width = 3;
+    image.height = 2;
+    image.x_offset = -1;
+    image.y_offset = 7;
+    image.zoomed_offset = -2;
+
+    ImageTable source;
+    source.AddImage(&image);
+    G1Element empty{};
+    source.AddImage(&empty);
+
+    MemoryStream stream;
+    source.WriteCompiled(&stream);
+    stream.SetPosition(0);
+
+    ImageTable compiled;
+    compiled.AddImage(&image);
+    compiled.ReadCompiled(&stream);
+    ASSERT_EQ(stream.GetPosition(), stream.GetLength());
+    ASSERT_EQ(compiled.GetCount(), 2u);
+
+    const auto& restored = compiled.GetImages()[0];
+    ASSERT_EQ(restored.width, 3);
+    ASSERT_EQ(restored.height, 2);
+    ASSERT_EQ(restored.x_offset, -1);
+    ASSERT_EQ(restored.y_offset, 7);
+    ASSERT_EQ(restored.zoomed_offset, -2);
+    ASSERT_NE(restored.offset, pixels);
+    ASSERT_EQ(std::memcmp(restored.offset, pixels, sizeof(pixels)), 0);
+    ASSERT_EQ(compiled.GetImages()[1].offset, nullptr);
+}
+
+TEST(ImageTableTest, IsSelfContained)
+{
+    auto fromFiles = Json::FromString(R"({
+        "images": [ "", "images/a.png", "$LGX:images.dat[0..3]", { "path": "images/b.png" }, { "gx": "images/c.png" } ]
+    })");
+    ASSERT_TRUE(ImageTable::IsSelfContained(fromFiles));
+    ASSERT_FALSE(fromFiles.contains("noCsgImages"));
+
+    auto fromG1 = Json::FromString(R"({ "images": [ "images/a.png", "$G1[0..2]" ] })");
+    ASSERT_FALSE(ImageTable::IsSelfContained(fromG1));
+
+    auto fromObject = Json::FromString(R"({ "images": [ { "gx": "$RCT2:OBJDATA/SCOL[0]" } ] })");
+    ASSERT_FALSE(ImageTable::IsSelfContained(fromObject));
+
+    auto fallbackFromCsg = Json::FromString(R"({ "images": [ "images/a.png" ], "noCsgImages": [ "$CSG[0]" ] })");
+    ASSERT_FALSE(ImageTable::IsSelfContained(fallbackFromCsg));
+}
@@ -0,0 +1,55 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <openrct2/util/Util.h>
+#include <openrct2/world/MapGen.h>
+
+static MapGenSettings GetSettings()
+{
+    MapGenSettings settings{};
+    // Widths that are not a multiple of four also run the scalar tail of each vectorised row
+    settings.mapSize = { 67, 45 };
+    settings.simplex_low = 6;
+    settings.simplex_high = 10;
+    settings.simplex_base_freq = 1.75f;
+    settings.simplex_octaves = 6;
+    return settings;
+}
+
+TEST(MapGenTest, VectorisedHeightMapMatchesScalar)
+{
+    constexpr uint32_t kSeed = 5318008;
+    auto settings = GetSettings();
+
+    UtilSrand(kSeed);
+    auto scalar = MapGenGenerateHeightMap(&settings, false);
+    UtilSrand(kSeed);
+    auto vectorised = MapGenGenerateHeightMap(&settings, true);
+
+    ASSERT_EQ(scalar.size(), static_cast<size_t>(settings.mapSize.x * 2 * settings.mapSize.y * 2));
+    ASSERT_NE(*std::min_element(scalar.begin(), scalar.end()), *std::max_element(scalar.begin(), scalar.end()));
+    ASSERT_EQ(scalar, vectorised);
+}
+
+TEST(MapGenTest, HeightMapDependsOnSeed)
+{
+    auto settings = GetSettings();
+
+    UtilSrand(1);
+    auto first = MapGenGenerateHeightMap(&settings, true);
+    UtilSrand(1);
+    auto repeated = MapGenGenerateHeightMap(&settings, true);
+    UtilSrand(2);
+    auto other = MapGenGenerateHeightMap(&settings, true);
+
+    ASSERT_EQ(first, repeated);
+    ASSERT_NE(first, other);
+}
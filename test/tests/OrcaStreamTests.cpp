@@ -0,0 +1,104 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/core/MemoryStream.h>
+#include <openrct2/core/OrcaStream.hpp>
+#include <string>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static constexpr uint32_t kChunkSmall = 0x01;
+static constexpr uint32_t kChunkLarge = 0x02;
+static constexpr uint32_t kChunkText = 0x03;
+static constexpr uint32_t kChunkMissing = 0x04;
+
+static std::vector<uint32_t> CreateValues()
+{
+    std::vector<uint32_t> values(10000);
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        values[i] = static_cast<uint32_t>(i / 16);
+    }
+    return values;
+}
+
+static void WriteChunks(MemoryStream& stream, uint32_t compression)
+{
+    OrcaStream os(stream, OrcaStream::Mode::WRITING);
+    os.GetHeader().Compression = compression;
+
+    os.ReadWriteChunk(kChunkSmall, [](OrcaStream::ChunkStream& cs) { cs.Write<uint32_t>(1234); });
+    os.ReadWriteChunk(kChunkLarge, [](OrcaStream::ChunkStream& cs) {
+        auto values = CreateValues();
+        cs.Write<uint32_t>(static_cast<uint32_t>(values.size()));
+        cs.Write(values.data(), values.size() * sizeof(uint32_t));
+    });
+    os.ReadWriteChunk(kChunkText, [](OrcaStream::ChunkStream& cs) { cs.Write(std::string("park")); });
+}
+
+static void ReadChunksOutOfOrder(MemoryStream& stream)
+{
+    stream.SetPosition(0);
+    OrcaStream os(stream, OrcaStream::Mode::READING);
+
+    std::string text;
+    ASSERT_TRUE(os.ReadWriteChunk(kChunkText, [&text](OrcaStream::ChunkStream& cs) { text = cs.Read<std::string>(); }));
+    ASSERT_EQ(text, "park");
+
+    std::vector<uint32_t> values;
+    ASSERT_TRUE(os.ReadWriteChunk(kChunkLarge, [&values](OrcaStream::ChunkStream& cs) {
+        values.resize(cs.Read<uint32_t>());
+        cs.Read(values.data(), values.size() * sizeof(uint32_t));
+    }));
+    ASSERT_EQ(values, CreateValues());
+
+    uint32_t small{};
+    ASSERT_TRUE(os.ReadWriteChunk(kChunkSmall, [&small](OrcaStream::ChunkStream& cs) { small = cs.Read<uint32_t>(); }));
+    ASSERT_EQ(small, 1234u);
+
+    // Chunks can be read again after another one has been loaded
+    ASSERT_TRUE(os.ReadWriteChunk(kChunkText, [&text](OrcaStream::ChunkStream& cs) { text = cs.Read<std::string>(); }));
+    ASSERT_EQ(text, "park");
+
+    bool called = false;
+    ASSERT_FALSE(os.ReadWriteChunk(kChunkMissing, [&called](OrcaStream::ChunkStream&) { called = true; }));
+    ASSERT_FALSE(called);
+}
+
+TEST(OrcaStreamTest, ChunkedRoundTrip)
+{
+    MemoryStream stream;
+    WriteChunks(stream, OrcaStream::COMPRESSION_GZIP_CHUNKED);
+    ReadChunksOutOfOrder(stream);
+}
+
+TEST(OrcaStreamTest, WholeStreamRoundTrip)
+{
+    MemoryStream stream;
+    WriteChunks(stream, OrcaStream::COMPRESSION_GZIP);
+    ReadChunksOutOfOrder(stream);
+}
+
+TEST(OrcaStreamTest, ChunkedCompressesEachChunk)
+{
+    MemoryStream chunked;
+    WriteChunks(chunked, OrcaStream::COMPRESSION_GZIP_CHUNKED);
+    MemoryStream uncompressed;
+    WriteChunks(uncompressed, OrcaStream::COMPRESSION_NONE);
+
+    chunked.SetPosition(0);
+    OrcaStream os(chunked, OrcaStream::Mode::READING);
+    const auto& header = os.GetHeader();
+    ASSERT_EQ(header.Compression, OrcaStream::COMPRESSION_GZIP_CHUNKED);
+    ASSERT_EQ(header.NumChunks, 3u);
+    ASSERT_LT(header.CompressedSize, header.UncompressedSize);
+    ASSERT_LT(chunked.GetLength(), uncompressed.GetLength());
+}
@@ -0,0 +1,83 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/paint/Paint.h>
+#include <random>
+#include <vector>
+
+class PaintSortTests : public testing::Test
+{
+protected:
+    // Fills a session with overlapping bounding boxes spread over a few neighbouring quadrants.
+    static void BuildSession(std::vector<PaintStruct>& storage, PaintSessionCore& session, uint32_t seed, size_t count)
+    {
+        std::mt19937 rng(seed);
+        storage.assign(count, PaintStruct{});
+        std::fill(std::begin(session.Quadrants), std::end(session.Quadrants), nullptr);
+        session.QuadrantBackIndex = UINT32_MAX;
+        session.QuadrantFrontIndex = 0;
+
+        for (auto& ps : storage)
+        {
+            const int32_t x = rng() % 256;
+            const int32_t y = rng() % 256;
+            const int32_t z = rng() % 64;
+            ps.Bounds = { x, y, z, x + static_cast<int32_t>(rng() % 48), y + static_cast<int32_t>(rng() % 48),
+                          z + static_cast<int32_t>(rng() % 32) };
+
+            const uint32_t quadrantIndex = 500 + (rng() % 24);
+            ps.QuadrantIndex = quadrantIndex;
+            ps.NextQuadrantEntry = session.Quadrants[quadrantIndex];
+            session.Quadrants[quadrantIndex] = &ps;
+            session.QuadrantBackIndex = std::min(session.QuadrantBackIndex, quadrantIndex);
+            session.QuadrantFrontIndex = std::max(session.QuadrantFrontIndex, quadrantIndex);
+        }
+    }
+
+    static std::vector<size_t> GetOrder(const std::vector<PaintStruct>& storage, const PaintSessionCore& session)
+    {
+        std::vector<size_t> order;
+        for (const auto* ps = session.PaintHead; ps != nullptr; ps = ps->NextQuadrantEntry)
+        {
+            order.push_back(ps - storage.data());
+        }
+        return order;
+    }
+};
+
+TEST_F(PaintSortTests, VectorisedMatchesScalar)
+{
+    auto scalarSession = std::make_unique<PaintSessionCore>();
+    auto vectorisedSession = std::make_unique<PaintSessionCore>();
+    std::vector<PaintStruct> scalarStorage;
+    std::vector<PaintStruct> vectorisedStorage;
+
+    for (uint32_t seed = 0; seed < 64; seed++)
+    {
+        for (uint8_t rotation = 0; rotation < 4; rotation++)
+        {
+            const size_t count = 1 + (seed * 37) % 700;
+            BuildSession(scalarStorage, *scalarSession, seed, count);
+            BuildSession(vectorisedStorage, *vectorisedSession, seed, count);
+            scalarSession->CurrentRotation = rotation;
+            vectorisedSession->CurrentRotation = rotation;
+
+            PaintSessionArrange(*scalarSession, PaintSortMethod::Scalar);
+            PaintSessionArrange(*vectorisedSession, PaintSortMethod::Vectorised);
+
+            const auto scalarOrder = GetOrder(scalarStorage, *scalarSession);
+            ASSERT_EQ(scalarOrder.size(), count);
+            ASSERT_EQ(scalarOrder, GetOrder(vectorisedStorage, *vectorisedSession))
+                << "seed " << seed << ", rotation " << static_cast<int>(rotation);
+        }
+    }
+}
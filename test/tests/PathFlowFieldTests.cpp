@@ -0,0 +1,67 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/peep/PathFlowField.h>
+
+using namespace OpenRCT2::PathFinding;
+
+TEST(PathFlowFieldTest, NumbersPathsOnce)
+{
+    PathFlowFieldCache cache;
+    ASSERT_EQ(cache.FindNode({ 3, 4, 14 }), PathFlowFieldCache::kNoNode);
+
+    const auto node = cache.GetNode({ 3, 4, 14 });
+    ASSERT_EQ(cache.GetNode({ 3, 4, 14 }), node);
+    ASSERT_EQ(cache.FindNode({ 3, 4, 14 }), node);
+    ASSERT_NE(cache.GetNode({ 3, 4, 16 }), node);
+    ASSERT_NE(cache.GetNode({ 4, 3, 14 }), node);
+    ASSERT_EQ(cache.GetNodeLocation(node), TileCoordsXYZ(3, 4, 14));
+
+    cache.Clear();
+    ASSERT_EQ(cache.FindNode({ 3, 4, 14 }), PathFlowFieldCache::kNoNode);
+}
+
+TEST(PathFlowFieldTest, KeepsFieldsPerGoal)
+{
+    PathFlowFieldCache cache;
+    const TileCoordsXYZ goal{ 10, 20, 14 };
+
+    auto& field = cache.GetField(goal, RideId::GetNull());
+    ASSERT_FALSE(field.IsComplete());
+    ASSERT_EQ(field.GetDistance(5), PathFlowField::kUnreachable);
+    field.SetDistance(5, 7);
+    ASSERT_EQ(field.GetDistance(5), 7);
+    ASSERT_EQ(field.GetDistance(4), PathFlowField::kUnreachable);
+
+    ASSERT_EQ(cache.GetField(goal, RideId::GetNull()).GetDistance(5), 7);
+    ASSERT_EQ(cache.GetField(goal, RideId::FromUnderlying(2)).GetDistance(5), PathFlowField::kUnreachable);
+    ASSERT_EQ(cache.GetFieldCount(), 2u);
+
+    cache.Clear();
+    ASSERT_EQ(cache.GetFieldCount(), 0u);
+}
+
+TEST(PathFlowFieldTest, DropsLeastRecentlyUsedField)
+{
+    PathFlowFieldCache cache;
+    cache.GetField({ 0, 0, 0 }, RideId::GetNull()).SetDistance(0, 1);
+    for (int32_t i = 1; i < static_cast<int32_t>(PathFlowFieldCache::kMaxFields); i++)
+    {
+        cache.GetField({ i, 0, 0 }, RideId::GetNull()).SetDistance(0, 1);
+    }
+    ASSERT_EQ(cache.GetFieldCount(), PathFlowFieldCache::kMaxFields);
+
+    // The first field is used again, so the second is dropped for a new one
+    cache.GetField({ 0, 0, 0 }, RideId::GetNull());
+    cache.GetField({ 0, 1, 0 }, RideId::GetNull());
+    ASSERT_EQ(cache.GetFieldCount(), PathFlowFieldCache::kMaxFields);
+    ASSERT_EQ(cache.GetField({ 0, 0, 0 }, RideId::GetNull()).GetDistance(0), 1);
+    ASSERT_EQ(cache.GetField({ 1, 0, 0 }, RideId::GetNull()).GetDistance(0), PathFlowField::kUnreachable);
+}
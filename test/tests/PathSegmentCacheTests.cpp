@@ -0,0 +1,86 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/peep/PathSegmentCache.h>
+#include <openrct2/world/TileElement.h>
+#include <vector>
+
+using namespace OpenRCT2::PathFinding;
+
+static PathSegment CreateSegment(const std::vector<TileElement>& elements)
+{
+    // A path on tile (3, 4) entered from the south west, followed by a tile with nothing to walk onto
+    PathSegmentTile tile;
+    tile.Location = { 3, 4 };
+    tile.EntryZ = 14;
+    tile.PathZ = 14;
+    tile.ExitZ = 14;
+    tile.ExitDirection = 0;
+    tile.ElementIndex = 0;
+    tile.Signature = PathSegmentCache::GetSignature(elements[0]);
+
+    PathSegment segment;
+    segment.Tiles.push_back(tile);
+    segment.End.Location = { 2, 4 };
+    segment.End.ElementIndex = PathSegmentCache::kNoElement;
+    return segment;
+}
+
+TEST(PathSegmentCacheTest, FindsStoredSegments)
+{
+    std::vector<TileElement> elements(1);
+    elements[0].ClearAs(TileElementType::Path);
+    elements[0].BaseHeight = 14;
+    elements[0].AsPath()->SetEdges(0b0101);
+
+    PathSegmentCache cache;
+    const TileCoordsXYZ start{ 3, 4, 14 };
+    ASSERT_EQ(cache.Find(start, 0, elements), nullptr);
+
+    cache.Store(start, 0, CreateSegment(elements));
+    const auto* segment = cache.Find(start, 0, elements);
+    ASSERT_NE(segment, nullptr);
+    ASSERT_EQ(segment->Tiles.size(), 1u);
+    ASSERT_EQ(cache.Find(start, 1, elements), nullptr);
+    ASSERT_EQ(cache.Find({ 3, 4, 16 }, 0, elements), nullptr);
+
+    cache.Clear();
+    ASSERT_EQ(cache.Find(start, 0, elements), nullptr);
+}
+
+TEST(PathSegmentCacheTest, DropsChangedSegments)
+{
+    std::vector<TileElement> elements(1);
+    elements[0].ClearAs(TileElementType::Path);
+    elements[0].BaseHeight = 14;
+    elements[0].AsPath()->SetEdges(0b0101);
+
+    PathSegmentCache cache;
+    const TileCoordsXYZ start{ 3, 4, 14 };
+    cache.Store(start, 0, CreateSegment(elements));
+
+    // Paths changed in place, the rejected segment is dropped even if the path is changed back
+    elements[0].AsPath()->SetEdges(0b0111);
+    ASSERT_EQ(cache.Find(start, 0, elements), nullptr);
+    elements[0].AsPath()->SetEdges(0b0101);
+    ASSERT_EQ(cache.Find(start, 0, elements), nullptr);
+
+    // Elements added to a tile on or past the segment
+    cache.Store(start, 0, CreateSegment(elements));
+    cache.InvalidateTile({ 5, 5 });
+    ASSERT_NE(cache.Find(start, 0, elements), nullptr);
+    cache.InvalidateTile({ 2, 4 });
+    ASSERT_EQ(cache.Find(start, 0, elements), nullptr);
+
+    cache.Store(start, 0, CreateSegment(elements));
+    ASSERT_NE(cache.Find(start, 0, elements), nullptr);
+    cache.InvalidateTile({ 3, 4 });
+    ASSERT_EQ(cache.Find(start, 0, elements), nullptr);
+}
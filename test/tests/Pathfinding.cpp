@@ -9,12 +9,15 @@
 #include <memory>
 #include <openrct2/Context.h>
 #include <openrct2/Game.h>
+#include <openrct2/GameState.h>
+#include <openrct2/GameStateTransient.h>
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/ParkImporter.h>
 #include <openrct2/core/String.hpp>
 #include <openrct2/platform/Platform.h>
 #include <openrct2/world/Footpath.h>
 #include <openrct2/world/Map.h>
+#include <openrct2/world/TileElementsView.h>
 #include <ostream>
 #include <string>
 
@@ -66,7 +69,8 @@ protected:
         return nullptr;
     }
 
-    static bool FindPath(TileCoordsXYZ* pos, const TileCoordsXYZ& goal, int expectedSteps, RideId targetRideID)
+    static bool FindPath(
+        TileCoordsXYZ* pos, const TileCoordsXYZ& goal, int expectedSteps, RideId targetRideID, bool exactSteps = true)
     {
         // Our start position is in tile coordinates, but we need to give the peep spawn
         // position in actual world coords (32 units per tile X/Y, 8 per Z level).
@@ -127,7 +131,10 @@ protected:
         // such a change in the number of steps taken on one of these paths needs to be reviewed. For the negative
         // tests, we will not have reached the goal but we still expect the loop to have run for the total number
         // of steps requested before giving up.
-        EXPECT_EQ(step, expectedSteps);
+        if (exactSteps)
+        {
+            EXPECT_EQ(step, expectedSteps);
+        }
 
         return *pos == goal;
     }
@@ -245,6 +252,24 @@ TEST_P(ImpossiblePathfindingTest, CannotFindPathFromStartToGoal)
     EXPECT_FALSE(FindPath(&pos, goal, 10000, ride->id));
 }
 
+TEST_P(ImpossiblePathfindingTest, FlowFieldDoesNotReachStart)
+{
+    const SimplePathfindingScenario& scenario = GetParam();
+    ASSERT_PRED_FORMAT1(AssertIsStartPosition, scenario.start);
+
+    auto ride = FindRideByName(scenario.name);
+    ASSERT_NE(ride, nullptr);
+
+    auto entrancePos = ride->GetStation().Entrance;
+    TileCoordsXYZ goal = TileCoordsXYZ(
+        entrancePos.x + TileDirectionDelta[entrancePos.direction].x,
+        entrancePos.y + TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+
+    EXPECT_EQ(PathFinding::ChooseFlowFieldDirection(scenario.start, goal, ride->id), INVALID_DIRECTION);
+    EXPECT_EQ(
+        PathFinding::ChooseFlowFieldDirection(scenario.start, TileCoordsXYZ(entrancePos), ride->id), INVALID_DIRECTION);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     ForScenario, ImpossiblePathfindingTest,
     ::testing::Values(
@@ -252,3 +277,144 @@ INSTANTIATE_TEST_SUITE_P(
         SimplePathfindingScenario("PathWithFences", { 11, 6, 14 }, 10000),
         SimplePathfindingScenario("PathWithCliff", { 7, 17, 14 }, 10000)),
     SimplePathfindingScenario::ToName);
+
+class FlowFieldPathfindingTest : public PathfindingTestBase, public ::testing::WithParamInterface<SimplePathfindingScenario>
+{
+protected:
+    void TearDown() override
+    {
+        gPeepPathFindFlowFields.reset();
+    }
+};
+
+TEST_P(FlowFieldPathfindingTest, CanFindPathFromStartToGoal)
+{
+    const SimplePathfindingScenario& scenario = GetParam();
+
+    ASSERT_PRED_FORMAT1(AssertIsStartPosition, scenario.start);
+    TileCoordsXYZ pos = scenario.start;
+
+    auto ride = FindRideByName(scenario.name);
+    ASSERT_NE(ride, nullptr);
+
+    auto entrancePos = ride->GetStation().Entrance;
+    TileCoordsXYZ goal = TileCoordsXYZ(
+        entrancePos.x - TileDirectionDelta[entrancePos.direction].x,
+        entrancePos.y - TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+
+    // Guests head for the entrance itself, which is reached from the paths next to it
+    EXPECT_NE(PathFinding::ChooseFlowFieldDirection(pos, TileCoordsXYZ(entrancePos), ride->id), INVALID_DIRECTION);
+
+    // The fields give a shortest route, so guests need no more tiles than with the heuristic search. Guests are spread
+    // across the path at random, which makes the number of steps differ a little.
+    gPeepPathFindFlowFields = true;
+    const auto maxSteps = static_cast<int>(scenario.steps) + 16;
+    const auto succeeded = FindPath(&pos, goal, maxSteps, ride->id, false) ? ::testing::AssertionSuccess()
+                                                                            : ::testing::AssertionFailure()
+            << "Failed to find path from " << scenario.start << " to " << goal << " in " << maxSteps << " steps; reached "
+            << pos << " before giving up.";
+
+    EXPECT_TRUE(succeeded);
+}
+
+class FlowFieldObstacleTest : public PathfindingTestBase
+{
+};
+
+TEST_F(FlowFieldObstacleTest, AvoidsForeignQueuesAndNoEntrySigns)
+{
+    auto ride = FindRideByName("StraightFlat");
+    ASSERT_NE(ride, nullptr);
+
+    const TileCoordsXYZ start{ 19, 15, 14 };
+    auto entrancePos = ride->GetStation().Entrance;
+    const TileCoordsXYZ entrance(entrancePos);
+    const auto direction = PathFinding::ChooseFlowFieldDirection(start, entrance, ride->id);
+    ASSERT_NE(direction, INVALID_DIRECTION);
+
+    // The entrance can only be reached from the path in front of it
+    const TileCoordsXYZ front(
+        entrancePos.x - TileDirectionDelta[entrancePos.direction].x,
+        entrancePos.y - TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+    auto* pathElement = MapGetFootpathElement(front.ToCoordsXYZ());
+    ASSERT_NE(pathElement, nullptr);
+    const auto originalPathElement = *pathElement;
+
+    // A queue of another ride, changed in place, so the fields are cleared as the game actions would
+    const auto otherRideIndex = RideId::FromUnderlying(ride->id.ToUnderlying() + 1);
+    pathElement->SetIsQueue(true);
+    pathElement->SetRideIndex(otherRideIndex);
+    GetGameState().Transient->PathFlowFields.Clear();
+    EXPECT_EQ(PathFinding::ChooseFlowFieldDirection(start, entrance, ride->id), INVALID_DIRECTION);
+    EXPECT_EQ(PathFinding::ChooseFlowFieldDirection(start, entrance, otherRideIndex), direction);
+    *pathElement = originalPathElement;
+    GetGameState().Transient->PathFlowFields.Clear();
+    EXPECT_EQ(PathFinding::ChooseFlowFieldDirection(start, entrance, ride->id), direction);
+
+    // A no entry sign on every edge, inserting and removing it clears the fields
+    auto* bannerElement = TileElementInsert(front.ToCoordsXYZ(), 0b1111, TileElementType::Banner);
+    ASSERT_NE(bannerElement, nullptr);
+    bannerElement->AsBanner()->SetAllowedEdges(0);
+    EXPECT_EQ(PathFinding::ChooseFlowFieldDirection(start, entrance, ride->id), INVALID_DIRECTION);
+    TileElementRemove(bannerElement);
+    EXPECT_EQ(PathFinding::ChooseFlowFieldDirection(start, entrance, ride->id), direction);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ForScenario, FlowFieldPathfindingTest,
+    ::testing::Values(
+        SimplePathfindingScenario("StraightFlat", { 19, 15, 14 }, 24), SimplePathfindingScenario("SBend", { 15, 12, 14 }, 87),
+        SimplePathfindingScenario("UBend", { 17, 9, 14 }, 87), SimplePathfindingScenario("CBend", { 14, 5, 14 }, 164),
+        SimplePathfindingScenario("TwoEqualRoutes", { 9, 13, 14 }, 89),
+        SimplePathfindingScenario("TwoUnequalRoutes", { 3, 13, 14 }, 89),
+        SimplePathfindingScenario("StraightUpBridge", { 12, 15, 14 }, 24),
+        SimplePathfindingScenario("StraightUpSlope", { 14, 15, 14 }, 24),
+        SimplePathfindingScenario("SelfCrossingPath", { 6, 5, 14 }, 211)),
+    SimplePathfindingScenario::ToName);
+
+class PathSegmentPathfindingTest : public PathfindingTestBase
+{
+};
+
+TEST_F(PathSegmentPathfindingTest, WalkingSegmentsGivesSameDirections)
+{
+    auto* peep = Guest::Generate({ 32 * 19 + 16, 32 * 15 + 16, 14 * kCoordsZStep });
+    ASSERT_NE(peep, nullptr);
+    peep->OutsideOfPark = false;
+
+    gPeepPathFindIgnoreForeignQueues = true;
+    const auto pathTiles = MapGetTilesWithElementTypes({ TileElementType::Path });
+    for (auto& ride : GetRideManager())
+    {
+        auto entrancePos = ride.GetStation().Entrance;
+        if (entrancePos.IsNull())
+            continue;
+        const TileCoordsXYZ goal(
+            entrancePos.x - TileDirectionDelta[entrancePos.direction].x,
+            entrancePos.y - TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+
+        peep->GuestHeadingToRideId = ride.id;
+        gPeepPathFindQueueRideIndex = ride.id;
+        for (const auto& tile : pathTiles)
+        {
+            for (auto* pathElement : TileElementsView<PathElement>(tile))
+            {
+                const TileCoordsXYZ start(tile, pathElement->BaseHeight);
+                auto chooseDirection = [&](bool walkSegments) {
+                    gPeepPathFindWalkSegments = walkSegments;
+                    peep->ResetPathfindGoal();
+                    return PathFinding::ChooseDirection(start, goal, *peep);
+                };
+
+                // Searched tile by tile, then with segments built during the search and with segments already cached
+                const auto expected = chooseDirection(false);
+                GetGameState().Transient->PathSegments.Clear();
+                EXPECT_EQ(chooseDirection(true), expected) << "from " << start << " to " << goal;
+                EXPECT_EQ(chooseDirection(true), expected) << "from " << start << " to " << goal;
+            }
+        }
+    }
+    gPeepPathFindWalkSegments = true;
+
+    PeepEntityRemove(peep);
+}
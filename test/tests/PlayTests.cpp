@@ -195,3 +195,38 @@ TEST_F(PlayTests, CarRideWithOneCarOnlyAcceptsTwoGuests)
         gameStateUpdateLogic();
     }
 }
+
+TEST_F(PlayTests, ParallelGuestDecisionsMatchSerialDecisions)
+{
+    // Making the guest decisions on worker threads must result in the same game state as making them one at a time
+    std::string initStateFile = TestData::GetParkPath("small_park_with_ferris_wheel.sv6");
+
+    const GuestDecisionMode modes[] = { GuestDecisionMode::Streams, GuestDecisionMode::Parallel };
+    std::string checksums[std::size(modes)];
+    for (size_t i = 0; i < std::size(modes); i++)
+    {
+        auto context = localStartGame(initStateFile);
+        ASSERT_NE(context.get(), nullptr);
+
+        execute<ParkSetParameterAction>(ParkParameter::Open);
+        execute<ParkSetEntranceFeeAction>(0);
+        for (auto& ride : GetRideManager())
+        {
+            execute<RideSetStatusAction>(ride.id, RideStatus::Open);
+        }
+        for (int32_t j = 0; j < 100; j++)
+        {
+            Park::GenerateGuest();
+        }
+
+        gGuestDecisionMode = modes[i];
+        for (int32_t tick = 0; tick < 2048; tick++)
+        {
+            gameStateUpdateLogic();
+        }
+        gGuestDecisionMode = GuestDecisionMode::Original;
+
+        checksums[i] = GetAllEntitiesChecksum().ToString();
+    }
+    ASSERT_EQ(checksums[0], checksums[1]);
+}
@@ -0,0 +1,194 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifdef ENABLE_SCRIPTING
+
+#    include <gtest/gtest.h>
+#    include <memory>
+#    include <openrct2/scripting/Plugin.h>
+#    include <openrct2/scripting/PluginProfiler.h>
+#    include <string>
+#    include <vector>
+
+using namespace OpenRCT2::Scripting;
+
+class PluginProfilerTest : public testing::Test
+{
+protected:
+    duk_context* _context{};
+    std::vector<std::shared_ptr<Plugin>> _plugins;
+
+    void SetUp() override
+    {
+        _context = duk_create_heap_default();
+        // Plugins are passed the global API objects, which are not needed here
+        duk_eval_string_noresult(_context, "var console, context, date, map, network, park, profiler, ui;");
+    }
+
+    void TearDown() override
+    {
+        _plugins.clear();
+        duk_destroy_heap(_context);
+    }
+
+    std::shared_ptr<Plugin> CreatePlugin(const std::string& name)
+    {
+        auto plugin = std::make_shared<Plugin>(_context, "");
+        plugin->SetCode(
+            "registerPlugin({ name: '" + name
+            + "', version: '1.0', type: 'local', licence: 'MIT', targetApiVersion: 100, main: function() {} });");
+        plugin->Load();
+        _plugins.push_back(plugin);
+        return plugin;
+    }
+
+    static void EndTicks(PluginProfiler& profiler, int32_t count)
+    {
+        for (int32_t i = 0; i < count; i++)
+        {
+            profiler.EndTick();
+        }
+    }
+};
+
+TEST_F(PluginProfilerTest, RecordsStatsPerPluginAndCategory)
+{
+    auto a = CreatePlugin("a");
+    auto b = CreatePlugin("b");
+
+    PluginProfiler profiler;
+    profiler.Record(a, "interval", 10);
+    ASSERT_TRUE(profiler.GetData().empty());
+
+    profiler.Enable();
+    profiler.Record(a, "interval", 10);
+    profiler.Record(a, std::string("inter") + "val", 30);
+    profiler.Record(a, "map.change", 5);
+    profiler.Record(b, "interval", 7);
+
+    auto data = profiler.GetData();
+    ASSERT_EQ(data.size(), 3u);
+    ASSERT_EQ(data[0]->PluginName, "a");
+    ASSERT_EQ(data[0]->Category, "interval");
+    ASSERT_EQ(data[0]->CallCount, 2u);
+    ASSERT_DOUBLE_EQ(data[0]->TotalTime, 40);
+    ASSERT_DOUBLE_EQ(data[0]->MaxTime, 30);
+    ASSERT_DOUBLE_EQ(data[0]->GetPercentile(50), 10);
+    ASSERT_DOUBLE_EQ(data[0]->GetPercentile(99), 30);
+    ASSERT_EQ(data[1]->Category, "map.change");
+    ASSERT_EQ(data[1]->CallCount, 1u);
+    ASSERT_EQ(data[2]->PluginName, "b");
+    ASSERT_DOUBLE_EQ(data[2]->TotalTime, 7);
+
+    profiler.Disable();
+    profiler.Record(b, "interval", 7);
+    ASSERT_EQ(profiler.GetData()[2]->CallCount, 1u);
+
+    profiler.Reset();
+    ASSERT_TRUE(profiler.GetData().empty());
+}
+
+TEST_F(PluginProfilerTest, KeepsSamplesOfRecentCalls)
+{
+    auto a = CreatePlugin("a");
+
+    PluginProfiler profiler;
+    profiler.Enable();
+    for (size_t i = 0; i < PluginCallStats::MaxSamplesSize; i++)
+    {
+        profiler.Record(a, "interval", 1000);
+    }
+    for (size_t i = 0; i < PluginCallStats::MaxSamplesSize / 2; i++)
+    {
+        profiler.Record(a, "interval", 1);
+    }
+
+    const auto* stats = profiler.GetData()[0];
+    ASSERT_EQ(stats->CallCount, PluginCallStats::MaxSamplesSize * 3 / 2);
+    ASSERT_DOUBLE_EQ(stats->MaxTime, 1000);
+    ASSERT_DOUBLE_EQ(stats->GetPercentile(50), 1);
+    ASSERT_DOUBLE_EQ(stats->GetPercentile(51), 1000);
+}
+
+TEST_F(PluginProfilerTest, ContinuesStatsOfReloadedPlugins)
+{
+    auto a = CreatePlugin("a");
+
+    PluginProfiler profiler;
+    profiler.Enable();
+    profiler.Record(a, "interval", 10);
+    profiler.RemovePlugin(a);
+
+    auto data = profiler.GetData();
+    ASSERT_EQ(data.size(), 1u);
+    ASSERT_EQ(data[0]->CallCount, 1u);
+
+    auto reloaded = CreatePlugin("a");
+    profiler.Record(reloaded, "interval", 20);
+    data = profiler.GetData();
+    ASSERT_EQ(data.size(), 1u);
+    ASSERT_EQ(data[0]->CallCount, 2u);
+    ASSERT_DOUBLE_EQ(data[0]->TotalTime, 30);
+}
+
+TEST_F(PluginProfilerTest, ThrottlesPluginsOverBudget)
+{
+    auto a = CreatePlugin("a");
+    auto b = CreatePlugin("b");
+
+    PluginProfiler profiler;
+    ASSERT_FALSE(profiler.IsTiming());
+    profiler.SetBudget(1, PluginBudgetAction::Throttle);
+    ASSERT_TRUE(profiler.IsTiming());
+    ASSERT_FALSE(profiler.IsEnabled());
+
+    // The budget is per tick, not per call
+    profiler.Record(a, "interval", 600);
+    profiler.Record(a, "map.change", 600);
+    profiler.Record(b, "interval", 900);
+    profiler.EndTick();
+    ASSERT_TRUE(profiler.IsThrottled(a));
+    ASSERT_FALSE(profiler.IsThrottled(b));
+    ASSERT_TRUE(profiler.GetData().empty());
+
+    // Stopping the profiler does not lift the budget
+    profiler.Enable();
+    profiler.Disable();
+    ASSERT_TRUE(profiler.IsTiming());
+    EndTicks(profiler, 39);
+    ASSERT_TRUE(profiler.IsThrottled(a));
+    profiler.EndTick();
+    ASSERT_FALSE(profiler.IsThrottled(a));
+
+    profiler.Record(b, "interval", 1500);
+    profiler.EndTick();
+    ASSERT_TRUE(profiler.IsThrottled(b));
+    profiler.RemovePlugin(b);
+    ASSERT_FALSE(profiler.IsThrottled(b));
+}
+
+TEST_F(PluginProfilerTest, LogsPluginsOverBudget)
+{
+    auto a = CreatePlugin("a");
+
+    PluginProfiler profiler;
+    profiler.SetBudget(1, PluginBudgetAction::Log);
+    profiler.Record(a, "interval", 1500);
+    profiler.EndTick();
+    ASSERT_FALSE(profiler.IsThrottled(a));
+
+    profiler.SetBudget(0, PluginBudgetAction::Throttle);
+    ASSERT_EQ(profiler.GetBudgetAction(), PluginBudgetAction::None);
+    ASSERT_FALSE(profiler.IsTiming());
+    profiler.Record(a, "interval", 1500);
+    profiler.EndTick();
+    ASSERT_FALSE(profiler.IsThrottled(a));
+}
+
+#endif
@@ -18,11 +18,15 @@
 #include <openrct2/audio/AudioContext.h>
 #include <openrct2/core/File.h>
 #include <openrct2/core/FileScanner.h>
+#include <openrct2/core/FileSystem.hpp>
 #include <openrct2/core/Path.hpp>
 #include <openrct2/core/String.hpp>
+#include <openrct2/entity/EntityRegistry.h>
 #include <openrct2/platform/Platform.h>
 #include <openrct2/ride/Ride.h>
+#include <algorithm>
 #include <string>
+#include <unordered_map>
 
 using namespace OpenRCT2;
 
@@ -97,6 +101,117 @@ TEST_P(ReplayTests, RunReplay)
     ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
 }
 
+TEST_P(ReplayTests, RunReplaySegments)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    auto testData = GetParam();
+    auto replayFile = testData.filePath;
+
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    IReplayManager* replayManager = context->GetReplayManager();
+    ASSERT_NE(replayManager, nullptr);
+
+    ReplayRecordInfo info{};
+    ASSERT_TRUE(replayManager->GetReplayInfo(replayFile, info));
+
+    // Without keyframes the only segment is the whole replay, which RunReplay already covers
+    if (info.NumKeyframes == 0)
+    {
+        GTEST_SKIP() << "Replay has no keyframes";
+    }
+
+    for (uint32_t segment = 0; segment <= info.NumKeyframes; segment++)
+    {
+        bool startedReplay = replayManager->StartSegmentPlayback(replayFile, segment);
+        ASSERT_TRUE(startedReplay);
+
+        while (replayManager->IsReplaying())
+        {
+            gameStateUpdateLogic();
+            if (replayManager->IsPlaybackStateMismatching())
+                break;
+        }
+        ASSERT_FALSE(replayManager->IsReplaying());
+        ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
+    }
+}
+
+TEST(ReplayKeyframeTests, RecordedSegmentsAndSeeksMatchRecording)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    GetContext()->LoadParkFromFile(TestData::GetParkPath("small_park_with_ferris_wheel.sv6"));
+    GameLoadInit();
+
+    IReplayManager* replayManager = context->GetReplayManager();
+    ASSERT_NE(replayManager, nullptr);
+
+    // Long enough for two keyframes, which splits the replay into three segments
+    const auto replayFile = (fs::temp_directory_path() / "openrct2-keyframe-test.parkrep").string();
+    const uint32_t replayTicks = 2 * k_ReplayKeyframeTicks + 100;
+    const auto tickStart = GetGameState().CurrentTicks;
+    ASSERT_TRUE(replayManager->StartRecording(replayFile, replayTicks));
+
+    // Entity checksums after each recorded tick, keyed by the tick that follows
+    std::unordered_map<uint32_t, std::string> checksums;
+    while (replayManager->IsRecording())
+    {
+        gameStateUpdateLogic();
+        checksums[GetGameState().CurrentTicks] = GetAllEntitiesChecksum().ToString();
+    }
+
+    ReplayRecordInfo info{};
+    ASSERT_TRUE(replayManager->GetReplayInfo(replayFile, info));
+    ASSERT_EQ(info.Ticks, replayTicks);
+    ASSERT_EQ(info.NumKeyframes, 2u);
+
+    for (uint32_t segment = 0; segment <= info.NumKeyframes; segment++)
+    {
+        bool startedReplay = replayManager->StartSegmentPlayback(replayFile, segment);
+        ASSERT_TRUE(startedReplay);
+        ASSERT_EQ(GetGameState().CurrentTicks, tickStart + segment * k_ReplayKeyframeTicks);
+
+        while (replayManager->IsReplaying())
+        {
+            gameStateUpdateLogic();
+            if (replayManager->IsPlaybackStateMismatching())
+                break;
+        }
+        ASSERT_FALSE(replayManager->IsReplaying());
+        ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
+
+        // Playback stops at the start of the segment's last tick, which still runs
+        const auto segmentEnd = std::min(tickStart + (segment + 1) * k_ReplayKeyframeTicks, tickStart + replayTicks);
+        ASSERT_EQ(GetGameState().CurrentTicks, segmentEnd + 1);
+        ASSERT_EQ(GetAllEntitiesChecksum().ToString(), checksums[segmentEnd + 1]);
+    }
+
+    // Seek forward past the last keyframe, then back to before the first one
+    bool startedReplay = replayManager->StartPlayback(replayFile);
+    ASSERT_TRUE(startedReplay);
+    for (uint32_t tick : { 2 * k_ReplayKeyframeTicks + 50, k_ReplayKeyframeTicks / 2 })
+    {
+        ASSERT_TRUE(replayManager->SeekPlayback(tick));
+        ASSERT_TRUE(replayManager->IsReplaying());
+        ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
+        ASSERT_EQ(GetGameState().CurrentTicks, tickStart + tick);
+        ASSERT_EQ(GetAllEntitiesChecksum().ToString(), checksums[tickStart + tick]);
+    }
+    replayManager->StopPlayback();
+
+    File::Delete(replayFile);
+}
+
 static void PrintTo(const ReplayTestData& testData, std::ostream* os)
 {
     *os << testData.filePath;
@@ -22,12 +22,14 @@
 #include <openrct2/core/Crypt.h>
 #include <openrct2/core/File.h>
 #include <openrct2/core/MemoryStream.h>
+#include <openrct2/core/OrcaStream.hpp>
 #include <openrct2/core/Path.hpp>
 #include <openrct2/core/String.hpp>
 #include <openrct2/entity/EntityRegistry.h>
 #include <openrct2/entity/EntityTweener.h>
 #include <openrct2/network/network.h>
 #include <openrct2/object/ObjectManager.h>
+#include <openrct2/object/ObjectRepository.h>
 #include <openrct2/park/ParkFile.h>
 #include <openrct2/platform/Platform.h>
 #include <openrct2/rct2/RCT2.h>
@@ -278,6 +280,80 @@ TEST(S6ImportExportAdvanceTicks, all)
     SUCCEED();
 }
 
+TEST(S6ImportExportPackedObjects, all)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    MemoryStream importBuffer;
+    MemoryStream exportBuffer;
+    MemoryStream snapshotStream;
+    size_t numExported{};
+
+    // Load initial park data and pack every loaded object, not just custom ones.
+    {
+        std::unique_ptr<IContext> context = CreateContext();
+        EXPECT_NE(context, nullptr);
+
+        bool initialised = context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        std::string testParkPath = TestData::GetParkPath("BigMapTest.sv6");
+        ASSERT_TRUE(LoadFileToBuffer(importBuffer, testParkPath));
+        ASSERT_TRUE(ImportS6(importBuffer, context, false));
+        RecordGameStateSnapshot(context, snapshotStream);
+
+        auto& objRepository = context->GetObjectRepository();
+        auto exporter = std::make_unique<ParkFileExporter>();
+        for (size_t i = 0; i < objRepository.GetNumObjects(); i++)
+        {
+            const auto* item = &objRepository.GetObjects()[i];
+            if (item->LoadedObject != nullptr)
+            {
+                exporter->ExportObjectsList.push_back(item);
+            }
+        }
+        numExported = exporter->ExportObjectsList.size();
+        ASSERT_GT(numExported, 0u);
+        exporter->Export(GetGameState(), exportBuffer);
+    }
+
+    // The packed objects are stored in their own chunk.
+    {
+        constexpr uint32_t kPackedObjectsChunk = 0x80;
+
+        exportBuffer.SetPosition(0);
+        OrcaStream os(exportBuffer, OrcaStream::Mode::READING);
+        ASSERT_EQ(os.GetHeader().Compression, OrcaStream::COMPRESSION_GZIP_CHUNKED);
+
+        uint32_t numPacked{};
+        ASSERT_TRUE(os.ReadWriteChunk(
+            kPackedObjectsChunk, [&numPacked](OrcaStream::ChunkStream& cs) { numPacked = cs.Read<uint32_t>(); }));
+        ASSERT_GT(numPacked, 0u);
+        ASSERT_LE(numPacked, numExported);
+    }
+
+    // Import the exported version, all objects are installed so the packed ones are left alone.
+    {
+        std::unique_ptr<IContext> context = CreateContext();
+        EXPECT_NE(context, nullptr);
+
+        bool initialised = context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        auto numObjects = context->GetObjectRepository().GetNumObjects();
+        ASSERT_TRUE(ImportPark(exportBuffer, context, true));
+        ASSERT_EQ(context->GetObjectRepository().GetNumObjects(), numObjects);
+
+        RecordGameStateSnapshot(context, snapshotStream);
+    }
+
+    snapshotStream.SetPosition(0);
+    CompareStates(importBuffer, exportBuffer, snapshotStream);
+
+    SUCCEED();
+}
+
 TEST(SeaDecrypt, DecryptSea)
 {
     auto path = TestData::GetParkPath("volcania.sea");
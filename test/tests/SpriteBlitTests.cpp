@@ -0,0 +1,316 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/drawing/SpriteLodCache.h>
+#include <random>
+#include <vector>
+
+class SpriteBlitTests : public testing::Test
+{
+protected:
+    static constexpr int32_t kWidth = 77;
+    static constexpr int32_t kHeight = 40;
+    static constexpr int32_t kMaxScale = 4;
+    static constexpr uint16_t kNumBlendMaps = 255;
+
+    std::mt19937 _rng{ 1234 };
+    std::vector<uint8_t> _bitmap;
+    std::vector<uint8_t> _rle;
+    std::vector<uint8_t> _remap;
+    std::vector<uint8_t> _blend;
+    std::vector<uint8_t> _background;
+
+    void SetUp() override
+    {
+        SpriteLodCacheClear();
+        SpriteLodCacheResetStats();
+        CreateBitmap(5);
+
+        // Remaps to 0 count as transparent, so include some of those too.
+        _remap.resize(256);
+        for (auto& entry : _remap)
+        {
+            entry = (_rng() % 7) == 0 ? 0 : static_cast<uint8_t>(_rng());
+        }
+        // One blend map per opaque source colour.
+        _blend.resize(kNumBlendMaps * 256);
+        for (auto& entry : _blend)
+        {
+            entry = (_rng() % 7) == 0 ? 0 : static_cast<uint8_t>(_rng());
+        }
+
+        _background.resize(kWidth * kHeight * kMaxScale * kMaxScale);
+        for (auto& pixel : _background)
+        {
+            pixel = static_cast<uint8_t>(_rng());
+        }
+    }
+
+    void TearDown() override
+    {
+        SpriteLodCacheClear();
+        SpriteLodCacheSetBudget(kSpriteLodCacheDefaultBudget);
+    }
+
+    // A bitmap with transparent gaps of varying length so RLE runs start and end at odd positions.
+    void CreateBitmap(uint32_t gapChance)
+    {
+        _bitmap.resize(kWidth * kHeight);
+        for (auto& pixel : _bitmap)
+        {
+            pixel = (_rng() % gapChance) == 0 ? 0 : static_cast<uint8_t>(_rng());
+        }
+        EncodeRLE();
+    }
+
+    void EncodeRLE()
+    {
+        _rle.assign(kHeight * 2, 0);
+        for (int32_t y = 0; y < kHeight; y++)
+        {
+            const auto lineOffset = _rle.size();
+            _rle[y * 2] = lineOffset & 0xFF;
+            _rle[y * 2 + 1] = (lineOffset >> 8) & 0xFF;
+
+            const uint8_t* line = &_bitmap[y * kWidth];
+            size_t runHeader = SIZE_MAX;
+            for (int32_t x = 0; x < kWidth;)
+            {
+                if (line[x] == 0)
+                {
+                    x++;
+                    continue;
+                }
+                auto runLength = 0;
+                while (x + runLength < kWidth && line[x + runLength] != 0 && runLength < 0x7F)
+                {
+                    runLength++;
+                }
+                runHeader = _rle.size();
+                _rle.push_back(static_cast<uint8_t>(runLength));
+                _rle.push_back(static_cast<uint8_t>(x));
+                _rle.insert(_rle.end(), line + x, line + x + runLength);
+                x += runLength;
+            }
+            if (runHeader == SIZE_MAX)
+            {
+                // Empty line, a zero length run that ends the line.
+                _rle.push_back(0x80);
+                _rle.push_back(0);
+            }
+            else
+            {
+                _rle[runHeader] |= 0x80;
+            }
+        }
+    }
+
+    std::vector<uint8_t> Draw(
+        bool vectorised, bool rle, ImageId imageId, const PaletteMap& paletteMap, int8_t zoom, int32_t srcX,
+        int32_t srcY = 0)
+    {
+        GfxSetVectorisedBlitting(vectorised);
+
+        G1Element g1{};
+        g1.offset = rle ? _rle.data() : _bitmap.data();
+        g1.width = kWidth;
+        g1.height = kHeight;
+        g1.flags = rle ? G1_FLAG_RLE_COMPRESSION : G1_FLAG_HAS_TRANSPARENCY;
+
+        auto buffer = _background;
+        DrawPixelInfo dpi{};
+        dpi.bits = buffer.data();
+        dpi.width = kWidth;
+        dpi.height = kHeight;
+        dpi.zoom_level = ZoomLevel{ zoom };
+
+        DrawSpriteArgs args(imageId, paletteMap, g1, srcX, srcY, kWidth - srcX, kHeight - std::max(srcY, 0), buffer.data());
+        if (rle)
+        {
+            GfxRleSpriteToBuffer(dpi, args);
+        }
+        else
+        {
+            GfxBmpSpriteToBuffer(dpi, args);
+        }
+
+        GfxSetVectorisedBlitting(true);
+        return buffer;
+    }
+
+    void CompareAllZoomLevels(ImageId imageId, const PaletteMap& paletteMap)
+    {
+        for (auto rle : { false, true })
+        {
+            for (int8_t zoom = -2; zoom <= 3; zoom++)
+            {
+                for (auto srcX : { 0, 5 })
+                {
+                    // The BMP magnify path does not support partial sprites.
+                    if (!rle && zoom < 0 && srcX != 0)
+                        continue;
+
+                    auto scalar = Draw(false, rle, imageId, paletteMap, zoom, srcX);
+                    auto vectorised = Draw(true, rle, imageId, paletteMap, zoom, srcX);
+                    ASSERT_EQ(scalar, vectorised) << (rle ? "RLE" : "BMP") << " zoom " << static_cast<int32_t>(zoom)
+                                                  << " srcX " << srcX;
+                }
+            }
+        }
+    }
+};
+
+TEST_F(SpriteBlitTests, Transparent)
+{
+    CompareAllZoomLevels(ImageId(0), PaletteMap::GetDefault());
+}
+
+TEST_F(SpriteBlitTests, SourceRemap)
+{
+    CompareAllZoomLevels(ImageId(0).WithPrimary(COLOUR_BLACK), PaletteMap(_remap.data(), 1, 256));
+}
+
+TEST_F(SpriteBlitTests, DestinationRemap)
+{
+    CompareAllZoomLevels(ImageId(0).WithBlended(true), PaletteMap(_remap.data(), 1, 256));
+}
+
+TEST_F(SpriteBlitTests, Blend)
+{
+    CompareAllZoomLevels(ImageId(0).WithPrimary(COLOUR_BLACK).WithBlended(true), PaletteMap(_blend.data(), kNumBlendMaps, 256));
+}
+
+TEST_F(SpriteBlitTests, LongRuns)
+{
+    // Runs long enough to be handed to the row blitters
+    CreateBitmap(40);
+    CompareAllZoomLevels(ImageId(0), PaletteMap::GetDefault());
+    CompareAllZoomLevels(ImageId(0).WithPrimary(COLOUR_BLACK), PaletteMap(_remap.data(), 1, 256));
+    CompareAllZoomLevels(ImageId(0).WithBlended(true), PaletteMap(_remap.data(), 1, 256));
+}
+
+TEST_F(SpriteBlitTests, LodCacheMatchesDirectMinify)
+{
+    const PaletteMap remap(_remap.data(), 1, 256);
+    for (int8_t zoom = 1; zoom <= 3; zoom++)
+    {
+        for (auto srcX : { -3, 0, 5, 6 })
+        {
+            for (auto srcY : { -1, 0, 3 })
+            {
+                for (auto imageId : { ImageId(0), ImageId(0).WithPrimary(COLOUR_BLACK) })
+                {
+                    SpriteLodCacheSetBudget(0);
+                    auto direct = Draw(true, true, imageId, remap, zoom, srcX, srcY);
+
+                    SpriteLodCacheSetBudget(kSpriteLodCacheDefaultBudget);
+                    auto built = Draw(true, true, imageId, remap, zoom, srcX, srcY);
+                    auto cached = Draw(true, true, imageId, remap, zoom, srcX, srcY);
+                    ASSERT_EQ(direct, built) << "zoom " << static_cast<int32_t>(zoom) << " src " << srcX << "," << srcY;
+                    ASSERT_EQ(direct, cached) << "zoom " << static_cast<int32_t>(zoom) << " src " << srcX << "," << srcY;
+                }
+            }
+        }
+    }
+
+    auto stats = SpriteLodCacheGetStats();
+    ASSERT_GT(stats.Hits, 0u);
+    ASSERT_GT(stats.Entries, 0u);
+
+    SpriteLodCacheInvalidate(0);
+    ASSERT_EQ(SpriteLodCacheGetStats().Entries, 0u);
+}
+
+TEST_F(SpriteBlitTests, LodCacheEvictsOnlyWhatIsNeeded)
+{
+    G1Element g1{};
+    g1.offset = _rle.data();
+    g1.width = kWidth;
+    g1.height = kHeight;
+    g1.flags = G1_FLAG_RLE_COMPRESSION;
+    const auto get = [&](ImageIndex imageIndex) { return SpriteLodCacheGet(imageIndex, g1, 1, 0, 0) != nullptr; };
+
+    // Room for three and a half copies of the same LOD
+    ASSERT_TRUE(get(1));
+    const auto size = SpriteLodCacheGetStats().Bytes;
+    SpriteLodCacheSetBudget(size * 3 + size / 2);
+    ASSERT_TRUE(get(2));
+    ASSERT_TRUE(get(3));
+    ASSERT_EQ(SpriteLodCacheGetStats().Entries, 3u);
+
+    // Every entry has been drawn, one is evicted rather than the whole cache
+    ASSERT_TRUE(get(4));
+    auto stats = SpriteLodCacheGetStats();
+    ASSERT_EQ(stats.Entries, 3u);
+    ASSERT_EQ(stats.Evictions, 1u);
+
+    // Image 2 is drawn again so it gets a second chance, image 3 is evicted instead
+    ASSERT_TRUE(get(2));
+    ASSERT_TRUE(get(5));
+    stats = SpriteLodCacheGetStats();
+    ASSERT_EQ(stats.Entries, 3u);
+    ASSERT_EQ(stats.Evictions, 2u);
+
+    ASSERT_TRUE(get(2));
+    ASSERT_TRUE(get(4));
+    ASSERT_TRUE(get(5));
+    ASSERT_EQ(SpriteLodCacheGetStats().Misses, stats.Misses);
+    ASSERT_TRUE(get(3));
+    ASSERT_EQ(SpriteLodCacheGetStats().Misses, stats.Misses + 1);
+}
+
+TEST_F(SpriteBlitTests, LodCacheIsFasterThanDirectMinify)
+{
+    G1Element g1{};
+    g1.offset = _rle.data();
+    g1.width = kWidth;
+    g1.height = kHeight;
+    g1.flags = G1_FLAG_RLE_COMPRESSION;
+    const PaletteMap remap(_remap.data(), 1, 256);
+
+    // Best of several rounds, so a round that was descheduled does not count
+    const auto timeDraws = [&](size_t budget, int8_t zoom) {
+        constexpr int32_t kRounds = 5;
+        constexpr int32_t kDrawsPerRound = 500;
+        SpriteLodCacheSetBudget(budget);
+
+        auto buffer = _background;
+        DrawPixelInfo dpi{};
+        dpi.bits = buffer.data();
+        dpi.width = kWidth;
+        dpi.height = kHeight;
+        dpi.zoom_level = ZoomLevel{ zoom };
+
+        auto best = std::chrono::duration<double, std::micro>::max();
+        for (int32_t round = 0; round < kRounds; round++)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (int32_t i = 0; i < kDrawsPerRound; i++)
+            {
+                DrawSpriteArgs args(ImageId(0).WithPrimary(COLOUR_BLACK), remap, g1, 0, 0, kWidth, kHeight, buffer.data());
+                GfxRleSpriteToBuffer(dpi, args);
+            }
+            best = std::min<std::chrono::duration<double, std::micro>>(best, std::chrono::steady_clock::now() - start);
+        }
+        return best.count() / kDrawsPerRound;
+    };
+
+    for (int8_t zoom = 2; zoom <= 3; zoom++)
+    {
+        const auto direct = timeDraws(0, zoom);
+        const auto cached = timeDraws(kSpriteLodCacheDefaultBudget, zoom);
+        std::printf("zoom %d: direct %.3f us, cached %.3f us per draw\n", zoom, direct, cached);
+        EXPECT_LT(cached, direct) << "zoom " << static_cast<int32_t>(zoom);
+    }
+}
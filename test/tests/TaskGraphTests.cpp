@@ -0,0 +1,99 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <openrct2/core/TaskGraph.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace OpenRCT2;
+
+TEST(TaskGraphTest, RunsDependenciesFirst)
+{
+    std::mutex mutex;
+    std::vector<int> order;
+    auto record = [&](int value) {
+        return [&, value]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(value);
+        };
+    };
+
+    TaskGraph graph;
+    auto a = graph.AddTask("a", record(0));
+    auto b = graph.AddTask("b", record(1), { a });
+    auto c = graph.AddTask("c", record(2), { a });
+    graph.AddTask("d", record(3), { b, c });
+    graph.Run(4);
+
+    ASSERT_EQ(order.size(), 4u);
+    ASSERT_EQ(order.front(), 0);
+    ASSERT_EQ(order.back(), 3);
+
+    const auto& timings = graph.GetTimings();
+    ASSERT_EQ(timings.size(), 4u);
+    for (const auto& timing : timings)
+    {
+        ASSERT_TRUE(timing.Ran);
+    }
+    ASSERT_EQ(timings[3].Name, "d");
+    ASSERT_GE(timings[3].Start, timings[1].Start + timings[1].Duration);
+}
+
+TEST(TaskGraphTest, RunsIndependentTasksConcurrently)
+{
+    std::atomic<int> running{ 0 };
+    std::atomic<int> maxRunning{ 0 };
+    auto task = [&]() {
+        auto now = ++running;
+        auto prev = maxRunning.load();
+        while (now > prev && !maxRunning.compare_exchange_weak(prev, now))
+        {
+        }
+        // Wait for the other task so both are known to be in flight together
+        for (int i = 0; i < 1000000 && maxRunning < 2; i++)
+        {
+            std::this_thread::yield();
+        }
+        running--;
+    };
+
+    TaskGraph graph;
+    graph.AddTask("a", task);
+    graph.AddTask("b", task);
+    graph.Run(2);
+
+    ASSERT_EQ(maxRunning.load(), 2);
+}
+
+TEST(TaskGraphTest, FailureSkipsDependents)
+{
+    bool independentRan = false;
+    bool dependentRan = false;
+
+    TaskGraph graph;
+    auto failing = graph.AddTask("failing", []() { throw std::runtime_error("failed"); });
+    graph.AddTask("dependent", [&]() { dependentRan = true; }, { failing });
+    graph.AddTask("independent", [&]() { independentRan = true; });
+
+    ASSERT_THROW(graph.Run(2), std::runtime_error);
+    ASSERT_FALSE(dependentRan);
+    ASSERT_TRUE(independentRan);
+    ASSERT_FALSE(graph.GetTimings()[0].Ran);
+    ASSERT_FALSE(graph.GetTimings()[1].Ran);
+}
+
+TEST(TaskGraphTest, RejectsUnknownDependency)
+{
+    TaskGraph graph;
+    ASSERT_THROW(graph.AddTask("a", []() {}, { 1 }), std::out_of_range);
+}
@@ -0,0 +1,93 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/world/TileElement.h>
+#include <openrct2/world/TileElementTypeIndex.h>
+#include <vector>
+
+static constexpr uint16_t kTestMapSize = 4;
+
+static std::vector<TileElement> CreateSurfaceTiles()
+{
+    std::vector<TileElement> elements(kTestMapSize * kTestMapSize);
+    for (auto& element : elements)
+    {
+        element.ClearAs(TileElementType::Surface);
+        element.SetLastForTile(true);
+    }
+    return elements;
+}
+
+TEST(TileElementTypeIndexTest, ListsTilesFromElements)
+{
+    auto elements = CreateSurfaceTiles();
+
+    // Give tile (2, 1) a path on top of its surface
+    auto it = elements.begin() + 1 * kTestMapSize + 2;
+    it->SetLastForTile(false);
+    auto path = elements.emplace(it + 1);
+    path->ClearAs(TileElementType::Path);
+    path->SetLastForTile(true);
+
+    TileElementTypeIndex index(kTestMapSize, elements.data(), elements.size());
+    auto tiles = index.GetTiles({ TileElementType::Path });
+    ASSERT_EQ(tiles.size(), 1u);
+    ASSERT_EQ(tiles[0], TileCoordsXY(2, 1));
+    ASSERT_TRUE(index.GetTiles({ TileElementType::Track }).empty());
+}
+
+TEST(TileElementTypeIndexTest, OrdersTilesByColumn)
+{
+    auto elements = CreateSurfaceTiles();
+    TileElementTypeIndex index(kTestMapSize, elements.data(), elements.size());
+
+    index.Add({ 3, 0 }, TileElementType::Banner);
+    index.Add({ 1, 2 }, TileElementType::Wall);
+    index.Add({ 1, 1 }, TileElementType::Banner);
+    index.Add({ 1, 1 }, TileElementType::Wall);
+
+    auto tiles = index.GetTiles({ TileElementType::Wall, TileElementType::Banner });
+    std::vector<TileCoordsXY> expected = { { 1, 1 }, { 1, 2 }, { 3, 0 } };
+    ASSERT_EQ(tiles, expected);
+}
+
+TEST(TileElementTypeIndexTest, SetTileTypesDropsAndReaddsTiles)
+{
+    auto elements = CreateSurfaceTiles();
+    TileElementTypeIndex index(kTestMapSize, elements.data(), elements.size());
+    const auto smallSceneryMask = TileElementTypeIndex::GetTypeMask(TileElementType::SmallScenery);
+    const auto surfaceMask = TileElementTypeIndex::GetTypeMask(TileElementType::Surface);
+
+    index.Add({ 0, 3 }, TileElementType::SmallScenery);
+    index.SetTileTypes({ 0, 3 }, surfaceMask);
+    ASSERT_TRUE(index.GetTiles({ TileElementType::SmallScenery }).empty());
+
+    index.SetTileTypes({ 0, 3 }, surfaceMask | smallSceneryMask);
+    index.SetTileTypes({ 0, 3 }, surfaceMask);
+    index.Add({ 0, 3 }, TileElementType::SmallScenery);
+    auto tiles = index.GetTiles({ TileElementType::SmallScenery });
+    ASSERT_EQ(tiles.size(), 1u);
+    ASSERT_EQ(tiles[0], TileCoordsXY(0, 3));
+    ASSERT_EQ(index.GetTileTypes({ 0, 3 }), surfaceMask | smallSceneryMask);
+}
+
+TEST(TileElementTypeIndexTest, GetTypeMaskOfTile)
+{
+    TileElement elements[3];
+    elements[0].ClearAs(TileElementType::Surface);
+    elements[1].ClearAs(TileElementType::Track);
+    elements[2].ClearAs(TileElementType::Track);
+    elements[2].SetLastForTile(true);
+
+    const auto expected = TileElementTypeIndex::GetTypeMask(TileElementType::Surface)
+        | TileElementTypeIndex::GetTypeMask(TileElementType::Track);
+    ASSERT_EQ(TileElementTypeIndex::GetTypeMask(elements), expected);
+    ASSERT_EQ(TileElementTypeIndex::GetTypeMask(static_cast<const TileElement*>(nullptr)), 0);
+}